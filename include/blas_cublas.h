@@ -1,5 +1,7 @@
 #include <quda_internal.h>
+#ifndef QUDA_HOST_ONLY
 #include <cublas_v2.h>
+#endif
 
 #pragma once
 
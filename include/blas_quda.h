@@ -90,6 +90,19 @@ namespace quda {
     double3 HeavyQuarkResidualNorm(ColorSpinorField &x, ColorSpinorField &r);
     double3 xpyHeavyQuarkResidualNorm(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &r);
 
+    /**
+       @brief Forms the true residual of a shifted system, r = b - (r
+       + a * x), where r is the unshifted operator applied to x, and
+       returns the norms used by the solvers' residual checks
+       @param a[in] Shift
+       @param x[in] Solution vector
+       @param b[in] Source vector
+       @param r[in,out] Unshifted operator applied to x on input, residual on output
+       @return (|x|^2, |r|^2, heavy-quark residual norm squared)
+    */
+    double3 axpyXmyHeavyQuarkResidualNorm(const double &a, ColorSpinorField &x, ColorSpinorField &b,
+					  ColorSpinorField &r);
+
     void tripleCGUpdate(const double &alpha, const double &beta, ColorSpinorField &q,
 			ColorSpinorField &r, ColorSpinorField &x, ColorSpinorField &p);
     double3 tripleCGReduction(ColorSpinorField &x, ColorSpinorField &y, ColorSpinorField &z);
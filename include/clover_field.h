@@ -311,6 +311,16 @@ namespace quda {
   */
   void cloverInvert(CloverField &clover, bool computeTraceLog, QudaFieldLocation location);
 
+  /**
+     @brief Invert a host clover field in packed order on the host
+     threads, processing a batch of chiral blocks per SIMD vector.
+     Twisted fields are inverted as (A^2 + mu^2)^{-1}.
+
+     @param clover The clover field (contains both the field itself and its inverse)
+     @param computeTraceLog Whether to compute the trace logarithm of the clover term
+  */
+  void cloverInvertHost(CloverField &clover, bool computeTraceLog);
+
   /**
      @brief This function adds a real scalar onto the clover diagonal (only to the direct field not the inverse)
 
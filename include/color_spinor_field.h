@@ -5,6 +5,7 @@
 #include <quda.h>
 
 #include <iostream>
+#include <memory>
 
 #include <lattice_field.h>
 #include <random_quda.h>
@@ -15,6 +16,19 @@ namespace quda {
 
   struct FullClover;
 
+  /**
+     @brief Size and error of the compressed halos packed from a set
+     of fields (see QudaGhostCompression)
+  */
+  struct GhostCompressionStats {
+    size_t raw_bytes;        //! bytes the halos would have taken uncompressed
+    size_t compressed_bytes; //! bytes actually packed
+    double max_error;        //! largest per-site relative error
+
+    GhostCompressionStats() : raw_bytes(0), compressed_bytes(0), max_error(0.0) { }
+    void reset() { raw_bytes = 0; compressed_bytes = 0; max_error = 0.0; }
+  };
+
   /** Typedef for a set of spinors. Can be further divided into subsets ,e.g., with different precisions (not implemented currently) */
   typedef std::vector<ColorSpinorField*> CompositeColorSpinorField;
 
@@ -103,6 +117,9 @@ namespace quda {
     bool is_component;
     int component_id;          //eigenvector index
 
+    QudaGhostCompression ghost_compression; // format of the halo messages sent by the host coarse operator
+    std::shared_ptr<GhostCompressionStats> ghost_stats; // where the compressed halo statistics are recorded (optional)
+
     ColorSpinorParam(const ColorSpinorField &a);
 
   ColorSpinorParam()
@@ -110,7 +127,8 @@ namespace quda {
       nSpin(0), twistFlavor(QUDA_TWIST_INVALID), siteOrder(QUDA_INVALID_SITE_ORDER),
       fieldOrder(QUDA_INVALID_FIELD_ORDER), gammaBasis(QUDA_INVALID_GAMMA_BASIS),
       create(QUDA_INVALID_FIELD_CREATE), PCtype(QUDA_PC_INVALID),
-      is_composite(false), composite_dim(0), is_component(false), component_id(0) { ; }
+      is_composite(false), composite_dim(0), is_component(false), component_id(0),
+      ghost_compression(QUDA_GHOST_COMPRESSION_NONE) { ; }
 
       // used to create cpu params
   ColorSpinorParam(void *V, QudaInvertParam &inv_param, const int *X, const bool pc_solution,
@@ -124,7 +142,8 @@ namespace quda {
       create(QUDA_REFERENCE_FIELD_CREATE),
       PCtype(((inv_param.dslash_type==QUDA_DOMAIN_WALL_4D_DSLASH)||
 	      (inv_param.dslash_type==QUDA_MOBIUS_DWF_DSLASH))?QUDA_4D_PC:QUDA_5D_PC ),
-      v(V), is_composite(false), composite_dim(0), is_component(false), component_id(0) {
+      v(V), is_composite(false), composite_dim(0), is_component(false), component_id(0),
+      ghost_compression(QUDA_GHOST_COMPRESSION_NONE) {
 
         if (nDim > QUDA_MAX_DIM) errorQuda("Number of dimensions too great");
 	for (int d=0; d<nDim; d++) x[d] = X[d];
@@ -180,7 +199,8 @@ namespace quda {
       location(location), nColor(cpuParam.nColor), nSpin(cpuParam.nSpin), twistFlavor(cpuParam.twistFlavor),
       siteOrder(QUDA_EVEN_ODD_SITE_ORDER), fieldOrder(QUDA_INVALID_FIELD_ORDER),
       gammaBasis(nSpin == 4? QUDA_UKQCD_GAMMA_BASIS : QUDA_DEGRAND_ROSSI_GAMMA_BASIS),
-      create(QUDA_COPY_FIELD_CREATE), PCtype(cpuParam.PCtype), v(0), is_composite(cpuParam.is_composite), composite_dim(cpuParam.composite_dim), is_component(false), component_id(0)
+      create(QUDA_COPY_FIELD_CREATE), PCtype(cpuParam.PCtype), v(0), is_composite(cpuParam.is_composite), composite_dim(cpuParam.composite_dim), is_component(false), component_id(0),
+      ghost_compression(QUDA_GHOST_COMPRESSION_NONE)
       {
 	siteSubset = cpuParam.siteSubset;
 	fieldOrder = (precision == QUDA_DOUBLE_PRECISION || nSpin == 1) ?
@@ -262,6 +282,9 @@ namespace quda {
 
     QudaDWFPCType PCtype; // used to select preconditioning method in DWF
 
+    QudaGhostCompression ghost_compression; // format of the halo messages sent by the host coarse operator
+    std::shared_ptr<GhostCompressionStats> ghost_stats; // where the compressed halo statistics are recorded (optional)
+
     size_t real_length; // physical length only
     size_t length; // length including pads, but not ghost zone - used for BLAS
 
@@ -396,6 +419,33 @@ namespace quda {
 
     QudaDWFPCType DWFPCtype() const { return PCtype; }
 
+    /**
+       @return The format of the halo messages sent by the host coarse operator
+    */
+    QudaGhostCompression GhostCompression() const { return ghost_compression; }
+
+    /**
+       @return Where the statistics of the compressed halos packed
+       from this field are recorded (may be null)
+    */
+    GhostCompressionStats* GhostStats() const { return ghost_stats.get(); }
+
+    /**
+       @brief Set the format of the halo messages sent by the host
+       coarse operator.  Fields created from this field inherit it.
+       @param[in] compression The halo format
+       @param[in] stats Where to record the size and error of the
+       compressed halos (optional).  Fields created from this field
+       share it, so their halos are recorded too, and it stays valid
+       for as long as any of them does.
+    */
+    void setGhostCompression(QudaGhostCompression compression, std::shared_ptr<GhostCompressionStats> stats=nullptr) {
+      ghost_compression = compression;
+      ghost_stats = stats;
+      if (even) even->setGhostCompression(compression, stats);
+      if (odd) odd->setGhostCompression(compression, stats);
+    }
+
     QudaSiteSubset SiteSubset() const { return siteSubset; }
     QudaSiteOrder SiteOrder() const { return siteOrder; }
     QudaFieldOrder FieldOrder() const { return fieldOrder; }
@@ -733,6 +783,29 @@ namespace quda {
     static size_t ghostFaceBytes[QUDA_MAX_DIM];
 
     private:
+    // persistent message handles for the static ghost buffers
+    static MsgHandle *mh_ghost_send_fwd[QUDA_MAX_DIM];
+    static MsgHandle *mh_ghost_send_back[QUDA_MAX_DIM];
+    static MsgHandle *mh_ghost_recv_fwd[QUDA_MAX_DIM];
+    static MsgHandle *mh_ghost_recv_back[QUDA_MAX_DIM];
+    static size_t ghostMsgBytes[QUDA_MAX_DIM]; // message size the handles were declared with
+
+    /**
+       @brief Create the persistent message handles for the ghost
+       buffers, redeclaring those whose message size has changed
+       @param[in] nFace Depth of each halo
+    */
+    void createGhostComms(int nFace) const;
+    static void destroyGhostComms();
+
+    /**
+       @return The size of the halo message in a given dimension in
+       the format given by GhostCompression()
+       @param[in] dim Dimension
+       @param[in] nFace Depth of the halo
+    */
+    size_t ghostMessageBytes(int dim, int nFace) const;
+
     //void *v; // the field elements
     //void *norm; // the normalization field
     bool init;
@@ -787,6 +860,28 @@ namespace quda {
     void exchangeGhost(QudaParity parity, int nFace, int dagger, const MemoryLocation *pack_destination=nullptr,
 		       const MemoryLocation *halo_location=nullptr, bool gdr_send=false, bool gdr_recv=false) const;
 
+    /**
+       @brief Pack the ghost zone and start a non-blocking halo
+       exchange into the persistent ghost buffers.  Must be completed
+       with exchangeGhostWait() before the halo is read.  The
+       messages are sent in the format given by GhostCompression().
+       @param[in] parity Field parity
+       @param[in] nFace Depth of halo exchange
+       @param[in] dagger Is this for a dagger operator
+    */
+    void exchangeGhostStart(QudaParity parity, int nFace, int dagger) const;
+
+    /**
+       @brief Progress the halo exchange started with exchangeGhostStart()
+       @return Whether all messages have completed
+    */
+    bool exchangeGhostQuery() const;
+
+    /**
+       @brief Complete the halo exchange started with exchangeGhostStart()
+    */
+    void exchangeGhostWait() const;
+
     /**
        @brief Backs up the cudaColorSpinorField
     */
@@ -801,6 +896,35 @@ namespace quda {
   void copyGenericColorSpinor(ColorSpinorField &dst, const ColorSpinorField &src,
       QudaFieldLocation location, void *Dst=0, void *Src=0,
       void *dstNorm=0, void*srcNorm=0);
+
+  /**
+     @brief Copy src into dst through the generic field-order
+     accessors, the path taken by copyGenericColorSpinor when the host
+     reorder engine does not apply.  Used to verify the host engine.
+  */
+  void copyGenericColorSpinorAccessor(ColorSpinorField &dst, const ColorSpinorField &src,
+      QudaFieldLocation location, void *Dst=0, void *Src=0,
+      void *dstNorm=0, void*srcNorm=0);
+
+  /**
+     @brief Whether the host reorder engine can copy src into dst:
+     Ncolor=3 fields in double or single precision, in FLOAT2, FLOAT4,
+     space-spin-color or space-color-spin order, with at most a change
+     between the UKQCD and the DeGrand-Rossi or chiral gamma bases
+     @param[in] dst Destination field
+     @param[in] src Source field
+  */
+  bool hostCopyColorSpinorSupported(const ColorSpinorField &dst, const ColorSpinorField &src);
+
+  /**
+     @brief Copy src into dst on the host threads, converting the
+     order, precision and gamma basis
+     @param[out] dst Destination field
+     @param[in] src Source field
+     @param[out] Dst Optional host buffer used in place of dst.V()
+     @param[in] Src Optional host buffer used in place of src.V()
+  */
+  void copyColorSpinorHost(ColorSpinorField &dst, const ColorSpinorField &src, void *Dst=0, const void *Src=0);
   void genericSource(cpuColorSpinorField &a, QudaSourceType sourceType, int x, int s, int c);
   int genericCompare(const cpuColorSpinorField &a, const cpuColorSpinorField &b, int tol);
   void genericPrintVector(cpuColorSpinorField &a, unsigned int x);
@@ -821,9 +945,11 @@ namespace quda {
      @param[in] parity Which parity are we packing
      @param[in] dagger Is for a dagger operator (presently ignored)
      @param[in[ location Array specifiying the memory location of each resulting ghost [2*dim+dir]
+     @param[in] compression Format of the packed ghost (block-float formats are host only)
   */
   void genericPackGhost(void **ghost, const ColorSpinorField &a, QudaParity parity,
-			int nFace, int dagger, MemoryLocation *destination=nullptr);
+			int nFace, int dagger, MemoryLocation *destination=nullptr,
+			QudaGhostCompression compression=QUDA_GHOST_COMPRESSION_NONE);
 
   /*Generate a gaussian distributed spinor
    * @param src The spinorfield
@@ -20,10 +20,13 @@
 #endif
 #include <register_traits.h>
 #include <typeinfo>
+#include <type_traits>
 #include <complex_quda.h>
 #include <index_helper.cuh>
 #include <color_spinor.h>
+#ifndef QUDA_HOST_ONLY
 #include <thrust_helper.cuh>
+#endif
 
 namespace quda {
 
@@ -257,12 +260,87 @@ namespace quda {
     };
 
 
-    template <typename Float, int nSpin, int nColor, int nVec, QudaFieldOrder order>
+    /**
+       @brief Block-float encoding used for compressed ghost zones:
+       each site stores one shared exponent, and each real number a
+       fixed-point mantissa relative to it, so the largest component
+       of every site keeps the full mantissa width.
+       @tparam ghostFloat Mantissa storage type (short or signed char)
+     */
+    template <typename ghostFloat> struct BlockFloat {
+      static constexpr int bits = 8*sizeof(ghostFloat) - 1; // mantissa bits excluding the sign
+      static constexpr int max_mantissa = (1 << bits) - 1;
+
+      /**
+	 @return The shared exponent for a site whose largest absolute
+	 component is max, or -128 if the site is zero.  Exponents are
+	 clamped to [-127,127], so sites beyond about 1e+-38 lose accuracy.
+       */
+      template <typename Float> __device__ __host__ static inline signed char exponent(Float max) {
+	if (max == static_cast<Float>(0.0)) return -128;
+	int e;
+	frexp(max, &e); // max = f * 2^e with 0.5 <= f < 1
+	return e < -127 ? -127 : e > 127 ? 127 : e;
+      }
+
+      template <typename Float> __device__ __host__ static inline ghostFloat encode(Float x, signed char e) {
+	Float q = round(ldexp(x, bits - e));
+	return static_cast<ghostFloat>(q > max_mantissa ? max_mantissa : q < -max_mantissa ? -max_mantissa : q);
+      }
+
+      template <typename Float> __device__ __host__ static inline Float decode(ghostFloat q, signed char e) {
+	return ldexp(static_cast<Float>(q), e - bits);
+      }
+    };
+
+    /**
+       @brief Helper that reads a ghost element: by reference when the
+       ghost is stored at field precision, else decoded from block float
+     */
+    template <typename Float, typename ghostFloat> struct GhostLoad {
+      typedef complex<Float> type;
+      __device__ __host__ static inline type get(const ghostFloat *ghost, const signed char *exponent, int idx, int site) {
+	const signed char e = exponent[site];
+	return complex<Float>(BlockFloat<ghostFloat>::template decode<Float>(ghost[2*idx+0], e),
+			      BlockFloat<ghostFloat>::template decode<Float>(ghost[2*idx+1], e));
+      }
+    };
+
+    template <typename Float> struct GhostLoad<Float,Float> {
+      typedef const complex<Float>& type;
+      __device__ __host__ static inline type get(const Float *ghost, const signed char *, int idx, int) {
+	return reinterpret_cast<const complex<Float>*>(ghost)[idx];
+      }
+    };
+
+    /**
+       @brief Bytes of the ghost zone of one dimension and direction
+       @tparam Float Field precision
+       @tparam ghostFloat Ghost storage type: Float for an uncompressed
+       ghost, else the block-float mantissa type
+       @param[in] sites Number of ghost sites (summed over parities)
+       @param[in] length Number of complex numbers per site
+     */
+    template <typename Float, typename ghostFloat>
+      inline size_t ghostBytes(size_t sites, int length) {
+      const bool compressed = !std::is_same<Float,ghostFloat>::value;
+      return sites * (2 * length * sizeof(ghostFloat) + (compressed ? sizeof(signed char) : 0));
+    }
+
+    /**
+       @tparam ghostFloat Storage type of the ghost zone.  If this
+       differs from Float the ghost is block-float encoded (see
+       BlockFloat), with the per-site exponents following the
+       mantissas in each ghost buffer.
+     */
+    template <typename Float, int nSpin, int nColor, int nVec, QudaFieldOrder order, typename ghostFloat=Float>
       class FieldOrderCB {
 
     protected:
       complex<Float> *v;
-      mutable complex<Float> *ghost[8];
+      mutable ghostFloat *ghost[8];
+      mutable signed char *ghost_exponent[8]; // per-site exponents of a compressed ghost
+      int ghostSites[4]; // number of ghost sites per parity
       mutable int x[QUDA_MAX_DIM];
       const int volumeCB;
       const int nDim;
@@ -286,11 +364,8 @@ namespace quda {
 	siteSubset(field.SiteSubset()), nParity(field.SiteSubset()),
 	location(field.Location()), accessor(field), ghostAccessor(field,nFace)
       { 
-	for (int d=0; d<4; d++) {
-	  void * const *_ghost = ghost_ ? ghost_ : field.Ghost();
-	  ghost[2*d+0] = static_cast<complex<Float>*>(_ghost[2*d+0]);
-	  ghost[2*d+1] = static_cast<complex<Float>*>(_ghost[2*d+1]);
-	}
+	for (int d=0; d<4; d++) ghostSites[d] = nFace*field.SurfaceCB(d);
+	resetGhost(ghost_ ? ghost_ : field.Ghost());
 
 	for (int d=0; d<QUDA_MAX_DIM; d++) x[d]=field.X(d);
       }
@@ -302,9 +377,13 @@ namespace quda {
 
       void resetGhost(void * const *ghost_) const
       {
+	const bool compressed = !std::is_same<Float,ghostFloat>::value;
 	for (int d=0; d<4; d++) {
-	  ghost[2*d+0] = static_cast<complex<Float>*>(ghost_[2*d+0]);
-	  ghost[2*d+1] = static_cast<complex<Float>*>(ghost_[2*d+1]);
+	  for (int dir=0; dir<2; dir++) {
+	    ghost[2*d+dir] = static_cast<ghostFloat*>(ghost_[2*d+dir]);
+	    ghost_exponent[2*d+dir] = (compressed && ghost[2*d+dir]) ?
+	      reinterpret_cast<signed char*>(ghost[2*d+dir] + 2*nParity*ghostSites[d]*nSpin*nColor*nVec) : nullptr;
+	  }
 	}
       }
 
@@ -341,8 +420,11 @@ namespace quda {
        * @param c color index
        * @param v vector number
        */
-      __device__ __host__ inline const complex<Float>& Ghost(int dim, int dir, int parity, int x_cb, int s, int c, int n=0) const
-      {	return ghost[2*dim+dir][ghostAccessor.index(dim,dir,parity,x_cb,s,c,n)]; }
+      __device__ __host__ inline typename GhostLoad<Float,ghostFloat>::type Ghost(int dim, int dir, int parity, int x_cb, int s, int c, int n=0) const
+      {
+	return GhostLoad<Float,ghostFloat>::get(ghost[2*dim+dir], ghost_exponent[2*dim+dir],
+						ghostAccessor.index(dim,dir,parity,x_cb,s,c,n), parity*ghostSites[dim] + x_cb);
+      }
 
       /**
        * Writable complex-member accessor function for the ghost zone.
@@ -354,7 +436,36 @@ namespace quda {
        * @param n vector number
        */
       __device__ __host__ inline complex<Float>& Ghost(int dim, int dir, int parity, int x_cb, int s, int c, int n=0)
-      { return ghost[2*dim+dir][ghostAccessor.index(dim,dir,parity,x_cb,s,c,n)]; }
+      {
+	static_assert(sizeof(Float) == sizeof(ghostFloat), "Compressed ghost zones are written with setGhost");
+	return reinterpret_cast<complex<Float>*>(ghost[2*dim+dir])[ghostAccessor.index(dim,dir,parity,x_cb,s,c,n)];
+      }
+
+      /**
+       * Set the shared exponent of a ghost site of a compressed ghost
+       * zone.  This must be called before the site's elements are
+       * written with setGhost.
+       * @param x_cb 1-d checkerboard ghost site index
+       * @param e Exponent from BlockFloat::exponent
+       */
+      __device__ __host__ inline void setGhostExponent(int dim, int dir, int parity, int x_cb, signed char e)
+      { ghost_exponent[2*dim+dir][parity*ghostSites[dim] + x_cb] = e; }
+
+      /**
+       * Write an element of a compressed ghost zone
+       * @param x_cb 1-d checkerboard ghost site index
+       * @param s spin index
+       * @param c color index
+       * @param a value to encode
+       * @param n vector number
+       */
+      __device__ __host__ inline void setGhost(int dim, int dir, int parity, int x_cb, int s, int c, const complex<Float> &a, int n=0)
+      {
+	const signed char e = ghost_exponent[2*dim+dir][parity*ghostSites[dim] + x_cb];
+	const int idx = ghostAccessor.index(dim,dir,parity,x_cb,s,c,n);
+	ghost[2*dim+dir][2*idx+0] = BlockFloat<ghostFloat>::template encode<Float>(a.real(), e);
+	ghost[2*dim+dir][2*idx+1] = BlockFloat<ghostFloat>::template encode<Float>(a.imag(), e);
+      }
 
       /**
 	 Convert from 1-dimensional index to the n-dimensional spatial index.
@@ -440,6 +551,7 @@ namespace quda {
       */
       __host__ double norm2(bool global=true) const {
 	double nrm2 = 0;
+#ifndef QUDA_HOST_ONLY
 	if (location == QUDA_CUDA_FIELD_LOCATION) {
 	  thrust_allocator alloc;
 	  thrust::device_ptr<complex<Float> > ptr(v);
@@ -449,6 +561,10 @@ namespace quda {
 	  nrm2 = thrust::transform_reduce(thrust::seq, v, v+nParity*volumeCB*nSpin*nColor*nVec,
 					  square<double,Float>(), 0.0, thrust::plus<double>());
 	}
+#else
+	square<double,Float> sq; // no thrust, and every field is a host field
+	for (size_t i=0; i<static_cast<size_t>(nParity)*volumeCB*nSpin*nColor*nVec; i++) nrm2 += sq(v[i]);
+#endif
 	if (global) comm_allreduce(&nrm2);
 	return nrm2;
       }
@@ -465,8 +581,12 @@ namespace quda {
        @tparam huge_alloc Template parameter that enables 64-bit
        pointer arithmetic for huge allocations (e.g., packed set of
        vectors).  Default is to use 32-bit pointer arithmetic.
+       @tparam polar Whether a fixed-point field stores each complex
+       number in polar form (see polar_load), with the norm of each
+       site being its largest magnitude.  Ghost zones keep the
+       Cartesian form.
      */
-    template <typename Float, int Ns, int Nc, int N, bool huge_alloc=false>
+    template <typename Float, int Ns, int Nc, int N, bool huge_alloc=false, bool polar=false>
       struct FloatNOrder {
 	typedef typename mapper<Float>::type RegType;
 	typedef typename VectorType<Float,N>::type Vector;
@@ -474,6 +594,7 @@ namespace quda {
 	typedef typename AllocType<huge_alloc>::type AllocInt;
 	static const int length = 2 * Ns * Nc;
 	static const int M = length / N;
+	static_assert(!polar || (isFixed<Float>::value && N % 2 == 0), "Polar storage requires a fixed-point type and complex pairs");
 	Float *field;
 	float *norm;
 	const AllocInt offset; // offset can be 32-bit or 64-bit
@@ -518,6 +639,20 @@ namespace quda {
 	virtual ~FloatNOrder() { ; }
 
 	__device__ __host__ inline void load(RegType v[length], int x, int parity=0) const {
+	  if (polar) {
+	    Vector vecTmp[M];
+#pragma unroll
+	    for (int i=0; i<M; i++) vecTmp[i] = vector_load<Vector>(field + parity*offset, x + stride*i);
+	    RegType nrm = norm[x+parity*norm_offset];
+#pragma unroll
+	    for (int i=0; i<length/2; i++) {
+	      polar_load(v[2*i+0], v[2*i+1], reinterpret_cast<const Float*>(vecTmp) + 2*i);
+	      v[2*i+0] *= nrm;
+	      v[2*i+1] *= nrm;
+	    }
+	    return;
+	  }
+
 #pragma unroll
 	  for (int i=0; i<M; i++) {
 	    // first do vectorized copy from memory
@@ -533,7 +668,7 @@ namespace quda {
 	    }
 	  }
 
-	  if (sizeof(Float)==sizeof(short)) {
+	  if (isFixed<Float>::value) {
 #if defined(USE_TEXTURE_OBJECTS) && defined(__CUDA_ARCH__)
 	    // use textures unless we have a large alloc
 	    RegType nrm = !huge_alloc ? tex1Dfetch<float>(texNorm,x+parity*norm_offset) : norm[x+parity*norm_offset];
@@ -549,13 +684,31 @@ namespace quda {
 	  RegType scale = 0.0;
 	  RegType tmp[length];
 
-	  if (sizeof(Float)==sizeof(short)) {
+	  if (polar) {
+#pragma unroll
+	    for (int i=0; i<length/2; i++) {
+	      RegType mag = sqrt(v[2*i+0]*v[2*i+0] + v[2*i+1]*v[2*i+1]);
+	      scale = mag > scale ? mag : scale;
+	    }
+	    norm[x+parity*norm_offset] = scale;
+
+	    RegType scale_inv = scale > static_cast<RegType>(0.0) ? static_cast<RegType>(1.0) / scale : static_cast<RegType>(0.0);
+	    Vector vecTmp[M];
+#pragma unroll
+	    for (int i=0; i<length/2; i++)
+	      polar_save(reinterpret_cast<Float*>(vecTmp) + 2*i, v[2*i+0] * scale_inv, v[2*i+1] * scale_inv);
+#pragma unroll
+	    for (int i=0; i<M; i++) vector_store(field + parity*offset, x + stride*i, vecTmp[i]);
+	    return;
+	  }
+
+	  if (isFixed<Float>::value) {
 #pragma unroll
 	    for (int i=0; i<length; i++) scale = fabs(v[i]) > scale ? fabs(v[i]) : scale;
 	    norm[x+parity*norm_offset] = scale;
 	  }
 
-	  if (sizeof(Float)==sizeof(short)) {
+	  if (isFixed<Float>::value) {
 	    RegType scale_inv = static_cast<RegType>(1.0) / scale;
 #pragma unroll
 	    for (int i=0; i<length; i++) tmp[i] = v[i] * scale_inv;
@@ -582,9 +735,9 @@ namespace quda {
 	   @return Instance of a colorspinor_wrapper that curries in access to
 	   this field at the above coordinates.
 	*/
-	__device__ __host__ inline colorspinor_wrapper<RegType,FloatNOrder<Float,Ns,Nc,N> >
+	__device__ __host__ inline colorspinor_wrapper<RegType,FloatNOrder<Float,Ns,Nc,N,huge_alloc,polar> >
 	  operator()(int x_cb, int parity) {
-	  return colorspinor_wrapper<RegType,FloatNOrder<Float,Ns,Nc,N> >(*this, x_cb, parity);
+	  return colorspinor_wrapper<RegType,FloatNOrder<Float,Ns,Nc,N,huge_alloc,polar> >(*this, x_cb, parity);
 	}
 
 	/**
@@ -596,10 +749,10 @@ namespace quda {
 	   @return Instance of a colorspinor_wrapper that curries in access to
 	   this field at the above coordinates.
 	*/
-	__device__ __host__ inline const colorspinor_wrapper<RegType,FloatNOrder<Float,Ns,Nc,N> >
+	__device__ __host__ inline const colorspinor_wrapper<RegType,FloatNOrder<Float,Ns,Nc,N,huge_alloc,polar> >
 	  operator()(int x_cb, int parity) const {
-	  return colorspinor_wrapper<RegType,FloatNOrder<Float,Ns,Nc,N> >
-	    (const_cast<FloatNOrder<Float,Ns,Nc,N>&>(*this), x_cb, parity);
+	  return colorspinor_wrapper<RegType,FloatNOrder<Float,Ns,Nc,N,huge_alloc,polar> >
+	    (const_cast<FloatNOrder<Float,Ns,Nc,N,huge_alloc,polar>&>(*this), x_cb, parity);
 	}
 
 	// no parity argument since we only presently exchange single parity field
@@ -638,9 +791,9 @@ namespace quda {
 	   @return Instance of a colorspinor_ghost_wrapper that curries in access to
 	   this field at the above coordinates.
 	*/
-	__device__ __host__ inline colorspinor_ghost_wrapper<Float,FloatNOrder<Float,Ns,Nc,N> >
+	__device__ __host__ inline colorspinor_ghost_wrapper<Float,FloatNOrder<Float,Ns,Nc,N,huge_alloc,polar> >
 	  Ghost(int dim, int dir, int ghost_idx, int parity) {
-	  return colorspinor_ghost_wrapper<Float,FloatNOrder<Float,Ns,Nc,N> >(*this, dim, dir, ghost_idx, parity);
+	  return colorspinor_ghost_wrapper<Float,FloatNOrder<Float,Ns,Nc,N,huge_alloc,polar> >(*this, dim, dir, ghost_idx, parity);
 	}
 
 	/**
@@ -654,10 +807,10 @@ namespace quda {
 	   @return Instance of a colorspinor_ghost+wrapper that curries in access to
 	   this field at the above coordinates.
 	*/
-	__device__ __host__ inline const colorspinor_ghost_wrapper<Float,FloatNOrder<Float,Ns,Nc,N> >
+	__device__ __host__ inline const colorspinor_ghost_wrapper<Float,FloatNOrder<Float,Ns,Nc,N,huge_alloc,polar> >
 	  Ghost(int dim, int dir, int ghost_idx, int parity) const {
-	  return colorspinor_ghost_wrapper<Float,FloatNOrder<Float,Ns,Nc,N> >
-	    (const_cast<FloatNOrder<Float,Ns,Nc,N>&>(*this), dim, dir, ghost_idx, parity);
+	  return colorspinor_ghost_wrapper<Float,FloatNOrder<Float,Ns,Nc,N,huge_alloc,polar> >
+	    (const_cast<FloatNOrder<Float,Ns,Nc,N,huge_alloc,polar>&>(*this), dim, dir, ghost_idx, parity);
 	}
 
 	/**
@@ -680,7 +833,7 @@ namespace quda {
 	  checkCudaError();
 	}
 
-	size_t Bytes() const { return nParity * volumeCB * (Nc * Ns * 2 * sizeof(Float) + (typeid(Float) == typeid(short) ? sizeof(float) : 0)); }
+	size_t Bytes() const { return nParity * volumeCB * (Nc * Ns * 2 * sizeof(Float) + (isFixed<Float>::value ? sizeof(float) : 0)); }
       };
 
     /**
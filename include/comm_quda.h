@@ -7,6 +7,8 @@ extern "C" {
 
   typedef struct MsgHandle_s MsgHandle;
   typedef struct Topology_s Topology;
+  typedef struct CollectiveHandle_s CollectiveHandle;
+  typedef struct ShmHandle_s ShmHandle;
 
   /* defined in quda.h; redefining here to avoid circular references */ 
   typedef int (*QudaCommsMap)(const int *coords, void *fdata);
@@ -258,12 +260,110 @@ extern "C" {
   void comm_allreduce_int(int* data);
   void comm_allreduce_xor(uint64_t *data);
   void comm_broadcast(void *data, size_t nbytes);
+
+  /**
+     @brief Start a non-blocking sum all-reduce of a double array.
+     The reduction is done in place: data must not be read or
+     modified until comm_wait_collective has been called on the
+     returned handle.  Receive buffers are persistent and reused
+     between calls.
+     @param[in,out] data Array to be reduced
+     @param[in] size Length of the array
+     @return Handle to the outstanding collective
+   */
+  CollectiveHandle *comm_iallreduce_array(double* data, size_t size);
+
+  /**
+     @brief Start a non-blocking broadcast from rank 0.  data must
+     not be read or modified until comm_wait_collective has been
+     called on the returned handle.
+     @param[in,out] data Buffer to be broadcast (source on rank 0,
+     destination elsewhere)
+     @param[in] nbytes Size of the buffer in bytes
+     @return Handle to the outstanding collective
+   */
+  CollectiveHandle *comm_ibroadcast(void *data, size_t nbytes);
+
+  /**
+     @brief Complete an outstanding non-blocking collective.  On
+     return the result is in the buffer that was passed when the
+     collective was started, and the handle is returned to the pool
+     and must not be used again.
+     @param[in] ch Handle returned by comm_iallreduce_array or comm_ibroadcast
+   */
+  void comm_wait_collective(CollectiveHandle *ch);
+
   void comm_barrier(void);
   void comm_abort(int status);
 
   void reduceMaxDouble(double &);
   void reduceDouble(double &);
   void reduceDoubleArray(double *, const int len);
+
+  /**
+     @brief Non-blocking variant of reduceDoubleArray: start the
+     reduction, which is a no-op if global reductions are disabled
+     @return Handle to pass to reduceDoubleArrayWait (may be NULL)
+   */
+  CollectiveHandle *reduceDoubleArrayStart(double *, const int len);
+
+  /**
+     @brief Complete a reduction started with reduceDoubleArrayStart
+   */
+  void reduceDoubleArrayWait(CollectiveHandle *);
+
+  /* implemented in comm_shm.cpp */
+
+  /**
+     @brief Set up the shared-memory transport for messages between
+     ranks on the same host.  Collective; enabled with
+     QUDA_ENABLE_SHM=1, with rank 0's environment taking precedence.
+     @param hostname_recv_buf Array that holds all process hostnames
+   */
+  void comm_shm_init(const char *hostname_recv_buf);
+
+  /**
+     @brief Remove the shared-memory segments.  Collective.
+   */
+  void comm_shm_finalize(void);
+
+  /**
+     @brief Query if messages to and from a given rank go through
+     shared memory
+     @param rank Global rank of the peer
+     @return Whether the shared-memory transport is used for this peer
+   */
+  bool comm_shm_enabled(int rank);
+
+  /**
+     @brief Create a persistent shared-memory send handle.  Messages
+     on the same (rank, tag) pair complete in the order they are
+     started, and may be larger than the ring.
+     @param buffer Buffer (host or device) from which the message is sent
+     @param rank Global rank of the receiver
+     @param tag Message tag
+     @param blksize Size of block in bytes
+     @param nblocks Number of blocks
+     @param stride Stride between blocks in bytes
+   */
+  ShmHandle *comm_shm_declare_send(void *buffer, int rank, int tag, size_t blksize, int nblocks, size_t stride);
+
+  /**
+     @brief Create a persistent shared-memory receive handle
+     @param buffer Buffer (host or device) into which the message is received
+     @param rank Global rank of the sender
+     @param tag Message tag
+     @param blksize Size of block in bytes
+     @param nblocks Number of blocks
+     @param stride Stride between blocks in bytes
+   */
+  ShmHandle *comm_shm_declare_receive(void *buffer, int rank, int tag, size_t blksize, int nblocks, size_t stride);
+
+  void comm_shm_free(ShmHandle *h);
+  void comm_shm_start(ShmHandle *h);
+  void comm_shm_wait(ShmHandle *h);
+  int comm_shm_query(ShmHandle *h);
+
   int commDim(int);
   int commCoords(int);
   int commDimPartitioned(int dir);
@@ -105,6 +105,16 @@ namespace quda {
     bool newTmp(ColorSpinorField **, const ColorSpinorField &) const;
     void deleteTmp(ColorSpinorField **, const bool &reset) const;
 
+    /**
+       @brief Create a host copy of a device gauge field for the host
+       Dslash: QDP order without reconstruction, with its backward halo
+       of the same depth as the device field exchanged in partitioned
+       dimensions
+       @param[in] gauge Device gauge field
+       @param[in] precision Precision of the copy
+    */
+    static cpuGaugeField* createHostGauge(const cudaGaugeField &gauge, QudaPrecision precision);
+
     QudaTune tune;
 
     int commDim[QUDA_MAX_DIM]; // whether do comms or not
@@ -172,8 +182,21 @@ namespace quda {
   class DiracWilson : public Dirac {
 
   protected:
+    mutable cpuGaugeField *gauge_h; // host copy of the gauge field used by the host Dslash
+    mutable const cudaGaugeField *gauge_h_src; // device field gauge_h was copied from
+    mutable uint64_t gauge_h_version; // version of gauge_h_src when it was copied
     void initConstants();
 
+    /**
+       @brief Return the host copy of the gauge field used when the
+       operator is applied to CPU fields.  This is created from the
+       device field on first use, and recreated if the precision
+       changes or the device field is replaced or updated (see
+       LatticeField::Version).
+       @param[in] precision Precision of the color-spinor fields
+    */
+    const cpuGaugeField& HostGauge(QudaPrecision precision) const;
+
   public:
     DiracWilson(const DiracParam &param);
     DiracWilson(const DiracWilson &dirac);
@@ -234,9 +257,21 @@ namespace quda {
 
   protected:
     cudaCloverField &clover;
+    mutable cpuCloverField *clover_h; // host copy of the clover field used by the host Dslash
+    mutable uint64_t clover_h_version; // version of the clover field when clover_h was copied
     void checkParitySpinor(const ColorSpinorField &, const ColorSpinorField &) const;
     void initConstants();
 
+    /**
+       @brief Return the host copy of the clover field, and its inverse
+       if present, used when the operator is applied to CPU fields.
+       This is created from the device field on first use, and
+       recreated if the precision changes or the device field is
+       updated (see LatticeField::Version).
+       @param[in] precision Precision of the color-spinor fields
+    */
+    const cpuCloverField& HostClover(QudaPrecision precision) const;
+
   public:
     DiracClover(const DiracParam &param);
     DiracClover(const DiracClover &dirac);
@@ -689,6 +724,21 @@ namespace quda {
   protected:
     cudaGaugeField &fatGauge;
     cudaGaugeField &longGauge;
+    mutable cpuGaugeField *fat_h; // host copy of the fat links used by the host Dslash
+    mutable cpuGaugeField *long_h; // host copy of the long links used by the host Dslash
+    mutable uint64_t fat_h_version; // version of the fat links when fat_h was copied
+    mutable uint64_t long_h_version; // version of the long links when long_h was copied
+
+    /**
+       @brief Return the host copies of the fat and long links used
+       when the operator is applied to CPU fields.  These are created
+       from the device fields on first use, and recreated if the
+       precision changes or the device fields are updated (see
+       LatticeField::Version).
+       @param[in] precision Precision of the color-spinor fields
+    */
+    const cpuGaugeField& HostFatGauge(QudaPrecision precision) const;
+    const cpuGaugeField& HostLongGauge(QudaPrecision precision) const;
 
   public:
     DiracImprovedStaggered(const DiracParam &param);
@@ -58,6 +58,77 @@ namespace quda {
   void ApplyClover(ColorSpinorField &out, const ColorSpinorField &in,
 		   const CloverField &clover, bool inverse, int parity);
 
+  /**
+     @brief Whether a color-spinor field can be used with the host
+     Wilson and Wilson-clover Dslash: a 4-d CPU field with Nspin=4 and
+     Ncolor=3 in space-spin-color order, the DeGrand-Rossi basis and
+     double or single precision
+     @param[in] field Color-spinor field
+  */
+  bool hostDslashSupported(const ColorSpinorField &field);
+
+  /**
+     @brief Apply the Wilson Dslash to host fields: out = D in, or
+     out = x + k D in if x is given.  The gauge field must be a
+     QDP-ordered CPU field without reconstruction, at the precision of
+     the spinors, with its backward halo filled in partitioned
+     dimensions.
+     @param[out] out Result single-parity field
+     @param[in] gauge Gauge field
+     @param[in] in Input single-parity field
+     @param[in] parity Parity of the output field
+     @param[in] dagger Whether to apply the Hermitian conjugate
+     @param[in] x Optional field added to the result
+     @param[in] k Scale factor of the hopping term when x is given
+  */
+  void wilsonDslashHost(ColorSpinorField &out, const GaugeField &gauge, const ColorSpinorField &in,
+			int parity, int dagger, const ColorSpinorField *x, double k);
+
+  /**
+     @brief Apply the inverse-clover preconditioned Dslash to host
+     fields: out = A^{-1} D in, or out = x + k A^{-1} D in if x is
+     given.  The clover field must be a packed CPU field at the
+     precision of the spinors that holds the inverse.
+     @param[out] out Result single-parity field
+     @param[in] gauge Gauge field
+     @param[in] clover Clover field
+     @param[in] in Input single-parity field
+     @param[in] parity Parity of the output field
+     @param[in] dagger Whether to apply the Hermitian conjugate
+     @param[in] x Optional field added to the result
+     @param[in] k Scale factor of the hopping term when x is given
+  */
+  void cloverDslashHost(ColorSpinorField &out, const GaugeField &gauge, const CloverField &clover,
+			const ColorSpinorField &in, int parity, int dagger, const ColorSpinorField *x, double k);
+
+  /**
+     @brief Apply the asymmetric clover Dslash to host fields:
+     out = A x + k D in
+     @param[out] out Result single-parity field
+     @param[in] gauge Gauge field
+     @param[in] clover Clover field
+     @param[in] in Input single-parity field
+     @param[in] parity Parity of the output field
+     @param[in] dagger Whether to apply the Hermitian conjugate
+     @param[in] x Field to which the clover term is applied
+     @param[in] k Scale factor of the hopping term
+  */
+  void asymCloverDslashHost(ColorSpinorField &out, const GaugeField &gauge, const CloverField &clover,
+			    const ColorSpinorField &in, int parity, int dagger, const ColorSpinorField &x, double k);
+
+  /**
+     @brief Apply the clover matrix, or its inverse, to a host field.
+     Unlike ApplyClover, this acts on fields in the DeGrand-Rossi basis
+     with the packed clover field, and out may alias in.
+     @param[out] out Result single-parity field
+     @param[in] in Input single-parity field
+     @param[in] clover Clover field
+     @param[in] inverse Whether to apply the inverse
+     @param[in] parity Parity of the fields
+  */
+  void ApplyCloverHost(ColorSpinorField &out, const ColorSpinorField &in, const CloverField &clover,
+		       bool inverse, int parity);
+
   // domain wall Dslash  
   void domainWallDslashCuda(cudaColorSpinorField *out, const cudaGaugeField &gauge, const cudaColorSpinorField *in,
 			    const int parity, const int dagger, const cudaColorSpinorField *x,
@@ -74,6 +145,86 @@ namespace quda {
 		      const int parity, const int dagger, const cudaColorSpinorField *x, const double &m_f, const double &k,
 		      const int *commDim, const int DS_type, TimeProfile &profile);
 
+  /**
+     @brief Whether a color-spinor field can be used with the host
+     domain-wall Dslash: a 5-d CPU field with Nspin=4, Ncolor=3 and at
+     most QUDA_MAX_DWF_LS slices in space-spin-color order and the
+     DeGrand-Rossi basis, in double or single precision
+     @param[in] field Color-spinor field
+  */
+  bool hostDomainWallDslashSupported(const ColorSpinorField &field);
+
+  /**
+     @brief Apply the 5-d even-odd preconditioned domain-wall Dslash
+     (the 4-d Wilson hop plus the fifth-dimension hop) to host fields,
+     out = D in, or out = x + k D in if x is given.  The gauge field
+     must be a QDP-ordered CPU field without reconstruction, at the
+     precision of the spinors, with its backward halo filled in
+     partitioned dimensions.
+     @param[out] out Result single-parity field
+     @param[in] gauge Gauge field
+     @param[in] in Input single-parity field
+     @param[in] parity Parity of the output field
+     @param[in] dagger Whether to apply the Hermitian conjugate
+     @param[in] x Optional field added to the result
+     @param[in] m_f Fermion mass at the walls
+     @param[in] k Scale factor of the Dslash when x is given
+  */
+  void domainWallDslashHost(ColorSpinorField &out, const GaugeField &gauge, const ColorSpinorField &in,
+			    int parity, int dagger, const ColorSpinorField *x, double m_f, double k);
+
+  /**
+     @brief Apply a part of the 4-d even-odd preconditioned
+     domain-wall operator to host fields, with the same conventions as
+     the corresponding domainWallDslashCuda.  DS_type selects
+     0: Dslash4, or x + a Dslash4;
+     1: Dslash5, or Dslash5 + a x;
+     2: M5^{-1} with kappa5 = a, or b M5^{-1} + x;
+     3: M5^{-1} Dslash4, or b M5^{-1} Dslash4 + x, in a single pass.
+     @param[out] out Result single-parity field
+     @param[in] gauge Gauge field, used by DS_type 0 and 3
+     @param[in] in Input single-parity field
+     @param[in] parity Parity of the output field
+     @param[in] dagger Whether to apply the Hermitian conjugate
+     @param[in] x Optional field added to the result
+     @param[in] m_f Fermion mass at the walls
+     @param[in] a First scale factor
+     @param[in] b Second scale factor
+     @param[in] DS_type Operator to apply
+  */
+  void domainWall4DDslashHost(ColorSpinorField &out, const GaugeField &gauge, const ColorSpinorField &in,
+			      int parity, int dagger, const ColorSpinorField *x, double m_f,
+			      double a, double b, int DS_type);
+
+  /**
+     @brief Apply a part of the 4-d even-odd preconditioned Mobius
+     operator to host fields, with the same conventions as the
+     corresponding MDWFDslashCuda, where the xpay forms bake in a
+     factor of kappa_b for DS_type 0 and kappa_b^2 otherwise.  DS_type
+     selects
+     0: Dslash4;
+     1: Dslash4pre;
+     2: M5;
+     3: M5^{-1};
+     4: M5^{-1} Dslash4 in a single pass, with the xpay form of 3;
+     5: Dslash4pre M5^{-1} Dslash4 in a single pass, with the xpay form of 1.
+     @param[out] out Result single-parity field
+     @param[in] gauge Gauge field, used by DS_type 0, 4 and 5
+     @param[in] in Input single-parity field
+     @param[in] parity Parity of the output field
+     @param[in] dagger Whether to apply the Hermitian conjugate
+     @param[in] x Optional field added to the result
+     @param[in] m_f Fermion mass at the walls
+     @param[in] m5 Domain-wall height
+     @param[in] b5 Mobius b coefficient of each slice
+     @param[in] c5 Mobius c coefficient of each slice
+     @param[in] k Scale factor of the xpay form
+     @param[in] DS_type Operator to apply
+  */
+  void MDWFDslashHost(ColorSpinorField &out, const GaugeField &gauge, const ColorSpinorField &in,
+		      int parity, int dagger, const ColorSpinorField *x, double m_f, double m5,
+		      const double *b5, const double *c5, double k, int DS_type);
+
   // staggered Dslash    
   void staggeredDslashCuda(cudaColorSpinorField *out, const cudaGaugeField &gauge,
 			   const cudaColorSpinorField *in, const int parity, const int dagger,
@@ -86,6 +237,34 @@ namespace quda {
 				   const cudaColorSpinorField *x, const double &k,
 				   const int *commDim, TimeProfile &profile);
 
+  /**
+     @brief Whether a color-spinor field can be used with the host
+     improved staggered Dslash: a 5-d CPU field with Nspin=1 and
+     Ncolor=3 in space-spin-color order, whose fifth dimension holds
+     the sources, in double or single precision
+     @param[in] field Color-spinor field
+  */
+  bool hostStaggeredDslashSupported(const ColorSpinorField &field);
+
+  /**
+     @brief Apply the improved staggered Dslash to host fields:
+     out = D in, or out = k x - D in if x is given.  The fat and long
+     gauge fields must be QDP-ordered CPU fields without
+     reconstruction, at the precision of the spinors, with their
+     backward halo filled in partitioned dimensions, of depth at
+     least 1 for the fat links and 3 for the long links.
+     @param[out] out Result single-parity field
+     @param[in] fatGauge Fat-link field
+     @param[in] longGauge Long-link field
+     @param[in] in Input single-parity field
+     @param[in] parity Parity of the output field
+     @param[in] dagger Whether to apply the Hermitian conjugate
+     @param[in] x Optional field added to the result
+     @param[in] k Scale factor of x when x is given
+  */
+  void improvedStaggeredDslashHost(ColorSpinorField &out, const GaugeField &fatGauge, const GaugeField &longGauge,
+				   const ColorSpinorField &in, int parity, int dagger, const ColorSpinorField *x, double k);
+
   // twisted mass Dslash  
   void twistedMassDslashCuda(cudaColorSpinorField *out, const cudaGaugeField &gauge, const   cudaColorSpinorField *in, 
 			     const int parity, const int dagger, const cudaColorSpinorField *x, const QudaTwistDslashType type,
@@ -117,6 +117,7 @@ extern "C" {
     QUDA_BICGSTABL_INVERTER,
     QUDA_CGNE_INVERTER,
     QUDA_CGNR_INVERTER,
+    QUDA_CA_GCR_INVERTER,
     QUDA_INVALID_INVERTER = QUDA_INVALID_ENUM
   } QudaInverterType;
 
@@ -466,6 +467,20 @@ extern "C" {
     QUDA_EXTLIB_INVALID = QUDA_INVALID_ENUM
   } QudaExtLibType;
 
+  typedef enum QudaWFlowType_s {
+    QUDA_WFLOW_TYPE_WILSON,
+    QUDA_WFLOW_TYPE_SYMANZIK,
+    QUDA_WFLOW_TYPE_INVALID = QUDA_INVALID_ENUM
+  } QudaWFlowType;
+
+  // Format of the halo messages exchanged by the host coarse operator
+  typedef enum QudaGhostCompression_s {
+    QUDA_GHOST_COMPRESSION_NONE,           // field precision
+    QUDA_GHOST_COMPRESSION_BLOCK_FLOAT_16, // per-site shared exponent with 16-bit mantissas
+    QUDA_GHOST_COMPRESSION_BLOCK_FLOAT_8,  // per-site shared exponent with 8-bit mantissas
+    QUDA_GHOST_COMPRESSION_INVALID = QUDA_INVALID_ENUM
+  } QudaGhostCompression;
+
 #ifdef __cplusplus
 }
 #endif
@@ -115,6 +115,7 @@
 #define QUDA_BICGSTABL_INVERTER 16
 #define QUDA_CGNE_INVERTER 17 
 #define QUDA_CGNR_INVERTER 18
+#define QUDA_CA_GCR_INVERTER 19
 #define QUDA_INVALID_INVERTER QUDA_INVALID_ENUM
 
 #define QudaEigType integer(4)
@@ -417,4 +418,15 @@
 #define QUDA_MAGMA_EXTLIB 2
 #define QUDA_EXTLIB_INVALID QUDA_INVALID_ENUM
 
+#define QudaWFlowType integer(4)
+#define QUDA_WFLOW_TYPE_WILSON 0
+#define QUDA_WFLOW_TYPE_SYMANZIK 1
+#define QUDA_WFLOW_TYPE_INVALID QUDA_INVALID_ENUM
+
+#define QudaGhostCompression integer(4)
+#define QUDA_GHOST_COMPRESSION_NONE 0
+#define QUDA_GHOST_COMPRESSION_BLOCK_FLOAT_16 1
+#define QUDA_GHOST_COMPRESSION_BLOCK_FLOAT_8 2
+#define QUDA_GHOST_COMPRESSION_INVALID QUDA_INVALID_ENUM
+
 #endif 
@@ -4,6 +4,7 @@
 #include <quda_internal.h>
 #include <quda.h>
 #include <lattice_field.h>
+#include <vector>
 
 namespace quda {
 
@@ -386,6 +387,18 @@ namespace quda {
      */
     void copy(const GaugeField &src);
 
+    /**
+       @brief Copy a source field into each field of a precision
+       ladder, e.g., the precise, sloppy and preconditioner fields.
+       With host reordering and a QDP or MILC order host source, the
+       source and its ghost zone are read once for all of the fields
+       (see copyGaugeLadderHost); otherwise the first field is copied
+       from the source and the others from the first.
+       @param[out] ladder Fields we are copying into, the most precise first
+       @param[in] src Source from which we are copying
+    */
+    static void copyLadder(const std::vector<cudaGaugeField*> &ladder, const GaugeField &src);
+
     void loadCPUField(const cpuGaugeField &);
     void saveCPUField(cpuGaugeField &) const;
 
@@ -528,6 +541,23 @@ namespace quda {
   */
   void copyGenericGauge(GaugeField &out, const GaugeField &in, QudaFieldLocation location, 
 			void *Out=0, void *In=0, void **ghostOut=0, void **ghostIn=0, int type=0);
+
+  /**
+     This function is used for copying a host gauge field in QDP or
+     MILC order into the host buffers of several native fields in a
+     single pass over the input and its ghost zone.  Defined in
+     copy_gauge_ladder_host.cpp.
+     @param out The output fields to which we are copying
+     @param Out The output buffers, each of the size of its field
+     @param n The number of output fields
+     @param in The input field from which we are copying
+  */
+  void copyGaugeLadderHost(GaugeField **out, void **Out, int n, const GaugeField &in);
+
+  /**
+     @return Whether copyGaugeLadderHost supports copying from in to out
+  */
+  bool copyGaugeLadderHostSupported(const GaugeField &out, const GaugeField &in);
   /**
      This function is used for copying the gauge field into an
      extended gauge field.  Defined in copy_extended_gauge.cu.
@@ -22,7 +22,9 @@
 #include <fast_intdiv.h>
 #include <type_traits>
 #include <atomic.cuh>
+#ifndef QUDA_HOST_ONLY
 #include <thrust_helper.cuh>
+#endif
 
 namespace quda {
 
@@ -321,6 +323,7 @@ namespace quda {
 
       __host__ double device_norm2(int dim) const {
 	if (dim >= geometry) errorQuda("Request dimension %d exceeds dimensionality of the field %d", dim, geometry);
+#ifndef QUDA_HOST_ONLY
 	thrust_allocator alloc;
 	thrust::device_ptr<complex<Float> > ptr(u);
 	double even = thrust::transform_reduce(thrust::cuda::par(alloc),
@@ -332,6 +335,13 @@ namespace quda {
 					       ptr+1*offset_cb+(dim+1)*stride*nColor*nColor,
 					       square<double,Float>(), 0.0, thrust::plus<double>());
 	return even + odd;
+#else
+	square<double,Float> sq; // no thrust, and every field is a host field
+	double nrm2 = 0.0;
+	for (int parity=0; parity<2; parity++)
+	  for (int i=dim*stride*nColor*nColor; i<(dim+1)*stride*nColor*nColor; i++) nrm2 += sq(u[parity*offset_cb + i]);
+	return nrm2;
+#endif
       }
 
     };
@@ -945,7 +955,13 @@ namespace quda {
   // we default to huge allocations for gauge field (for now)
   constexpr bool default_huge_alloc = true;
 
-  template <typename Float, int length, int N, int reconLenParam, QudaStaggeredPhase stag_phase=QUDA_STAGGERED_PHASE_NO, bool huge_alloc=default_huge_alloc>
+  /**
+     @brief Accessor routine for gauge fields in native field order.
+     @tparam polar Whether a fixed-point field stores each complex
+     number of the links in polar form (see polar_load), which is
+     supported for the 18 and 12 reconstructions
+   */
+  template <typename Float, int length, int N, int reconLenParam, QudaStaggeredPhase stag_phase=QUDA_STAGGERED_PHASE_NO, bool huge_alloc=default_huge_alloc, bool polar=false>
     struct FloatNOrder {
       typedef typename mapper<Float>::type RegType;
       typedef typename VectorType<Float,N>::type Vector;
@@ -953,6 +969,8 @@ namespace quda {
       Reconstruct<reconLenParam,Float> reconstruct;
       static const int reconLen = (reconLenParam == 11) ? 10 : reconLenParam;
       static const int hasPhase = (reconLen == 9 || reconLen == 13) ? 1 : 0;
+      static_assert(!polar || (isFixed<Float>::value && N % 2 == 0 && (reconLen == 18 || reconLen == 12)),
+		    "Polar storage requires a fixed-point type and the 18 or 12 reconstruction");
       Float *gauge;
       const AllocInt offset;
 #ifdef USE_TEXTURE_OBJECTS
@@ -1028,7 +1046,7 @@ namespace quda {
         for (int i=0; i<M; i++){
 	  // first do vectorized copy from memory
 #if defined(USE_TEXTURE_OBJECTS) && defined(__CUDA_ARCH__)
-	  if (!huge_alloc) { // use textures unless we have a huge alloc
+	  if (!huge_alloc && !polar) { // use textures unless we have a huge alloc
 	    TexVector vecTmp = tex1Dfetch<TexVector>(tex, parity*tex_offset + dir*stride*M + stride*i + x);
 #pragma unroll
 	    for (int j=0; j<N; j++) copy(tmp[i*N+j], reinterpret_cast<RegType*>(&vecTmp)[j]);
@@ -1037,8 +1055,13 @@ namespace quda {
 	  {
 	    Vector vecTmp = vector_load<Vector>(gauge + parity*offset, dir*stride*M + stride*i + x);
 	    // second do copy converting into register type
+	    if (polar) {
 #pragma unroll
-	    for (int j=0; j<N; j++) copy(tmp[i*N+j], reinterpret_cast<Float*>(&vecTmp)[j]);
+	      for (int j=0; j<N; j+=2) polar_load(tmp[i*N+j], tmp[i*N+j+1], reinterpret_cast<Float*>(&vecTmp) + j);
+	    } else {
+#pragma unroll
+	      for (int j=0; j<N; j++) copy(tmp[i*N+j], reinterpret_cast<Float*>(&vecTmp)[j]);
+	    }
 	  }
 	}
 
@@ -1069,8 +1092,13 @@ namespace quda {
         for (int i=0; i<M; i++){
 	  Vector vecTmp;
 	  // first do copy converting into storage type
+	  if (polar) {
+#pragma unroll
+	    for (int j=0; j<N; j+=2) polar_save(reinterpret_cast<Float*>(&vecTmp) + j, tmp[i*N+j], tmp[i*N+j+1]);
+	  } else {
 #pragma unroll
-	  for (int j=0; j<N; j++) copy(reinterpret_cast<Float*>(&vecTmp)[j], tmp[i*N+j]);
+	    for (int j=0; j<N; j++) copy(reinterpret_cast<Float*>(&vecTmp)[j], tmp[i*N+j]);
+	  }
 	  // second do vectorized copy into memory
 	  vector_store(gauge + parity*offset, x + dir*stride*M + stride*i, vecTmp);
         }
@@ -1090,9 +1118,9 @@ namespace quda {
 	 @return Instance of a gauge_wrapper that curries in access to
 	 this field at the above coordinates.
        */
-      __device__ __host__ inline gauge_wrapper<Float,FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc> >
+      __device__ __host__ inline gauge_wrapper<Float,FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc,polar> >
 	   operator()(int dim, int x_cb, int parity) {
-	return gauge_wrapper<Float,FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc> >(*this, dim, x_cb, parity);
+	return gauge_wrapper<Float,FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc,polar> >(*this, dim, x_cb, parity);
       }
 
       /**
@@ -1105,10 +1133,10 @@ namespace quda {
 	 @return Instance of a gauge_wrapper that curries in access to
 	 this field at the above coordinates.
        */
-      __device__ __host__ inline const gauge_wrapper<Float,FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc> >
+      __device__ __host__ inline const gauge_wrapper<Float,FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc,polar> >
 	   operator()(int dim, int x_cb, int parity) const {
-	return gauge_wrapper<Float,FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc> >
-	(const_cast<FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc>&>(*this), dim, x_cb, parity);
+	return gauge_wrapper<Float,FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc,polar> >
+	(const_cast<FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc,polar>&>(*this), dim, x_cb, parity);
       }
 
       __device__ __host__ inline void loadGhost(RegType v[length], int x, int dir, int parity) const {
@@ -1169,9 +1197,9 @@ namespace quda {
 	 @return Instance of a gauge_wrapper that curries in access to
 	 this field at the above coordinates.
        */
-      __device__ __host__ inline gauge_ghost_wrapper<Float,FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc> >
+      __device__ __host__ inline gauge_ghost_wrapper<Float,FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc,polar> >
 	   Ghost(int dim, int ghost_idx, int parity) {
-	return gauge_ghost_wrapper<Float,FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc> >(*this, dim, ghost_idx, parity);
+	return gauge_ghost_wrapper<Float,FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc,polar> >(*this, dim, ghost_idx, parity);
       }
 
       /**
@@ -1184,10 +1212,10 @@ namespace quda {
 	 @return Instance of a gauge_wrapper that curries in access to
 	 this field at the above coordinates.
        */
-      __device__ __host__ inline const gauge_ghost_wrapper<Float,FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc> >
+      __device__ __host__ inline const gauge_ghost_wrapper<Float,FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc,polar> >
 	   Ghost(int dim, int ghost_idx, int parity) const {
-	return gauge_ghost_wrapper<Float,FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc> >
-	(const_cast<FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc>&>(*this), dim, ghost_idx, parity);
+	return gauge_ghost_wrapper<Float,FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc,polar> >
+	(const_cast<FloatNOrder<Float,length,N,reconLenParam,stag_phase,huge_alloc,polar>&>(*this), dim, ghost_idx, parity);
       }
 
       __device__ __host__ inline void loadGhostEx(RegType v[length], int buff_idx, int extended_idx, int dir,
@@ -1208,8 +1236,10 @@ namespace quda {
 	if(hasPhase) copy(phase, ghost[dim][((dir*2+parity)*geometry+g)*R[dim]*faceVolumeCB[dim]*(M*N + 1)
 					    + R[dim]*faceVolumeCB[dim]*M*N + buff_idx]);
 
-	// use the extended_idx to determine the boundary condition
-	reconstruct.Unpack(v, tmp, extended_idx, g, 2.*M_PI*phase, X, R);
+	// use the extended_idx to determine the boundary condition: this
+	// depends on the radius of the extended region (this->R) and not on
+	// the depth of the halo being exchanged (R)
+	reconstruct.Unpack(v, tmp, extended_idx, g, 2.*M_PI*phase, X, this->R);
       }
 
       __device__ __host__ inline void saveGhostEx(const RegType v[length], int buff_idx, int extended_idx,
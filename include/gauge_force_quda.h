@@ -16,6 +16,23 @@ namespace quda {
    */
   void gaugeForce(GaugeField& mom, const GaugeField& u, double coeff, int ***input_path,
 		  int *length, double *path_coeff, int num_paths, int max_length);
+
+  /**
+     @brief Compute the gauge-force contribution to the momentum on
+     the host.  The path table is first compiled so that link products
+     shared between paths are computed once per site, and the result
+     is then evaluated over sites in parallel.
+     @param[out] mom MILC-ordered compressed momentum field
+     @param[in] u QDP-ordered gauge field (extended when partitioned)
+     @param[in] coeff Step-size coefficient
+     @param[in] input_path Host-array holding all path contributions for the gauge action
+     @param[in] length Host array holding the length of all paths
+     @param[in] path_coeff Coefficient of each path
+     @param[in] num_paths Numer of paths
+     @param[in] max_length Maximum length of each path
+   */
+  void gaugeForceHost(GaugeField& mom, const GaugeField& u, double coeff, int ***input_path,
+		      int *length, double *path_coeff, int num_paths, int max_length);
 } // namespace quda
 
 
@@ -55,6 +55,34 @@ namespace quda {
 			const GaugeField& dataOr,
 			double rho, double epsilon);
 
+  /**
+     Advance the gauge field by one step of the gradient flow using
+     Luscher's low-storage third-order Runge-Kutta integrator.  The
+     field is updated in place and its halo refreshed after each
+     stage.  Runs on the host when the fields are host (QDP ordered)
+     fields.
+
+     @param U Extended gauge field to be flowed; the halo depth must be
+     at least one in partitioned dimensions (two for the Symanzik flow)
+     @param Z Work field for the flow generator (interior volume, no reconstruction)
+     @param epsilon Step size
+     @param type Action whose gradient drives the flow
+     @param obs Observables of the field at the start of the step:
+     average plaquette, clover energy density, topological charge and
+     the RMS local error estimate of the step
+     @param redundant_comms Whether to do redundant halo communication
+  */
+  void gradientFlowStep(GaugeField &U, GaugeField &Z, double epsilon, QudaWFlowType type,
+			double obs[4], bool redundant_comms=false);
+
+  /**
+     Measure the gradient flow observables without advancing the flow
+
+     @param U Extended gauge field
+     @param Z Work field for the flow generator (not modified)
+     @param obs Average plaquette, clover energy density and topological charge
+  */
+  void gradientFlowMeasure(GaugeField &U, GaugeField &Z, double obs[3]);
 
   /**
    * @brief Gauge fixing with overrelaxation with support for single and multi GPU.
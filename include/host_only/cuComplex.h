@@ -0,0 +1,53 @@
+#ifndef _QUDA_HOST_ONLY_CUCOMPLEX_H
+#define _QUDA_HOST_ONLY_CUCOMPLEX_H
+
+/**
+   @file cuComplex.h
+
+   Stand-in for the CUDA complex types, for builds with
+   QUDA_HOST_ONLY; see cuda_runtime.h.
+ */
+
+#include <cuda_runtime.h>
+
+typedef float2 cuFloatComplex;
+typedef double2 cuDoubleComplex;
+typedef cuFloatComplex cuComplex;
+
+inline float cuCrealf(cuFloatComplex x) { return x.x; }
+inline float cuCimagf(cuFloatComplex x) { return x.y; }
+inline double cuCreal(cuDoubleComplex x) { return x.x; }
+inline double cuCimag(cuDoubleComplex x) { return x.y; }
+
+inline cuFloatComplex make_cuFloatComplex(float r, float i) { return make_float2(r, i); }
+inline cuDoubleComplex make_cuDoubleComplex(double r, double i) { return make_double2(r, i); }
+inline cuComplex make_cuComplex(float r, float i) { return make_float2(r, i); }
+
+inline cuFloatComplex cuConjf(cuFloatComplex x) { return make_float2(x.x, -x.y); }
+inline cuDoubleComplex cuConj(cuDoubleComplex x) { return make_double2(x.x, -x.y); }
+
+inline cuFloatComplex cuCaddf(cuFloatComplex x, cuFloatComplex y) { return make_float2(x.x + y.x, x.y + y.y); }
+inline cuDoubleComplex cuCadd(cuDoubleComplex x, cuDoubleComplex y) { return make_double2(x.x + y.x, x.y + y.y); }
+inline cuFloatComplex cuCsubf(cuFloatComplex x, cuFloatComplex y) { return make_float2(x.x - y.x, x.y - y.y); }
+inline cuDoubleComplex cuCsub(cuDoubleComplex x, cuDoubleComplex y) { return make_double2(x.x - y.x, x.y - y.y); }
+
+inline cuFloatComplex cuCmulf(cuFloatComplex x, cuFloatComplex y)
+{ return make_float2(x.x * y.x - x.y * y.y, x.x * y.y + x.y * y.x); }
+inline cuDoubleComplex cuCmul(cuDoubleComplex x, cuDoubleComplex y)
+{ return make_double2(x.x * y.x - x.y * y.y, x.x * y.y + x.y * y.x); }
+
+inline cuFloatComplex cuCdivf(cuFloatComplex x, cuFloatComplex y)
+{
+  const float s = 1.0f / (y.x * y.x + y.y * y.y);
+  return make_float2((x.x * y.x + x.y * y.y) * s, (x.y * y.x - x.x * y.y) * s);
+}
+inline cuDoubleComplex cuCdiv(cuDoubleComplex x, cuDoubleComplex y)
+{
+  const double s = 1.0 / (y.x * y.x + y.y * y.y);
+  return make_double2((x.x * y.x + x.y * y.y) * s, (x.y * y.x - x.x * y.y) * s);
+}
+
+inline float cuCabsf(cuFloatComplex x) { return hypotf(x.x, x.y); }
+inline double cuCabs(cuDoubleComplex x) { return hypot(x.x, x.y); }
+
+#endif // _QUDA_HOST_ONLY_CUCOMPLEX_H
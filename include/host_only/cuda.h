@@ -0,0 +1,42 @@
+#ifndef _QUDA_HOST_ONLY_CUDA_H
+#define _QUDA_HOST_ONLY_CUDA_H
+
+/**
+   @file cuda.h
+
+   Stand-in for the parts of the CUDA driver API used by the host
+   code of QUDA, for builds with QUDA_HOST_ONLY; see cuda_runtime.h.
+ */
+
+#include <cuda_runtime.h>
+
+#define CUDA_VERSION 9000
+
+typedef enum cudaError_enum {
+  CUDA_SUCCESS = 0,
+  CUDA_ERROR_OUT_OF_MEMORY = 2,
+  CUDA_ERROR_NO_DEVICE = 100,
+  CUDA_ERROR_NOT_SUPPORTED = 801
+} CUresult;
+
+typedef unsigned long long CUdeviceptr;
+typedef int CUdevice;
+typedef cudaStream_t CUstream;
+
+typedef enum CUdevice_attribute_enum {
+  CU_DEVICE_ATTRIBUTE_CAN_USE_STREAM_MEM_OPS = 92
+} CUdevice_attribute;
+
+typedef enum CUstreamWaitValue_flags_enum {
+  CU_STREAM_WAIT_VALUE_GEQ = 0x0,
+  CU_STREAM_WAIT_VALUE_EQ = 0x1
+} CUstreamWaitValue_flags;
+
+CUresult cuMemAlloc(CUdeviceptr *dptr, size_t bytesize);
+CUresult cuMemFree(CUdeviceptr dptr);
+CUresult cuGetErrorString(CUresult error, const char **pStr);
+CUresult cuDeviceGet(CUdevice *device, int ordinal);
+CUresult cuDeviceGetAttribute(int *pi, CUdevice_attribute attrib, CUdevice dev);
+CUresult cuStreamWaitValue32(CUstream stream, CUdeviceptr addr, unsigned int value, unsigned int flags);
+
+#endif // _QUDA_HOST_ONLY_CUDA_H
@@ -0,0 +1,304 @@
+#ifndef _QUDA_HOST_ONLY_CUDA_RUNTIME_H
+#define _QUDA_HOST_ONLY_CUDA_RUNTIME_H
+
+/**
+   @file cuda_runtime.h
+
+   Stand-in for the parts of the CUDA runtime API used by the host
+   code of QUDA, for builds with QUDA_HOST_ONLY.  The execution-space
+   qualifiers expand to nothing, "device" memory is host memory,
+   streams are synchronous and events are host timestamps; see
+   lib/host_only_runtime.cpp.  Kernels cannot be launched, so every
+   device path must be compiled out or fail with an error.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+
+#define CUDART_VERSION 9000
+
+#define __host__
+#define __device__
+#define __global__
+#define __shared__
+#define __constant__
+#define __forceinline__ inline __attribute__((always_inline))
+#define __align__(n) __attribute__((aligned(n)))
+#define __launch_bounds__(...)
+
+// built-in vector types
+struct __align__(2) char2 { signed char x, y; };
+struct __align__(4) char4 { signed char x, y, z, w; };
+struct __align__(4) short2 { short x, y; };
+struct short3 { short x, y, z; };
+struct __align__(8) short4 { short x, y, z, w; };
+struct __align__(8) int2 { int x, y; };
+struct int3 { int x, y, z; };
+struct __align__(16) int4 { int x, y, z, w; };
+struct __align__(8) uint2 { unsigned int x, y; };
+struct uint3 { unsigned int x, y, z; };
+struct __align__(16) uint4 { unsigned int x, y, z, w; };
+struct __align__(8) float2 { float x, y; };
+struct float3 { float x, y, z; };
+struct __align__(16) float4 { float x, y, z, w; };
+struct __align__(16) double2 { double x, y; };
+struct double3 { double x, y, z; };
+struct __align__(16) double4 { double x, y, z, w; };
+
+struct dim3 {
+  unsigned int x, y, z;
+  dim3(unsigned int x=1, unsigned int y=1, unsigned int z=1) : x(x), y(y), z(z) { }
+  dim3(uint3 v) : x(v.x), y(v.y), z(v.z) { }
+};
+
+inline char2 make_char2(signed char x, signed char y) { char2 v = {x, y}; return v; }
+inline char4 make_char4(signed char x, signed char y, signed char z, signed char w) { char4 v = {x, y, z, w}; return v; }
+inline short2 make_short2(short x, short y) { short2 v = {x, y}; return v; }
+inline short3 make_short3(short x, short y, short z) { short3 v = {x, y, z}; return v; }
+inline short4 make_short4(short x, short y, short z, short w) { short4 v = {x, y, z, w}; return v; }
+inline int2 make_int2(int x, int y) { int2 v = {x, y}; return v; }
+inline int3 make_int3(int x, int y, int z) { int3 v = {x, y, z}; return v; }
+inline int4 make_int4(int x, int y, int z, int w) { int4 v = {x, y, z, w}; return v; }
+inline uint2 make_uint2(unsigned int x, unsigned int y) { uint2 v = {x, y}; return v; }
+inline uint3 make_uint3(unsigned int x, unsigned int y, unsigned int z) { uint3 v = {x, y, z}; return v; }
+inline float2 make_float2(float x, float y) { float2 v = {x, y}; return v; }
+inline float3 make_float3(float x, float y, float z) { float3 v = {x, y, z}; return v; }
+inline float4 make_float4(float x, float y, float z, float w) { float4 v = {x, y, z, w}; return v; }
+inline double2 make_double2(double x, double y) { double2 v = {x, y}; return v; }
+inline double3 make_double3(double x, double y, double z) { double3 v = {x, y, z}; return v; }
+inline double4 make_double4(double x, double y, double z, double w) { double4 v = {x, y, z, w}; return v; }
+
+// math functions that CUDA also provides for the host
+inline float rsqrt(float x) { return 1.0f / sqrtf(x); }
+inline double rsqrt(double x) { return 1.0 / sqrt(x); }
+
+// device built-ins, declared so that kernel templates parse; they are never instantiated
+extern const uint3 threadIdx;
+extern const uint3 blockIdx;
+extern const dim3 blockDim;
+extern const dim3 gridDim;
+static const int warpSize = 32;
+inline void __syncthreads() { }
+inline void __threadfence() { }
+
+enum cudaError {
+  cudaSuccess = 0,
+  cudaErrorMemoryAllocation = 2,
+  cudaErrorInvalidValue = 11,
+  cudaErrorNotReady = 34,
+  cudaErrorNoDevice = 38,
+  cudaErrorNotSupported = 71,
+};
+typedef enum cudaError cudaError_t;
+
+enum cudaMemcpyKind {
+  cudaMemcpyHostToHost = 0,
+  cudaMemcpyHostToDevice = 1,
+  cudaMemcpyDeviceToHost = 2,
+  cudaMemcpyDeviceToDevice = 3,
+  cudaMemcpyDefault = 4
+};
+
+enum cudaMemoryType {
+  cudaMemoryTypeUnregistered = 0,
+  cudaMemoryTypeHost = 1,
+  cudaMemoryTypeDevice = 2,
+  cudaMemoryTypeManaged = 3
+};
+
+struct cudaPointerAttributes {
+  enum cudaMemoryType memoryType;
+  enum cudaMemoryType type;
+  int device;
+  void *devicePointer;
+  void *hostPointer;
+  int isManaged;
+};
+
+#define cudaHostAllocDefault 0x00
+#define cudaHostAllocPortable 0x01
+#define cudaHostAllocMapped 0x02
+#define cudaHostRegisterDefault 0x00
+#define cudaHostRegisterPortable 0x01
+#define cudaHostRegisterMapped 0x02
+#define cudaEventDefault 0x00
+#define cudaEventBlockingSync 0x01
+#define cudaEventDisableTiming 0x02
+#define cudaEventInterprocess 0x04
+#define cudaStreamDefault 0x00
+#define cudaStreamNonBlocking 0x01
+#define cudaMemAttachGlobal 0x01
+#define cudaIpcMemLazyEnablePeerAccess 0x01
+
+struct CUstream_st;
+struct CUevent_st;
+typedef struct CUstream_st *cudaStream_t;
+typedef struct CUevent_st *cudaEvent_t;
+
+struct cudaIpcMemHandle_t { char reserved[64]; };
+struct cudaIpcEventHandle_t { char reserved[64]; };
+
+struct cudaDeviceProp {
+  char name[256];
+  size_t totalGlobalMem;
+  size_t sharedMemPerBlock;
+  int regsPerBlock;
+  int warpSize;
+  int maxThreadsPerBlock;
+  int maxThreadsDim[3];
+  int maxGridSize[3];
+  int clockRate;
+  int major;
+  int minor;
+  int multiProcessorCount;
+  int kernelExecTimeoutEnabled;
+  int integrated;
+  int canMapHostMemory;
+  int computeMode;
+  int concurrentKernels;
+  int ECCEnabled;
+  int pciBusID;
+  int pciDeviceID;
+  int tccDriver;
+  int asyncEngineCount;
+  int unifiedAddressing;
+  int memoryClockRate;
+  int memoryBusWidth;
+  int l2CacheSize;
+  int maxThreadsPerMultiProcessor;
+  size_t sharedMemPerMultiprocessor;
+  int regsPerMultiprocessor;
+  int managedMemory;
+  int pageableMemoryAccess;
+  size_t sharedMemPerBlockOptin;
+  int maxTexture1DLinear;
+};
+
+enum cudaFuncCache {
+  cudaFuncCachePreferNone = 0,
+  cudaFuncCachePreferShared = 1,
+  cudaFuncCachePreferL1 = 2,
+  cudaFuncCachePreferEqual = 3
+};
+
+enum cudaDeviceP2PAttr {
+  cudaDevP2PAttrPerformanceRank = 1,
+  cudaDevP2PAttrAccessSupported = 2,
+  cudaDevP2PAttrNativeAtomicSupported = 3
+};
+
+enum cudaFuncAttribute {
+  cudaFuncAttributeMaxDynamicSharedMemorySize = 8,
+  cudaFuncAttributePreferredSharedMemoryCarveout = 9
+};
+#define cudaSharedmemCarveoutMaxShared 100
+
+// texture objects
+typedef unsigned long long cudaTextureObject_t;
+enum cudaChannelFormatKind {
+  cudaChannelFormatKindSigned = 0,
+  cudaChannelFormatKindUnsigned = 1,
+  cudaChannelFormatKindFloat = 2
+};
+struct cudaChannelFormatDesc { int x, y, z, w; enum cudaChannelFormatKind f; };
+enum cudaResourceType { cudaResourceTypeArray = 0, cudaResourceTypeMipmappedArray = 1, cudaResourceTypeLinear = 2 };
+struct cudaResourceDesc {
+  enum cudaResourceType resType;
+  union {
+    struct { void *devPtr; struct cudaChannelFormatDesc desc; size_t sizeInBytes; } linear;
+  } res;
+};
+enum cudaTextureReadMode { cudaReadModeElementType = 0, cudaReadModeNormalizedFloat = 1 };
+struct cudaTextureDesc { enum cudaTextureReadMode readMode; int normalizedCoords; };
+
+// device management
+cudaError_t cudaGetDeviceCount(int *count);
+cudaError_t cudaGetDevice(int *device);
+cudaError_t cudaSetDevice(int device);
+cudaError_t cudaGetDeviceProperties(cudaDeviceProp *prop, int device);
+cudaError_t cudaDeviceSynchronize();
+cudaError_t cudaDeviceReset();
+cudaError_t cudaDeviceSetCacheConfig(cudaFuncCache cacheConfig);
+cudaError_t cudaDeviceCanAccessPeer(int *canAccessPeer, int device, int peerDevice);
+cudaError_t cudaDeviceGetP2PAttribute(int *value, cudaDeviceP2PAttr attr, int srcDevice, int dstDevice);
+template <typename T> inline cudaError_t cudaFuncSetAttribute(T *, cudaFuncAttribute, int) { return cudaSuccess; }
+
+// errors
+cudaError_t cudaGetLastError();
+cudaError_t cudaPeekAtLastError();
+const char* cudaGetErrorString(cudaError_t error);
+
+// memory
+cudaError_t cudaMalloc(void **devPtr, size_t size);
+cudaError_t cudaMallocManaged(void **devPtr, size_t size, unsigned int flags=cudaMemAttachGlobal);
+cudaError_t cudaFree(void *devPtr);
+cudaError_t cudaHostAlloc(void **pHost, size_t size, unsigned int flags);
+cudaError_t cudaMallocHost(void **ptr, size_t size);
+cudaError_t cudaFreeHost(void *ptr);
+cudaError_t cudaHostRegister(void *ptr, size_t size, unsigned int flags);
+cudaError_t cudaHostUnregister(void *ptr);
+cudaError_t cudaHostGetDevicePointer(void **pDevice, void *pHost, unsigned int flags);
+cudaError_t cudaPointerGetAttributes(cudaPointerAttributes *attributes, const void *ptr);
+cudaError_t cudaMemcpy(void *dst, const void *src, size_t count, cudaMemcpyKind kind);
+cudaError_t cudaMemcpyAsync(void *dst, const void *src, size_t count, cudaMemcpyKind kind, cudaStream_t stream=0);
+cudaError_t cudaMemcpy2D(void *dst, size_t dpitch, const void *src, size_t spitch, size_t width, size_t height,
+			 cudaMemcpyKind kind);
+cudaError_t cudaMemcpy2DAsync(void *dst, size_t dpitch, const void *src, size_t spitch, size_t width, size_t height,
+			      cudaMemcpyKind kind, cudaStream_t stream=0);
+cudaError_t cudaMemset(void *devPtr, int value, size_t count);
+cudaError_t cudaMemsetAsync(void *devPtr, int value, size_t count, cudaStream_t stream=0);
+cudaError_t cudaMemset2D(void *devPtr, size_t pitch, int value, size_t width, size_t height);
+cudaError_t cudaMemset2DAsync(void *devPtr, size_t pitch, int value, size_t width, size_t height, cudaStream_t stream=0);
+
+// typed overloads, as provided by the runtime C++ API
+template <typename T> inline cudaError_t cudaMalloc(T **devPtr, size_t size)
+{ return cudaMalloc(reinterpret_cast<void**>(devPtr), size); }
+template <typename T> inline cudaError_t cudaHostAlloc(T **pHost, size_t size, unsigned int flags)
+{ return cudaHostAlloc(reinterpret_cast<void**>(pHost), size, flags); }
+template <typename T> inline cudaError_t cudaHostGetDevicePointer(T **pDevice, void *pHost, unsigned int flags)
+{ return cudaHostGetDevicePointer(reinterpret_cast<void**>(pDevice), pHost, flags); }
+
+template <typename T>
+inline cudaError_t cudaMemcpyToSymbol(const T &symbol, const void *src, size_t count, size_t offset=0,
+				      cudaMemcpyKind kind=cudaMemcpyHostToDevice)
+{ return cudaMemcpy(reinterpret_cast<char*>(const_cast<T*>(&symbol)) + offset, src, count, kind); }
+
+template <typename T>
+inline cudaError_t cudaMemcpyToSymbolAsync(const T &symbol, const void *src, size_t count, size_t offset=0,
+					   cudaMemcpyKind kind=cudaMemcpyHostToDevice, cudaStream_t stream=0)
+{ return cudaMemcpyAsync(reinterpret_cast<char*>(const_cast<T*>(&symbol)) + offset, src, count, kind, stream); }
+
+// streams and events
+cudaError_t cudaStreamCreate(cudaStream_t *stream);
+cudaError_t cudaStreamCreateWithFlags(cudaStream_t *stream, unsigned int flags);
+cudaError_t cudaStreamCreateWithPriority(cudaStream_t *stream, unsigned int flags, int priority);
+cudaError_t cudaStreamDestroy(cudaStream_t stream);
+cudaError_t cudaStreamSynchronize(cudaStream_t stream);
+cudaError_t cudaStreamQuery(cudaStream_t stream);
+cudaError_t cudaStreamWaitEvent(cudaStream_t stream, cudaEvent_t event, unsigned int flags);
+cudaError_t cudaDeviceGetStreamPriorityRange(int *leastPriority, int *greatestPriority);
+cudaError_t cudaEventCreate(cudaEvent_t *event);
+cudaError_t cudaEventCreate(cudaEvent_t *event, unsigned int flags);
+cudaError_t cudaEventCreateWithFlags(cudaEvent_t *event, unsigned int flags);
+cudaError_t cudaEventDestroy(cudaEvent_t event);
+cudaError_t cudaEventRecord(cudaEvent_t event, cudaStream_t stream=0);
+cudaError_t cudaEventQuery(cudaEvent_t event);
+cudaError_t cudaEventSynchronize(cudaEvent_t event);
+cudaError_t cudaEventElapsedTime(float *ms, cudaEvent_t start, cudaEvent_t end);
+
+// inter-process communication is not available without a device
+cudaError_t cudaIpcGetMemHandle(cudaIpcMemHandle_t *handle, void *devPtr);
+cudaError_t cudaIpcOpenMemHandle(void **devPtr, cudaIpcMemHandle_t handle, unsigned int flags);
+cudaError_t cudaIpcCloseMemHandle(void *devPtr);
+cudaError_t cudaIpcGetEventHandle(cudaIpcEventHandle_t *handle, cudaEvent_t event);
+cudaError_t cudaIpcOpenEventHandle(cudaEvent_t *event, cudaIpcEventHandle_t handle);
+
+// texture objects cannot be created without a device
+cudaError_t cudaCreateTextureObject(cudaTextureObject_t *texObject, const cudaResourceDesc *resDesc,
+				    const cudaTextureDesc *texDesc, const void *resViewDesc);
+cudaError_t cudaDestroyTextureObject(cudaTextureObject_t texObject);
+template <typename T> inline cudaChannelFormatDesc cudaCreateChannelDesc()
+{ cudaChannelFormatDesc desc = { 8*static_cast<int>(sizeof(T)), 0, 0, 0, cudaChannelFormatKindFloat }; return desc; }
+
+#endif // _QUDA_HOST_ONLY_CUDA_RUNTIME_H
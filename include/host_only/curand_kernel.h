@@ -0,0 +1,36 @@
+#ifndef _QUDA_HOST_ONLY_CURAND_KERNEL_H
+#define _QUDA_HOST_ONLY_CURAND_KERNEL_H
+
+/**
+   @file curand_kernel.h
+
+   Stand-in for the CURAND generator states, for builds with
+   QUDA_HOST_ONLY; see cuda_runtime.h.  The generators only run in
+   kernels, so they are declared but not defined.
+ */
+
+#include <cuda_runtime.h>
+
+struct curandStateXORWOW {
+  unsigned int d, v[5];
+  int boxmuller_flag;
+  int boxmuller_flag_double;
+  float boxmuller_extra;
+  double boxmuller_extra_double;
+};
+
+struct curandStateMRG32k3a {
+  double s1[3];
+  double s2[3];
+  int boxmuller_flag;
+  int boxmuller_flag_double;
+  float boxmuller_extra;
+  double boxmuller_extra_double;
+};
+
+template <typename State> float curand_uniform(State *state);
+template <typename State> double curand_uniform_double(State *state);
+template <typename State> float curand_normal(State *state);
+template <typename State> double curand_normal_double(State *state);
+
+#endif // _QUDA_HOST_ONLY_CURAND_KERNEL_H
@@ -35,6 +35,11 @@ namespace quda {
      */
     void *deflation_op;
 
+    /**
+     * Recycled subspace kept between solves (GMRES-DR only)
+     */
+    void *recycle_space;
+
     /**
      * Whether to use the L2 relative residual, L2 absolute residual
      * or Fermilab heavy-quark residual, or combinations therein to
@@ -206,7 +211,7 @@ namespace quda {
     /**
        Default constructor
      */
-    SolverParam() : compute_null_vector(QUDA_COMPUTE_NULL_VECTOR_NO),
+    SolverParam() : recycle_space(nullptr), compute_null_vector(QUDA_COMPUTE_NULL_VECTOR_NO),
       compute_true_res(true), verbosity_precondition(QUDA_SILENT) { ; }
 
     /**
@@ -216,6 +221,7 @@ namespace quda {
      */
     SolverParam(const QudaInvertParam &param) : inv_type(param.inv_type),
       inv_type_precondition(param.inv_type_precondition), preconditioner(param.preconditioner), deflation_op(param.deflation_op),
+      recycle_space(nullptr),
       residual_type(param.residual_type), use_init_guess(param.use_init_guess),
       compute_null_vector(QUDA_COMPUTE_NULL_VECTOR_NO), delta(param.reliable_delta),
       use_sloppy_partial_accumulator(param.use_sloppy_partial_accumulator),
@@ -251,6 +257,7 @@ namespace quda {
 
     SolverParam(const SolverParam &param) : inv_type(param.inv_type),
       inv_type_precondition(param.inv_type_precondition), preconditioner(param.preconditioner), deflation_op(param.deflation_op),
+      recycle_space(param.recycle_space),
       residual_type(param.residual_type), use_init_guess(param.use_init_guess),
       delta(param.delta), use_sloppy_partial_accumulator(param.use_sloppy_partial_accumulator),
       solution_accumulator_pipeline(param.solution_accumulator_pipeline),
@@ -662,6 +669,54 @@ namespace quda {
     void operator()(ColorSpinorField &out, ColorSpinorField &in);
   };
 
+  /**
+     @brief Communication-avoiding (s-step) GCR / MR solver.  Each
+     cycle builds the Krylov basis {r, Ar, ..., A^{s-1}r} with s
+     matrix-vector products, computes the full Gram matrix of the
+     basis and residual with a single batched dot product (one
+     reduction), and then solves the s x s least-squares problem on
+     the host.  This reduces the number of global synchronizations
+     per cycle from s to one, which is most useful when used as a
+     multigrid smoother.  The basis size s is set by param.Nkrylov.
+   */
+  class CAGCR : public Solver {
+
+  private:
+    const DiracMatrix &mat;
+    const DiracMatrix &matSloppy;
+
+    /**
+       The size of the s-step basis
+     */
+    const int nKrylov;
+
+    ColorSpinorField *rp;    //! residual vector
+    ColorSpinorField *tmpp;  //! temporary for mat-vec
+    ColorSpinorField *yp;    //! sloppy solution accumulator
+    std::vector<ColorSpinorField*> q; //! q[i] = A^{i+1} r
+
+    Complex *gram;  //! Gram matrix of {q, r}
+    Complex *alpha; //! least-squares solution coefficients
+
+    bool init;
+    bool allocate_r;
+
+    /**
+       @brief Solve the normal equations G alpha = c for the s-step
+       update, where G is the Gram matrix of the basis and c its
+       overlap with the residual.
+       @param[in] s Size of the basis used this cycle
+       @return Reduction in the residual norm squared, Re(c^dagger alpha)
+     */
+    double solve(int s);
+
+  public:
+    CAGCR(DiracMatrix &mat, DiracMatrix &matSloppy, SolverParam &param, TimeProfile &profile);
+    virtual ~CAGCR();
+
+    void operator()(ColorSpinorField &out, ColorSpinorField &in);
+  };
+
   // Steepest descent solver used as a preconditioner
   class SD : public Solver {
     private:
@@ -856,6 +911,52 @@ namespace quda {
 //forward declaration
  class GMResDRArgs;
 
+  /**
+     Recycled subspace for GCRO-DR style GMRES-DR (Parks et al, SIAM
+     J. Sci. Comput. 28 (2006) 1651).  Holds U and C = A U with
+     orthonormal C, and is kept resident between solves with the same
+     operator so that later solves start from the harmonic Ritz space
+     of the earlier ones.
+   */
+  class RecycleSpace {
+
+  public:
+    std::vector<ColorSpinorField*> U; //! recycled vectors
+    std::vector<ColorSpinorField*> C; //! images A U, orthonormal
+
+    const int max_dim;        //! maximum number of recycled vectors
+    const double mem_limit;   //! maximum memory in GiB used by U and C (0 = no limit)
+
+    RecycleSpace(int max_dim, double mem_limit);
+    virtual ~RecycleSpace();
+
+    int size() const { return U.size(); }
+
+    /**
+       @brief Number of vectors that fit in the caps for fields like meta
+       @param[in] meta Field whose size is used for the memory estimate
+    */
+    int capacity(const ColorSpinorField &meta) const;
+
+    /**
+       @brief Append new vectors, taking ownership of them.  Cnew
+       must be orthonormal and orthogonal to C, with Cnew = A Unew.
+       If the caps are exceeded the space is compressed onto the
+       harmonic Ritz vectors with the smallest harmonic Ritz values.
+    */
+    void add(std::vector<ColorSpinorField*> &Unew, std::vector<ColorSpinorField*> &Cnew);
+
+    /**
+       @brief Compress the space onto n harmonic Ritz vectors
+    */
+    void compress(int n);
+
+    /**
+       @brief Free all recycled vectors
+    */
+    void clear();
+  };
+
  class GMResDR : public Solver {
 
   private:
@@ -881,6 +982,8 @@ namespace quda {
 
     GMResDRArgs *gmresdr_args;
 
+    RecycleSpace *recycle; //! recycled subspace from previous solves (may be nullptr)
+
     bool init;
 
   public:
@@ -902,6 +1005,12 @@ namespace quda {
 
     void UpdateSolution(ColorSpinorField *x, ColorSpinorField *r, bool do_gels);
 
+    /**
+       @brief Extend the recycled subspace with the harmonic Ritz
+       vectors of the current cycle (GCRO-DR)
+    */
+    void UpdateRecycleSpace();
+
   };
 
 } // namespace quda
@@ -70,6 +70,93 @@ namespace quda {
                     cudaColorSpinorField &r, cudaColorSpinorField &Apsi, int k0, int m);
   };
     
+  /**
+     @brief Thick-restart Lanczos eigensolver for Hermitian operators
+     with optional Chebyshev polynomial acceleration (Wu and Simon,
+     SIAM J. Matrix Anal. Appl. 22 (2000) 602).
+
+     When eigParam.NPoly > 0 the Lanczos iteration is applied to
+     T_n(y(A)), where y maps the unwanted part of the spectrum
+     [MatPoly_param[0], MatPoly_param[1]] onto [-1,1], so that the
+     lowest eigenvalues of A become the dominant eigenvalues of the
+     filtered operator.  Eigenvalues are always reported for A itself.
+
+     The Lanczos basis is kept fully orthogonal with block classical
+     Gram-Schmidt (multi-blas cDotProduct / caxpy), and the small
+     tridiagonal / arrowhead eigenproblem is solved on the host with
+     Eigen.  After convergence the first nEv components of the Krylov
+     space hold the eigenvectors, ready to be passed to
+     Deflation::increment.
+  */
+  class TRLanczos {
+
+  private:
+    const DiracMatrix &mat;
+    QudaEigParam &eigParam;
+    TimeProfile &profile;
+
+    const int nEv;          //! number of wanted eigenpairs
+    const int nKr;          //! size of the Krylov space
+    const double tol;       //! relative residual tolerance
+    const int max_restarts; //! maximum number of restarts
+    const int poly_deg;     //! degree of the Chebyshev filter (0 = none)
+    const double a_min;     //! lower end of the interval to suppress
+    const double a_max;     //! upper end of the interval to suppress
+
+    std::vector<ColorSpinorField*> work; //! scratch space for the restart rotation
+    ColorSpinorField *r;    //! Lanczos residual
+    ColorSpinorField *tmp1; //! Chebyshev recurrence temporary
+    ColorSpinorField *tmp2; //! Chebyshev recurrence temporary
+
+    std::vector<double> alpha; //! diagonal of the projected matrix
+    std::vector<double> beta;  //! off-diagonal of the projected matrix (arrow for i < num_keep)
+    int num_keep;              //! number of Ritz vectors retained at restart
+
+    /**
+       @brief Apply the (optionally filtered) operator
+       @param[out] out Result
+       @param[in] in Input vector
+    */
+    void chebyOp(ColorSpinorField &out, const ColorSpinorField &in);
+
+    /**
+       @brief Extend the Lanczos factorization by one step
+       @param[in,out] kSpace Krylov space
+       @param[in] j Index of the vector being extended
+    */
+    void lanczosStep(std::vector<ColorSpinorField*> &kSpace, int j);
+
+    /**
+       @brief Orthogonalize r against the first n vectors of the Krylov
+       space with one block classical Gram-Schmidt pass
+    */
+    void blockOrthogonalize(std::vector<ColorSpinorField*> &kSpace, int n);
+
+    /**
+       @brief Rotate the Krylov space by the Ritz vectors of the
+       projected problem and set up the arrowhead for the next cycle
+       @param[in,out] kSpace Krylov space
+       @param[in] Y Ritz vectors of the projected problem (nKr x nKr, column-major)
+       @param[in] theta Ritz values of the projected problem
+       @param[in] n Number of vectors to retain
+    */
+    void restart(std::vector<ColorSpinorField*> &kSpace, const double *Y, const double *theta, int n);
+
+  public:
+    TRLanczos(const DiracMatrix &mat, QudaEigParam &eigParam, TimeProfile &profile, int nEv);
+    virtual ~TRLanczos();
+
+    /**
+       @brief Compute the nEv lowest eigenpairs of the operator
+       @param[in,out] kSpace Krylov space of at least nKr+1
+       vectors. On entry kSpace[0] is the (non-zero) starting vector,
+       on exit the first nEv vectors are the eigenvectors
+       @param[out] evals Eigenvalues of the operator (length nEv)
+       @return Number of converged eigenpairs
+    */
+    int operator()(std::vector<ColorSpinorField*> &kSpace, double *evals);
+  };
+
 #if 0
   /**
      Not implemented yet!!!, Implicitely restarted Lanczos algoritm can rapidly approach the solution than normal Lanczos, Chebychev acceleration and implicite restart processes are needed. At this moment external program call can do this.
@@ -321,6 +321,12 @@ namespace quda {
     mutable char *backup_norm_h;
     mutable bool backed_up;
 
+    /** Version of the contents of this field, unique across fields (see updateVersion) */
+    uint64_t version;
+
+    /** The last version handed out */
+    static uint64_t version_counter;
+
   public:
 
     /**
@@ -341,6 +347,21 @@ namespace quda {
     */
     virtual ~LatticeField();
     
+    /**
+       @brief Return the version of the contents of this field.  Each
+       field starts with a version no other field has had, and gets a
+       new one whenever its contents are replaced, so that a copy of
+       the field can be checked for staleness by comparing versions.
+       @return The version
+    */
+    uint64_t Version() const { return version; }
+
+    /**
+       @brief Give this field a new version.  This should be called
+       by any routine that overwrites the contents of a field in place.
+    */
+    void updateVersion() { version = ++version_counter; }
+
     /**
        @brief Allocate the static ghost buffers
        @param[in] ghost_bytes Size of the ghost buffer to allocate
@@ -487,6 +508,11 @@ namespace quda {
     */
     size_t GBytes() const { return total_bytes / (1<<30); }
 
+    /**
+       @return The total storage allocated in bytes
+    */
+    size_t TotalBytes() const { return total_bytes; }
+
     /**
        Check that the metadata of *this and a are compatible
        @param a The LatticeField to which we are comparing
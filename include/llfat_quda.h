@@ -19,6 +19,21 @@ namespace quda {
 		     const cudaGaugeField& gauge,
 		     const double* coeff);
   
+  /**
+     @brief Compute the fat and long links for improved staggered
+     fermions on the host.  The staples are built from a single
+     extended copy of the input links, in parallel over sites.
+     @param fat[out] The computed fat link
+     @param lng[out] The computed long link (only computed if lng!=0)
+     @param u[in] The input gauge field, extended by 2 in partitioned
+     dimensions
+     @param coeff[in] Array of path coefficients
+  */
+  void fatLongKSLinkHost(cpuGaugeField* fat,
+			 cpuGaugeField* lng,
+			 const cpuGaugeField& u,
+			 const double* coeff);
+
 } // namespace quda
 
 #endif // _LLFAT_QUDA_H
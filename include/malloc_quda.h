@@ -86,6 +86,21 @@ namespace quda {
     */
     void flush_pinned();
 
+    /**
+       @brief Device memory held by active allocations, i.e., not
+       counting those cached by the pool allocator.
+       @return Size in bytes
+    */
+    size_t device_allocated();
+
+    /**
+       @brief Host memory held by pageable, pinned and mapped
+       allocations, including the pinned allocations cached by the
+       pool allocator.
+       @return Size in bytes
+    */
+    size_t host_allocated();
+
   } // namespace pool
 
 }
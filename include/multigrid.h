@@ -6,8 +6,9 @@
 #include <vector>
 #include <complex_quda.h>
 
-// at the moment double-precision multigrid is only enabled when debugging
-#ifdef HOST_DEBUG
+// at the moment double-precision multigrid is only enabled when
+// debugging, or by the build in host-only builds
+#if defined(HOST_DEBUG) && !defined(GPU_MULTIGRID_DOUBLE)
 #define GPU_MULTIGRID_DOUBLE
 #endif
 
@@ -166,6 +167,34 @@ namespace quda {
 
   };
 
+  /**
+     The parts of the multigrid setup and V-cycle that are timed
+     separately on each level
+   */
+  enum MGComponent {
+    MG_COMPONENT_NULL_VECTORS, /**< Null-space vector generation */
+    MG_COMPONENT_BLOCK_ORTHO,  /**< Transfer operator construction (block orthogonalization) */
+    MG_COMPONENT_COARSE_OP,    /**< Coarse-grid operator construction */
+    MG_COMPONENT_SMOOTHER,     /**< Pre- and post-smoothing (the solve itself on the coarsest level) */
+    MG_COMPONENT_RESTRICT,     /**< Restriction of the residual */
+    MG_COMPONENT_PROLONG,      /**< Prolongation of the coarse-grid correction */
+    MG_COMPONENT_COARSE_SOLVE, /**< Coarse-grid solve, including all coarser levels */
+    MG_COMPONENT_COUNT         /**< The number of components.  Must be last enum type. */
+  };
+
+  /**
+     @brief Return the name of a multigrid component, e.g., for reporting
+     @param component The component
+   */
+  const char *getMGComponentName(MGComponent component);
+
+  /**
+     @brief Whether the multigrid components are timed, as set by
+     QUDA_ENABLE_MG_PROFILE=1.  Timing synchronizes the device around
+     each component, so it is off by default.
+   */
+  bool profileMGComponents();
+
   /**
      Adaptive Multigrid solver
    */
@@ -235,6 +264,28 @@ namespace quda {
     /** Coarse temporary vector */
     ColorSpinorField *tmp_coarse;
 
+    /** Ghost compression statistics of the coarse-grid fields of this level and of the fields created from them */
+    std::shared_ptr<GhostCompressionStats> ghost_stats;
+
+    /** Timers of the setup and V-cycle components on this level (see MGComponent) */
+    Timer component_timer[MG_COMPONENT_COUNT];
+
+    /**
+       @brief Start the timer of a component if profileMGComponents()
+       is set.  The device is then synchronized first, so that the time
+       is not attributed to a component whose kernels are still
+       running.
+       @param component The component
+     */
+    void startComponent(MGComponent component);
+
+    /**
+       @brief Stop the timer of a component, after synchronizing the
+       device, if profileMGComponents() is set
+       @param component The component
+     */
+    void stopComponent(MGComponent component);
+
     /** The coarse operator used for computing inter-grid residuals */
     Dirac *diracCoarseResidual;
 
@@ -294,6 +345,48 @@ namespace quda {
      */
     void verify();
 
+    /**
+       @brief Reset the ghost compression statistics of this and all
+       coarser levels, e.g., at the start of a solve
+     */
+    void resetGhostCompressionStats();
+
+    /**
+       @brief Return the ghost compression statistics of the coarse
+       grids below this level
+       @param stats stats[i] holds the statistics of the halos
+       exchanged on grid level param.level+1+i, by the coarse V-cycle
+       vectors and by every field created from them, e.g., the work
+       fields of the coarse solver
+     */
+    void ghostCompressionStats(std::vector<GhostCompressionStats> &stats) const;
+
+    /**
+       @brief Print the ghost compression statistics of all coarse
+       grids where compression was used
+     */
+    void printGhostCompressionStats() const;
+
+    /**
+       @brief Reset the V-cycle component timers (smoother,
+       restriction, prolongation and coarse solve) of this and all
+       coarser levels, e.g., at the start of a solve.  The setup
+       timers are kept.
+     */
+    void resetComponentTimers();
+
+    /**
+       @brief Return the component timers of this and all coarser levels
+       @param timers timers[i][c] holds the timer of component c on
+       grid level param.level+i
+     */
+    void componentTimers(std::vector<std::vector<Timer> > &timers) const;
+
+    /**
+       @brief Print the time spent in each component on each level
+     */
+    void printComponentTimers() const;
+
     /**
        This applies the V-cycle to the residual vector returning the residual vector
        @param out The solution vector
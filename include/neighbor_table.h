@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+
+namespace quda {
+
+  namespace host {
+
+    /**
+       @brief Neighbor table of a 4-d even-odd lattice used by the host
+       stencil operators.  Each site has neighbors at nHop distances
+       (1, and nFace for the improved staggered operator) in each of
+       the 8 directions.  For output parity p, site x_cb, direction
+       d = 2*mu + (0 forwards, 1 backwards) and hop h, the entry
+       nbr[p][(x_cb*8 + d)*nHop + h] is the checkerboard index of the
+       neighbor if it is in the local volume, else -(1 + i) where i is
+       the checkerboard index of the neighbor in the depth-nFace halo,
+       as packed by the color-spinor ghost exchange with a trivial
+       fifth dimension.
+    */
+    struct NeighborTable {
+      int X[4];
+      int partitioned[4];
+      int nFace;
+      int nHop;
+      int hop[2];
+      int faceVolumeCB[4]; // checkerboard sites in a single layer of each face
+      std::vector<int> nbr[2];
+      std::vector<int> interior[2]; // sites with no halo neighbors
+      std::vector<int> boundary[2]; // sites with at least one halo neighbor
+
+      NeighborTable(const int *X, const int *partitioned, int nFace);
+
+      bool match(const int *X, const int *partitioned, int nFace) const;
+
+      /**
+	 @return The depth in the halo, counted from the face of the
+	 local volume, of the neighbor at halo index i in dimension mu
+      */
+      int layer(int mu, int i) const { return i / faceVolumeCB[mu]; }
+    };
+
+    /**
+       @brief Return the neighbor table of the local lattice X with the
+       current partitioning, building it on first use.  Tables are kept
+       for the lifetime of the process.
+       @param[in] X Local lattice dimensions
+       @param[in] nFace Halo depth: 1 for nearest neighbors only, or 3
+       to include the third-nearest neighbors
+    */
+    const NeighborTable &getNeighborTable(const int *X, int nFace);
+
+  } // namespace host
+
+} // namespace quda
@@ -309,6 +309,14 @@ extern "C" {
     /** initCG tuning parameter:  tolerance for cg refinement corrections in the deflation stage */
     double inc_tol;
 
+    /** GMRES-DR: maximum number of vectors in the recycled subspace
+        kept resident between solves with the same operator (GCRO-DR
+        style recycling), 0 disables recycling */
+    int max_recycle_dim;
+    /** GMRES-DR: maximum memory in GiB used by the recycled subspace,
+        0 means it is limited by max_recycle_dim only */
+    double recycle_mem_limit;
+
     /** Whether to make the solution vector(s) after the solve */
     int make_resident_solution;
 
@@ -356,6 +364,16 @@ extern "C" {
     int np;
     int f_size;
     double eigen_shift;
+
+    /** Size of the Krylov space used by the thick-restart Lanczos
+        solver (must exceed the number of wanted eigenpairs; if zero
+        the deflated solver uses twice the number of wanted eigenpairs) */
+    int nKr;
+
+    /** Maximum number of restarts for the thick-restart Lanczos
+        solver (if zero the deflated solver uses 100) */
+    int max_restarts;
+
 //more general stuff:
     /** Whether to load eigenvectors */
     QudaBoolean import_vectors;
@@ -446,6 +464,9 @@ extern "C" {
     /** Location where each level should be done */
     QudaFieldLocation location[QUDA_MAX_MG_LEVEL];
 
+    /** Halo message format for the coarse operator on each level (host levels only) */
+    QudaGhostCompression ghost_compression[QUDA_MAX_MG_LEVEL];
+
     /** Whether to compute the null vectors or reload them */
     QudaComputeNullVector compute_null_vector;
  
@@ -710,6 +731,23 @@ extern "C" {
    */
   void invertMultiSrcQuda(void **_hp_x, void **_hp_b, QudaInvertParam *param);
 
+  /**
+   * Perform the solve like @invertQuda for a batch of sources with
+   * the same operator, e.g., the spin-color components of a
+   * propagator.  The reordering and transfer of the next source and
+   * of the previous solution overlap with each solve.  The returned
+   * iteration count, time and flops are summed over the sources, and
+   * the true residuals are the largest over the sources.  Initial
+   * guesses and resident solutions are not supported.
+   *
+   * @param hp_x   Array of host solution spinor fields
+   * @param hp_b   Array of host source spinor fields
+   * @param n_src  Number of sources
+   * @param param  Contains all metadata regarding host and device
+   *               storage and solver parameters
+   */
+  void invertPropagatorQuda(void **hp_x, void **hp_b, int n_src, QudaInvertParam *param);
+
 
   /**
    * Solve for multiple shifts (e.g., masses).
@@ -816,13 +854,27 @@ extern "C" {
   void pack_ghost(void **cpuLink, void **cpuGhost, int nFace,
       QudaPrecision precision);
 
+  /**
+   * Compute the fat and long links, and optionally the unitarized
+   * fat links, from the thin links.  All the link arrays are host
+   * arrays.  The links are computed on the device, or on the host
+   * when QUDA_LINK_LOCATION=CPU or the device kernels are not built.
+   * @param fatlink  Output fat links, or NULL
+   * @param longlink Output long links, or NULL
+   * @param ulink    Output unitarized fat links, or NULL
+   * @param inlink   Input thin links
+   * @param path_coeff The six path coefficients
+   * @param param    Contains all metadata regarding the link fields
+   */
   void computeKSLinkQuda(void* fatlink, void* longlink, void* ulink, void* inlink,
                          double *path_coeff, QudaGaugeParam *param);
 
 
 
   /**
-   * Compute the gauge force and update the mometum field
+   * Compute the gauge force and update the mometum field.  The force
+   * is computed on the device, or on the host when
+   * QUDA_LINK_LOCATION=CPU or the device kernels are not built.
    *
    * @param mom The momentum field to be updated
    * @param sitelink The gauge field from which we compute the force
@@ -1055,6 +1107,21 @@ extern "C" {
    */
   void performOvrImpSTOUTnStep(unsigned int nSteps, double rho, double epsilon);
 
+  /**
+   * Integrates the gradient flow of gaugePrecise and stores the flowed
+   * field in gaugeSmeared.  The plaquette, the clover energy density
+   * E(t) and the topological charge Q(t) are measured in the same pass
+   * as each flow step.
+   * @param nSteps  Number of flow steps to apply.
+   * @param epsilon (Initial) step size.
+   * @param tol     Local error tolerance used to adapt the step size;
+   *                zero for a fixed step size.
+   * @param type    Action whose gradient drives the flow (Wilson or Symanzik).
+   * @param obs     If non-null, array of length 4*(nSteps+1) that
+   *                returns (t, plaquette, E, Q) at each flow time.
+   */
+  void performGFlownStep(unsigned int nSteps, double epsilon, double tol, QudaWFlowType type, double *obs);
+
   /**
    * Calculates the topological charge from gaugeSmeared, if it exist, or from gaugePrecise if no smeared fields are present.
    */
@@ -1113,6 +1180,12 @@ extern "C" {
    */
   void flushChronoQuda(int index);
 
+  /**
+   * @brief Free the recycled GMRES-DR subspace that is kept resident
+   * between invertQuda calls
+   */
+  void flushRecycleQuda(void);
+
 
   /**
   * Open/Close MAGMA library
@@ -246,6 +246,11 @@ extern "C" {
    */
   void flush_chrono_quda_(int *index);
 
+  /**
+   * @brief Free the recycled GMRES-DR subspace
+   */
+  void flush_recycle_quda_();
+
   /**
    * @brief Pinned a pre-existing memory allocation
    * @param[in] ptr Pointer to buffer to be pinned
@@ -36,20 +36,24 @@ namespace quda {
     double -> double
     float -> float
     short -> float
+    char -> float
     This allows us to wrap the encapsulate the register type into the storage template type
    */
   template<typename> struct mapper { };
   template<> struct mapper<double> { typedef double type; };
   template<> struct mapper<float> { typedef float type; };
   template<> struct mapper<short> { typedef float type; };
+  template<> struct mapper<char> { typedef float type; };
 
   template<> struct mapper<double2> { typedef double2 type; };
   template<> struct mapper<float2> { typedef float2 type; };
   template<> struct mapper<short2> { typedef float2 type; };
+  template<> struct mapper<char2> { typedef float2 type; };
 
   template<> struct mapper<double4> { typedef double4 type; };
   template<> struct mapper<float4> { typedef float4 type; };
   template<> struct mapper<short4> { typedef float4 type; };
+  template<> struct mapper<char4> { typedef float4 type; };
 
   template<typename,typename> struct bridge_mapper { };
   template<> struct bridge_mapper<double2,double2> { typedef double2 type; };
@@ -74,6 +78,9 @@ namespace quda {
   template<> struct vec_length<short4> { static const int value = 4; };
   template<> struct vec_length<short2> { static const int value = 2; };
   template<> struct vec_length<short> { static const int value = 1; };
+  template<> struct vec_length<char4> { static const int value = 4; };
+  template<> struct vec_length<char2> { static const int value = 2; };
+  template<> struct vec_length<char> { static const int value = 1; };
 
   template<typename, int N> struct vector { };
 
@@ -104,6 +111,9 @@ namespace quda {
   template<> struct scalar<short3> { typedef short type; };
   template<> struct scalar<short2> { typedef short type; };
   template<> struct scalar<short> { typedef short type; };
+  template<> struct scalar<char4> { typedef char type; };
+  template<> struct scalar<char2> { typedef char type; };
+  template<> struct scalar<char> { typedef char type; };
 
   /* Traits used to determine if a variable is half precision or not */
   template< typename T > struct isHalf{ static const bool value = false; };
@@ -111,6 +121,15 @@ namespace quda {
   template<> struct isHalf<short2>{ static const bool value = true; };
   template<> struct isHalf<short4>{ static const bool value = true; };
 
+  /* Traits used to determine if a storage type is fixed point (half or quarter precision) or not */
+  template< typename T > struct isFixed{ static const bool value = false; };
+  template<> struct isFixed<short>{ static const bool value = true; };
+  template<> struct isFixed<short2>{ static const bool value = true; };
+  template<> struct isFixed<short4>{ static const bool value = true; };
+  template<> struct isFixed<char>{ static const bool value = true; };
+  template<> struct isFixed<char2>{ static const bool value = true; };
+  template<> struct isFixed<char4>{ static const bool value = true; };
+
   template<typename T1, typename T2> __host__ __device__ inline void copy (T1 &a, const T2 &b) { a = b; }
 
   template<> __host__ __device__ inline void copy(double &a, const int2 &b) {
@@ -139,7 +158,7 @@ namespace quda {
 #ifdef __CUDA_ARCH__
     f += 12582912.0f; return reinterpret_cast<int&>(f);
 #else
-    return static_cast<int>(f);
+    return static_cast<int>(rintf(f)); // round to nearest, as on the device
 #endif
   }
 
@@ -148,7 +167,7 @@ namespace quda {
 #ifdef __CUDA_ARCH__
     d += 6755399441055744.0; return reinterpret_cast<int&>(d);
 #else
-    return static_cast<int>(d);
+    return static_cast<int>(rint(d)); // round to nearest, as on the device
 #endif
   }
 
@@ -171,6 +190,29 @@ namespace quda {
     a.x = f2i(b.x*MAX_SHORT); a.y = f2i(b.y*MAX_SHORT); a.z = f2i(b.z*MAX_SHORT); a.w = f2i(b.w*MAX_SHORT);
   }
 
+  // specializations for char-float conversion (quarter precision)
+#define MAX_CHAR_INV 7.874015748e-3
+  static inline __host__ __device__ float c2f(const char &a) { return static_cast<float>(static_cast<signed char>(a)) * MAX_CHAR_INV; }
+
+  template<> __host__ __device__ inline void copy(float &a, const char &b) { a = c2f(b); }
+  template<> __host__ __device__ inline void copy(char &a, const float &b) { a = f2i(b*MAX_CHAR); }
+
+  template<> __host__ __device__ inline void copy(float2 &a, const char2 &b) {
+    a.x = c2f(b.x); a.y = c2f(b.y);
+  }
+
+  template<> __host__ __device__ inline void copy(char2 &a, const float2 &b) {
+    a.x = f2i(b.x*MAX_CHAR); a.y = f2i(b.y*MAX_CHAR);
+  }
+
+  template<> __host__ __device__ inline void copy(float4 &a, const char4 &b) {
+    a.x = c2f(b.x); a.y = c2f(b.y); a.z = c2f(b.z); a.w = c2f(b.w);
+  }
+
+  template<> __host__ __device__ inline void copy(char4 &a, const float4 &b) {
+    a.x = f2i(b.x*MAX_CHAR); a.y = f2i(b.y*MAX_CHAR); a.z = f2i(b.z*MAX_CHAR); a.w = f2i(b.w*MAX_CHAR);
+  }
+
   
   /**
      Generic wrapper for Trig functions
@@ -254,6 +296,11 @@ namespace quda {
   template <> struct VectorType<short, 2>{typedef short2 type; };
   template <> struct VectorType<short, 4>{typedef short4 type; };
 
+  // quarter precision
+  template <> struct VectorType<char, 1>{typedef char type; };
+  template <> struct VectorType<char, 2>{typedef char2 type; };
+  template <> struct VectorType<char, 4>{typedef char4 type; };
+
   // This trait returns the matching texture type (needed for double precision)
   template <typename Float, int number> struct TexVectorType;
 
@@ -331,6 +378,66 @@ namespace quda {
 #endif
   }
 
+  /**
+     @brief Limits of the fixed-point storage types, with the signed
+     and unsigned types of the same width used for polar phases and
+     magnitudes.  The floating-point types have trivial limits so that
+     the (never taken) polar branches of the accessors compile for them.
+   */
+  template <typename Float> struct fixed_point {
+    typedef Float signed_type;
+    typedef Float unsigned_type;
+    static constexpr float max = 1.0f;
+    static constexpr float umax = 1.0f;
+  };
+  template <> struct fixed_point<short> {
+    typedef short signed_type;
+    typedef unsigned short unsigned_type;
+    static constexpr float max = 32767.0f;
+    static constexpr float umax = 65535.0f;
+  };
+  template <> struct fixed_point<char> {
+    typedef signed char signed_type;
+    typedef unsigned char unsigned_type;
+    static constexpr float max = 127.0f;
+    static constexpr float umax = 255.0f;
+  };
+
+  /**
+     @brief Decode a complex number stored in polar fixed-point form:
+     the magnitude in [0,1] as an unsigned fixed-point number in z[0],
+     and the phase in units of pi as a signed one in z[1]
+     @param[out] re Real part
+     @param[out] im Imaginary part
+     @param[in] z Encoded magnitude and phase
+   */
+  template <typename Float, typename RegType>
+  __device__ __host__ inline void polar_load(RegType &re, RegType &im, const Float z[2]) {
+    typedef typename fixed_point<Float>::unsigned_type U;
+    typedef typename fixed_point<Float>::signed_type S;
+    const RegType mag = static_cast<RegType>(reinterpret_cast<const U&>(z[0])) / fixed_point<Float>::umax;
+    const RegType phase = static_cast<RegType>(static_cast<S>(z[1])) / fixed_point<Float>::max;
+    RegType s, c;
+    Trig<false,RegType>::SinCos(static_cast<RegType>(M_PI) * phase, &s, &c);
+    re = mag * c;
+    im = mag * s;
+  }
+
+  /**
+     @brief Encode a complex number with magnitude at most one in polar fixed-point form
+     @param[out] z Encoded magnitude and phase
+     @param[in] re Real part
+     @param[in] im Imaginary part
+   */
+  template <typename Float, typename RegType>
+  __device__ __host__ inline void polar_save(Float z[2], const RegType &re, const RegType &im) {
+    typedef typename fixed_point<Float>::unsigned_type U;
+    const RegType mag = sqrt(re*re + im*im);
+    const RegType phase = Trig<false,RegType>::Atan2(im, re) / static_cast<RegType>(M_PI);
+    reinterpret_cast<U&>(z[0]) = static_cast<U>(f2i(mag * fixed_point<Float>::umax));
+    z[1] = static_cast<Float>(f2i(phase * fixed_point<Float>::max));
+  }
+
   template<bool large_alloc> struct AllocType { };
   template<> struct AllocType<true> { typedef size_t type; };
   template<> struct AllocType<false> { typedef int type; };
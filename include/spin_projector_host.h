@@ -0,0 +1,100 @@
+#pragma once
+
+namespace quda {
+
+  namespace host {
+
+    // spin projectors (1 -/+ gamma_mu) in the DeGrand-Rossi basis, the
+    // same as those used by the host reference Dslash
+    static const double projector[8][4][4][2] = {
+      {
+	{{1,0}, {0,0}, {0,0}, {0,-1}},
+	{{0,0}, {1,0}, {0,-1}, {0,0}},
+	{{0,0}, {0,1}, {1,0}, {0,0}},
+	{{0,1}, {0,0}, {0,0}, {1,0}}
+      },
+      {
+	{{1,0}, {0,0}, {0,0}, {0,1}},
+	{{0,0}, {1,0}, {0,1}, {0,0}},
+	{{0,0}, {0,-1}, {1,0}, {0,0}},
+	{{0,-1}, {0,0}, {0,0}, {1,0}}
+      },
+      {
+	{{1,0}, {0,0}, {0,0}, {1,0}},
+	{{0,0}, {1,0}, {-1,0}, {0,0}},
+	{{0,0}, {-1,0}, {1,0}, {0,0}},
+	{{1,0}, {0,0}, {0,0}, {1,0}}
+      },
+      {
+	{{1,0}, {0,0}, {0,0}, {-1,0}},
+	{{0,0}, {1,0}, {1,0}, {0,0}},
+	{{0,0}, {1,0}, {1,0}, {0,0}},
+	{{-1,0}, {0,0}, {0,0}, {1,0}}
+      },
+      {
+	{{1,0}, {0,0}, {0,-1}, {0,0}},
+	{{0,0}, {1,0}, {0,0}, {0,1}},
+	{{0,1}, {0,0}, {1,0}, {0,0}},
+	{{0,0}, {0,-1}, {0,0}, {1,0}}
+      },
+      {
+	{{1,0}, {0,0}, {0,1}, {0,0}},
+	{{0,0}, {1,0}, {0,0}, {0,-1}},
+	{{0,-1}, {0,0}, {1,0}, {0,0}},
+	{{0,0}, {0,1}, {0,0}, {1,0}}
+      },
+      {
+	{{1,0}, {0,0}, {-1,0}, {0,0}},
+	{{0,0}, {1,0}, {0,0}, {-1,0}},
+	{{-1,0}, {0,0}, {1,0}, {0,0}},
+	{{0,0}, {-1,0}, {0,0}, {1,0}}
+      },
+      {
+	{{1,0}, {0,0}, {1,0}, {0,0}},
+	{{0,0}, {1,0}, {0,0}, {1,0}},
+	{{1,0}, {0,0}, {1,0}, {0,0}},
+	{{0,0}, {1,0}, {0,0}, {1,0}}
+      }
+    };
+
+    /**
+       Each projector has rank two: the upper two components of the
+       projected spinor are h_r = psi_r + phase_r psi_{col_r}, and the
+       lower two are coeff_r h_{src_r}.
+     */
+    struct HalfProjector {
+      int col[2];
+      double phase[2][2];
+      int src[2];
+      double coeff[2][2];
+
+      HalfProjector(const double P[4][4][2]) {
+	for (int r=0; r<2; r++) {
+	  for (int t=0; t<4; t++) {
+	    if (t != r && (P[r][t][0] != 0.0 || P[r][t][1] != 0.0)) {
+	      col[r] = t;
+	      phase[r][0] = P[r][t][0];
+	      phase[r][1] = P[r][t][1];
+	    }
+	  }
+	  // row r+2 is a multiple of row 0 or row 1, which have unit diagonals
+	  for (int t=0; t<2; t++) {
+	    if (P[r+2][t][0] != 0.0 || P[r+2][t][1] != 0.0) {
+	      src[r] = t;
+	      coeff[r][0] = P[r+2][t][0];
+	      coeff[r][1] = P[r+2][t][1];
+	    }
+	  }
+	}
+      }
+    };
+
+    inline const HalfProjector &halfProjector(int i) {
+      static const HalfProjector proj[8] = { projector[0], projector[1], projector[2], projector[3],
+					     projector[4], projector[5], projector[6], projector[7] };
+      return proj[i];
+    }
+
+  } // namespace host
+
+} // namespace quda
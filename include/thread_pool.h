@@ -0,0 +1,32 @@
+#pragma once
+
+#include <functional>
+
+namespace quda {
+
+  namespace host {
+
+    /**
+       @return The number of threads used by host kernels.  This is
+       set with QUDA_HOST_THREADS, and defaults to the hardware
+       concurrency.
+     */
+    int nThreads();
+
+    /**
+       @brief Apply f to sub-ranges [begin, end) of [0, n) using the
+       persistent host thread pool.  The calling thread takes part in
+       the work and, if given, calls progress between its chunks, e.g.,
+       to advance communication that overlaps the computation.  Calls
+       made from inside f run serially on the calling thread.
+       @param[in] n Number of work items
+       @param[in] f Function applied to each chunk [begin, end)
+       @param[in] progress Optional function called by the calling
+       thread after each chunk it completes
+     */
+    void parallel_for(int n, const std::function<void(int,int)> &f,
+		      const std::function<void()> &progress = nullptr);
+
+  } // namespace host
+
+} // namespace quda
@@ -35,6 +35,24 @@ namespace quda {
 
   void unitarizeLinksCPU(cpuGaugeField& outfield, const cpuGaugeField &infield);
 
+  /**
+   * @brief Unitarize a host gauge field in MILC or QDP order, using
+   * the analytic method for batches of links and SVD for the links
+   * where the analytic method is flagged as unreliable.
+   *
+   * @param out The unitarized gauge field
+   * @param in The gauge field to unitarize
+   * @param unitarize_eps Below this the eigenvalues of V^dagger V are taken as degenerate
+   * @param max_error Tolerance on the unitarity of the result
+   * @param allow_svd Whether to use SVD for the flagged links
+   * @param svd_only Whether to use SVD for all links
+   * @param svd_rel_error Relative tolerance on the determinant of V^dagger V
+   * @param svd_abs_error Absolute tolerance on the determinant of V^dagger V
+   * @return Number of links that failed on this process
+   */
+  int unitarizeLinksHost(cpuGaugeField &out, const cpuGaugeField &in, double unitarize_eps, double max_error,
+			 bool allow_svd, bool svd_only, double svd_rel_error, double svd_abs_error);
+
   void unitarizeLinks(cudaGaugeField& outfield, const cudaGaugeField &infield, int *fails);
   void unitarizeLinks(cudaGaugeField& outfield, int *fails);
   
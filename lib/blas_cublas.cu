@@ -1,5 +1,10 @@
 #include <blas_cublas.h>
 #include <malloc_quda.h>
+#ifdef QUDA_HOST_ONLY
+#include <thread_pool.h>
+#include <complex>
+#include <vector>
+#endif
 
 #define FMULS_GETRF(m_, n_) ( ((m_) < (n_)) \
     ? (0.5 * (m_) * ((m_) * ((n_) - (1./3.) * (m_) - 1. ) + (n_)) + (2. / 3.) * (m_)) \
@@ -21,6 +26,7 @@ namespace quda {
 
   namespace cublas { 
 
+#ifndef QUDA_HOST_ONLY
     // mini kernel to set the array of pointers needed for batched cublas
     template<typename T>
     __global__ void set_pointer(T **output_array_a, T *input_a, T **output_array_b, T *input_b, int batch_offset)
@@ -28,12 +34,91 @@ namespace quda {
       output_array_a[blockIdx.x] = input_a + blockIdx.x * batch_offset;
       output_array_b[blockIdx.x] = input_b + blockIdx.x * batch_offset;
     }
+#else
+    /**
+       Invert an n x n complex matrix by Gauss-Jordan elimination with
+       partial pivoting.
+       @param[out] Ainv The inverse matrix
+       @param[in] A The input matrix
+       @param[in] n Dimension of the matrix
+       @param[in] work Workspace of n*n elements
+       @return Whether the matrix was non-singular
+    */
+    template <typename Float>
+    bool invertMatrixHost(std::complex<Float> *Ainv, const std::complex<Float> *A, int n, std::complex<Float> *work)
+    {
+      for (int i=0; i<n*n; i++) work[i] = A[i];
+      for (int i=0; i<n; i++) for (int j=0; j<n; j++) Ainv[i*n+j] = (i == j) ? 1.0 : 0.0;
+
+      for (int k=0; k<n; k++) {
+	int p = k;
+	for (int i=k+1; i<n; i++) if (std::norm(work[i*n+k]) > std::norm(work[p*n+k])) p = i;
+	if (std::norm(work[p*n+k]) == 0.0) return false;
+	if (p != k) {
+	  for (int j=0; j<n; j++) {
+	    std::swap(work[k*n+j], work[p*n+j]);
+	    std::swap(Ainv[k*n+j], Ainv[p*n+j]);
+	  }
+	}
+
+	const std::complex<Float> pivot = static_cast<Float>(1.0) / work[k*n+k];
+	for (int j=0; j<n; j++) { work[k*n+j] *= pivot; Ainv[k*n+j] *= pivot; }
+
+	for (int i=0; i<n; i++) {
+	  if (i == k) continue;
+	  const std::complex<Float> f = work[i*n+k];
+	  if (f == static_cast<Float>(0.0)) continue;
+	  for (int j=0; j<n; j++) { work[i*n+j] -= f * work[k*n+j]; Ainv[i*n+j] -= f * Ainv[k*n+j]; }
+	}
+      }
+      return true;
+    }
+
+    template <typename Float>
+    void BatchInvertMatrixHost(void *Ainv, void *A, const int n, const int batch)
+    {
+      typedef std::complex<Float> C;
+      C *a = static_cast<C*>(A);
+      C *ainv = static_cast<C*>(Ainv);
+      std::vector<int> singular(batch, 0);
+
+      host::parallel_for(batch, [&](int begin, int end) {
+	  std::vector<C> work(n*n);
+	  for (int b=begin; b<end; b++) singular[b] = !invertMatrixHost(ainv + b*n*n, a + b*n*n, n, work.data());
+	});
+
+      for (int i=0; i<batch; i++)
+	if (singular[i]) errorQuda("%d factorization completed but the factor U is exactly singular", i);
+    }
+#endif
 
     // FIXME do this in pipelined fashion to reduce memory overhead.
     long long BatchInvertMatrix(void *Ainv, void* A, const int n, const int batch, QudaPrecision prec, QudaFieldLocation location)
     {
       long long flops = 0;
-#ifdef CUBLAS_LIB
+#ifdef QUDA_HOST_ONLY
+      // without a device both locations are host memory, so invert the batch in place on the host
+      timeval start, stop;
+      gettimeofday(&start, NULL);
+
+      if (prec == QUDA_DOUBLE_PRECISION) {
+	BatchInvertMatrixHost<double>(Ainv, A, n, batch);
+	flops += batch*(FLOPS_ZGETRF(n,n) + FLOPS_ZGETRI(n));
+      } else if (prec == QUDA_SINGLE_PRECISION) {
+	BatchInvertMatrixHost<float>(Ainv, A, n, batch);
+	flops += batch*(FLOPS_CGETRF(n,n) + FLOPS_CGETRI(n));
+      } else {
+	errorQuda("%s not implemented for precision=%d", __func__, prec);
+      }
+
+      gettimeofday(&stop, NULL);
+      long ds = stop.tv_sec - start.tv_sec;
+      long dus = stop.tv_usec - start.tv_usec;
+      double time = ds + 0.000001*dus;
+
+      printfQuda("Batched matrix inversion completed in %f seconds with GFLOPS = %f\n",
+		 time, 1e-9 * flops / time);
+#elif defined(CUBLAS_LIB)
       timeval start, stop;
       gettimeofday(&start, NULL);
 
@@ -121,7 +206,7 @@ namespace quda {
 
       printfQuda("Batched matrix inversion completed in %f seconds with GFLOPS = %f\n",
 		 time, 1e-9 * flops / time);
-#endif // CUBLAS_LIB
+#endif // QUDA_HOST_ONLY / CUBLAS_LIB
 
       return flops;
     }
@@ -156,6 +156,8 @@ void printQudaEigParam(QudaEigParam *param) {
   P(np, 0);
   P(f_size, 0);
   P(eigen_shift, 0.0);
+  P(nKr, 0);
+  P(max_restarts, 0);
   P(extlib_type, QUDA_EIGEN_EXTLIB);
   P(mem_type_ritz, QUDA_MEMORY_DEVICE);
 #else
@@ -165,6 +167,8 @@ void printQudaEigParam(QudaEigParam *param) {
   P(np, INVALID_INT);
   P(f_size, INVALID_INT);
   P(eigen_shift, INVALID_DOUBLE);
+  P(nKr, INVALID_INT);
+  P(max_restarts, INVALID_INT);
   P(extlib_type, QUDA_EXTLIB_INVALID);
   P(mem_type_ritz, QUDA_MEMORY_INVALID);
 #endif
@@ -449,6 +453,8 @@ void printQudaInvertParam(QudaInvertParam *param) {
   P(tol_restart,5e-5);
   P(inc_tol, 1e-2);
   P(eigenval_tol, 1e-1);
+  P(max_recycle_dim, 0);
+  P(recycle_mem_limit, 0.0);
 #else
   P(cuda_prec_ritz, QUDA_INVALID_PRECISION);
   P(nev, INVALID_INT);
@@ -460,6 +466,8 @@ void printQudaInvertParam(QudaInvertParam *param) {
   P(tol_restart,INVALID_DOUBLE);
   P(inc_tol, INVALID_DOUBLE);
   P(eigenval_tol, INVALID_DOUBLE);
+  P(max_recycle_dim, INVALID_INT);
+  P(recycle_mem_limit, INVALID_DOUBLE);
 #endif
 
 #if defined INIT_PARAM
@@ -565,6 +573,11 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
 
     P(omega[i], INVALID_DOUBLE);
     P(location[i], QUDA_INVALID_FIELD_LOCATION);
+#ifdef INIT_PARAM
+    P(ghost_compression[i], QUDA_GHOST_COMPRESSION_NONE);
+#else
+    P(ghost_compression[i], QUDA_GHOST_COMPRESSION_INVALID);
+#endif
   }
 
   P(compute_null_vector, QUDA_COMPUTE_NULL_VECTOR_INVALID);
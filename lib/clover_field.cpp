@@ -310,6 +310,7 @@ namespace quda {
       errorQuda("Invalid clover field type");
     }
 
+    updateVersion();
     checkCudaError();
   }
 
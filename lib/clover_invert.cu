@@ -182,6 +182,14 @@ namespace quda {
   // this is the function that is actually called, from here on down we instantiate all required templates
   void cloverInvert(CloverField &clover, bool computeTraceLog, QudaFieldLocation location) {
 
+    clover.updateVersion(); // the inverse is overwritten
+
+    // packed host fields are inverted by the batched host inverter
+    if (clover.Location() == QUDA_CPU_FIELD_LOCATION && clover.Order() == QUDA_PACKED_CLOVER_ORDER) {
+      cloverInvertHost(clover, computeTraceLog);
+      return;
+    }
+
 #ifdef GPU_CLOVER_DIRAC
     if (clover.Precision() == QUDA_HALF_PRECISION && clover.Order() > 4) 
       errorQuda("Half precision not supported for order %d", clover.Order());
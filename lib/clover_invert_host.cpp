@@ -0,0 +1,211 @@
+// Host inversion of clover fields in packed order, optionally with
+// the log determinant of each parity.
+
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+#include <quda_internal.h>
+#include <clover_field.h>
+#include <thread_pool.h>
+
+namespace quda {
+
+  static constexpr int N = 6;       // rows of a chiral block (2 spins x 3 colors)
+  static constexpr int block = N*N; // reals per chiral block
+
+  /**
+     @return The offset of element (i,j), with i > j, of the strictly
+     lower triangle in a packed chiral block: the diagonal comes first,
+     followed by the lower triangle in column-major order
+   */
+  static constexpr int offDiag(int i, int j) { return N + 2*(N*(N-1)/2 - (N-j)*(N-j-1)/2 + i - j - 1); }
+
+  /**
+     Invert the n <= W consecutive chiral blocks of in into out, which
+     may alias in.  @return The log determinant of the n blocks
+   */
+  template <typename Float, int W, bool twist, bool trlog>
+  static double invertBatch(Float *out, const Float *in, int n, Float mu2)
+  {
+    alignas(64) Float a_re[N][N][W], a_im[N][N][W];
+
+    // gather the lower triangle, padding the unused lanes with the identity
+    for (int l=0; l<W; l++) {
+      const Float *b = in + l*block;
+      for (int i=0; i<N; i++) {
+	a_re[i][i][l] = l < n ? b[i] : 1.0;
+	a_im[i][i][l] = 0.0;
+	for (int j=0; j<i; j++) {
+	  a_re[i][j][l] = l < n ? b[offDiag(i,j) + 0] : 0.0;
+	  a_im[i][j][l] = l < n ? b[offDiag(i,j) + 1] : 0.0;
+	}
+      }
+    }
+
+    if (twist) {
+      // A^2 + mu^2, using A_kj = conj(A_jk) for the upper triangle
+      alignas(64) Float s_re[N][N][W], s_im[N][N][W];
+      for (int i=0; i<N; i++) {
+	for (int j=0; j<=i; j++) {
+	  for (int l=0; l<W; l++) { s_re[i][j][l] = 0.0; s_im[i][j][l] = 0.0; }
+	  for (int k=0; k<N; k++) {
+	    const Float sik = k > i ? -1.0 : 1.0, skj = j > k ? -1.0 : 1.0;
+	    const Float *x_re = k > i ? a_re[k][i] : a_re[i][k], *x_im = k > i ? a_im[k][i] : a_im[i][k];
+	    const Float *y_re = j > k ? a_re[j][k] : a_re[k][j], *y_im = j > k ? a_im[j][k] : a_im[k][j];
+	    for (int l=0; l<W; l++) {
+	      s_re[i][j][l] += x_re[l] * y_re[l] - sik * skj * x_im[l] * y_im[l];
+	      s_im[i][j][l] += sik * x_im[l] * y_re[l] + skj * x_re[l] * y_im[l];
+	    }
+	  }
+	}
+	for (int l=0; l<W; l++) s_re[i][i][l] += mu2;
+      }
+      for (int i=0; i<N; i++) {
+	for (int j=0; j<=i; j++) {
+	  for (int l=0; l<W; l++) { a_re[i][j][l] = s_re[i][j][l]; a_im[i][j][l] = s_im[i][j][l]; }
+	}
+      }
+    }
+
+    // Cholesky decomposition A = L L^dagger in place, keeping 1/L_jj
+    alignas(64) Float inv[N][W];
+    double trlogA = 0.0;
+    for (int j=0; j<N; j++) {
+      Float *d = a_re[j][j];
+      for (int k=0; k<j; k++) {
+	for (int l=0; l<W; l++) d[l] -= a_re[j][k][l] * a_re[j][k][l] + a_im[j][k][l] * a_im[j][k][l];
+      }
+      for (int l=0; l<W; l++) {
+	d[l] = sqrt(d[l]);
+	inv[j][l] = static_cast<Float>(1.0) / d[l];
+      }
+      if (trlog) for (int l=0; l<n; l++) trlogA += 2.0*log(d[l]);
+
+      for (int i=j+1; i<N; i++) {
+	Float *re = a_re[i][j], *im = a_im[i][j];
+	for (int k=0; k<j; k++) {
+	  for (int l=0; l<W; l++) {
+	    re[l] -= a_re[i][k][l] * a_re[j][k][l] + a_im[i][k][l] * a_im[j][k][l];
+	    im[l] -= a_im[i][k][l] * a_re[j][k][l] - a_re[i][k][l] * a_im[j][k][l];
+	  }
+	}
+	for (int l=0; l<W; l++) { re[l] *= inv[j][l]; im[l] *= inv[j][l]; }
+      }
+    }
+
+    // M = L^{-1}, by forward substitution
+    alignas(64) Float m_re[N][N][W], m_im[N][N][W];
+    for (int j=0; j<N; j++) {
+      for (int l=0; l<W; l++) { m_re[j][j][l] = inv[j][l]; m_im[j][j][l] = 0.0; }
+      for (int i=j+1; i<N; i++) {
+	Float *re = m_re[i][j], *im = m_im[i][j];
+	for (int l=0; l<W; l++) { re[l] = 0.0; im[l] = 0.0; }
+	for (int k=j; k<i; k++) {
+	  for (int l=0; l<W; l++) {
+	    re[l] -= a_re[i][k][l] * m_re[k][j][l] - a_im[i][k][l] * m_im[k][j][l];
+	    im[l] -= a_re[i][k][l] * m_im[k][j][l] + a_im[i][k][l] * m_re[k][j][l];
+	  }
+	}
+	for (int l=0; l<W; l++) { re[l] *= inv[i][l]; im[l] *= inv[i][l]; }
+      }
+    }
+
+    // A^{-1} = M^dagger M, of which we need the lower triangle
+    for (int i=0; i<N; i++) {
+      for (int j=0; j<=i; j++) {
+	Float *re = a_re[i][j], *im = a_im[i][j];
+	for (int l=0; l<W; l++) { re[l] = 0.0; im[l] = 0.0; }
+	for (int k=i; k<N; k++) {
+	  for (int l=0; l<W; l++) {
+	    re[l] += m_re[k][i][l] * m_re[k][j][l] + m_im[k][i][l] * m_im[k][j][l];
+	    im[l] += m_re[k][i][l] * m_im[k][j][l] - m_im[k][i][l] * m_re[k][j][l];
+	  }
+	}
+      }
+    }
+
+    for (int l=0; l<n; l++) {
+      Float *b = out + l*block;
+      for (int i=0; i<N; i++) {
+	b[i] = a_re[i][i][l];
+	for (int j=0; j<i; j++) {
+	  b[offDiag(i,j) + 0] = a_re[i][j][l];
+	  b[offDiag(i,j) + 1] = a_im[i][j][l];
+	}
+      }
+    }
+
+    return trlogA;
+  }
+
+  template <typename Float, bool twist, bool trlog>
+  static void cloverInvertHost(Float *inverse[2], const Float *clover[2], int volumeCB, Float mu2, double *trlogA)
+  {
+    constexpr int W = 64 / sizeof(Float); // blocks per batch
+    const int nBlock = 2*volumeCB; // chiral blocks per parity, contiguous in packed order
+    const int nBatch = (nBlock + W - 1) / W;
+
+    std::vector<double> partial(trlog ? 2*nBatch : 0);
+    host::parallel_for(2*nBatch, [&](int begin, int end) {
+	for (int t=begin; t<end; t++) {
+	  const int parity = t / nBatch;
+	  const int first = (t % nBatch) * W;
+	  const double r = invertBatch<Float,W,twist,trlog>(inverse[parity] + first*block, clover[parity] + first*block,
+							    std::min(W, nBlock - first), mu2);
+	  if (trlog) partial[t] = r;
+	}
+      });
+
+    if (trlog) {
+      for (int parity=0; parity<2; parity++) {
+	trlogA[parity] = 0.0;
+	for (int i=0; i<nBatch; i++) trlogA[parity] += partial[parity*nBatch + i];
+      }
+    }
+  }
+
+  template <typename Float>
+  static void cloverInvertHost(CloverField &clover, bool computeTraceLog, double *trlogA)
+  {
+    const size_t offset = clover.Bytes() / (2*sizeof(Float));
+    Float *inverse[2] = { static_cast<Float*>(clover.V(true)), static_cast<Float*>(clover.V(true)) + offset };
+    const Float *direct[2] = { static_cast<const Float*>(clover.V(false)),
+			       static_cast<const Float*>(clover.V(false)) + offset };
+    const Float mu2 = clover.Mu2();
+
+    if (computeTraceLog) {
+      if (clover.Twisted()) cloverInvertHost<Float,true,true>(inverse, direct, clover.VolumeCB(), mu2, trlogA);
+      else cloverInvertHost<Float,false,true>(inverse, direct, clover.VolumeCB(), mu2, trlogA);
+    } else {
+      if (clover.Twisted()) cloverInvertHost<Float,true,false>(inverse, direct, clover.VolumeCB(), mu2, trlogA);
+      else cloverInvertHost<Float,false,false>(inverse, direct, clover.VolumeCB(), mu2, trlogA);
+    }
+  }
+
+  void cloverInvertHost(CloverField &clover, bool computeTraceLog)
+  {
+    if (clover.Location() != QUDA_CPU_FIELD_LOCATION)
+      errorQuda("Host clover inversion requires a CPU field");
+    if (clover.Order() != QUDA_PACKED_CLOVER_ORDER)
+      errorQuda("Host clover inversion requires packed order, not %d", clover.Order());
+    if (!clover.V(false) || !clover.V(true))
+      errorQuda("Host clover inversion requires both the clover field and its inverse");
+
+    double trlogA[2] = { 0.0, 0.0 };
+    if (clover.Precision() == QUDA_DOUBLE_PRECISION) {
+      cloverInvertHost<double>(clover, computeTraceLog, trlogA);
+    } else if (clover.Precision() == QUDA_SINGLE_PRECISION) {
+      cloverInvertHost<float>(clover, computeTraceLog, trlogA);
+    } else {
+      errorQuda("Precision %d not supported", clover.Precision());
+    }
+
+    if (computeTraceLog) {
+      comm_allreduce_array(trlogA, 2);
+      clover.TrLog()[0] = trlogA[0];
+      clover.TrLog()[1] = trlogA[1];
+    }
+  }
+
+} // namespace quda
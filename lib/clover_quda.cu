@@ -159,8 +159,12 @@ namespace quda {
 
       void apply(const cudaStream_t &stream) {
         if(location == QUDA_CUDA_FIELD_LOCATION){
+#ifndef QUDA_HOST_ONLY
           TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
           cloverComputeKernel<<<tp.grid,tp.block,tp.shared_bytes>>>(arg);  
+#else
+          errorQuda("GPU fields are not supported in a host-only build");
+#endif
         } else { // run the CPU code
           cloverComputeCPU(arg);
         }
@@ -215,6 +219,7 @@ namespace quda {
     } else {
       errorQuda("Precision %d not supported", clover.Precision());
     }
+    clover.updateVersion();
     return;
 #else
     errorQuda("Clover has not been built");
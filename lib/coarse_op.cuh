@@ -848,7 +848,7 @@ namespace quda {
       for (int x_cb=0; x_cb<arg.coarseVolumeCB; x_cb++) {
         for(int s = 0; s < nSpin; s++) { //Spin
          for(int c = 0; c < nColor; c++) { //Color
-	   arg.X(0,parity,x_cb,s,s,c,c) += static_cast<Float>(1.0);
+	   arg.X(0,parity,x_cb,s,s,c,c) += complex<Float>(1.0,0.0);
          } //Color
         } //Spin
       } // x_cb
@@ -865,7 +865,7 @@ namespace quda {
 
     for(int s = 0; s < nSpin; s++) { //Spin
       for(int c = 0; c < nColor; c++) { //Color
-	arg.X(0,parity,x_cb,s,s,c,c) += static_cast<Float>(1.0);
+	arg.X(0,parity,x_cb,s,s,c,c) += complex<Float>(1.0,0.0);
       } //Color
     } //Spin
    }
@@ -943,6 +943,7 @@ namespace quda {
     ComputeType type;
     bool bidirectional;
 
+  public:
     long long flops() const
     {
       long long flops_ = 0;
@@ -987,6 +988,8 @@ namespace quda {
       // 2 from parity, 8 from complex
       return flops_;
     }
+
+  protected:
     long long bytes() const
     {
       long long bytes_ = 0;
@@ -1135,6 +1138,7 @@ namespace quda {
 	  errorQuda("Undefined compute type %d", type);
 	}
       } else {
+#ifndef QUDA_HOST_ONLY
 
 	if (type == COMPUTE_UV) {
 
@@ -1208,6 +1212,9 @@ namespace quda {
 	} else {
 	  errorQuda("Undefined compute type %d", type);
 	}
+#else
+	errorQuda("GPU coarse-link construction is not available in the host-only build");
+#endif
       }
     }
 
@@ -1420,7 +1427,10 @@ namespace quda {
     Arg &arg;
     const LatticeField &meta;
 
+  public:
     long long flops() const { return 2l * arg.coarseVolumeCB * 8 * n * n * (8*n-2); } // 8 from dir, 8 from complexity,
+
+  protected:
     long long bytes() const { return 2l * (arg.Xinv.Bytes() + 8*arg.Y.Bytes() + 8*arg.Yhat.Bytes()); }
 
     unsigned int minThreads() const { return arg.coarseVolumeCB; }
@@ -1439,7 +1449,11 @@ namespace quda {
       if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
 	CalculateYhatCPU<Float,n,Arg>(arg);
       } else {
+#ifndef QUDA_HOST_ONLY
 	CalculateYhatGPU<Float,n,Arg> <<<tp.grid,tp.block,tp.shared_bytes>>>(arg);
+#else
+	errorQuda("GPU coarse-link construction is not available in the host-only build");
+#endif
       }
     }
 
@@ -1548,6 +1562,7 @@ namespace quda {
 
       y.setComputeType(COMPUTE_AV);
       y.apply(0);
+      blas::flops += y.flops();
 
       printfQuda("AV2 = %e\n", AV.norm2());
     }
@@ -1560,6 +1575,7 @@ namespace quda {
 
       y.setComputeType(COMPUTE_TMAV);
       y.apply(0);
+      blas::flops += y.flops();
 
       printfQuda("AV2 = %e\n", AV.norm2());
     }
@@ -1573,6 +1589,7 @@ namespace quda {
 
       y.setComputeType(COMPUTE_TMCAV);
       y.apply(0);
+      blas::flops += y.flops();
 
       printfQuda("AV2 = %e\n", AV.norm2());
     }
@@ -1586,10 +1603,12 @@ namespace quda {
 
 	y.setComputeType(COMPUTE_UV);  // compute U*V product
 	y.apply(0);
+	blas::flops += y.flops();
 	printfQuda("UV2[%d] = %e\n", d, UV.norm2());
 
 	y.setComputeType(COMPUTE_VUV); // compute Y += VUV
 	y.apply(0);
+	blas::flops += y.flops();
 	printfQuda("Y2[%d] = %e\n", d, Y.norm2(4+d));
       }
     }
@@ -1609,10 +1628,12 @@ namespace quda {
 
       y.setComputeType(COMPUTE_UV);  // compute U*A*V product
       y.apply(0);
+      blas::flops += y.flops();
       printfQuda("UAV2[%d] = %e\n", d, UV.norm2());
 
       y.setComputeType(COMPUTE_VUV); // compute Y += VUV
       y.apply(0);
+      blas::flops += y.flops();
       printfQuda("Y2[%d] = %e\n", d, Y.norm2(d));
     }
     printfQuda("X2 = %e\n", X.norm2(0));
@@ -1625,6 +1646,7 @@ namespace quda {
       printfQuda("Reversing links\n");
       y.setComputeType(COMPUTE_REVERSE_Y);  // reverse the links for the forwards direction
       y.apply(0);
+      blas::flops += y.flops();
     }
 
     cudaDeviceSynchronize(); checkCudaError();
@@ -1632,6 +1654,7 @@ namespace quda {
     printfQuda("Computing coarse local\n");
     y.setComputeType(COMPUTE_COARSE_LOCAL);
     y.apply(0);
+    blas::flops += y.flops();
     printfQuda("X2 = %e\n", X.norm2(0));
 
     cudaDeviceSynchronize(); checkCudaError();
@@ -1641,10 +1664,12 @@ namespace quda {
       printfQuda("Computing fine->coarse clover term\n");
       y.setComputeType(COMPUTE_COARSE_CLOVER);
       y.apply(0);
+      blas::flops += y.flops();
     } else {  //Otherwise, we just have to add the identity matrix
       printfQuda("Summing diagonal contribution to coarse clover\n");
       y.setComputeType(COMPUTE_DIAGONAL);
       y.apply(0);
+      blas::flops += y.flops();
     }
 
     cudaDeviceSynchronize(); checkCudaError();
@@ -1655,6 +1680,7 @@ namespace quda {
       printfQuda("Adding mu = %e\n",arg.mu*arg.mu_factor);
       y.setComputeType(COMPUTE_TMDIAGONAL);
       y.apply(0);
+      blas::flops += y.flops();
     }
 
     cudaDeviceSynchronize(); checkCudaError();
@@ -1701,6 +1727,7 @@ namespace quda {
       yHatArg arg(yHatAccessor, yAccessor, xInvAccessor, xc_size, comm_dim, 1);
       CalculateYhat<Float, coarseSpin*coarseColor, yHatArg> yHat(arg, Y_);
       yHat.apply(0);
+      blas::flops += yHat.flops();
 
       for (int d=0; d<8; d++) printfQuda("Yhat[%d] = %e\n", d, Y.norm2(d));
     }
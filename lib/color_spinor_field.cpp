@@ -14,7 +14,7 @@ namespace quda {
   }
 
   ColorSpinorField::ColorSpinorField(const ColorSpinorParam &param)
-    : LatticeField(param), init(false), v(0), norm(0),
+    : LatticeField(param), init(false), ghost_compression(param.ghost_compression), ghost_stats(param.ghost_stats), v(0), norm(0),
       ghost( ), ghostNorm( ), ghostFace( ),
       bytes(0), norm_bytes(0), even(0), odd(0),
       composite_descr(param.is_composite, param.composite_dim, param.is_component, param.component_id),
@@ -26,7 +26,7 @@ namespace quda {
   }
 
   ColorSpinorField::ColorSpinorField(const ColorSpinorField &field)
-    : LatticeField(field), init(false), v(0), norm(0),
+    : LatticeField(field), init(false), ghost_compression(field.ghost_compression), ghost_stats(field.ghost_stats), v(0), norm(0),
       ghost( ), ghostNorm( ), ghostFace( ),
       bytes(0), norm_bytes(0), even(0), odd(0),
      composite_descr(field.composite_descr), components(0)
@@ -243,6 +243,8 @@ namespace quda {
       create(src.nDim, src.x, src.nColor, src.nSpin, src.twistFlavor,
 	     src.precision, src.pad, src.siteSubset,
 	     src.siteOrder, src.fieldOrder, src.gammaBasis, src.PCtype);
+      ghost_compression = src.ghost_compression;
+      ghost_stats = src.ghost_stats;
     }
     return *this;
   }
@@ -362,6 +364,8 @@ namespace quda {
     param.gammaBasis = gammaBasis;
     param.PCtype = PCtype;
     param.create = QUDA_INVALID_FIELD_CREATE;
+    param.ghost_compression = ghost_compression;
+    param.ghost_stats = ghost_stats;
   }
 
   void ColorSpinorField::exchange(void **ghost, void **sendbuf, int nFace) const {
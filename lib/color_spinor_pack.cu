@@ -3,9 +3,15 @@
 #include <index_helper.cuh>
 #include <tune_quda.h>
 #include <fast_intdiv.h>
+#include <thread_pool.h>
+#include <algorithm>
+#include <mutex>
 
 namespace quda {
 
+  // guards the per-thread error reduction and the field's GhostCompressionStats
+  static std::mutex ghost_stats_mutex;
+
   template <typename Field>
   struct PackGhostArg {
 
@@ -138,9 +144,13 @@ namespace quda {
 	if (arg.nDim == 5) GenericPackGhost<Float,Ns,Ms,Nc,Mc,5,Arg>(arg);
 	else GenericPackGhost<Float,Ns,Ms,Nc,Mc,4,Arg>(arg);
       } else {
+#ifndef QUDA_HOST_ONLY
 	const TuneParam &tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	if (arg.nDim == 5) GenericPackGhostKernel<Float,Ns,Ms,Nc,Mc,5,Arg> <<<tp.grid,tp.block,tp.shared_bytes,stream>>>(arg);
 	else GenericPackGhostKernel<Float,Ns,Ms,Nc,Mc,4,Arg> <<<tp.grid,tp.block,tp.shared_bytes,stream>>>(arg);
+#else
+	errorQuda("GPU fields are not supported in a host-only build");
+#endif
       }
     }
 
@@ -159,9 +169,109 @@ namespace quda {
     }
   };
 
+  /**
+     Pack one site into the compressed ghost zones it borders: the
+     site is encoded once with a shared exponent set by its largest
+     component and written to each ghost zone.
+     @return The largest error of the site relative to that component
+   */
+  template <typename Float, typename ghostFloat, int Ns, int Nc, int nDim, typename Arg>
+  inline double packGhostCompressed(Arg &arg, int x_cb, int parity, int spinor_parity) {
+    typedef colorspinor::BlockFloat<ghostFloat> BF;
+
+    int x[5] = { };
+    if (nDim == 5) getCoords5(x, x_cb, arg.X, parity, arg.pc_type);
+    else getCoords(x, x_cb, arg.X, parity);
+
+    bool boundary = false;
+    for (int dim=0; dim<4; dim++)
+      if (arg.commDim[dim] && (x[dim] < arg.nFace || x[dim] >= arg.X[dim] - arg.nFace)) boundary = true;
+    if (!boundary) return 0.0;
+
+    complex<Float> v[Ns*Nc];
+    Float max = 0.0;
+    for (int s=0; s<Ns; s++) {
+      for (int c=0; c<Nc; c++) {
+	v[s*Nc+c] = arg.field(spinor_parity, x_cb, s, c);
+	max = fmax(max, fmax(fabs(v[s*Nc+c].real()), fabs(v[s*Nc+c].imag())));
+      }
+    }
+    const signed char e = BF::exponent(max);
+
+    for (int dim=0; dim<4; dim++) {
+      if (!arg.commDim[dim]) continue;
+      for (int dir=0; dir<2; dir++) {
+	if ( (dir == 0 && x[dim] >= arg.nFace) || (dir == 1 && x[dim] < arg.X[dim] - arg.nFace) ) continue;
+	const int ghost_idx = dir == 0 ? ghostFaceIndex<0>(x,arg.X,dim,arg.nFace) : ghostFaceIndex<1>(x,arg.X,dim,arg.nFace);
+	arg.field.setGhostExponent(dim, dir, spinor_parity, ghost_idx, e);
+	for (int s=0; s<Ns; s++)
+	  for (int c=0; c<Nc; c++)
+	    arg.field.setGhost(dim, dir, spinor_parity, ghost_idx, s, c, v[s*Nc+c]);
+      }
+    }
+
+    if (max == static_cast<Float>(0.0)) return 0.0;
+    Float error = 0.0;
+    for (int i=0; i<Ns*Nc; i++) {
+      error = fmax(error, fabs(BF::template decode<Float>(BF::encode(v[i].real(), e), e) - v[i].real()));
+      error = fmax(error, fabs(BF::template decode<Float>(BF::encode(v[i].imag(), e), e) - v[i].imag()));
+    }
+    return error / max;
+  }
+
+  template <typename Float, typename ghostFloat, int Ns, int Nc, int nDim, typename Arg>
+  double GenericPackGhostCompressed(Arg &arg) {
+    double max_error = 0.0;
+    for (int parity=0; parity<arg.nParity; parity++) {
+      parity = (arg.nParity == 2) ? parity : arg.parity;
+      const int spinor_parity = (arg.nParity == 2) ? parity : 0;
+      host::parallel_for(arg.volumeCB, [&](int begin, int end) {
+	  double error = 0.0;
+	  for (int i=begin; i<end; i++)
+	    error = std::max(error, packGhostCompressed<Float,ghostFloat,Ns,Nc,nDim>(arg, i, parity, spinor_parity));
+	  std::lock_guard<std::mutex> lock(ghost_stats_mutex);
+	  max_error = std::max(max_error, error);
+	});
+    }
+
+    return max_error;
+  }
+
+  template <typename Float, typename ghostFloat, QudaFieldOrder order, int Ns, int Nc>
+  inline void genericPackGhostCompressed(void **ghost, const ColorSpinorField &a, QudaParity parity, int nFace, int dagger) {
+
+    typedef typename colorspinor::FieldOrderCB<Float,Ns,Nc,1,order,ghostFloat> Q;
+    Q field(a, nFace, 0, ghost);
+
+    PackGhostArg<Q> arg(field, ghost, a, parity, nFace, dagger);
+    double max_error = (arg.nDim == 5) ? GenericPackGhostCompressed<Float,ghostFloat,Ns,Nc,5>(arg) :
+      GenericPackGhostCompressed<Float,ghostFloat,Ns,Nc,4>(arg);
+
+    GhostCompressionStats *stats = a.GhostStats();
+    if (!stats) return;
+
+    std::lock_guard<std::mutex> lock(ghost_stats_mutex);
+    stats->max_error = std::max(stats->max_error, max_error);
+    for (int d=0; d<4; d++) {
+      if (!comm_dim_partitioned(d)) continue;
+      const size_t sites = 2*a.SiteSubset()*nFace*a.SurfaceCB(d); // both directions
+      stats->raw_bytes += colorspinor::ghostBytes<Float,Float>(sites, Ns*Nc);
+      stats->compressed_bytes += colorspinor::ghostBytes<Float,ghostFloat>(sites, Ns*Nc);
+    }
+  }
+
   template <typename Float, QudaFieldOrder order, int Ns, int Nc>
   inline void genericPackGhost(void **ghost, const ColorSpinorField &a, QudaParity parity,
-			       int nFace, int dagger, MemoryLocation *destination) {
+			       int nFace, int dagger, MemoryLocation *destination, QudaGhostCompression compression) {
+
+    // compression is only supported for (host) space-spin-color fields, so only instantiate that order
+    if (compression == QUDA_GHOST_COMPRESSION_BLOCK_FLOAT_16) {
+      genericPackGhostCompressed<Float,short,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,Ns,Nc>(ghost, a, parity, nFace, dagger);
+      return;
+    } else if (compression == QUDA_GHOST_COMPRESSION_BLOCK_FLOAT_8) {
+      genericPackGhostCompressed<Float,signed char,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,Ns,Nc>(ghost, a, parity, nFace, dagger);
+      return;
+    }
 
     typedef typename colorspinor::FieldOrderCB<Float,Ns,Nc,1,order> Q;
     Q field(a, nFace, 0, ghost);
@@ -176,44 +286,44 @@ namespace quda {
 
   template <typename Float, QudaFieldOrder order, int Ns>
   inline void genericPackGhost(void **ghost, const ColorSpinorField &a, QudaParity parity,
-			       int nFace, int dagger, MemoryLocation *destination) {
+			       int nFace, int dagger, MemoryLocation *destination, QudaGhostCompression compression) {
     
     if (a.Ncolor() == 2) {
-      genericPackGhost<Float,order,Ns,2>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,2>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 3) {
-      genericPackGhost<Float,order,Ns,3>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,3>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 4) {
-      genericPackGhost<Float,order,Ns,4>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,4>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 6) {
-      genericPackGhost<Float,order,Ns,6>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,6>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 8) {
-      genericPackGhost<Float,order,Ns,8>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,8>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 12) {
-      genericPackGhost<Float,order,Ns,12>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,12>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 16) {
-      genericPackGhost<Float,order,Ns,16>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,16>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 20) {
-      genericPackGhost<Float,order,Ns,20>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,20>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 24) {
-      genericPackGhost<Float,order,Ns,24>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,24>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 28) {
-      genericPackGhost<Float,order,Ns,28>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,28>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 32) {
-      genericPackGhost<Float,order,Ns,32>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,32>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 48) {
-      genericPackGhost<Float,order,Ns,48>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,48>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 72) {
-      genericPackGhost<Float,order,Ns,72>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,72>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 96) {
-      genericPackGhost<Float,order,Ns,96>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,96>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 256) {
-      genericPackGhost<Float,order,Ns,256>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,256>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 576) {
-      genericPackGhost<Float,order,Ns,576>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,576>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 768) {
-      genericPackGhost<Float,order,Ns,768>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,768>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Ncolor() == 1024) {
-      genericPackGhost<Float,order,Ns,1024>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,Ns,1024>(ghost, a, parity, nFace, dagger, destination, compression);
     } else {
       errorQuda("Unsupported nColor = %d", a.Ncolor());
     }
@@ -222,15 +332,15 @@ namespace quda {
 
   template <typename Float, QudaFieldOrder order>
   inline void genericPackGhost(void **ghost, const ColorSpinorField &a, QudaParity parity,
-			       int nFace, int dagger, MemoryLocation *destination) {
+			       int nFace, int dagger, MemoryLocation *destination, QudaGhostCompression compression) {
 
     if (a.Nspin() == 4) {
-      genericPackGhost<Float,order,4>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,4>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Nspin() == 2) {
-      genericPackGhost<Float,order,2>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,2>(ghost, a, parity, nFace, dagger, destination, compression);
 #ifdef GPU_STAGGERED_DIRAC
     } else if (a.Nspin() == 1) {
-      genericPackGhost<Float,order,1>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,order,1>(ghost, a, parity, nFace, dagger, destination, compression);
 #endif
     } else {
       errorQuda("Unsupported nSpin = %d", a.Nspin());
@@ -240,14 +350,14 @@ namespace quda {
 
   template <typename Float>
   inline void genericPackGhost(void **ghost, const ColorSpinorField &a, QudaParity parity,
-			       int nFace, int dagger, MemoryLocation *destination) {
+			       int nFace, int dagger, MemoryLocation *destination, QudaGhostCompression compression) {
 
     if (a.FieldOrder() == QUDA_FLOAT2_FIELD_ORDER) {
-      genericPackGhost<Float,QUDA_FLOAT2_FIELD_ORDER>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,QUDA_FLOAT2_FIELD_ORDER>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.FieldOrder() == QUDA_FLOAT4_FIELD_ORDER) {
-      genericPackGhost<Float,QUDA_FLOAT4_FIELD_ORDER>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,QUDA_FLOAT4_FIELD_ORDER>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
-      genericPackGhost<Float,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<Float,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER>(ghost, a, parity, nFace, dagger, destination, compression);
     } else {
       errorQuda("Unsupported field order = %d", a.FieldOrder());
     }
@@ -255,12 +365,21 @@ namespace quda {
   }
 
   void genericPackGhost(void **ghost, const ColorSpinorField &a, QudaParity parity,
-			int nFace, int dagger, MemoryLocation *destination_) {
+			int nFace, int dagger, MemoryLocation *destination_, QudaGhostCompression compression) {
 
     if (a.FieldOrder() == QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) {
       errorQuda("Field order %d not supported", a.FieldOrder());
     }
 
+    if (compression != QUDA_GHOST_COMPRESSION_NONE) {
+      if (compression != QUDA_GHOST_COMPRESSION_BLOCK_FLOAT_16 && compression != QUDA_GHOST_COMPRESSION_BLOCK_FLOAT_8)
+	errorQuda("Unsupported ghost compression %d", compression);
+      if (a.Location() != QUDA_CPU_FIELD_LOCATION)
+	errorQuda("Ghost compression is only supported for CPU fields");
+      if (a.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+	errorQuda("Ghost compression is not supported for field order %d", a.FieldOrder());
+    }
+
     // set default location to match field type
     MemoryLocation destination[2*QUDA_MAX_DIM];
     for (int i=0; i<4*2; i++) {
@@ -274,9 +393,9 @@ namespace quda {
     if (!partitioned) return;
 
     if (a.Precision() == QUDA_DOUBLE_PRECISION) {
-      genericPackGhost<double>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<double>(ghost, a, parity, nFace, dagger, destination, compression);
     } else if (a.Precision() == QUDA_SINGLE_PRECISION) {
-      genericPackGhost<float>(ghost, a, parity, nFace, dagger, destination);
+      genericPackGhost<float>(ghost, a, parity, nFace, dagger, destination, compression);
     } else {
       errorQuda("Unsupported precision %d", a.Precision());
     }
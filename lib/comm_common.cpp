@@ -153,7 +153,11 @@ void comm_peer2peer_init(const char* hostname_recv_buf)
 {
   if (peer2peer_init) return;
 
+#ifndef QUDA_HOST_ONLY
   bool disable_peer_to_peer = false;
+#else
+  bool disable_peer_to_peer = true; // there is no device memory to share between the ranks
+#endif
   char *enable_peer_to_peer_env = getenv("QUDA_ENABLE_P2P");
   if (enable_peer_to_peer_env && strcmp(enable_peer_to_peer_env, "0") == 0) {
     if (getVerbosity() > QUDA_SILENT) printfQuda("Disabling peer-to-peer access\n");
@@ -557,6 +561,7 @@ MsgHandle *comm_declare_strided_receive_relative_(const char *func, const char *
 
 void comm_finalize(void)
 {
+  comm_shm_finalize();
   Topology *topo = comm_default_topology();
   comm_destroy_topology(topo);
   comm_set_default_topology(NULL);
@@ -646,6 +651,12 @@ void reduceDouble(double &sum) { if (globalReduce) comm_allreduce(&sum); }
 void reduceDoubleArray(double *sum, const int len)
 { if (globalReduce) comm_allreduce_array(sum, len); }
 
+CollectiveHandle *reduceDoubleArrayStart(double *sum, const int len)
+{ return globalReduce ? comm_iallreduce_array(sum, len) : nullptr; }
+
+void reduceDoubleArrayWait(CollectiveHandle *ch)
+{ if (ch) comm_wait_collective(ch); }
+
 int commDim(int dir) { return comm_dim(dir); }
 
 int commCoords(int dir) { return comm_coord(dir); }
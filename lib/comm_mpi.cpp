@@ -3,6 +3,7 @@
 #include <string.h>
 #include <mpi.h>
 #include <csignal>
+#include <vector>
 #include <quda_internal.h>
 #include <comm_quda.h>
 
@@ -37,6 +38,12 @@ struct MsgHandle_s {
      determine whether we need to free the datatype or not.
    */
   bool custom;
+
+  /**
+     Shared-memory handle used instead of MPI when the peer is on the
+     same host (NULL otherwise)
+   */
+  ShmHandle *shm;
 };
 
 static int rank = -1;
@@ -94,6 +101,7 @@ void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *m
     }
   }
 
+#ifndef QUDA_HOST_ONLY // the ranks of a host-only build have no GPUs to share out
   int device_count;
   cudaGetDeviceCount(&device_count);
   if (device_count == 0) {
@@ -108,9 +116,14 @@ void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *m
       errorQuda("Too few GPUs available on %s", comm_hostname());
     }
   }
+#else
+  gpuid = 0; // every rank uses the host device
+#endif
 
   comm_peer2peer_init(hostname_recv_buf);
 
+  comm_shm_init(hostname_recv_buf);
+
   host_free(hostname_recv_buf);
 
   snprintf(partition_string, 16, ",comm=%d%d%d%d", comm_dim_partitioned(0), comm_dim_partitioned(1), comm_dim_partitioned(2), comm_dim_partitioned(3));
@@ -161,8 +174,13 @@ MsgHandle *comm_declare_send_displaced(void *buffer, const int displacement[], s
   tag = tag >= 0 ? tag : 2*pow(4*max_displacement,ndim) + tag;
 
   MsgHandle *mh = (MsgHandle *)safe_malloc(sizeof(MsgHandle));
-  MPI_CHECK( MPI_Send_init(buffer, nbytes, MPI_BYTE, rank, tag, MPI_COMM_WORLD, &(mh->request)) );
   mh->custom = false;
+  if (comm_shm_enabled(rank)) {
+    mh->shm = comm_shm_declare_send(buffer, rank, tag, nbytes, 1, nbytes);
+    return mh;
+  }
+  mh->shm = NULL;
+  MPI_CHECK( MPI_Send_init(buffer, nbytes, MPI_BYTE, rank, tag, MPI_COMM_WORLD, &(mh->request)) );
 
   return mh;
 }
@@ -184,8 +202,13 @@ MsgHandle *comm_declare_receive_displaced(void *buffer, const int displacement[]
   tag = tag >= 0 ? tag : 2*pow(4*max_displacement,ndim) + tag;
 
   MsgHandle *mh = (MsgHandle *)safe_malloc(sizeof(MsgHandle));
-  MPI_CHECK( MPI_Recv_init(buffer, nbytes, MPI_BYTE, rank, tag, MPI_COMM_WORLD, &(mh->request)) );
   mh->custom = false;
+  if (comm_shm_enabled(rank)) {
+    mh->shm = comm_shm_declare_receive(buffer, rank, tag, nbytes, 1, nbytes);
+    return mh;
+  }
+  mh->shm = NULL;
+  MPI_CHECK( MPI_Recv_init(buffer, nbytes, MPI_BYTE, rank, tag, MPI_COMM_WORLD, &(mh->request)) );
 
   return mh;
 }
@@ -208,6 +231,12 @@ MsgHandle *comm_declare_strided_send_displaced(void *buffer, const int displacem
   tag = tag >= 0 ? tag : 2*pow(4*max_displacement,ndim) + tag;
 
   MsgHandle *mh = (MsgHandle *)safe_malloc(sizeof(MsgHandle));
+  if (comm_shm_enabled(rank)) {
+    mh->custom = false;
+    mh->shm = comm_shm_declare_send(buffer, rank, tag, blksize, nblocks, stride);
+    return mh;
+  }
+  mh->shm = NULL;
 
   // create a new strided MPI type
   MPI_CHECK( MPI_Type_vector(nblocks, blksize, stride, MPI_BYTE, &(mh->datatype)) );
@@ -237,6 +266,12 @@ MsgHandle *comm_declare_strided_receive_displaced(void *buffer, const int displa
   tag = tag >= 0 ? tag : 2*pow(4*max_displacement,ndim) + tag;
 
   MsgHandle *mh = (MsgHandle *)safe_malloc(sizeof(MsgHandle));
+  if (comm_shm_enabled(rank)) {
+    mh->custom = false;
+    mh->shm = comm_shm_declare_receive(buffer, rank, tag, blksize, nblocks, stride);
+    return mh;
+  }
+  mh->shm = NULL;
 
   // create a new strided MPI type
   MPI_CHECK( MPI_Type_vector(nblocks, blksize, stride, MPI_BYTE, &(mh->datatype)) );
@@ -251,6 +286,11 @@ MsgHandle *comm_declare_strided_receive_displaced(void *buffer, const int displa
 
 void comm_free(MsgHandle *mh)
 {
+  if (mh->shm) {
+    comm_shm_free(mh->shm);
+    host_free(mh);
+    return;
+  }
   MPI_CHECK(MPI_Request_free(&(mh->request)));
   if (mh->custom) MPI_CHECK(MPI_Type_free(&(mh->datatype)));
   host_free(mh);
@@ -259,18 +299,21 @@ void comm_free(MsgHandle *mh)
 
 void comm_start(MsgHandle *mh)
 {
+  if (mh->shm) return comm_shm_start(mh->shm);
   MPI_CHECK( MPI_Start(&(mh->request)) );
 }
 
 
 void comm_wait(MsgHandle *mh)
 {
+  if (mh->shm) return comm_shm_wait(mh->shm);
   MPI_CHECK( MPI_Wait(&(mh->request), MPI_STATUS_IGNORE) );
 }
 
 
 int comm_query(MsgHandle *mh)
 {
+  if (mh->shm) return comm_shm_query(mh->shm);
   int query;
   MPI_CHECK( MPI_Test(&(mh->request), &query, MPI_STATUS_IGNORE) );
 
@@ -293,12 +336,14 @@ void comm_allreduce_max(double* data)
   *data = recvbuf;
 }
 
+// persistent receive buffer for comm_allreduce_array, grown on demand
+static std::vector<double> allreduce_recvbuf;
+
 void comm_allreduce_array(double* data, size_t size)
 {
-  double *recvbuf = new double[size];
-  MPI_CHECK( MPI_Allreduce(data, recvbuf, size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD) );
-  memcpy(data, recvbuf, size*sizeof(double));
-  delete []recvbuf;
+  if (allreduce_recvbuf.size() < size) allreduce_recvbuf.resize(size);
+  MPI_CHECK( MPI_Allreduce(data, allreduce_recvbuf.data(), size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD) );
+  memcpy(data, allreduce_recvbuf.data(), size*sizeof(double));
 }
 
 
@@ -325,6 +370,90 @@ void comm_broadcast(void *data, size_t nbytes)
 }
 
 
+struct CollectiveHandle_s {
+  /**
+     The MPI request handle for the outstanding collective
+   */
+  MPI_Request request;
+
+  /**
+     Persistent receive buffer for reductions: this is retained when
+     the handle is returned to the pool so that repeated reductions
+     do not allocate.
+   */
+  std::vector<double> recvbuf;
+
+  /**
+     User buffer that the result is written back to on completion
+     (only used for reductions, broadcasts are done in place)
+   */
+  double *data;
+
+  /**
+     Number of elements in the reduction
+   */
+  size_t size;
+
+  /**
+     Whether this handle is currently in flight
+   */
+  bool active;
+};
+
+// maximum number of non-blocking collectives that can be in flight at once
+static const int max_collective = 16;
+static CollectiveHandle collective_pool[max_collective];
+
+static CollectiveHandle *get_collective_handle()
+{
+  for (int i=0; i<max_collective; i++) {
+    if (!collective_pool[i].active) {
+      collective_pool[i].active = true;
+      collective_pool[i].data = nullptr;
+      collective_pool[i].size = 0;
+      return &collective_pool[i];
+    }
+  }
+  errorQuda("Exceeded maximum number of outstanding non-blocking collectives (%d)", max_collective);
+  return nullptr;
+}
+
+CollectiveHandle *comm_iallreduce_array(double* data, size_t size)
+{
+  CollectiveHandle *ch = get_collective_handle();
+  ch->data = data;
+  ch->size = size;
+  if (ch->recvbuf.size() < size) ch->recvbuf.resize(size);
+#if MPI_VERSION >= 3
+  MPI_CHECK( MPI_Iallreduce(data, ch->recvbuf.data(), size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD, &(ch->request)) );
+#else
+  MPI_CHECK( MPI_Allreduce(data, ch->recvbuf.data(), size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD) );
+  ch->request = MPI_REQUEST_NULL;
+#endif
+  return ch;
+}
+
+CollectiveHandle *comm_ibroadcast(void *data, size_t nbytes)
+{
+  CollectiveHandle *ch = get_collective_handle();
+#if MPI_VERSION >= 3
+  MPI_CHECK( MPI_Ibcast(data, (int)nbytes, MPI_BYTE, 0, MPI_COMM_WORLD, &(ch->request)) );
+#else
+  MPI_CHECK( MPI_Bcast(data, (int)nbytes, MPI_BYTE, 0, MPI_COMM_WORLD) );
+  ch->request = MPI_REQUEST_NULL;
+#endif
+  return ch;
+}
+
+void comm_wait_collective(CollectiveHandle *ch)
+{
+  if (!ch || !ch->active) errorQuda("Invalid collective handle");
+  MPI_CHECK( MPI_Wait(&(ch->request), MPI_STATUS_IGNORE) );
+  if (ch->data) memcpy(ch->data, ch->recvbuf.data(), ch->size*sizeof(double));
+  ch->active = false;
+}
+
+
 void comm_barrier(void)
 {
   MPI_CHECK( MPI_Barrier(MPI_COMM_WORLD) );
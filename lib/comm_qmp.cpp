@@ -102,6 +102,7 @@ void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *m
     }
   }
 
+#ifndef QUDA_HOST_ONLY // the ranks of a host-only build have no GPUs to share out
   int device_count;
   cudaGetDeviceCount(&device_count);
   if (device_count == 0) {
@@ -116,6 +117,9 @@ void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *m
       errorQuda("Too few GPUs available on %s", comm_hostname());
     }
   }
+#else
+  gpuid = 0; // every rank uses the host device
+#endif
 
   comm_peer2peer_init(hostname_recv_buf);
 
@@ -286,6 +290,32 @@ void comm_broadcast(void *data, size_t nbytes)
 }
 
 
+/**
+   QMP has no non-blocking collectives, so these are performed
+   eagerly when started and the handle carries no state.
+ */
+struct CollectiveHandle_s { };
+
+static CollectiveHandle collective_handle;
+
+CollectiveHandle *comm_iallreduce_array(double* data, size_t size)
+{
+  comm_allreduce_array(data, size);
+  return &collective_handle;
+}
+
+CollectiveHandle *comm_ibroadcast(void *data, size_t nbytes)
+{
+  comm_broadcast(data, nbytes);
+  return &collective_handle;
+}
+
+void comm_wait_collective(CollectiveHandle *ch)
+{
+  if (!ch) errorQuda("Invalid collective handle");
+}
+
+
 void comm_barrier(void)
 {
   QMP_CHECK( QMP_barrier() );
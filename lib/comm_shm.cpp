@@ -0,0 +1,320 @@
+/**
+ * Shared-memory transport for messages between ranks on the same
+ * host.  Each (source, destination, tag) triple maps a POSIX
+ * shared-memory segment that holds a lock-free single-producer
+ * single-consumer byte ring.  Messages are streamed through the ring
+ * in chunks, so they may be larger than the ring, and messages on a
+ * given channel complete in the order in which they were started, as
+ * with MPI.  Ranks on different hosts continue to use the
+ * message-passing backend.
+ *
+ * The transport is enabled with QUDA_ENABLE_SHM=1, and the size of
+ * each ring can be set with QUDA_SHM_RING_BYTES.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <algorithm>
+
+#include <quda_internal.h>
+#include <comm_quda.h>
+
+static_assert(ATOMIC_LONG_LOCK_FREE == 2 || ATOMIC_LLONG_LOCK_FREE == 2,
+	      "shared-memory transport requires lock-free 64-bit atomics");
+
+/**
+   Header of the shared segment: the producer and consumer counters
+   are on separate cache lines and count bytes since the channel was
+   created, so the ring is full when head - tail == capacity.
+ */
+struct ShmRing {
+  std::atomic<uint64_t> head;
+  char pad0[64 - sizeof(std::atomic<uint64_t>)];
+  std::atomic<uint64_t> tail;
+  char pad1[64 - sizeof(std::atomic<uint64_t>)];
+};
+
+struct ShmChannel {
+  char name[64];
+  int src;
+  int dst;
+  int tag;
+  ShmRing *ring;
+  char *data;
+  size_t capacity;
+  std::deque<ShmHandle*> sends; // started sends in start order
+  std::deque<ShmHandle*> recvs; // started receives in start order
+};
+
+struct ShmHandle_s {
+  ShmChannel *channel;
+  char *buffer;
+  size_t blksize;
+  int nblocks;
+  size_t stride;
+  size_t nbytes;   // total bytes in the (packed) message
+  size_t offset;   // bytes transferred so far for the message in flight
+  bool send;
+  bool device;     // whether buffer is device memory
+  bool active;     // started and not yet completed
+};
+
+static bool shm_init = false;
+static bool shm_enabled = false;
+static int shm_key = 0;
+static size_t ring_bytes = 1 << 20;
+static std::vector<bool> shm_local; // whether each rank is on this host
+static std::vector<ShmChannel*> channels;
+
+
+void comm_shm_init(const char *hostname_recv_buf)
+{
+  if (shm_init) return;
+
+  // rank 0 decides so that both ends of every channel agree
+  int param[3] = { 0, (int)getpid() ^ (int)time(NULL), (int)ring_bytes };
+  if (comm_rank() == 0) {
+    char *enable_shm_env = getenv("QUDA_ENABLE_SHM");
+    if (enable_shm_env && strcmp(enable_shm_env, "1") == 0) param[0] = 1;
+
+    char *ring_bytes_env = getenv("QUDA_SHM_RING_BYTES");
+    if (ring_bytes_env) param[2] = atoi(ring_bytes_env);
+    if (param[2] < 4096) errorQuda("QUDA_SHM_RING_BYTES=%d is too small", param[2]);
+  }
+  comm_broadcast(param, sizeof(param));
+
+  shm_enabled = param[0];
+  shm_key = param[1] & 0x7fffffff;
+  ring_bytes = param[2];
+
+  shm_local.assign(comm_size(), false);
+  int nlocal = 0;
+  for (int r=0; r<comm_size(); r++) {
+    shm_local[r] = !strncmp(comm_hostname(), &hostname_recv_buf[128*r], 128);
+    if (shm_local[r]) nlocal++;
+  }
+
+  if (shm_enabled && getVerbosity() > QUDA_SILENT)
+    printfQuda("Enabling shared-memory intra-node communication (%lu byte rings, %d ranks on rank 0's host)\n",
+	       ring_bytes, nlocal);
+
+  shm_init = true;
+}
+
+void comm_shm_finalize(void)
+{
+  if (!shm_init) return;
+
+  // ensure no channel is still being opened by a peer before removing the names
+  comm_barrier();
+  for (auto c : channels) {
+    shm_unlink(c->name); // the peer may already have removed it
+    munmap(c->ring, sizeof(ShmRing) + c->capacity);
+    delete c;
+  }
+  channels.clear();
+  shm_local.clear();
+
+  shm_init = false;
+  shm_enabled = false;
+}
+
+bool comm_shm_enabled(int rank)
+{
+  return shm_enabled && shm_local[rank];
+}
+
+static ShmChannel *get_channel(int src, int dst, int tag)
+{
+  for (auto c : channels) if (c->src == src && c->dst == dst && c->tag == tag) return c;
+
+  ShmChannel *c = new ShmChannel;
+  c->src = src;
+  c->dst = dst;
+  c->tag = tag;
+  c->capacity = ring_bytes;
+  snprintf(c->name, sizeof(c->name), "/quda.%d.%d.%d.%d", shm_key, src, dst, tag);
+
+  // either end may get here first: a new segment is zero filled, which is a valid empty ring
+  const size_t bytes = sizeof(ShmRing) + c->capacity;
+  int fd = shm_open(c->name, O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd < 0) errorQuda("shm_open(%s) failed", c->name);
+  if (ftruncate(fd, bytes) != 0) errorQuda("ftruncate(%s, %lu) failed", c->name, bytes);
+  // reserve the pages now rather than failing with SIGBUS when /dev/shm is full
+  if (posix_fallocate(fd, 0, bytes) != 0)
+    errorQuda("Cannot allocate %lu bytes for %s: is /dev/shm large enough?", bytes, c->name);
+
+  void *ptr = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (ptr == MAP_FAILED) errorQuda("mmap(%s) failed", c->name);
+  close(fd);
+
+  c->ring = static_cast<ShmRing*>(ptr);
+  c->data = static_cast<char*>(ptr) + sizeof(ShmRing);
+
+  channels.push_back(c);
+  return c;
+}
+
+static bool is_device_pointer(const void *ptr)
+{
+  cudaPointerAttributes attr;
+  if (cudaPointerGetAttributes(&attr, ptr) != cudaSuccess) {
+    cudaGetLastError(); // unregistered host memory
+    return false;
+  }
+#if CUDART_VERSION >= 10000
+  return attr.type == cudaMemoryTypeDevice;
+#else
+  return attr.memoryType == cudaMemoryTypeDevice;
+#endif
+}
+
+static ShmHandle *declare(void *buffer, int src, int dst, int tag, size_t blksize, int nblocks, size_t stride, bool send)
+{
+  if (!comm_shm_enabled(send ? dst : src)) errorQuda("Shared-memory transport not enabled for this rank pair");
+
+  ShmHandle *h = (ShmHandle *)safe_malloc(sizeof(ShmHandle));
+  h->channel = get_channel(src, dst, tag);
+  h->buffer = static_cast<char*>(buffer);
+  h->blksize = blksize;
+  h->nblocks = nblocks;
+  h->stride = stride;
+  h->nbytes = blksize * nblocks;
+  h->offset = 0;
+  h->send = send;
+  h->device = is_device_pointer(buffer);
+  h->active = false;
+  return h;
+}
+
+ShmHandle *comm_shm_declare_send(void *buffer, int rank, int tag, size_t blksize, int nblocks, size_t stride)
+{
+  return declare(buffer, comm_rank(), rank, tag, blksize, nblocks, stride, true);
+}
+
+ShmHandle *comm_shm_declare_receive(void *buffer, int rank, int tag, size_t blksize, int nblocks, size_t stride)
+{
+  return declare(buffer, rank, comm_rank(), tag, blksize, nblocks, stride, false);
+}
+
+void comm_shm_free(ShmHandle *h)
+{
+  if (h->active) errorQuda("Cannot free an active shared-memory message handle");
+  host_free(h);
+}
+
+static inline void copy_bytes(void *dst, const void *src, size_t bytes, bool device)
+{
+  if (device) cudaMemcpy(dst, src, bytes, cudaMemcpyDefault);
+  else memcpy(dst, src, bytes);
+}
+
+/**
+   Copy bytes [offset, offset+bytes) of the packed message between
+   the (possibly strided) user buffer and the ring, starting at ring
+   position pos, splitting at block and ring-wrap boundaries.
+ */
+static void copy_message(ShmHandle *h, size_t offset, size_t bytes, uint64_t pos, bool to_ring)
+{
+  ShmChannel *c = h->channel;
+  while (bytes) {
+    size_t block = offset / h->blksize;
+    size_t within = offset - block * h->blksize;
+    size_t ring_offset = pos % c->capacity;
+    size_t n = std::min(bytes, std::min(h->blksize - within, c->capacity - ring_offset));
+
+    char *user = h->buffer + block * h->stride + within;
+    char *ring = c->data + ring_offset;
+    if (to_ring) copy_bytes(ring, user, n, h->device);
+    else copy_bytes(user, ring, n, h->device);
+
+    offset += n;
+    pos += n;
+    bytes -= n;
+  }
+}
+
+/**
+   Move as much of the message in flight as the ring allows
+   @return Whether the message is complete
+ */
+static bool transfer(ShmHandle *h)
+{
+  ShmRing *ring = h->channel->ring;
+  size_t remaining = h->nbytes - h->offset;
+
+  if (h->send) {
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    uint64_t tail = ring->tail.load(std::memory_order_acquire);
+    size_t n = std::min(remaining, static_cast<size_t>(h->channel->capacity - (head - tail)));
+    if (n) {
+      copy_message(h, h->offset, n, head, true);
+      ring->head.store(head + n, std::memory_order_release);
+      h->offset += n;
+    }
+  } else {
+    uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+    size_t n = std::min(remaining, static_cast<size_t>(head - tail));
+    if (n) {
+      copy_message(h, h->offset, n, tail, false);
+      ring->tail.store(tail + n, std::memory_order_release);
+      h->offset += n;
+    }
+  }
+
+  return h->offset == h->nbytes;
+}
+
+static void progress(std::deque<ShmHandle*> &queue)
+{
+  while (!queue.empty() && transfer(queue.front())) {
+    queue.front()->active = false;
+    queue.pop_front();
+  }
+}
+
+/**
+   Advance every channel, not just the one being waited on, so that
+   two ranks waiting on each other with full rings cannot deadlock
+ */
+static void progress_all()
+{
+  for (auto c : channels) {
+    progress(c->sends);
+    progress(c->recvs);
+  }
+}
+
+void comm_shm_start(ShmHandle *h)
+{
+  if (h->active) errorQuda("Shared-memory message handle is already active");
+  h->offset = 0;
+  h->active = true;
+  std::deque<ShmHandle*> &queue = h->send ? h->channel->sends : h->channel->recvs;
+  queue.push_back(h);
+  progress(queue);
+}
+
+void comm_shm_wait(ShmHandle *h)
+{
+  for (unsigned int spin = 0; h->active; spin++) {
+    progress_all();
+    if (spin > 64) sched_yield(); // stop spinning if the peer is not running
+  }
+}
+
+int comm_shm_query(ShmHandle *h)
+{
+  if (h->active) progress_all();
+  return !h->active;
+}
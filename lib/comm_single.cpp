@@ -1,12 +1,33 @@
 /**
- * Dummy communications layer for single-GPU backend.
+ * Communications layer for the single-GPU backend.  Messages can
+ * only be exchanged with this process itself: a started send is
+ * copied to a staging buffer, and is delivered to a receive whose
+ * displacement is its negative, as with the tags of the MPI backend,
+ * so that a partitioned dimension wraps around onto this process.
+ * A receive that is never matched leaves its buffer untouched.
  */
 
 #include <stdlib.h>
 #include <string.h>
 #include <csignal>
+#include <deque>
+#include <algorithm>
+#include <quda_internal.h>
 #include <comm_quda.h>
 
+struct MsgHandle_s {
+  char *buffer;
+  size_t blksize;
+  int nblocks;
+  size_t stride;
+  int displacement[QUDA_MAX_DIM];
+  bool send;
+  char *staging; // packed copy of the message of a send
+  bool pending;  // a receive that has been started and not yet matched
+};
+
+static std::deque<MsgHandle*> sends; // started sends that have not yet been received
+
 static char partition_string[16] = ",comm=0000";
 static char topology_string[16] = ",topo=1111";
 
@@ -30,27 +51,90 @@ void comm_gather_gpuid(int *gpuid_recv_buf) {
   gpuid_recv_buf[0] = comm_gpuid();
 }
 
+static MsgHandle *declare(void *buffer, const int displacement[], size_t blksize, int nblocks, size_t stride, bool send)
+{
+  MsgHandle *mh = (MsgHandle *)safe_malloc(sizeof(MsgHandle));
+  mh->buffer = static_cast<char*>(buffer);
+  mh->blksize = blksize;
+  mh->nblocks = nblocks;
+  mh->stride = stride;
+  const int ndim = comm_ndim(comm_default_topology());
+  for (int i=0; i<QUDA_MAX_DIM; i++) mh->displacement[i] = i < ndim ? displacement[i] : 0;
+  mh->send = send;
+  mh->staging = send ? (char *)safe_malloc(blksize * nblocks) : nullptr;
+  mh->pending = false;
+  return mh;
+}
+
 MsgHandle *comm_declare_send_displaced(void *buffer, const int displacement[], size_t nbytes)
-{ return NULL; }
+{ return declare(buffer, displacement, nbytes, 1, nbytes, true); }
 
 MsgHandle *comm_declare_receive_displaced(void *buffer, const int displacement[], size_t nbytes)
-{ return NULL; }
+{ return declare(buffer, displacement, nbytes, 1, nbytes, false); }
 
 MsgHandle *comm_declare_strided_send_displaced(void *buffer, const int displacement[],
 					       size_t blksize, int nblocks, size_t stride)
-{ return NULL; }
+{ return declare(buffer, displacement, blksize, nblocks, stride, true); }
 
 MsgHandle *comm_declare_strided_receive_displaced(void *buffer, const int displacement[],
 						  size_t blksize, int nblocks, size_t stride)
-{ return NULL; }
+{ return declare(buffer, displacement, blksize, nblocks, stride, false); }
+
+void comm_free(MsgHandle *mh)
+{
+  auto it = std::find(sends.begin(), sends.end(), mh);
+  if (it != sends.end()) sends.erase(it);
+  if (mh->staging) host_free(mh->staging);
+  host_free(mh);
+}
+
+// cudaMemcpyDefault since the buffers may be device or host memory
+static void copy_blocks(MsgHandle *mh, bool to_staging, const char *staging = nullptr)
+{
+  for (int i=0; i<mh->nblocks; i++) {
+    if (to_staging) cudaMemcpy(mh->staging + i*mh->blksize, mh->buffer + i*mh->stride, mh->blksize, cudaMemcpyDefault);
+    else cudaMemcpy(mh->buffer + i*mh->stride, staging + i*mh->blksize, mh->blksize, cudaMemcpyDefault);
+  }
+}
 
-void comm_free(MsgHandle *mh) {}
+/**
+   Deliver the oldest started send that matches a pending receive
+   @return Whether the receive has completed
+ */
+static bool match(MsgHandle *recv)
+{
+  if (!recv->pending) return true;
+
+  for (auto it = sends.begin(); it != sends.end(); it++) {
+    MsgHandle *send = *it;
+    bool matched = send->blksize * send->nblocks == recv->blksize * recv->nblocks;
+    for (int i=0; i<QUDA_MAX_DIM; i++) matched = matched && send->displacement[i] == -recv->displacement[i];
+    if (!matched) continue;
+
+    copy_blocks(recv, false, send->staging);
+    sends.erase(it);
+    recv->pending = false;
+    return true;
+  }
+  return false;
+}
 
-void comm_start(MsgHandle *mh) {}
+void comm_start(MsgHandle *mh)
+{
+  if (mh->send) {
+    copy_blocks(mh, true);
+    if (std::find(sends.begin(), sends.end(), mh) == sends.end()) sends.push_back(mh);
+  } else {
+    mh->pending = true;
+  }
+}
 
-void comm_wait(MsgHandle *mh) {}
+void comm_wait(MsgHandle *mh)
+{
+  if (!mh->send && !match(mh)) mh->pending = false; // nothing to receive from
+}
 
-int comm_query(MsgHandle *mh) { return 1; }
+int comm_query(MsgHandle *mh) { return mh->send ? 1 : match(mh); }
 
 void comm_allreduce(double* data) {}
 
@@ -64,6 +148,16 @@ void comm_allreduce_xor(uint64_t *data) {}
 
 void comm_broadcast(void *data, size_t nbytes) {}
 
+struct CollectiveHandle_s { };
+
+static CollectiveHandle collective_handle;
+
+CollectiveHandle *comm_iallreduce_array(double* data, size_t size) { return &collective_handle; }
+
+CollectiveHandle *comm_ibroadcast(void *data, size_t nbytes) { return &collective_handle; }
+
+void comm_wait_collective(CollectiveHandle *ch) {}
+
 void comm_barrier(void) {}
 
 void comm_abort(int status) {
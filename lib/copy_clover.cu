@@ -79,9 +79,13 @@ namespace quda {
     virtual ~CopyClover() { ; }
   
     void apply(const cudaStream_t &stream) {
+#ifndef QUDA_HOST_ONLY
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       copyCloverKernel<FloatOut, FloatIn, length, Out, In> 
 	<<<tp.grid, tp.block, tp.shared_bytes, stream>>>(arg);
+#else
+      errorQuda("GPU fields are not supported in a host-only build");
+#endif
     }
 
     TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
@@ -24,6 +24,19 @@ namespace quda {
 			      QudaFieldLocation location, void *Dst, void *Src, 
 			      void *dstNorm, void *srcNorm) {
 
+    // the common host reorders are done by the threaded host engine
+    if (location == QUDA_CPU_FIELD_LOCATION && hostCopyColorSpinorSupported(dst, src)) {
+      copyColorSpinorHost(dst, src, Dst, Src);
+      return;
+    }
+
+    copyGenericColorSpinorAccessor(dst, src, location, Dst, Src, dstNorm, srcNorm);
+  }
+
+  void copyGenericColorSpinorAccessor(ColorSpinorField &dst, const ColorSpinorField &src,
+				      QudaFieldLocation location, void *Dst, void *Src,
+				      void *dstNorm, void *srcNorm) {
+
     if (dst.SiteSubset() != src.SiteSubset())
       errorQuda("Destination %d and source %d site subsets not equal", dst.SiteSubset(), src.SiteSubset());
 
@@ -176,9 +176,13 @@ namespace quda {
       if (location == QUDA_CPU_FIELD_LOCATION) {
 	copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, PreserveBasis<Ns,Nc>());
       } else {
+#ifndef QUDA_HOST_ONLY
 	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	copyColorSpinorKernel<FloatOut, FloatIn, Ns, Nc>
 	  <<<tp.grid, tp.block, tp.shared_bytes, stream>>> (arg, PreserveBasis<Ns,Nc>());
+#else
+	errorQuda("GPU fields are not supported in a host-only build");
+#endif
       }
     }
 
@@ -237,6 +241,7 @@ namespace quda {
 	  copyColorSpinor<FloatOut, FloatIn, Ns, Nc>(arg, NonRelToChiralBasis<Ns,Nc>());
 	}
       } else {
+#ifndef QUDA_HOST_ONLY
 	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	if (out.GammaBasis()==in.GammaBasis()) {
 	  copyColorSpinorKernel<FloatOut, FloatIn, Ns, Nc>
@@ -254,6 +259,9 @@ namespace quda {
 	  copyColorSpinorKernel<FloatOut, FloatIn, Ns, Nc>
 	    <<<tp.grid, tp.block, tp.shared_bytes, stream>>> (arg, NonRelToChiralBasis<Ns,Nc>());
 	}
+#else
+	errorQuda("GPU fields are not supported in a host-only build");
+#endif
       }
     }
 
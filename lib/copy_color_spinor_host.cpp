@@ -0,0 +1,194 @@
+// Host reordering of Ncolor=3 color-spinor fields between the FloatN
+// and site-major orders, with precision and gamma basis conversion.
+
+#include <math.h>
+#include <algorithm>
+#include <type_traits>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <thread_pool.h>
+#include <copy_color_spinor.cuh> // for the basis normalization kP and kU
+
+namespace quda {
+
+  static constexpr int nColor = 3;
+  static constexpr int maxLength = 2*4*nColor; // reals per site
+
+  /**
+     Position of the reals of each site of a field: component
+     (s*nColor + c)*2 + z of site x of parity p is at
+     p*parityOffset + x*siteStride + offset[(s*nColor + c)*2 + z]
+   */
+  struct SpinorLayout {
+    size_t parityOffset;
+    int siteStride;
+    int offset[maxLength];
+  };
+
+  static int floatN(QudaFieldOrder order)
+  {
+    switch (order) {
+    case QUDA_FLOAT2_FIELD_ORDER: return 2;
+    case QUDA_FLOAT4_FIELD_ORDER: return 4;
+    default: return 0;
+    }
+  }
+
+  static SpinorLayout spinorLayout(const ColorSpinorField &field)
+  {
+    const int Ns = field.Nspin();
+    const int length = 2*Ns*nColor;
+    const int N = floatN(field.FieldOrder());
+
+    SpinorLayout layout;
+    layout.parityOffset = field.Bytes() / (2*field.Precision());
+    layout.siteStride = N ? N : length;
+    for (int s=0; s<Ns; s++) {
+      for (int c=0; c<nColor; c++) {
+	for (int z=0; z<2; z++) {
+	  const int r = (s*nColor + c)*2 + z;
+	  if (N) layout.offset[r] = (r / N) * field.Stride() * N + r % N;
+	  else if (field.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) layout.offset[r] = r;
+	  else layout.offset[r] = (c*Ns + s)*2 + z; // space-color-spin
+	}
+      }
+    }
+    return layout;
+  }
+
+  /**
+     Change of gamma basis, out_s = K1_s in_{s1_s} + K2_s in_{s2_s},
+     with the coefficients of the basis functors of copy_color_spinor.cuh
+   */
+  struct BasisRotation {
+    int s1[4], s2[4];
+    double K1[4], K2[4];
+  };
+
+  static const BasisRotation *basisRotation(QudaGammaBasis out, QudaGammaBasis in)
+  {
+    static const BasisRotation nonRel = { {1, 2, 3, 0}, {3, 0, 1, 2}, {kP, -kP, -kP, -kP}, {kP, -kP, kP, kP} };
+    static const BasisRotation rel = { {1, 2, 3, 0}, {3, 0, 1, 2}, {-kU, kU, kU, kU}, {-kU, kU, -kU, -kU} };
+    static const BasisRotation chiralToNonRel = { {0, 1, 0, 1}, {2, 3, 2, 3}, {-kP, -kP, kP, kP}, {kP, kP, kP, kP} };
+    static const BasisRotation nonRelToChiral = { {0, 1, 0, 1}, {2, 3, 2, 3}, {-kU, -kU, kU, kU}, {kU, kU, kU, kU} };
+
+    if (out == QUDA_UKQCD_GAMMA_BASIS && in == QUDA_DEGRAND_ROSSI_GAMMA_BASIS) return &nonRel;
+    if (in == QUDA_UKQCD_GAMMA_BASIS && out == QUDA_DEGRAND_ROSSI_GAMMA_BASIS) return &rel;
+    if (out == QUDA_UKQCD_GAMMA_BASIS && in == QUDA_CHIRAL_GAMMA_BASIS) return &chiralToNonRel;
+    if (in == QUDA_UKQCD_GAMMA_BASIS && out == QUDA_CHIRAL_GAMMA_BASIS) return &nonRelToChiral;
+    return nullptr;
+  }
+
+  static bool hostCopyOrderSupported(const ColorSpinorField &field)
+  {
+    const int length = 2*field.Nspin()*nColor;
+    const int N = floatN(field.FieldOrder());
+    if (N) return length % N == 0;
+    return (field.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER ||
+	    field.FieldOrder() == QUDA_SPACE_COLOR_SPIN_FIELD_ORDER) && field.Stride() == field.VolumeCB();
+  }
+
+  bool hostCopyColorSpinorSupported(const ColorSpinorField &dst, const ColorSpinorField &src)
+  {
+    const ColorSpinorField *fields[2] = { &dst, &src };
+    for (int i=0; i<2; i++) {
+      const ColorSpinorField &f = *fields[i];
+      if (f.Ncolor() != nColor) return false;
+      if (f.Precision() != QUDA_DOUBLE_PRECISION && f.Precision() != QUDA_SINGLE_PRECISION) return false;
+      if (f.SiteOrder() != QUDA_EVEN_ODD_SITE_ORDER && f.SiteOrder() != QUDA_ODD_EVEN_SITE_ORDER) return false;
+      if (!hostCopyOrderSupported(f)) return false;
+    }
+    if (dst.Nspin() != src.Nspin() || dst.Ndim() != src.Ndim() || dst.Volume() != src.Volume() ||
+	dst.SiteSubset() != src.SiteSubset()) return false;
+    if (dst.GammaBasis() != src.GammaBasis() &&
+	(dst.Nspin() != 4 || !basisRotation(dst.GammaBasis(), src.GammaBasis()))) return false;
+    return true;
+  }
+
+  template <typename FloatOut, typename FloatIn>
+  static void copyColorSpinorHost(FloatOut *out, const SpinorLayout &lo, const FloatIn *in, const SpinorLayout &li,
+				  int Ns, int volumeCB, int nParity, int outParity, int inParity,
+				  const BasisRotation *rotation)
+  {
+    // compute in the wider of the two precisions
+    typedef typename std::conditional<sizeof(FloatOut) < sizeof(FloatIn), FloatIn, FloatOut>::type Float;
+    constexpr int T = 64; // sites per tile
+    const int length = 2*Ns*nColor;
+    const int nTile = (volumeCB + T - 1) / T;
+
+    host::parallel_for(nParity*nTile, [&](int begin, int end) {
+	alignas(64) Float a[maxLength][T], b[maxLength][T];
+	for (int t=begin; t<end; t++) {
+	  const int parity = t / nTile;
+	  const int x0 = (t % nTile) * T;
+	  const int n = std::min(T, volumeCB - x0);
+
+	  // gather, walking along the contiguous runs of the input
+	  const FloatIn *src = in + ((parity + inParity) & 1)*li.parityOffset + static_cast<size_t>(x0)*li.siteStride;
+	  if (li.siteStride < length) {
+	    for (int r=0; r<length; r++) for (int x=0; x<n; x++) a[r][x] = src[x*li.siteStride + li.offset[r]];
+	  } else {
+	    for (int x=0; x<n; x++) for (int r=0; r<length; r++) a[r][x] = src[x*li.siteStride + li.offset[r]];
+	  }
+
+	  Float (*v)[T] = a;
+	  if (rotation) {
+	    for (int s=0; s<4; s++) {
+	      const Float K1 = rotation->K1[s], K2 = rotation->K2[s];
+	      for (int i=0; i<2*nColor; i++) {
+		const Float *a1 = a[rotation->s1[s]*2*nColor + i], *a2 = a[rotation->s2[s]*2*nColor + i];
+		Float *o = b[s*2*nColor + i];
+		for (int x=0; x<n; x++) o[x] = K1 * a1[x] + K2 * a2[x];
+	      }
+	    }
+	    v = b;
+	  }
+
+	  // scatter, walking along the contiguous runs of the output
+	  FloatOut *dst = out + ((parity + outParity) & 1)*lo.parityOffset + static_cast<size_t>(x0)*lo.siteStride;
+	  if (lo.siteStride < length) {
+	    for (int r=0; r<length; r++) for (int x=0; x<n; x++) dst[x*lo.siteStride + lo.offset[r]] = v[r][x];
+	  } else {
+	    for (int x=0; x<n; x++) for (int r=0; r<length; r++) dst[x*lo.siteStride + lo.offset[r]] = v[r][x];
+	  }
+	}
+      });
+  }
+
+  template <typename FloatOut>
+  static void copyColorSpinorHost(ColorSpinorField &dst, const ColorSpinorField &src, FloatOut *Dst, const void *Src,
+				  const BasisRotation *rotation)
+  {
+    const SpinorLayout lo = spinorLayout(dst), li = spinorLayout(src);
+    const int outParity = dst.SiteOrder() == QUDA_ODD_EVEN_SITE_ORDER ? 1 : 0;
+    const int inParity = src.SiteOrder() == QUDA_ODD_EVEN_SITE_ORDER ? 1 : 0;
+
+    if (src.Precision() == QUDA_DOUBLE_PRECISION) {
+      copyColorSpinorHost(Dst, lo, static_cast<const double*>(Src), li, src.Nspin(), src.VolumeCB(),
+			  src.SiteSubset(), outParity, inParity, rotation);
+    } else {
+      copyColorSpinorHost(Dst, lo, static_cast<const float*>(Src), li, src.Nspin(), src.VolumeCB(),
+			  src.SiteSubset(), outParity, inParity, rotation);
+    }
+  }
+
+  void copyColorSpinorHost(ColorSpinorField &dst, const ColorSpinorField &src, void *Dst, const void *Src)
+  {
+    if (!hostCopyColorSpinorSupported(dst, src))
+      errorQuda("Host copy from order %d precision %d basis %d to order %d precision %d basis %d not supported",
+		src.FieldOrder(), src.Precision(), src.GammaBasis(), dst.FieldOrder(), dst.Precision(), dst.GammaBasis());
+
+    if (!Dst) Dst = dst.V();
+    if (!Src) Src = src.V();
+    const BasisRotation *rotation = dst.GammaBasis() == src.GammaBasis() ? nullptr :
+      basisRotation(dst.GammaBasis(), src.GammaBasis());
+
+    if (dst.Precision() == QUDA_DOUBLE_PRECISION) {
+      copyColorSpinorHost(dst, src, static_cast<double*>(Dst), Src, rotation);
+    } else {
+      copyColorSpinorHost(dst, src, static_cast<float*>(Dst), Src, rotation);
+    }
+  }
+
+} // namespace quda
@@ -66,10 +66,14 @@ namespace quda {
       if (location == QUDA_CPU_FIELD_LOCATION) {
 	packSpinor<FloatOut, FloatIn, Ns, Nc>(out, in, meta.VolumeCB());
       } else {
+#ifndef QUDA_HOST_ONLY
 	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	packSpinorKernel<FloatOut, FloatIn, Ns, Nc, OutOrder, InOrder>
 	  <<<tp.grid, tp.block, tp.shared_bytes, stream>>>
 	  (out, in, meta.VolumeCB());
+#else
+	errorQuda("GPU fields are not supported in a host-only build");
+#endif
       }
     }
 
@@ -133,10 +133,14 @@ namespace quda {
 	if(arg.regularToextended) copyGaugeEx<FloatOut, FloatIn, length, OutOrder, InOrder, true>(arg);
 	else copyGaugeEx<FloatOut, FloatIn, length, OutOrder, InOrder, false>(arg);
       } else if (location == QUDA_CUDA_FIELD_LOCATION) {
+#ifndef QUDA_HOST_ONLY
 	if(arg.regularToextended) copyGaugeExKernel<FloatOut, FloatIn, length, OutOrder, InOrder, true>
 				    <<<tp.grid, tp.block, tp.shared_bytes, stream>>>(arg);
 	else copyGaugeExKernel<FloatOut, FloatIn, length, OutOrder, InOrder, false>
 	       <<<tp.grid, tp.block, tp.shared_bytes, stream>>>(arg);
+#else
+	errorQuda("GPU fields are not supported in a host-only build");
+#endif
       }
     }
 
@@ -220,6 +220,7 @@ namespace quda {
     virtual ~CopyGauge() { ; }
   
     void apply(const cudaStream_t &stream) {
+#ifndef QUDA_HOST_ONLY
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       if (!isGhost) {
 	copyGaugeKernel<FloatOut, FloatIn, length, OutOrder, InOrder> 
@@ -228,6 +229,9 @@ namespace quda {
 	copyGhostKernel<FloatOut, FloatIn, length, OutOrder, InOrder> 
 	  <<<tp.grid, tp.block, tp.shared_bytes, stream>>>(arg);
       }
+#else
+      errorQuda("GPU fields are not supported in a host-only build");
+#endif
     }
 
     TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
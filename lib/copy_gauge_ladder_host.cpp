@@ -0,0 +1,164 @@
+// Host engine that fills every rung of a native gauge field ladder
+// (e.g., precise, sloppy and preconditioner) in one pass over the input.
+
+#include <memory>
+#include <vector>
+
+#include <quda_internal.h>
+#include <gauge_field.h>
+#include <gauge_field_order.h>
+#include <thread_pool.h>
+
+namespace quda {
+
+  using namespace gauge;
+
+  static constexpr int length = 18;
+
+  /**
+     One rung of the ladder: saves links given in double precision
+     into the staging buffer of a native field
+   */
+  struct LadderRung {
+    virtual ~LadderRung() { }
+    virtual void save(const double v[length], int x, int dir, int parity) = 0;
+    virtual void saveGhost(const double v[length], int x, int dir, int parity) = 0;
+  };
+
+  template <typename Order>
+  struct LadderRungImpl : public LadderRung {
+    typedef typename Order::RegType RegType;
+    Order order;
+    LadderRungImpl(const GaugeField &u, void *buffer) : order(u, static_cast<decltype(order.gauge)>(buffer), 0, true) { }
+
+    void save(const double v[length], int x, int dir, int parity) {
+      RegType u[length];
+      for (int i=0; i<length; i++) u[i] = v[i];
+      order.save(u, x, dir, parity);
+    }
+
+    void saveGhost(const double v[length], int x, int dir, int parity) {
+      RegType u[length];
+      for (int i=0; i<length; i++) u[i] = v[i];
+      order.saveGhost(u, x, dir, parity); // the ghost zone is in the pad of the buffer
+    }
+  };
+
+  template <typename Float>
+  static LadderRung *createRung(const GaugeField &u, void *buffer)
+  {
+    switch (u.Reconstruct()) {
+    case QUDA_RECONSTRUCT_NO:
+      if (typeid(Float) == typeid(short) && u.LinkType() == QUDA_ASQTAD_FAT_LINKS)
+	return new LadderRungImpl<FloatNOrder<short,length,2,19> >(u, buffer);
+      return new LadderRungImpl<typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type>(u, buffer);
+    case QUDA_RECONSTRUCT_12:
+      return new LadderRungImpl<typename gauge_mapper<Float,QUDA_RECONSTRUCT_12>::type>(u, buffer);
+    case QUDA_RECONSTRUCT_8:
+      return new LadderRungImpl<typename gauge_mapper<Float,QUDA_RECONSTRUCT_8>::type>(u, buffer);
+    default:
+      errorQuda("Reconstruction %d not supported", u.Reconstruct());
+    }
+    return nullptr;
+  }
+
+  static LadderRung *createRung(const GaugeField &u, void *buffer)
+  {
+    switch (u.Precision()) {
+    case QUDA_DOUBLE_PRECISION: return createRung<double>(u, buffer);
+    case QUDA_SINGLE_PRECISION: return createRung<float>(u, buffer);
+    case QUDA_HALF_PRECISION: return createRung<short>(u, buffer);
+    default: errorQuda("Precision %d not supported", u.Precision());
+    }
+    return nullptr;
+  }
+
+  template <typename InOrder>
+  static void copyGaugeLadderHost(std::vector<std::unique_ptr<LadderRung> > &rungs, const InOrder &in,
+				  const GaugeField &u, bool ghost)
+  {
+    typedef typename InOrder::RegType RegType;
+    const int volumeCB = u.VolumeCB();
+    const int geometry = u.Geometry();
+
+    // the work items are the sites of both parities followed by the ghost faces
+    int face_offset[5] = { 2*volumeCB };
+    for (int d=0; d<4; d++) face_offset[d+1] = face_offset[d] + (ghost ? 2*u.SurfaceCB(d)*u.Nface() : 0);
+
+    host::parallel_for(face_offset[4], [&](int begin, int end) {
+	RegType v[length];
+	double w[length];
+	for (int t=begin; t<end; t++) {
+	  if (t < face_offset[0]) {
+	    const int parity = t / volumeCB, x = t % volumeCB;
+	    for (int d=0; d<geometry; d++) {
+	      in.load(v, x, d, parity);
+	      for (int i=0; i<length; i++) w[i] = v[i];
+	      for (auto &rung : rungs) rung->save(w, x, d, parity);
+	    }
+	  } else {
+	    int d = 0;
+	    while (t >= face_offset[d+1]) d++;
+	    const int faceVolumeCB = (face_offset[d+1] - face_offset[d]) / 2;
+	    const int parity = (t - face_offset[d]) / faceVolumeCB, x = (t - face_offset[d]) % faceVolumeCB;
+	    in.loadGhost(v, x, d, parity);
+	    for (int i=0; i<length; i++) w[i] = v[i];
+	    for (auto &rung : rungs) rung->saveGhost(w, x, d, parity);
+	  }
+	}
+      });
+  }
+
+  template <typename Float>
+  static void copyGaugeLadderHost(std::vector<std::unique_ptr<LadderRung> > &rungs, const GaugeField &in, bool ghost)
+  {
+    Float *gauge = static_cast<Float*>(const_cast<void*>(in.Gauge_p()));
+    if (in.Order() == QUDA_QDP_GAUGE_ORDER) {
+      copyGaugeLadderHost(rungs, QDPOrder<Float,length>(in, gauge), in, ghost);
+    } else if (in.Order() == QUDA_MILC_GAUGE_ORDER) {
+      copyGaugeLadderHost(rungs, MILCOrder<Float,length>(in, gauge), in, ghost);
+    } else {
+      errorQuda("Gauge field order %d not supported", in.Order());
+    }
+  }
+
+  bool copyGaugeLadderHostSupported(const GaugeField &out, const GaugeField &in)
+  {
+    if (in.Location() != QUDA_CPU_FIELD_LOCATION || in.Ncolor() != 3 || in.Reconstruct() != QUDA_RECONSTRUCT_NO ||
+	in.Geometry() != QUDA_VECTOR_GEOMETRY || in.GhostExchange() == QUDA_GHOST_EXCHANGE_EXTENDED ||
+	(in.Order() != QUDA_QDP_GAUGE_ORDER && in.Order() != QUDA_MILC_GAUGE_ORDER) ||
+	(in.Precision() != QUDA_DOUBLE_PRECISION && in.Precision() != QUDA_SINGLE_PRECISION)) return false;
+
+    if (!out.isNative() || out.Ncolor() != 3 || out.Geometry() != QUDA_VECTOR_GEOMETRY ||
+	out.GhostExchange() == QUDA_GHOST_EXCHANGE_EXTENDED ||
+	(out.Reconstruct() != QUDA_RECONSTRUCT_NO && out.Reconstruct() != QUDA_RECONSTRUCT_12 &&
+	 out.Reconstruct() != QUDA_RECONSTRUCT_8)) return false;
+
+    // the ghost zone is copied over only if both fields have it and it has the same depth
+    if (in.GhostExchange() == QUDA_GHOST_EXCHANGE_PAD && out.GhostExchange() == QUDA_GHOST_EXCHANGE_PAD &&
+	in.Nface() != out.Nface()) return false;
+
+    return true;
+  }
+
+  void copyGaugeLadderHost(GaugeField **out, void **Out, int n, const GaugeField &in)
+  {
+    bool ghost = in.GhostExchange() == QUDA_GHOST_EXCHANGE_PAD;
+    std::vector<std::unique_ptr<LadderRung> > rungs;
+    for (int i=0; i<n; i++) {
+      if (!copyGaugeLadderHostSupported(*out[i], in))
+	errorQuda("Copying from order %d, precision %d to order %d, precision %d, reconstruct %d is not supported",
+		  in.Order(), in.Precision(), out[i]->Order(), out[i]->Precision(), out[i]->Reconstruct());
+      in.checkField(*out[i]);
+      if (out[i]->GhostExchange() != QUDA_GHOST_EXCHANGE_PAD) ghost = false;
+      rungs.emplace_back(createRung(*out[i], Out[i]));
+    }
+
+    if (in.Precision() == QUDA_DOUBLE_PRECISION) {
+      copyGaugeLadderHost<double>(rungs, in, ghost);
+    } else {
+      copyGaugeLadderHost<float>(rungs, in, ghost);
+    }
+  }
+
+} // namespace quda
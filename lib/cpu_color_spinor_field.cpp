@@ -16,6 +16,12 @@ namespace quda {
 
   size_t cpuColorSpinorField::ghostFaceBytes[QUDA_MAX_DIM] = { };
 
+  MsgHandle *cpuColorSpinorField::mh_ghost_send_fwd[QUDA_MAX_DIM] = { };
+  MsgHandle *cpuColorSpinorField::mh_ghost_send_back[QUDA_MAX_DIM] = { };
+  MsgHandle *cpuColorSpinorField::mh_ghost_recv_fwd[QUDA_MAX_DIM] = { };
+  MsgHandle *cpuColorSpinorField::mh_ghost_recv_back[QUDA_MAX_DIM] = { };
+  size_t cpuColorSpinorField::ghostMsgBytes[QUDA_MAX_DIM] = { };
+
   cpuColorSpinorField::cpuColorSpinorField(const ColorSpinorParam &param) :
     ColorSpinorField(param), init(false), reference(false) {
 
@@ -284,6 +290,8 @@ namespace quda {
   {
     if(!initGhostFaceBuffer) return;
 
+    destroyGhostComms(); // the handles refer to the buffers
+
     for(int i=0; i < 4; i++){  // make nDimComms static?
       host_free(fwdGhostFaceBuffer[i]); fwdGhostFaceBuffer[i] = NULL;
       host_free(backGhostFaceBuffer[i]); backGhostFaceBuffer[i] = NULL;
@@ -296,7 +304,7 @@ namespace quda {
 
   void cpuColorSpinorField::packGhost(void **ghost, const QudaParity parity, const int nFace, const int dagger) const
   {
-    genericPackGhost(ghost, *this, parity, nFace, dagger);
+    genericPackGhost(ghost, *this, parity, nFace, dagger, nullptr, ghost_compression);
     return;
   }
 
@@ -308,14 +316,60 @@ namespace quda {
     }
   }
 
-  void cpuColorSpinorField::exchangeGhost(QudaParity parity, int nFace, int dagger, const MemoryLocation *dummy1,
-					  const MemoryLocation *dummy2, bool dummy3, bool dummy4) const
+  size_t cpuColorSpinorField::ghostMessageBytes(int dim, int nFace) const
+  {
+    size_t sites = siteSubset*nFace*surfaceCB[dim];
+    switch (ghost_compression) {
+    case QUDA_GHOST_COMPRESSION_NONE: return sites*2*nSpin*nColor*precision;
+    case QUDA_GHOST_COMPRESSION_BLOCK_FLOAT_16: return sites*(2*nSpin*nColor*sizeof(short) + sizeof(signed char));
+    case QUDA_GHOST_COMPRESSION_BLOCK_FLOAT_8: return sites*(2*nSpin*nColor*sizeof(signed char) + sizeof(signed char));
+    default: errorQuda("Unsupported ghost compression %d", ghost_compression);
+    }
+    return 0;
+  }
+
+  void cpuColorSpinorField::createGhostComms(int nFace) const
+  {
+    for (int i=0; i<nDimComms; i++) {
+      if (!comm_dim_partitioned(i)) continue;
+      // the buffers are sized for the uncompressed ghost, which is never smaller
+      size_t nbytes = ghostMessageBytes(i, nFace);
+      if (nbytes == ghostMsgBytes[i] && mh_ghost_send_fwd[i]) continue;
+
+      if (mh_ghost_send_fwd[i]) {
+	comm_free(mh_ghost_send_fwd[i]);
+	comm_free(mh_ghost_send_back[i]);
+	comm_free(mh_ghost_recv_fwd[i]);
+	comm_free(mh_ghost_recv_back[i]);
+      }
+
+      mh_ghost_send_fwd[i] = comm_declare_send_relative(fwdGhostFaceSendBuffer[i], i, +1, nbytes);
+      mh_ghost_send_back[i] = comm_declare_send_relative(backGhostFaceSendBuffer[i], i, -1, nbytes);
+      mh_ghost_recv_fwd[i] = comm_declare_receive_relative(fwdGhostFaceBuffer[i], i, +1, nbytes);
+      mh_ghost_recv_back[i] = comm_declare_receive_relative(backGhostFaceBuffer[i], i, -1, nbytes);
+      ghostMsgBytes[i] = nbytes;
+    }
+  }
+
+  void cpuColorSpinorField::destroyGhostComms()
+  {
+    for (int i=0; i<QUDA_MAX_DIM; i++) {
+      if (!mh_ghost_send_fwd[i]) continue;
+      comm_free(mh_ghost_send_fwd[i]); mh_ghost_send_fwd[i] = nullptr;
+      comm_free(mh_ghost_send_back[i]); mh_ghost_send_back[i] = nullptr;
+      comm_free(mh_ghost_recv_fwd[i]); mh_ghost_recv_fwd[i] = nullptr;
+      comm_free(mh_ghost_recv_back[i]); mh_ghost_recv_back[i] = nullptr;
+      ghostMsgBytes[i] = 0;
+    }
+  }
+
+  void cpuColorSpinorField::exchangeGhostStart(QudaParity parity, int nFace, int dagger) const
   {
     // allocate ghost buffer if not yet allocated
     allocateGhostBuffer(nFace);
+    createGhostComms(nFace);
 
-    void **sendbuf = static_cast<void**>(safe_malloc(nDimComms * 2 * sizeof(void*)));
-
+    void *sendbuf[2*QUDA_MAX_DIM];
     for (int i=0; i<nDimComms; i++) {
       sendbuf[2*i + 0] = backGhostFaceSendBuffer[i];
       sendbuf[2*i + 1] = fwdGhostFaceSendBuffer[i];
@@ -325,9 +379,45 @@ namespace quda {
 
     packGhost(sendbuf, parity, nFace, dagger);
 
-    exchange(ghost_buf, sendbuf, nFace);
+    for (int i=0; i<nDimComms; i++) {
+      if (!comm_dim_partitioned(i)) continue;
+      comm_start(mh_ghost_recv_back[i]);
+      comm_start(mh_ghost_recv_fwd[i]);
+      comm_start(mh_ghost_send_fwd[i]);
+      comm_start(mh_ghost_send_back[i]);
+    }
+  }
+
+  bool cpuColorSpinorField::exchangeGhostQuery() const
+  {
+    bool complete = true;
+    for (int i=0; i<nDimComms; i++) {
+      if (!comm_dim_partitioned(i)) continue;
+      // query every handle so that each one makes progress
+      complete = comm_query(mh_ghost_send_fwd[i]) && complete;
+      complete = comm_query(mh_ghost_send_back[i]) && complete;
+      complete = comm_query(mh_ghost_recv_back[i]) && complete;
+      complete = comm_query(mh_ghost_recv_fwd[i]) && complete;
+    }
+    return complete;
+  }
+
+  void cpuColorSpinorField::exchangeGhostWait() const
+  {
+    for (int i=0; i<nDimComms; i++) {
+      if (!comm_dim_partitioned(i)) continue;
+      comm_wait(mh_ghost_send_fwd[i]);
+      comm_wait(mh_ghost_send_back[i]);
+      comm_wait(mh_ghost_recv_back[i]);
+      comm_wait(mh_ghost_recv_fwd[i]);
+    }
+  }
 
-    host_free(sendbuf);
+  void cpuColorSpinorField::exchangeGhost(QudaParity parity, int nFace, int dagger, const MemoryLocation *dummy1,
+					  const MemoryLocation *dummy2, bool dummy3, bool dummy4) const
+  {
+    exchangeGhostStart(parity, nFace, dagger);
+    exchangeGhostWait();
   }
 
 } // namespace quda
@@ -658,7 +658,7 @@ namespace quda {
 				       const int dagger, cudaStream_t *stream, 
 				       MemoryLocation location [2*QUDA_MAX_DIM], double a, double b)
   {
-#ifdef MULTI_GPU
+#if defined(MULTI_GPU) && !defined(QUDA_HOST_ONLY) // the packing kernels are not in the host-only build
     int face_num = (dir == QUDA_BACKWARDS) ? 0 : (dir == QUDA_FORWARDS) ? 1 : 2;
     void *packBuffer[2*QUDA_MAX_DIM];
 
@@ -676,7 +676,7 @@ namespace quda {
 
     packFace(packBuffer, *this, location, nFace, dagger, parity, dim, face_num, *stream, a, b);
 #else
-    errorQuda("packGhost not built on single-GPU build");
+    errorQuda("packGhost not built on single-GPU or host-only build");
 #endif
   }
  
@@ -814,7 +814,7 @@ namespace quda {
 					       const int dim, const QudaDirection dir,
 					       const int dagger, cudaStream_t *stream, bool zero_copy)
   {
-#ifdef MULTI_GPU
+#if defined(MULTI_GPU) && !defined(QUDA_HOST_ONLY)
     int face_num = (dir == QUDA_BACKWARDS) ? 0 : (dir == QUDA_FORWARDS) ? 1 : 2;
     void *packBuffer[2*QUDA_MAX_DIM];
     MemoryLocation location[2*QUDA_MAX_DIM];
@@ -837,7 +837,7 @@ namespace quda {
 
     packFaceExtended(packBuffer, *this, location, nFace, R, dagger, parity, dim, face_num, *stream);
 #else
-    errorQuda("packGhostExtended not built on single-GPU build");
+    errorQuda("packGhostExtended not built on single-GPU or host-only build");
 #endif
 
   }
@@ -859,7 +859,7 @@ namespace quda {
     int offset = length + ghostOffset[dim][0];
     offset += (dir == QUDA_BACKWARDS) ? 0 : len;
 
-#ifdef MULTI_GPU
+#if defined(MULTI_GPU) && !defined(QUDA_HOST_ONLY)
     const int face_num = 2;
     const bool unpack = true;
     const int R[4] = {0,0,0,0};
@@ -884,7 +884,7 @@ namespace quda {
 
     packFaceExtended(packBuffer, *this, location, nFace, R, dagger, parity, dim, face_num, *stream, unpack);
 #else
-    errorQuda("unpackGhostExtended not built on single-GPU build");
+    errorQuda("unpackGhostExtended not built on single-GPU or host-only build");
 #endif
   }
 
@@ -347,10 +347,18 @@ namespace quda {
 
   void cudaGaugeField::createComms(const int *R, bool no_comms_fill)
   {
+    size_t face_bytes[QUDA_MAX_DIM];
+    for (int i=0; i<nDim; i++) face_bytes[i] = ghost_face_bytes[i];
+
     allocateGhostBuffer(R, no_comms_fill); // allocate the ghost buffer if not yet allocated
 
+    // a change of halo depth changes the message sizes and buffer
+    // offsets (peer-to-peer copies compute their offsets per call)
+    bool depth_change = false;
+    for (int i=0; i<nDim; i++) if (face_bytes[i] != ghost_face_bytes[i]) depth_change = true;
+
     // ascertain if this instance needs it comms buffers to be updated
-    bool comms_reset = ghost_field_reset || // FIXME add send buffer check
+    bool comms_reset = ghost_field_reset || (initComms && depth_change) || // FIXME add send buffer check
       (my_face_h[0] != ghost_pinned_buffer_h[0]) || (my_face_h[1] != ghost_pinned_buffer_h[1]); // pinned buffers
 
     if (!initComms || comms_reset) LatticeField::createComms(no_comms_fill);
@@ -535,6 +543,7 @@ namespace quda {
           "QUDA_REFERENCE_FIELD_CREATE type\n");
     }
     gauge = gauge_;
+    updateVersion();
   }
 
   void *create_gauge_buffer(size_t bytes, QudaGaugeFieldOrder order, QudaFieldGeometry geometry) {
@@ -666,6 +675,53 @@ namespace quda {
 
     staggeredPhaseApplied = src.StaggeredPhaseApplied();
     staggeredPhaseType = src.StaggeredPhase();
+    updateVersion();
+
+    checkCudaError();
+  }
+
+  void cudaGaugeField::copyLadder(const std::vector<cudaGaugeField*> &ladder, const GaugeField &src) {
+    if (ladder.size() == 0) return;
+
+    bool host_ladder = typeid(src) == typeid(cpuGaugeField) && reorder_location() == QUDA_CPU_FIELD_LOCATION;
+    for (auto u : ladder) if (!copyGaugeLadderHostSupported(*u, src)) host_ladder = false;
+
+    if (!host_ladder) {
+      ladder[0]->copy(src);
+      for (unsigned int i=1; i<ladder.size(); i++) ladder[i]->copy(*ladder[0]);
+      return;
+    }
+
+    std::vector<GaugeField*> out(ladder.begin(), ladder.end());
+    std::vector<void*> buffer(ladder.size());
+    for (unsigned int i=0; i<ladder.size(); i++) {
+      cudaGaugeField &u = *ladder[i];
+      if (u.link_type == QUDA_ASQTAD_FAT_LINKS) {
+	u.fat_link_max = src.LinkMax();
+	if (u.precision == QUDA_HALF_PRECISION && u.fat_link_max == 0.0)
+	  errorQuda("fat_link_max has not been computed");
+      } else {
+	u.fat_link_max = 1.0;
+      }
+      buffer[i] = pool_pinned_malloc(u.bytes);
+    }
+
+    // one pass over the source fills all of the staging buffers
+    copyGaugeLadderHost(out.data(), buffer.data(), ladder.size(), src);
+
+    for (unsigned int i=0; i<ladder.size(); i++) {
+      cudaGaugeField &u = *ladder[i];
+      qudaMemcpy(u.gauge, buffer[i], u.bytes, cudaMemcpyHostToDevice);
+      pool_pinned_free(buffer[i]);
+
+      // if we have copied from a source without a pad then we need to exchange
+      if (u.ghostExchange == QUDA_GHOST_EXCHANGE_PAD && src.GhostExchange() != QUDA_GHOST_EXCHANGE_PAD)
+	u.exchangeGhost();
+
+      u.staggeredPhaseApplied = src.StaggeredPhaseApplied();
+      u.staggeredPhaseType = src.StaggeredPhase();
+      u.updateVersion();
+    }
 
     checkCudaError();
   }
@@ -763,6 +819,7 @@ namespace quda {
 
   void cudaGaugeField::zero() {
     cudaMemset(gauge, 0, bytes);
+    updateVersion();
   }
 
 
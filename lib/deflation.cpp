@@ -221,58 +221,84 @@ namespace quda {
 
     printfQuda("\nConstruct projection matrix..\n");
 
-    // Block MGS orthogonalization
-    // The degree to which we interpolate between modified GramSchmidt and GramSchmidt (performance vs stability)
-    const int cdot_pipeline_length  = 4;
-
-    for(int i = first_idx; i < (first_idx + nev); i++)
-    {
-      std::unique_ptr<Complex[] > alpha(new Complex[i]);
-
-      ColorSpinorField *accum = param.eig_global.cuda_prec_ritz != QUDA_DOUBLE_PRECISION ? r : &param.RV->Component(i);
-      *accum = param.RV->Component(i);
+    // block workspace: holds the rotated block during CholQR and then A V for the projection matrix
+    ColorSpinorParam csParam(param.RV->Component(0));
+    csParam.create        = QUDA_ZERO_FIELD_CREATE;
+    csParam.is_composite  = true;
+    csParam.composite_dim = nev;
+    std::unique_ptr<ColorSpinorField> W(ColorSpinorField::Create(csParam));
+
+    std::vector<ColorSpinorField*> v_old(param.RV->Components().begin(), param.RV->Components().begin()+first_idx);
+    std::vector<ColorSpinorField*> v_new(param.RV->Components().begin()+first_idx, param.RV->Components().begin()+first_idx+nev);
+    std::vector<ColorSpinorField*> w(W->Components().begin(), W->Components().end());
+
+    std::unique_ptr<Complex[] > h(new Complex[std::max(first_idx, nev)*nev]);
+
+    // with a reduced-precision deflation space the new block is
+    // orthogonalized in double-precision accumulators, and only rounded
+    // to the Ritz precision once it is complete
+    const bool accum = param.eig_global.cuda_prec_ritz != QUDA_DOUBLE_PRECISION;
+    std::unique_ptr<ColorSpinorField> A, B;
+    std::vector<ColorSpinorField*> q(v_new), q_tmp(w);
+    if (accum) {
+      ColorSpinorParam aParam(csParam);
+      aParam.setPrecision(QUDA_DOUBLE_PRECISION);
+      if (aParam.location == QUDA_CUDA_FIELD_LOCATION) aParam.fieldOrder = QUDA_FLOAT2_FIELD_ORDER;
+      A.reset(ColorSpinorField::Create(aParam));
+      B.reset(ColorSpinorField::Create(aParam));
+      q.assign(A->Components().begin(), A->Components().end());
+      q_tmp.assign(B->Components().begin(), B->Components().end());
+      for (int i = 0; i < nev; i++) blas::copy(*q[i], *v_new[i]);
+    }
 
-      int offset = 0;
-      while (offset < i) {
-        
-        const int local_length = (i - offset) > cdot_pipeline_length  ? cdot_pipeline_length : (i - offset);
+    // Block classical Gram-Schmidt with CholQR, applied twice (BCGS2):
+    // each pass is one large cDotProduct/caxpy against the existing space
+    // and one Gram matrix + triangular update within the new block.
+    for (int pass = 0; pass < 2; pass++) {
 
-        std::vector<ColorSpinorField*> vj_(param.RV->Components().begin()+offset, param.RV->Components().begin()+offset+local_length);
-        std::vector<ColorSpinorField*> vi_;
-	vi_.push_back(accum);
+      if (first_idx > 0) {
+        blas::cDotProduct(h.get(), v_old, q); //<j,i>
+        for (int k = 0; k < first_idx*nev; k++) h[k] = -h[k];
+        blas::caxpy(h.get(), v_old, q); //i-<j,i>j
+      }
 
-        blas::cDotProduct(alpha.get(), vj_, vi_);
-        for (int j = 0; j < local_length; j++) alpha[j] = -alpha[j];
+      blas::hDotProduct(h.get(), q, q);
 
-        blas::caxpy(alpha.get(), vj_, vi_); //i-<j,i>j
+      Map<Matrix<Complex, Dynamic, Dynamic, RowMajor>, Unaligned> G(h.get(), nev, nev);
+      LLT<MatrixXcd> chol(G);
+      if (chol.info() != Success) errorQuda("\nCannot orthogonalize new block of %d vectors\n", nev);
 
-        offset += cdot_pipeline_length;
-      }
+      // V <- V R^{-1} with G = R^H R
+      MatrixXcd Rinv = chol.matrixU().solve(MatrixXcd::Identity(nev, nev));
+      G = Rinv;
 
-      alpha[0] = blas::norm2(*accum);
+      for (int i = 0; i < nev; i++) blas::zero(*q_tmp[i]);
+      blas::caxpy_U(h.get(), q, q_tmp);
+      if (accum) std::swap(q, q_tmp);
+      else for (int i = 0; i < nev; i++) blas::copy(*v_new[i], *w[i]);
+    }
 
-      if(alpha[0].real() > 1e-16) blas::ax(1.0 /sqrt(alpha[0].real()), *accum);
-      else                        errorQuda("\nCannot orthogonalize %dth vector\n", i);
+    if (accum) for (int i = 0; i < nev; i++) blas::copy(*v_new[i], *q[i]);
 
-      param.RV->Component(i) = *accum;
+    // apply the operator to the whole block, then fill the new rows/columns of matProj at once
+    for (int i = 0; i < nev; i++) param.matDeflation(*w[i], *v_new[i]);//precision must match!
 
-      param.matDeflation(*Av_sloppy, param.RV->Component(i));//precision must match!
-      //load diagonal:
-      *Av = *Av_sloppy; 
-      param.matProj[i*param.ld+i] = cDotProduct(*accum, *Av);
+    const int new_dim = first_idx + nev;
+    std::vector<ColorSpinorField*> v_all(param.RV->Components().begin(), param.RV->Components().begin()+new_dim);
+    std::unique_ptr<Complex[] > proj(new Complex[new_dim*nev]);
 
-      if (i>0) {
-        std::vector<ColorSpinorField*> vj_(param.RV->Components().begin(), param.RV->Components().begin()+i);
-        std::vector<ColorSpinorField*> av_;
-	av_.push_back(Av_sloppy);
+    blas::cDotProduct(proj.get(), v_all, w); //<j, A i>
 
-	blas::cDotProduct(alpha.get(), vj_, av_);
+    // the block within the new vectors is taken from the double-precision accumulators
+    if (accum) blas::cDotProduct(proj.get() + first_idx*nev, q, w);
 
-        for (int j = 0; j < i; j++) {
-          param.matProj[i*param.ld+j] = alpha[j];
-          param.matProj[j*param.ld+i] = conj(alpha[j]);//conj
-        }
+    for (int i = 0; i < nev; i++) {
+      const int col = first_idx + i;
+      for (int j = 0; j < col; j++) {
+        param.matProj[col*param.ld+j] = proj[j*nev+i];
+        param.matProj[j*param.ld+col] = conj(proj[j*nev+i]);//conj
       }
+      param.matProj[col*param.ld+col] = Complex(proj[col*nev+i].real(), 0.0);
     }
 
     param.cur_dim += nev;
@@ -68,6 +68,24 @@ namespace quda {
     }
   }
 
+  cpuGaugeField* Dirac::createHostGauge(const cudaGaugeField &gauge, QudaPrecision precision) {
+    GaugeFieldParam param(gauge);
+    param.order = QUDA_QDP_GAUGE_ORDER;
+    param.reconstruct = QUDA_RECONSTRUCT_NO;
+    param.precision = precision;
+    param.pad = 0;
+    param.create = QUDA_NULL_FIELD_CREATE;
+    param.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+    cpuGaugeField *gauge_h = new cpuGaugeField(param);
+    gauge_h->copy(gauge);
+
+    bool partitioned = false;
+    for (int mu=0; mu<4; mu++) if (comm_dim_partitioned(mu)) partitioned = true;
+    if (partitioned) gauge_h->exchangeGhost(QUDA_LINK_BACKWARDS);
+
+    return gauge_h;
+  }
+
 #define flip(x) (x) = ((x) == QUDA_DAG_YES ? QUDA_DAG_NO : QUDA_DAG_YES)
 
   void Dirac::Mdag(ColorSpinorField &out, const ColorSpinorField &in) const
@@ -14,7 +14,7 @@ namespace quda {
   }
 
   DiracClover::DiracClover(const DiracParam &param)
-    : DiracWilson(param), clover(*(param.clover))
+    : DiracWilson(param), clover(*(param.clover)), clover_h(nullptr), clover_h_version(0)
   {
     clover::initConstants(*param.gauge, profile);
     asym_clover::initConstants(*param.gauge, profile);
@@ -24,7 +24,7 @@ namespace quda {
   }
 
   DiracClover::DiracClover(const DiracClover &dirac) 
-    : DiracWilson(dirac), clover(dirac.clover)
+    : DiracWilson(dirac), clover(dirac.clover), clover_h(nullptr), clover_h_version(0)
   {
     clover::initConstants(*dirac.gauge, profile);
     asym_clover::initConstants(*dirac.gauge, profile);
@@ -33,17 +33,38 @@ namespace quda {
 #endif
   }
 
-  DiracClover::~DiracClover() { }
+  DiracClover::~DiracClover() { if (clover_h) delete clover_h; }
 
   DiracClover& DiracClover::operator=(const DiracClover &dirac)
   {
     if (&dirac != this) {
       DiracWilson::operator=(dirac);
       clover = dirac.clover;
+      if (clover_h) delete clover_h;
+      clover_h = nullptr;
     }
     return *this;
   }
 
+  const cpuCloverField& DiracClover::HostClover(QudaPrecision precision) const
+  {
+    if (clover_h && clover_h->Precision() == precision && clover_h_version == clover.Version()) return *clover_h;
+    if (clover_h) delete clover_h;
+
+    CloverFieldParam param(clover);
+    param.order = QUDA_PACKED_CLOVER_ORDER;
+    param.precision = precision;
+    param.pad = 0;
+    param.direct = true;
+    param.inverse = clover.V(true) ? true : false;
+    param.create = QUDA_NULL_FIELD_CREATE;
+    clover_h = new cpuCloverField(param);
+    clover.saveCPUField(*clover_h);
+    clover_h_version = clover.Version();
+
+    return *clover_h;
+  }
+
   void DiracClover::checkParitySpinor(const ColorSpinorField &out, const ColorSpinorField &in) const
   {
     Dirac::checkParitySpinor(out, in);
@@ -68,7 +89,7 @@ namespace quda {
 			   &static_cast<const cudaColorSpinorField&>(in), parity, dagger, 
 			   &static_cast<const cudaColorSpinorField&>(x), k, commDim, profile);
     } else {
-      errorQuda("Not implemented");
+      asymCloverDslashHost(out, HostGauge(in.Precision()), HostClover(in.Precision()), in, parity, dagger, x, k);
     }
 
     flops += 1872ll*in.Volume();
@@ -78,12 +99,24 @@ namespace quda {
   void DiracClover::Clover(ColorSpinorField &out, const ColorSpinorField &in, const QudaParity parity) const
   {
     checkParitySpinor(in, out);
-    ApplyClover(out, in, clover, false, parity);
+    if (checkLocation(out, in) == QUDA_CPU_FIELD_LOCATION && hostDslashSupported(in)) {
+      ApplyCloverHost(out, in, HostClover(in.Precision()), false, parity);
+    } else {
+      ApplyClover(out, in, clover, false, parity);
+    }
     flops += 504ll*in.Volume();
   }
 
   void DiracClover::M(ColorSpinorField &out, const ColorSpinorField &in) const
   {
+    if (hostDslashSupported(in) && hostDslashSupported(out)) {
+      // apply the operator on the host without staging to the device
+      checkFullSpinor(out, in);
+      DslashXpay(out.Odd(), in.Even(), QUDA_ODD_PARITY, in.Odd(), -kappa);
+      DslashXpay(out.Even(), in.Odd(), QUDA_EVEN_PARITY, in.Even(), -kappa);
+      return;
+    }
+
     ColorSpinorField *In = &const_cast<ColorSpinorField&>(in);
     if (in.Location() == QUDA_CPU_FIELD_LOCATION) {
       ColorSpinorParam param(in);
@@ -176,7 +209,11 @@ namespace quda {
 				const QudaParity parity) const
   {
     checkParitySpinor(in, out);
-    ApplyClover(out, in, clover, true, parity);
+    if (checkLocation(out, in) == QUDA_CPU_FIELD_LOCATION && hostDslashSupported(in)) {
+      ApplyCloverHost(out, in, HostClover(in.Precision()), true, parity);
+    } else {
+      ApplyClover(out, in, clover, true, parity);
+    }
     flops += 504ll*in.Volume();
   }
 
@@ -194,7 +231,7 @@ namespace quda {
       cloverDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge, cs, 
 		       &static_cast<const cudaColorSpinorField&>(in), parity, dagger, 0, 0.0, commDim, profile);
     } else {
-      errorQuda("Not supported");
+      cloverDslashHost(out, HostGauge(in.Precision()), HostClover(in.Precision()), in, parity, dagger, nullptr, 0.0);
     }
 
     flops += 1824ll*in.Volume();
@@ -214,7 +251,7 @@ namespace quda {
 		       &static_cast<const cudaColorSpinorField&>(in), parity, dagger, 
 		       &static_cast<const cudaColorSpinorField&>(x), k, commDim, profile);
     } else {
-      errorQuda("Not supported");
+      cloverDslashHost(out, HostGauge(in.Precision()), HostClover(in.Precision()), in, parity, dagger, &x, k);
     }
 
     flops += 1872ll*in.Volume();
@@ -43,7 +43,7 @@ namespace quda {
 			   &static_cast<const cudaColorSpinorField&>(in), 
 			   parity, dagger, 0, mass, 0, commDim, profile);   
     } else {
-      errorQuda("Not implemented");
+      domainWallDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, nullptr, mass, 0.0);
     }
 
     long long Ls = in.X(4);
@@ -67,7 +67,7 @@ namespace quda {
 			   &static_cast<const cudaColorSpinorField&>(x), 
 			   mass, k, commDim, profile);   
     } else {
-      errorQuda("Not implemented");
+      domainWallDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, &x, mass, k);
     }
 
     long long Ls = in.X(4);
@@ -43,9 +43,13 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
  
-    domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-			 &static_cast<const cudaColorSpinorField&>(in),
-			 parity, dagger, 0, mass, 0, 0, commDim, 0, profile);
+    if (checkLocation(out, in) == QUDA_CUDA_FIELD_LOCATION) {
+      domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+			   &static_cast<const cudaColorSpinorField&>(in),
+			   parity, dagger, 0, mass, 0, 0, commDim, 0, profile);
+    } else {
+      domainWall4DDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, nullptr, mass, 0.0, 0.0, 0);
+    }
 
     flops += 1320LL*(long long)in.Volume();
   }
@@ -57,9 +61,13 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
  
-    domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-			 &static_cast<const cudaColorSpinorField&>(in),
-			 parity, dagger, 0, mass, 0, 0, commDim, 1, profile);
+    if (checkLocation(out, in) == QUDA_CUDA_FIELD_LOCATION) {
+      domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+			   &static_cast<const cudaColorSpinorField&>(in),
+			   parity, dagger, 0, mass, 0, 0, commDim, 1, profile);
+    } else {
+      domainWall4DDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, nullptr, mass, 0.0, 0.0, 1);
+    }
 
     long long Ls = in.X(4);
     long long bulk = (Ls-2)*(in.Volume()/Ls);
@@ -76,9 +84,13 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
  
-    domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-			 &static_cast<const cudaColorSpinorField&>(in),
-			 parity, dagger, 0, mass, k, 0, commDim, 2, profile);
+    if (checkLocation(out, in) == QUDA_CUDA_FIELD_LOCATION) {
+      domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+			   &static_cast<const cudaColorSpinorField&>(in),
+			   parity, dagger, 0, mass, k, 0, commDim, 2, profile);
+    } else {
+      domainWall4DDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, nullptr, mass, k, 0.0, 2);
+    }
 
   
     long long Ls = in.X(4);
@@ -95,10 +107,14 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
 
-    domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-			 &static_cast<const cudaColorSpinorField&>(in),
-			 parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
-			 mass, k, 0, commDim, 0, profile);
+    if (checkLocation(out, in, x) == QUDA_CUDA_FIELD_LOCATION) {
+      domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+			   &static_cast<const cudaColorSpinorField&>(in),
+			   parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
+			   mass, k, 0, commDim, 0, profile);
+    } else {
+      domainWall4DDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, &x, mass, k, 0.0, 0);
+    }
 
     flops += (1320LL+48LL)*(long long)in.Volume();
   }
@@ -111,10 +127,14 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
 
-    domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-			 &static_cast<const cudaColorSpinorField&>(in),
-			 parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
-			 mass, k, 0, commDim, 1, profile);
+    if (checkLocation(out, in, x) == QUDA_CUDA_FIELD_LOCATION) {
+      domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+			   &static_cast<const cudaColorSpinorField&>(in),
+			   parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
+			   mass, k, 0, commDim, 1, profile);
+    } else {
+      domainWall4DDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, &x, mass, k, 0.0, 1);
+    }
 
     long long Ls = in.X(4);
     long long bulk = (Ls-2)*(in.Volume()/Ls);
@@ -131,10 +151,14 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
 
-    domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-			 &static_cast<const cudaColorSpinorField&>(in),
-			 parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
-			 mass, a, b, commDim, 2, profile);
+    if (checkLocation(out, in, x) == QUDA_CUDA_FIELD_LOCATION) {
+      domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+			   &static_cast<const cudaColorSpinorField&>(in),
+			   parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
+			   mass, a, b, commDim, 2, profile);
+    } else {
+      domainWall4DDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, &x, mass, a, b, 2);
+    }
 
     long long Ls = in.X(4);
     flops +=  (144LL*Ls + 48LL)*(long long)in.Volume() + 3LL*Ls*(Ls-1LL);
@@ -152,7 +176,27 @@ namespace quda {
     bool symmetric =(matpcType == QUDA_MATPC_EVEN_EVEN || matpcType == QUDA_MATPC_ODD_ODD) ? true : false;
     QudaParity parity[2] = {static_cast<QudaParity>((1 + odd_bit) % 2), static_cast<QudaParity>((0 + odd_bit) % 2)};
 
-    if (symmetric && !dagger) {
+    if (checkLocation(out, in) == QUDA_CPU_FIELD_LOCATION) {
+      // on the host each M5^-1 is fused with the Dslash4 it follows
+      const cpuGaugeField &gauge_h = HostGauge(in.Precision());
+      long long Ls = in.X(4);
+      long long fused = (1320LL + 144LL*Ls)*(long long)in.Volume() + 3LL*Ls*(Ls-1LL);
+      if (symmetric && !dagger) {
+	domainWall4DDslashHost(*tmp1, gauge_h, in, parity[0], dagger, nullptr, mass, kappa5, 0.0, 3);
+	domainWall4DDslashHost(out, gauge_h, *tmp1, parity[1], dagger, &in, mass, kappa5, -kappa2, 3);
+	flops += 2*fused + 48LL*(long long)in.Volume();
+      } else if (symmetric && dagger) {
+	Dslash5inv(out, in, parity[1], kappa5);
+	domainWall4DDslashHost(*tmp1, gauge_h, out, parity[0], dagger, nullptr, mass, kappa5, 0.0, 3);
+	flops += fused;
+	Dslash4Xpay(out, *tmp1, parity[1], in, -kappa2);
+      } else {
+	domainWall4DDslashHost(out, gauge_h, in, parity[0], dagger, nullptr, mass, kappa5, 0.0, 3);
+	flops += fused;
+	Dslash4Xpay(*tmp1, out, parity[1], in, -kappa2);
+	Dslash5Xpay(out, in, parity[1], *tmp1, -kappa5);
+      }
+    } else if (symmetric && !dagger) {
       // 1 - k^2 M5^-1 D4 M5^-1 D4
       Dslash4(*tmp1, in, parity[0]);
       Dslash5inv(out, *tmp1, parity[0], kappa5);
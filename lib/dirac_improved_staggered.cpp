@@ -1,5 +1,6 @@
 #include <dirac_quda.h>
 #include <blas_quda.h>
+#include <dslash_quda.h>
 
 namespace quda {
 
@@ -8,7 +9,7 @@ namespace quda {
   }
 
   DiracImprovedStaggered::DiracImprovedStaggered(const DiracParam &param) : 
-    Dirac(param), fatGauge(*(param.fatGauge)), longGauge(*(param.longGauge))
+    Dirac(param), fatGauge(*(param.fatGauge)), longGauge(*(param.longGauge)), fat_h(nullptr), long_h(nullptr), fat_h_version(0), long_h_version(0)
     //FIXME: this may break mixed precision multishift solver since may not have fatGauge initializeed yet
   {
     improvedstaggered::initConstants(*param.gauge, profile);    
@@ -16,13 +17,17 @@ namespace quda {
   }
 
   DiracImprovedStaggered::DiracImprovedStaggered(const DiracImprovedStaggered &dirac) 
-  : Dirac(dirac), fatGauge(dirac.fatGauge), longGauge(dirac.longGauge)
+  : Dirac(dirac), fatGauge(dirac.fatGauge), longGauge(dirac.longGauge), fat_h(nullptr), long_h(nullptr), fat_h_version(0), long_h_version(0)
   {
     improvedstaggered::initConstants(*dirac.gauge, profile);
     improvedstaggered::initStaggeredConstants(fatGauge, longGauge, profile);
   }
 
-  DiracImprovedStaggered::~DiracImprovedStaggered() { }
+  DiracImprovedStaggered::~DiracImprovedStaggered()
+  {
+    if (fat_h) delete fat_h;
+    if (long_h) delete long_h;
+  }
 
   DiracImprovedStaggered& DiracImprovedStaggered::operator=(const DiracImprovedStaggered &dirac)
   {
@@ -30,10 +35,34 @@ namespace quda {
       Dirac::operator=(dirac);
       fatGauge = dirac.fatGauge;
       longGauge = dirac.longGauge;
+      if (fat_h) delete fat_h;
+      if (long_h) delete long_h;
+      fat_h = nullptr;
+      long_h = nullptr;
     }
     return *this;
   }
 
+  const cpuGaugeField& DiracImprovedStaggered::HostFatGauge(QudaPrecision precision) const
+  {
+    if (fat_h && fat_h->Precision() == precision && fat_h_version == fatGauge.Version()) return *fat_h;
+    if (fat_h) delete fat_h;
+
+    fat_h = createHostGauge(fatGauge, precision);
+    fat_h_version = fatGauge.Version();
+    return *fat_h;
+  }
+
+  const cpuGaugeField& DiracImprovedStaggered::HostLongGauge(QudaPrecision precision) const
+  {
+    if (long_h && long_h->Precision() == precision && long_h_version == longGauge.Version()) return *long_h;
+    if (long_h) delete long_h;
+
+    long_h = createHostGauge(longGauge, precision);
+    long_h_version = longGauge.Version();
+    return *long_h;
+  }
+
   void DiracImprovedStaggered::checkParitySpinor(const ColorSpinorField &in, const ColorSpinorField &out) const
   {
     if (in.Ndim() != 5 || out.Ndim() != 5) {
@@ -70,8 +99,9 @@ namespace quda {
 				  &static_cast<const cudaColorSpinorField&>(in), parity, 
 				  dagger, 0, 0, commDim, profile);
     } else {
-      errorQuda("Not supported");
-    }  
+      improvedStaggeredDslashHost(out, HostFatGauge(in.Precision()), HostLongGauge(in.Precision()),
+				  in, parity, dagger, nullptr, 0.0);
+    }
 
     flops += 1146ll*in.Volume();
   }
@@ -87,8 +117,9 @@ namespace quda {
 			  &static_cast<const cudaColorSpinorField&>(in), parity, dagger, 
 			  &static_cast<const cudaColorSpinorField&>(x), k, commDim, profile);
     } else {
-      errorQuda("Not supported");
-    }  
+      improvedStaggeredDslashHost(out, HostFatGauge(in.Precision()), HostLongGauge(in.Precision()),
+				  in, parity, dagger, &x, k);
+    }
 
     flops += 1158ll*in.Volume();
   }
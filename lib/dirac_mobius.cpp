@@ -41,11 +41,14 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
  
-    mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
-
-    MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-		   &static_cast<const cudaColorSpinorField&>(in),
-		   parity, dagger, 0, mass, 0, commDim, 0, profile);   
+    if (checkLocation(out, in) == QUDA_CUDA_FIELD_LOCATION) {
+      mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
+      MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+		     &static_cast<const cudaColorSpinorField&>(in),
+		     parity, dagger, 0, mass, 0, commDim, 0, profile);
+    } else {
+      MDWFDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, nullptr, mass, m5, b_5, c_5, 0.0, 0);
+    }
 
     flops += 1320LL*(long long)in.Volume();
   }
@@ -56,11 +59,14 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
  
-    mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
-
-    MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-		   &static_cast<const cudaColorSpinorField&>(in),
-		   parity, dagger, 0, mass, 0, commDim, 1, profile);   
+    if (checkLocation(out, in) == QUDA_CUDA_FIELD_LOCATION) {
+      mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
+      MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+		     &static_cast<const cudaColorSpinorField&>(in),
+		     parity, dagger, 0, mass, 0, commDim, 1, profile);
+    } else {
+      MDWFDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, nullptr, mass, m5, b_5, c_5, 0.0, 1);
+    }
 
     long long Ls = in.X(4);
     long long bulk = (Ls-2)*(in.Volume()/Ls);
@@ -74,11 +80,14 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
  
-    mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
-    
-    MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-		   &static_cast<const cudaColorSpinorField&>(in),
-		   parity, dagger, 0, mass, 0, commDim, 2, profile);   
+    if (checkLocation(out, in) == QUDA_CUDA_FIELD_LOCATION) {
+      mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
+      MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+		     &static_cast<const cudaColorSpinorField&>(in),
+		     parity, dagger, 0, mass, 0, commDim, 2, profile);
+    } else {
+      MDWFDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, nullptr, mass, m5, b_5, c_5, 0.0, 2);
+    }
 
     long long Ls = in.X(4);
     long long bulk = (Ls-2)*(in.Volume()/Ls);
@@ -95,12 +104,15 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
 
-    mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
-
-    MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-		   &static_cast<const cudaColorSpinorField&>(in),
-		   parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
-		   mass, k, commDim, 0, profile);
+    if (checkLocation(out, in, x) == QUDA_CUDA_FIELD_LOCATION) {
+      mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
+      MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+		     &static_cast<const cudaColorSpinorField&>(in),
+		     parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
+		     mass, k, commDim, 0, profile);
+    } else {
+      MDWFDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, &x, mass, m5, b_5, c_5, k, 0);
+    }
 
     flops += (1320LL+48LL)*(long long)in.Volume();
   }
@@ -113,12 +125,15 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
 
-    mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
-
-    MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-		   &static_cast<const cudaColorSpinorField&>(in),
-		   parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
-		   mass, k, commDim, 1, profile);
+    if (checkLocation(out, in, x) == QUDA_CUDA_FIELD_LOCATION) {
+      mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
+      MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+		     &static_cast<const cudaColorSpinorField&>(in),
+		     parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
+		     mass, k, commDim, 1, profile);
+    } else {
+      MDWFDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, &x, mass, m5, b_5, c_5, k, 1);
+    }
 
     long long Ls = in.X(4);
     long long bulk = (Ls-2)*(in.Volume()/Ls);
@@ -134,12 +149,15 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
 
-    mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
-
-    MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-		   &static_cast<const cudaColorSpinorField&>(in),
-		   parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
-		   mass, k, commDim, 2, profile);
+    if (checkLocation(out, in, x) == QUDA_CUDA_FIELD_LOCATION) {
+      mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
+      MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+		     &static_cast<const cudaColorSpinorField&>(in),
+		     parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
+		     mass, k, commDim, 2, profile);
+    } else {
+      MDWFDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, &x, mass, m5, b_5, c_5, k, 2);
+    }
 
     long long Ls = in.X(4);
     long long bulk = (Ls-2)*(in.Volume()/Ls);
@@ -223,11 +241,14 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
 
-    mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
-
-    MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-		   &static_cast<const cudaColorSpinorField&>(in),
-		   parity, dagger, 0, mass, 0, commDim, 3, profile);
+    if (checkLocation(out, in) == QUDA_CUDA_FIELD_LOCATION) {
+      mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
+      MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+		     &static_cast<const cudaColorSpinorField&>(in),
+		     parity, dagger, 0, mass, 0, commDim, 3, profile);
+    } else {
+      MDWFDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, nullptr, mass, m5, b_5, c_5, 0.0, 3);
+    }
 
     long long Ls = in.X(4);
     flops += 144LL*(long long)in.Volume()*Ls + 3LL*Ls*(Ls-1LL);
@@ -242,12 +263,15 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
 
-    mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
-
-    MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-		   &static_cast<const cudaColorSpinorField&>(in),
-		   parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
-		   mass, k, commDim, 3, profile);
+    if (checkLocation(out, in, x) == QUDA_CUDA_FIELD_LOCATION) {
+      mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
+      MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+		     &static_cast<const cudaColorSpinorField&>(in),
+		     parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
+		     mass, k, commDim, 3, profile);
+    } else {
+      MDWFDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, &x, mass, m5, b_5, c_5, k, 3);
+    }
 
     long long Ls = in.X(4);
     flops +=  (144LL*Ls + 48LL)*(long long)in.Volume() + 3LL*Ls*(Ls-1LL);
@@ -267,7 +291,26 @@ namespace quda {
 
     //QUDA_MATPC_EVEN_EVEN_ASYMMETRIC : M5 - kappa_b^2 * D4_{eo}D4pre_{oe}D5inv_{ee}D4_{eo}D4pre_{oe}
     //QUDA_MATPC_ODD_ODD_ASYMMETRIC : M5 - kappa_b^2 * D4_{oe}D4pre_{eo}D5inv_{oo}D4_{oe}D4pre_{eo}
-    if (symmetric && !dagger) {
+    if (checkLocation(out, in) == QUDA_CPU_FIELD_LOCATION && !dagger) {
+      // on the host each M5^-1, and the Dslash4pre after it, is fused with the Dslash4 it follows
+      const cpuGaugeField &gauge_h = HostGauge(in.Precision());
+      long long Ls = in.X(4);
+      long long bulk = (Ls-2)*(in.Volume()/Ls);
+      long long wall = 2*in.Volume()/Ls;
+      long long fused = (1320LL + 144LL*Ls)*(long long)in.Volume() + 3LL*Ls*(Ls-1LL);
+      if (symmetric) {
+	Dslash4pre(out, in, parity[1]);
+	MDWFDslashHost(*tmp1, gauge_h, out, parity[0], dagger, nullptr, mass, m5, b_5, c_5, 0.0, 5);
+	MDWFDslashHost(out, gauge_h, *tmp1, parity[1], dagger, &in, mass, m5, b_5, c_5, -1.0, 4);
+	flops += 2*fused + (72LL+48LL)*(long long)in.Volume() + 96LL*bulk + 120LL*wall;
+      } else {
+	Dslash4pre(*tmp1, in, parity[1]);
+	MDWFDslashHost(out, gauge_h, *tmp1, parity[0], dagger, nullptr, mass, m5, b_5, c_5, 0.0, 5);
+	flops += fused + 72LL*(long long)in.Volume() + 96LL*bulk + 120LL*wall;
+	Dslash4(*tmp1, out, parity[1]);
+	Dslash5Xpay(out, in, parity[1], *tmp1, -1.0);
+      }
+    } else if (symmetric && !dagger) {
       Dslash4pre(*tmp1, in, parity[1]);
       Dslash4(out, *tmp1, parity[0]);
       Dslash5inv(*tmp1, out, parity[0]);
@@ -9,32 +9,46 @@ namespace quda {
 #include <dslash_init.cuh>
   }
 
-  DiracWilson::DiracWilson(const DiracParam &param) : Dirac(param)
+  DiracWilson::DiracWilson(const DiracParam &param) : Dirac(param), gauge_h(nullptr), gauge_h_src(nullptr), gauge_h_version(0)
     { 
       wilson::initConstants(*param.gauge, profile);
     }
 
-  DiracWilson::DiracWilson(const DiracWilson &dirac) : Dirac(dirac)
+  DiracWilson::DiracWilson(const DiracWilson &dirac) : Dirac(dirac), gauge_h(nullptr), gauge_h_src(nullptr), gauge_h_version(0)
     { 
       wilson::initConstants(*dirac.gauge, profile);
     }
 
-  DiracWilson::DiracWilson(const DiracParam &param, const int nDims) : Dirac(param)
+  DiracWilson::DiracWilson(const DiracParam &param, const int nDims) : Dirac(param), gauge_h(nullptr), gauge_h_src(nullptr), gauge_h_version(0)
   { 
     wilson::initConstants(*param.gauge, profile);
     
   }//temporal hack (for DW and TM operators) 
 
-  DiracWilson::~DiracWilson() { }
+  DiracWilson::~DiracWilson() { if (gauge_h) delete gauge_h; }
 
   DiracWilson& DiracWilson::operator=(const DiracWilson &dirac)
   {
     if (&dirac != this) {
       Dirac::operator=(dirac);
+      if (gauge_h) delete gauge_h;
+      gauge_h = nullptr;
     }
     return *this;
   }
 
+  const cpuGaugeField& DiracWilson::HostGauge(QudaPrecision precision) const
+  {
+    if (gauge_h && gauge_h->Precision() == precision && gauge_h_src == gauge && gauge_h_version == gauge->Version())
+      return *gauge_h;
+    if (gauge_h) delete gauge_h;
+
+    gauge_h = createHostGauge(*gauge, precision);
+    gauge_h_src = gauge;
+    gauge_h_version = gauge->Version();
+    return *gauge_h;
+  }
+
   void DiracWilson::Dslash(ColorSpinorField &out, const ColorSpinorField &in, 
 			   const QudaParity parity) const
   {
@@ -45,7 +59,7 @@ namespace quda {
       wilsonDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge, 
 		       &static_cast<const cudaColorSpinorField&>(in), parity, dagger, 0, 0.0, commDim, profile);
     } else {
-      errorQuda("Not supported");
+      wilsonDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, nullptr, 0.0);
     }
 
     flops += 1320ll*in.Volume();
@@ -63,7 +77,7 @@ namespace quda {
 		       &static_cast<const cudaColorSpinorField&>(in), parity, dagger, 
 		       &static_cast<const cudaColorSpinorField&>(x), k, commDim, profile);
     } else {
-      errorQuda("Not supported");
+      wilsonDslashHost(out, HostGauge(in.Precision()), in, parity, dagger, &x, k);
     }
 
     flops += 1368ll*in.Volume();
@@ -71,6 +85,14 @@ namespace quda {
 
   void DiracWilson::M(ColorSpinorField &out, const ColorSpinorField &in) const
   {
+    if (hostDslashSupported(in) && hostDslashSupported(out)) {
+      // apply the operator on the host without staging to the device
+      checkFullSpinor(out, in);
+      DslashXpay(out.Odd(), in.Even(), QUDA_ODD_PARITY, in.Odd(), -kappa);
+      DslashXpay(out.Even(), in.Odd(), QUDA_EVEN_PARITY, in.Even(), -kappa);
+      return;
+    }
+
     ColorSpinorField *In = &const_cast<ColorSpinorField&>(in);
     if (in.Location() == QUDA_CPU_FIELD_LOCATION) {
       ColorSpinorParam param(in);
@@ -2,6 +2,7 @@
 #include <gauge_field_order.h>
 #include <color_spinor_field_order.h>
 #include <index_helper.cuh>
+#include <thread_pool.h>
 #if __COMPUTE_CAPABILITY__ >= 300
 #include <generics/shfl.h>
 #endif
@@ -16,13 +17,19 @@ namespace quda {
     DSLASH_FULL
   };
 
-  template <typename Float, int coarseSpin, int coarseColor, QudaFieldOrder csOrder, QudaGaugeFieldOrder gOrder>
+  /**
+     @tparam ghostFloat Storage type of the ghost zone of inA, which
+     differs from Float if the halo is block-float compressed
+  */
+  template <typename Float, int coarseSpin, int coarseColor, QudaFieldOrder csOrder, QudaGaugeFieldOrder gOrder,
+	    typename ghostFloat=Float>
   struct DslashCoarseArg {
     typedef typename colorspinor::FieldOrderCB<Float,coarseSpin,coarseColor,1,csOrder> F;
+    typedef typename colorspinor::FieldOrderCB<Float,coarseSpin,coarseColor,1,csOrder,ghostFloat> FG;
     typedef typename gauge::FieldOrder<Float,coarseColor*coarseSpin,coarseSpin,gOrder> G;
 
     F out;
-    const F inA;
+    const FG inA;
     const F inB;
     const G Y;
     const G X;
@@ -361,9 +368,22 @@ namespace quda {
     }
   }
 
+  /**
+     @brief Helper function to determine if a site touches the halo
+     of a partitioned dimension, and so has an exterior contribution
+   */
+  template <typename Arg>
+  static inline bool isHaloSite(const Arg &arg, int x_cb, int parity) {
+    int coord[4];
+    getCoordsCB(coord, x_cb, arg.dim, arg.X0h, parity);
+    for (int d=0; d<4; d++)
+      if (arg.commDim[d] && (coord[d] < arg.nFace || coord[d] >= arg.dim[d] - arg.nFace)) return true;
+    return false;
+  }
+
   // CPU kernel for applying the coarse Dslash to a vector
   template <typename Float, int nDim, int Ns, int Nc, int Mc, bool dslash, bool clover, bool dagger, DslashType type, typename Arg>
-  void coarseDslash(Arg arg)
+  void coarseDslash(Arg &arg, const std::function<void()> &progress)
   {
     // the fine-grain parameters mean nothing for CPU variant
     const int color_stride = 1;
@@ -372,22 +392,25 @@ namespace quda {
     const int dir = 0;
     const int dim = 0;
 
-    for (int parity= 0; parity < arg.nParity; parity++) {
-      // for full fields then set parity from loop else use arg setting
-      parity = (arg.nParity == 2) ? parity : arg.parity;
+    // sites are distributed over the host threads with parity and source index outermost
+    auto kernel = [&](int begin, int end) {
+      for (int i=begin; i<end; i++) {
+	int x_cb = i % arg.volumeCB;
+	int src_idx = (i / arg.volumeCB) % arg.dim[4];
+	// for full fields then set parity from loop else use arg setting
+	int parity = (arg.nParity == 2) ? i / (arg.volumeCB * arg.dim[4]) : arg.parity;
 
-      for (int src_idx = 0; src_idx < arg.dim[4]; src_idx++) {
-	//#pragma omp parallel for
-	for(int x_cb = 0; x_cb < arg.volumeCB; x_cb++) { // 4-d volume
-	  for (int s=0; s<2; s++) {
-	    for (int color_block=0; color_block<Nc; color_block+=Mc) { // Mc=Nc means all colors in a thread
-	      coarseDslash<Float,nDim,Ns,Nc,Mc,color_stride,dim_thread_split,dslash,clover,dagger,type,dir,dim>(arg, x_cb, src_idx, parity, s, color_block, color_offset);
-	    }
+	if (type == DSLASH_EXTERIOR && !isHaloSite(arg, x_cb, parity)) continue;
+
+	for (int s=0; s<2; s++) {
+	  for (int color_block=0; color_block<Nc; color_block+=Mc) { // Mc=Nc means all colors in a thread
+	    coarseDslash<Float,nDim,Ns,Nc,Mc,color_stride,dim_thread_split,dslash,clover,dagger,type,dir,dim>(arg, x_cb, src_idx, parity, s, color_block, color_offset);
 	  }
-	} // 4-d volumeCB
-      } // src index
-    } // parity
+	}
+      }
+    };
 
+    host::parallel_for(arg.nParity * arg.dim[4] * arg.volumeCB, kernel, progress);
   }
 
   // GPU Kernel for applying the coarse Dslash to a vector
@@ -651,6 +674,17 @@ namespace quda {
     }
     virtual ~DslashCoarse() { }
 
+    template <typename ghostFloat> inline void applyHost() {
+      DslashCoarseArg<Float,Ns,Nc,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,QUDA_QDP_GAUGE_ORDER,ghostFloat>
+	arg(out, inA, inB, Y, X, (Float)kappa, parity);
+
+      // progress the halo exchange while the interior is computed
+      std::function<void()> progress = nullptr;
+      if (type == DSLASH_INTERIOR) progress = [&]() { static_cast<const cpuColorSpinorField&>(inA).exchangeGhostQuery(); };
+
+      coarseDslash<Float,nDim,Ns,Nc,Mc,dslash,clover,dagger,type>(arg, progress);
+    }
+
     inline void apply(const cudaStream_t &stream) {
 
       if (out.Location() == QUDA_CPU_FIELD_LOCATION) {
@@ -658,10 +692,18 @@ namespace quda {
 	if (out.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER || Y.FieldOrder() != QUDA_QDP_GAUGE_ORDER)
 	  errorQuda("Unsupported field order colorspinor=%d gauge=%d combination\n", inA.FieldOrder(), Y.FieldOrder());
 
-	DslashCoarseArg<Float,Ns,Nc,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER,QUDA_QDP_GAUGE_ORDER> arg(out, inA, inB, Y, X, (Float)kappa, parity);
-	coarseDslash<Float,nDim,Ns,Nc,Mc,dslash,clover,dagger,type>(arg);
+	// only the halo is read in the compressed format
+	if (doHalo<type>() && inA.GhostCompression() == QUDA_GHOST_COMPRESSION_BLOCK_FLOAT_16) {
+	  applyHost<short>();
+	} else if (doHalo<type>() && inA.GhostCompression() == QUDA_GHOST_COMPRESSION_BLOCK_FLOAT_8) {
+	  applyHost<signed char>();
+	} else if (inA.GhostCompression() == QUDA_GHOST_COMPRESSION_NONE || !doHalo<type>()) {
+	  applyHost<Float>();
+	} else {
+	  errorQuda("Unsupported ghost compression %d", inA.GhostCompression());
+	}
       } else {
-
+#ifndef QUDA_HOST_ONLY
         const TuneParam &tp = tuneLaunch(*this, getTuning(), QUDA_VERBOSE /*getVerbosity()*/);
 
 	if (out.FieldOrder() != QUDA_FLOAT2_FIELD_ORDER || Y.FieldOrder() != QUDA_FLOAT2_GAUGE_ORDER)
@@ -733,6 +775,9 @@ namespace quda {
 	default:
 	  errorQuda("Invalid dimension thread splitting %d", tp.aux.y);
 	}
+#else
+	errorQuda("GPU fields are not supported in a host-only build");
+#endif
       }
     }
 
@@ -754,6 +799,34 @@ namespace quda {
   };
 
 
+  template <typename Float, int nDim, int coarseSpin, int coarseColor, int colors_per_thread, bool dslash, bool clover, bool dagger>
+  inline void ApplyCoarse(ColorSpinorField &out, const ColorSpinorField &inA, const ColorSpinorField &inB,
+			  const GaugeField &Y, const GaugeField &X, double kappa, int parity, DslashType type,
+			  MemoryLocation *halo_location) {
+    switch (type) {
+    case DSLASH_FULL:
+      {
+	DslashCoarse<Float,nDim,coarseSpin,coarseColor,colors_per_thread,dslash,clover,dagger,DSLASH_FULL> op(out, inA, inB, Y, X, kappa, parity, halo_location);
+	op.apply(0);
+	break;
+      }
+    case DSLASH_INTERIOR:
+      {
+	DslashCoarse<Float,nDim,coarseSpin,coarseColor,colors_per_thread,dslash,clover,dagger,DSLASH_INTERIOR> op(out, inA, inB, Y, X, kappa, parity, halo_location);
+	op.apply(0);
+	break;
+      }
+    case DSLASH_EXTERIOR:
+      {
+	DslashCoarse<Float,nDim,coarseSpin,coarseColor,colors_per_thread,dslash,clover,dagger,DSLASH_EXTERIOR> op(out, inA, inB, Y, X, kappa, parity, halo_location);
+	op.apply(0);
+	break;
+      }
+    default:
+      errorQuda("Dslash type %d not instantiated", type);
+    }
+  }
+
   template <typename Float, int coarseColor, int coarseSpin>
   inline void ApplyCoarse(ColorSpinorField &out, const ColorSpinorField &inA, const ColorSpinorField &inB,
 			  const GaugeField &Y, const GaugeField &X, double kappa, int parity, bool dslash,
@@ -765,15 +838,9 @@ namespace quda {
     if (dagger) {
       if (dslash) {
 	if (clover) {
-	  if (type == DSLASH_FULL) {
-	    DslashCoarse<Float,nDim,coarseSpin,coarseColor,colors_per_thread,true,true,true,DSLASH_FULL> dslash(out, inA, inB, Y, X, kappa, parity, halo_location);
-	    dslash.apply(0);
-	  } else { errorQuda("Dslash type %d not instantiated", type); }
+	  ApplyCoarse<Float,nDim,coarseSpin,coarseColor,colors_per_thread,true,true,true>(out, inA, inB, Y, X, kappa, parity, type, halo_location);
 	} else {
-	  if (type == DSLASH_FULL) {
-	    DslashCoarse<Float,nDim,coarseSpin,coarseColor,colors_per_thread,true,false,true,DSLASH_FULL> dslash(out, inA, inB, Y, X, kappa, parity, halo_location);
-	    dslash.apply(0);
-	  } else { errorQuda("Dslash type %d not instantiated", type); }
+	  ApplyCoarse<Float,nDim,coarseSpin,coarseColor,colors_per_thread,true,false,true>(out, inA, inB, Y, X, kappa, parity, type, halo_location);
 	}
       } else {
 	if (type == DSLASH_EXTERIOR) errorQuda("Cannot call halo on pure clover kernel");
@@ -787,15 +854,9 @@ namespace quda {
     } else {
       if (dslash) {
 	if (clover) {
-	  if (type == DSLASH_FULL) {
-	    DslashCoarse<Float,nDim,coarseSpin,coarseColor,colors_per_thread,true,true,false,DSLASH_FULL> dslash(out, inA, inB, Y, X, kappa, parity, halo_location);
-	    dslash.apply(0);
-	  } else { errorQuda("Dslash type %d not instantiated", type); }
+	  ApplyCoarse<Float,nDim,coarseSpin,coarseColor,colors_per_thread,true,true,false>(out, inA, inB, Y, X, kappa, parity, type, halo_location);
 	} else {
-	  if (type == DSLASH_FULL) {
-	    DslashCoarse<Float,nDim,coarseSpin,coarseColor,colors_per_thread,true,false,false,DSLASH_FULL> dslash(out, inA, inB, Y, X, kappa, parity, halo_location);
-	    dslash.apply(0);
-	  } else { errorQuda("Dslash type %d not instantiated", type); }
+	  ApplyCoarse<Float,nDim,coarseSpin,coarseColor,colors_per_thread,true,false,false>(out, inA, inB, Y, X, kappa, parity, type, halo_location);
 	}
       } else {
 	if (type == DSLASH_EXTERIOR) errorQuda("Cannot call halo on pure clover kernel");
@@ -914,7 +975,17 @@ namespace quda {
       bool gdr_recv = (policy == DSLASH_COARSE_GDR_RECV || policy == DSLASH_COARSE_GDR ||
 		       policy == DSLASH_COARSE_ZERO_COPY_PACK_GDR_RECV) ? true : false;
 
-      if (dslash && comm_partitioned()) {
+      const bool comms = dslash && comm_partitioned();
+
+      // on the host the halo exchange is overlapped with the interior
+      // computation and the boundary sites are finished once it completes
+      const bool overlap = comms && out.Location() == QUDA_CPU_FIELD_LOCATION;
+      const cpuColorSpinorField *in_h = overlap ? static_cast<const cpuColorSpinorField*>(&inA) : nullptr;
+
+      if (overlap) {
+	const int nFace = 1;
+	in_h->exchangeGhostStart((QudaParity)(1-parity), nFace, dagger);
+      } else if (comms) {
 	const int nFace = 1;
 	inA.exchangeGhost((QudaParity)(1-parity), nFace, dagger, pack_destination, halo_location, gdr_send, gdr_recv);
       }
@@ -923,14 +994,20 @@ namespace quda {
 
       if (precision == QUDA_DOUBLE_PRECISION) {
 #ifdef GPU_MULTIGRID_DOUBLE
-	ApplyCoarse<double>(out, inA, inB, Y, X, kappa, parity, dslash, clover, dagger, DSLASH_FULL, halo_location);
-	//if (dslash && comm_partitioned()) ApplyCoarse<double>(out, inA, inB, Y, X, kappa, parity, dslash, clover, dagger, true, halo_location);
+	ApplyCoarse<double>(out, inA, inB, Y, X, kappa, parity, dslash, clover, dagger, overlap ? DSLASH_INTERIOR : DSLASH_FULL, halo_location);
+	if (overlap) {
+	  in_h->exchangeGhostWait();
+	  ApplyCoarse<double>(out, inA, inB, Y, X, kappa, parity, dslash, clover, dagger, DSLASH_EXTERIOR, halo_location);
+	}
 #else
 	errorQuda("Double precision multigrid has not been enabled");
 #endif
       } else if (precision == QUDA_SINGLE_PRECISION) {
-	ApplyCoarse<float>(out, inA, inB, Y, X, kappa, parity, dslash, clover, dagger, DSLASH_FULL, halo_location);
-	//if (dslash && comm_partitioned()) ApplyCoarse<float>(out, inA, inB, Y, X, kappa, parity, dslash, clover, dagger, true, halo_location);
+	ApplyCoarse<float>(out, inA, inB, Y, X, kappa, parity, dslash, clover, dagger, overlap ? DSLASH_INTERIOR : DSLASH_FULL, halo_location);
+	if (overlap) {
+	  in_h->exchangeGhostWait();
+	  ApplyCoarse<float>(out, inA, inB, Y, X, kappa, parity, dslash, clover, dagger, DSLASH_EXTERIOR, halo_location);
+	}
       } else {
 	errorQuda("Unsupported precision %d\n", Y.Precision());
       }
@@ -0,0 +1,533 @@
+// Host domain-wall and Mobius Dslash for single-parity 5-d fields in
+// space-spin-color order, with 5-d or 4-d even-odd preconditioning.
+
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+#include <dslash_quda.h>
+#include <neighbor_table.h>
+#include <spin_projector_host.h>
+#include <thread_pool.h>
+
+namespace quda {
+
+  /**
+     Precision-independent description of a host domain-wall operator
+     out_s = alpha_s y_s + beta_s x_s, where y is in, or its 4-d
+     hopping term, followed by the fifth-dimension operators in ops
+  */
+  struct DomainWallHostOp {
+    struct FifthDimOp {
+      bool inverse;
+      std::vector<double> a, b; // hop: y_s <- a_s (D5 y)_s + b_s y_s
+      std::vector<double> kappa; // inverse: y <- M5^{-1} y, where M5 = 1 - kappa_s D5 / 2
+    };
+
+    bool pc5d; // slice s of a parity p field holds the 4-d sites of parity (p+s)%2
+    bool hop4; // start from the 4-d hopping term of in, else from in
+    bool hop5; // add the fifth-dimension hopping term of in, for the 5-d preconditioned Dslash
+    std::vector<FifthDimOp> ops;
+    std::vector<double> alpha, beta;
+
+    DomainWallHostOp(int Ls) : pc5d(false), hop4(false), hop5(false), alpha(Ls, 1.0), beta(Ls, 0.0) { }
+
+    void addHop(const std::vector<double> &a, const std::vector<double> &b) {
+      FifthDimOp op;
+      op.inverse = false;
+      op.a = a;
+      op.b = b;
+      ops.push_back(op);
+    }
+
+    void addInverse(const std::vector<double> &kappa) {
+      FifthDimOp op;
+      op.inverse = true;
+      op.kappa = kappa;
+      ops.push_back(op);
+    }
+  };
+
+  /**
+     The fifth-dimension hop D5 takes the upper (spins 0 and 1) and the
+     lower (spins 2 and 3) chiralities from opposite neighbors, each
+     with a factor of two from the projector, and a factor of -mferm
+     across the walls.  @return The offset of the neighbor slice of
+     chirality chi
+   */
+  static inline int fifthDimHop(int chi, int dagger) { return (chi == 0) == (dagger == 0) ? -1 : 1; }
+
+  template <typename Float>
+  struct DomainWallHostArg {
+    struct FifthDimOp {
+      bool inverse;
+      std::vector<Float> a, b;
+      std::vector<Float> m[2]; // M5^{-1} of each chirality, m[chi][t*Ls + s] couples slice t to slice s
+    };
+
+    Float *out;
+    const Float *in;
+    const Float *x;
+    const Float *U[4];      // links [(parity*volumeCB + x_cb)*18] for each dimension
+    const Float *Ughost[4]; // backward links from the neighboring rank
+    int ghostFace;          // depth of the link halo
+    const Float *ghost[8];  // spinor halo, [2*mu+0] backwards, [2*mu+1] forwards
+    const host::NeighborTable *table;
+    int parity;
+    int dagger;
+    bool pc5d;
+    bool hop4;
+    bool hop5;
+    std::vector<FifthDimOp> ops;
+    std::vector<Float> alpha, beta;
+    Float mferm;
+    int volumeCB; // 4-d
+    int Ls;
+
+    DomainWallHostArg(const DomainWallHostOp &op, Float *out, const Float *in, const Float *x,
+		      int volumeCB, int Ls, int parity, int dagger, double mferm) :
+      out(out), in(in), x(x), ghostFace(0), table(nullptr),
+      parity(parity), dagger(dagger), pc5d(op.pc5d), hop4(op.hop4), hop5(op.hop5),
+      alpha(op.alpha.begin(), op.alpha.end()), beta(op.beta.begin(), op.beta.end()),
+      mferm(mferm), volumeCB(volumeCB), Ls(Ls)
+    {
+      for (int i=0; i<4; i++) { U[i] = nullptr; Ughost[i] = nullptr; }
+      for (int i=0; i<8; i++) ghost[i] = nullptr;
+
+      for (const auto &o : op.ops) {
+	FifthDimOp f;
+	f.inverse = o.inverse;
+	f.a.assign(o.a.begin(), o.a.end());
+	f.b.assign(o.b.begin(), o.b.end());
+	if (o.inverse) {
+	  // closed form of the inverse of 1 - kappa_s P S, where the shift S has S^Ls = -mferm
+	  for (int chi=0; chi<2; chi++) {
+	    const int hop = fifthDimHop(chi, dagger);
+	    f.m[chi].resize(Ls*Ls);
+	    for (int s=0; s<Ls; s++) {
+	      const double norm = 1.0 / (1.0 + pow(o.kappa[s], Ls) * mferm);
+	      for (int t=0; t<Ls; t++) {
+		const int e = hop < 0 ? (s - t + Ls) % Ls : (t - s + Ls) % Ls;
+		const bool wall = hop < 0 ? t > s : t < s;
+		f.m[chi][t*Ls + s] = norm * pow(o.kappa[s], e) * (wall ? -mferm : 1.0);
+	      }
+	    }
+	  }
+	}
+	ops.push_back(f);
+      }
+    }
+  };
+
+  /**
+     Compute the 4-d hopping term of the n slices s0, s0+ds, ... of
+     the 4-d site x_cb of parity q
+   */
+  template <typename Float, int L>
+  static inline void dslash4(Float y[24][L], const DomainWallHostArg<Float> &arg, int q, int x_cb,
+			     int s0, int ds, int n)
+  {
+    const host::NeighborTable &table = *arg.table;
+    const int *nbr = table.nbr[q].data();
+    const int V = arg.volumeCB;
+
+    for (int i=0; i<24; i++) for (int l=0; l<n; l++) y[i][l] = 0.0;
+
+    for (int d=0; d<8; d++) {
+      const int mu = d / 2;
+      const bool forwards = (d % 2 == 0);
+      const host::HalfProjector &P = host::halfProjector(2*mu + (d + arg.dagger) % 2);
+      const int fv = table.faceVolumeCB[mu];
+
+      const int j = nbr[x_cb*8 + d];
+      const Float *base;
+      int stride; // between slices
+      const Float *link;
+      if (j >= 0) {
+	base = arg.in + j*24;
+	stride = V*24;
+	link = forwards ? arg.U[mu] + (q*V + x_cb)*18 : arg.U[mu] + ((1-q)*V + j)*18;
+      } else {
+	// each slice has its own layer of the halo, and the link halo holds the layers nearest the face
+	const int i = -j-1;
+	const int g = arg.ghostFace;
+	base = arg.ghost[2*mu + (forwards ? 1 : 0)] + i*24;
+	stride = fv*24;
+	link = forwards ? arg.U[mu] + (q*V + x_cb)*18 :
+	  arg.Ughost[mu] + ((1-q)*g*fv + i - (1-g)*fv)*18;
+      }
+
+      // the link is shared by all the slices: U for forwards hops, U^dagger for backwards hops
+      Float u_re[3][3], u_im[3][3];
+      for (int a=0; a<3; a++) {
+	for (int b=0; b<3; b++) {
+	  u_re[a][b] = forwards ? link[(a*3 + b)*2 + 0] : link[(b*3 + a)*2 + 0];
+	  u_im[a][b] = forwards ? link[(a*3 + b)*2 + 1] : -link[(b*3 + a)*2 + 1];
+	}
+      }
+
+      alignas(64) Float psi[24][L];
+      for (int l=0; l<n; l++) {
+	const Float *s = base + (s0 + l*ds)*stride;
+	for (int i=0; i<24; i++) psi[i][l] = s[i];
+      }
+
+      // project to a half spinor
+      alignas(64) Float h[12][L];
+      for (int r=0; r<2; r++) {
+	const Float p_re = P.phase[r][0], p_im = P.phase[r][1];
+	for (int c=0; c<3; c++) {
+	  const Float *a_re = psi[(r*3 + c)*2 + 0], *a_im = psi[(r*3 + c)*2 + 1];
+	  const Float *b_re = psi[(P.col[r]*3 + c)*2 + 0], *b_im = psi[(P.col[r]*3 + c)*2 + 1];
+	  for (int l=0; l<n; l++) {
+	    h[(r*3 + c)*2 + 0][l] = a_re[l] + p_re * b_re[l] - p_im * b_im[l];
+	    h[(r*3 + c)*2 + 1][l] = a_im[l] + p_re * b_im[l] + p_im * b_re[l];
+	  }
+	}
+      }
+
+      // multiply by the link
+      alignas(64) Float uh[12][L];
+      for (int r=0; r<2; r++) {
+	for (int a=0; a<3; a++) {
+	  Float *re = uh[(r*3 + a)*2 + 0], *im = uh[(r*3 + a)*2 + 1];
+	  for (int l=0; l<n; l++) { re[l] = 0.0; im[l] = 0.0; }
+	  for (int b=0; b<3; b++) {
+	    const Float g_re = u_re[a][b], g_im = u_im[a][b];
+	    const Float *v_re = h[(r*3 + b)*2 + 0], *v_im = h[(r*3 + b)*2 + 1];
+	    for (int l=0; l<n; l++) {
+	      re[l] += g_re * v_re[l] - g_im * v_im[l];
+	      im[l] += g_re * v_im[l] + g_im * v_re[l];
+	    }
+	  }
+	}
+      }
+
+      // reconstruct the full spinor and accumulate
+      for (int r=0; r<2; r++) {
+	const Float c_re = P.coeff[r][0], c_im = P.coeff[r][1];
+	for (int c=0; c<3; c++) {
+	  const Float *a_re = uh[(r*3 + c)*2 + 0], *a_im = uh[(r*3 + c)*2 + 1];
+	  const Float *b_re = uh[(P.src[r]*3 + c)*2 + 0], *b_im = uh[(P.src[r]*3 + c)*2 + 1];
+	  Float *upper_re = y[(r*3 + c)*2 + 0], *upper_im = y[(r*3 + c)*2 + 1];
+	  Float *lower_re = y[((r+2)*3 + c)*2 + 0], *lower_im = y[((r+2)*3 + c)*2 + 1];
+	  for (int l=0; l<n; l++) {
+	    upper_re[l] += a_re[l];
+	    upper_im[l] += a_im[l];
+	    lower_re[l] += c_re * b_re[l] - c_im * b_im[l];
+	    lower_im[l] += c_re * b_im[l] + c_im * b_re[l];
+	  }
+	}
+      }
+    }
+  }
+
+  /**
+     Apply the fifth-dimension operator op to the Ls slices of y
+   */
+  template <typename Float, int L>
+  static inline void fifthDimTile(Float y[24][L], const typename DomainWallHostArg<Float>::FifthDimOp &op,
+				  const DomainWallHostArg<Float> &arg)
+  {
+    const int Ls = arg.Ls;
+    alignas(64) Float z[24][L];
+
+    for (int chi=0; chi<2; chi++) {
+      if (op.inverse) {
+	const Float *m = op.m[chi].data();
+	for (int i=chi*12; i<(chi+1)*12; i++) {
+	  for (int s=0; s<Ls; s++) z[i][s] = 0.0;
+	  for (int t=0; t<Ls; t++) {
+	    const Float y_t = y[i][t];
+	    const Float *m_t = m + t*Ls;
+	    for (int s=0; s<Ls; s++) z[i][s] += m_t[s] * y_t;
+	  }
+	}
+      } else {
+	const int hop = fifthDimHop(chi, arg.dagger);
+	const int wall = hop < 0 ? 0 : Ls-1; // the slice whose neighbor is across the wall
+	for (int i=chi*12; i<(chi+1)*12; i++) {
+	  for (int s=0; s<Ls; s++) {
+	    const Float w = s == wall ? -2.0 * arg.mferm : 2.0;
+	    z[i][s] = op.a[s] * w * y[i][(s + hop + Ls) % Ls] + op.b[s] * y[i][s];
+	  }
+	}
+      }
+    }
+
+    for (int i=0; i<24; i++) for (int s=0; s<Ls; s++) y[i][s] = z[i][s];
+  }
+
+  template <typename Float>
+  static void computeSite(const DomainWallHostArg<Float> &arg, int q, int x_cb)
+  {
+    constexpr int L = QUDA_MAX_DWF_LS;
+    const int Ls = arg.Ls;
+    const int V = arg.volumeCB;
+
+    // with 5-d preconditioning only every other slice is at this 4-d site
+    const int s0 = arg.pc5d ? (q + arg.parity) % 2 : 0;
+    const int ds = arg.pc5d ? 2 : 1;
+    const int n = (Ls - s0 + ds - 1) / ds;
+
+    alignas(64) Float y[24][L];
+    if (arg.hop4) {
+      dslash4<Float,L>(y, arg, q, x_cb, s0, ds, n);
+    } else {
+      for (int l=0; l<n; l++) {
+	const Float *s = arg.in + ((s0 + l*ds)*V + x_cb)*24;
+	for (int i=0; i<24; i++) y[i][l] = s[i];
+      }
+    }
+
+    if (arg.hop5) {
+      // the neighboring slices of a 5-d preconditioned field are at the same checkerboard index
+      for (int chi=0; chi<2; chi++) {
+	const int hop = fifthDimHop(chi, arg.dagger);
+	for (int l=0; l<n; l++) {
+	  const int s = s0 + l*ds;
+	  const Float w = (s + hop < 0 || s + hop >= Ls) ? -2.0 * arg.mferm : 2.0;
+	  const Float *v = arg.in + (((s + hop + Ls) % Ls)*V + x_cb)*24;
+	  for (int i=chi*12; i<(chi+1)*12; i++) y[i][l] += w * v[i];
+	}
+      }
+    }
+
+    for (const auto &op : arg.ops) fifthDimTile<Float,L>(y, op, arg);
+
+    for (int l=0; l<n; l++) {
+      const int s = s0 + l*ds;
+      Float *o = arg.out + (s*V + x_cb)*24;
+      if (arg.x) {
+	const Float *x = arg.x + (s*V + x_cb)*24;
+	for (int i=0; i<24; i++) o[i] = arg.alpha[s] * y[i][l] + arg.beta[s] * x[i];
+      } else {
+	for (int i=0; i<24; i++) o[i] = arg.alpha[s] * y[i][l];
+      }
+    }
+  }
+
+  /**
+     Compute the 4-d sites sites[q] of each parity q that has them
+   */
+  template <typename Float>
+  static void applySites(const DomainWallHostArg<Float> &arg, const std::vector<int> *sites[2],
+			 const std::function<void()> &progress)
+  {
+    const int n0 = sites[0] ? sites[0]->size() : 0;
+    const int n1 = sites[1] ? sites[1]->size() : 0;
+    host::parallel_for(n0 + n1, [&](int begin, int end) {
+	for (int t=begin; t<end; t++) {
+	  if (t < n0) computeSite(arg, 0, (*sites[0])[t]);
+	  else computeSite(arg, 1, (*sites[1])[t - n0]);
+	}
+      }, progress);
+  }
+
+  bool hostDomainWallDslashSupported(const ColorSpinorField &field)
+  {
+    return field.Location() == QUDA_CPU_FIELD_LOCATION &&
+      field.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER &&
+      field.GammaBasis() == QUDA_DEGRAND_ROSSI_GAMMA_BASIS &&
+      field.Nspin() == 4 && field.Ncolor() == 3 && field.Ndim() == 5 && field.X(4) <= QUDA_MAX_DWF_LS &&
+      (field.Precision() == QUDA_DOUBLE_PRECISION || field.Precision() == QUDA_SINGLE_PRECISION);
+  }
+
+  template <typename Float>
+  static void domainWallHost(ColorSpinorField &out, const GaugeField &gauge, const ColorSpinorField &in,
+			     int parity, int dagger, const ColorSpinorField *x, double mferm,
+			     const DomainWallHostOp &op)
+  {
+    DomainWallHostArg<Float> arg(op, static_cast<Float*>(out.V()), static_cast<const Float*>(in.V()),
+				 x ? static_cast<const Float*>(x->V()) : nullptr, in.VolumeCB() / in.X(4), in.X(4),
+				 parity, dagger, mferm);
+
+    const std::vector<int> *sites[2] = { nullptr, nullptr };
+    if (!arg.hop4) {
+      // site-local, so no neighbors or halo are needed
+      std::vector<int> all(arg.volumeCB);
+      for (int i=0; i<arg.volumeCB; i++) all[i] = i;
+      sites[parity] = &all;
+      applySites(arg, sites, nullptr);
+      return;
+    }
+
+    const host::NeighborTable &table = host::getNeighborTable(gauge.X(), 1);
+    arg.table = &table;
+    arg.ghostFace = gauge.Nface();
+    for (int mu=0; mu<4; mu++) {
+      arg.U[mu] = static_cast<const Float* const*>(gauge.Gauge_p())[mu];
+      arg.Ughost[mu] = comm_dim_partitioned(mu) ? static_cast<const Float*>(gauge.Ghost()[mu]) : nullptr;
+    }
+
+    bool comms = false;
+    for (int mu=0; mu<4; mu++) if (comm_dim_partitioned(mu)) comms = true;
+
+    // with 5-d preconditioning the slices of a field alternate between the 4-d parities
+    for (int q=0; q<2; q++) if (arg.pc5d || q == parity) sites[q] = &table.interior[q];
+
+    if (comms) {
+      const cpuColorSpinorField &in_h = static_cast<const cpuColorSpinorField&>(in);
+      in_h.exchangeGhostStart(static_cast<QudaParity>(1-parity), 1, dagger);
+      // the interior is overlapped with the halo exchange
+      applySites(arg, sites, [&]() { in_h.exchangeGhostQuery(); });
+      in_h.exchangeGhostWait();
+      for (int i=0; i<8; i++) arg.ghost[i] = static_cast<const Float*>(in_h.Ghost()[i]);
+      for (int q=0; q<2; q++) if (sites[q]) sites[q] = &table.boundary[q];
+      applySites(arg, sites, nullptr);
+    } else {
+      applySites(arg, sites, nullptr);
+    }
+  }
+
+  static void domainWallHost(ColorSpinorField &out, const GaugeField &gauge, const ColorSpinorField &in,
+			     int parity, int dagger, const ColorSpinorField *x, double mferm,
+			     const DomainWallHostOp &op)
+  {
+    const QudaDWFPCType pc_type = op.pc5d ? QUDA_5D_PC : QUDA_4D_PC;
+    const ColorSpinorField *fields[3] = { &out, &in, x };
+    for (int i=0; i<3; i++) {
+      if (!fields[i]) continue;
+      if (!hostDomainWallDslashSupported(*fields[i]))
+	errorQuda("Host domain-wall Dslash requires 5-d Nspin=4 Ncolor=3 CPU fields in space-spin-color order and the DeGrand-Rossi basis");
+      if (fields[i]->SiteSubset() != QUDA_PARITY_SITE_SUBSET)
+	errorQuda("Host domain-wall Dslash requires single-parity fields");
+      if (fields[i]->DWFPCtype() != pc_type)
+	errorQuda("Preconditioning type %d does not match the operator (%d)", fields[i]->DWFPCtype(), pc_type);
+      if (fields[i]->Precision() != out.Precision())
+	errorQuda("Precisions %d and %d do not match", fields[i]->Precision(), out.Precision());
+      if (fields[i]->VolumeCB() != out.VolumeCB() || fields[i]->X(4) != out.X(4))
+	errorQuda("Volumes %d and %d do not match", fields[i]->VolumeCB(), out.VolumeCB());
+    }
+    if (in.GhostCompression() != QUDA_GHOST_COMPRESSION_NONE)
+      errorQuda("Host domain-wall Dslash does not support halo compression %d", in.GhostCompression());
+
+    if (op.hop4) {
+      if (gauge.Order() != QUDA_QDP_GAUGE_ORDER || gauge.Reconstruct() != QUDA_RECONSTRUCT_NO)
+	errorQuda("Host domain-wall Dslash requires a QDP-ordered gauge field without reconstruction");
+      if (gauge.Precision() != out.Precision())
+	errorQuda("Gauge precision %d does not match spinor precision %d", gauge.Precision(), out.Precision());
+      if (gauge.VolumeCB() * in.X(4) != out.VolumeCB())
+	errorQuda("Gauge volume %d does not match spinor volume %d", gauge.VolumeCB(), out.VolumeCB());
+      for (int mu=0; mu<4; mu++)
+	if (comm_dim_partitioned(mu) && !gauge.Ghost()[mu])
+	  errorQuda("Gauge field has no halo in partitioned dimension %d", mu);
+    }
+
+    if (out.Precision() == QUDA_DOUBLE_PRECISION) {
+      domainWallHost<double>(out, gauge, in, parity, dagger, x, mferm, op);
+    } else {
+      domainWallHost<float>(out, gauge, in, parity, dagger, x, mferm, op);
+    }
+  }
+
+  void domainWallDslashHost(ColorSpinorField &out, const GaugeField &gauge, const ColorSpinorField &in,
+			    int parity, int dagger, const ColorSpinorField *x, double mferm, double k)
+  {
+    const int Ls = in.X(4);
+    DomainWallHostOp op(Ls);
+    op.pc5d = true;
+    op.hop4 = true;
+    op.hop5 = true;
+    if (x) {
+      op.alpha.assign(Ls, k);
+      op.beta.assign(Ls, 1.0);
+    }
+    domainWallHost(out, gauge, in, parity, dagger, x, mferm, op);
+  }
+
+  void domainWall4DDslashHost(ColorSpinorField &out, const GaugeField &gauge, const ColorSpinorField &in,
+			      int parity, int dagger, const ColorSpinorField *x, double mferm,
+			      double a, double b, int DS_type)
+  {
+    const int Ls = in.X(4);
+    DomainWallHostOp op(Ls);
+    const std::vector<double> kappa(Ls, 2.0*a);
+
+    switch (DS_type) {
+    case 0: // Dslash4, or x + a Dslash4
+      op.hop4 = true;
+      if (x) op.alpha.assign(Ls, a);
+      break;
+    case 1: // D5, or D5 + a x
+      op.addHop(std::vector<double>(Ls, 1.0), std::vector<double>(Ls, 0.0));
+      break;
+    case 2: // M5^{-1}, or b M5^{-1} + x
+      op.addInverse(kappa);
+      if (x) op.alpha.assign(Ls, b);
+      break;
+    case 3: // M5^{-1} Dslash4, or b M5^{-1} Dslash4 + x
+      op.hop4 = true;
+      op.addInverse(kappa);
+      if (x) op.alpha.assign(Ls, b);
+      break;
+    default:
+      errorQuda("Unsupported DS_type %d", DS_type);
+    }
+    if (x) op.beta.assign(Ls, DS_type == 1 ? a : 1.0);
+
+    domainWallHost(out, gauge, in, parity, dagger, x, mferm, op);
+  }
+
+  void MDWFDslashHost(ColorSpinorField &out, const GaugeField &gauge, const ColorSpinorField &in,
+		      int parity, int dagger, const ColorSpinorField *x, double mferm, double m5,
+		      const double *b5, const double *c5, double k, int DS_type)
+  {
+    const int Ls = in.X(4);
+    DomainWallHostOp op(Ls);
+
+    std::vector<double> kappa_b(Ls), kappa(Ls), b5_(b5, b5+Ls), half_c5(Ls), C5(Ls);
+    for (int s=0; s<Ls; s++) {
+      kappa_b[s] = 0.5 / (b5[s]*(4.0 + m5) + 1.0);
+      kappa[s] = -(c5[s]*(4.0 + m5) - 1.0) / (b5[s]*(4.0 + m5) + 1.0);
+      half_c5[s] = 0.5 * c5[s];
+      C5[s] = -0.5 * kappa[s];
+    }
+
+    switch (DS_type) {
+    case 0: // Dslash4
+      op.hop4 = true;
+      break;
+    case 1: // Dslash4pre
+      op.addHop(half_c5, b5_);
+      break;
+    case 2: // M5
+      op.addHop(C5, std::vector<double>(Ls, 1.0));
+      break;
+    case 3: // M5^{-1}
+      op.addInverse(kappa);
+      break;
+    case 4: // M5^{-1} Dslash4
+      op.hop4 = true;
+      op.addInverse(kappa);
+      break;
+    case 5: // Dslash4pre M5^{-1} Dslash4
+      op.hop4 = true;
+      op.addInverse(kappa);
+      op.addHop(half_c5, b5_);
+      break;
+    default:
+      errorQuda("Unsupported DS_type %d", DS_type);
+    }
+
+    if (x) {
+      // the xpay term bakes in a factor of kappa_b, or kappa_b^2 for the fifth-dimension operators
+      for (int s=0; s<Ls; s++) {
+	const double coeff = DS_type == 0 ? k * kappa_b[s] : k * kappa_b[s] * kappa_b[s];
+	if (DS_type == 0 || DS_type == 3 || DS_type == 4) {
+	  op.alpha[s] = coeff;
+	  op.beta[s] = 1.0;
+	} else {
+	  op.beta[s] = coeff;
+	}
+      }
+    }
+
+    domainWallHost(out, gauge, in, parity, dagger, x, mferm, op);
+  }
+
+} // namespace quda
@@ -0,0 +1,222 @@
+// Host improved-staggered Dslash for single-parity fields in
+// space-color order; the fifth dimension holds independent sources.
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+#include <dslash_quda.h>
+#include <neighbor_table.h>
+#include <thread_pool.h>
+
+namespace quda {
+
+  template <typename Float>
+  struct StaggeredHostArg {
+    Float *out;
+    const Float *in;
+    const Float *x;
+    const Float *U[2][4];      // fat and long links [(parity*volumeCB + x_cb)*18]
+    const Float *Ughost[2][4]; // backward fat and long links from the neighboring rank
+    int ghostFace[2];          // depth of the fat and long link halos
+    const Float *ghost[8];     // spinor halo, [2*mu+0] backwards, [2*mu+1] forwards
+    const host::NeighborTable *table;
+    int parity;
+    int dagger;
+    bool xpay;
+    Float k;
+    int volumeCB; // of a single source
+    int nSrc;
+  };
+
+  /**
+     Compute the n sites [sites, sites+n) of source s
+   */
+  template <typename Float, int W>
+  static void computeTile(const StaggeredHostArg<Float> &arg, const int *sites, int n, int s)
+  {
+    const host::NeighborTable &table = *arg.table;
+    const int *nbr = table.nbr[arg.parity].data();
+    const int nFace = table.nFace;
+    const int nHop = table.nHop;
+
+    alignas(64) Float acc[6][W];
+    for (int i=0; i<6; i++) for (int l=0; l<W; l++) acc[i][l] = 0.0;
+
+    for (int d=0; d<8; d++) {
+      const int mu = d / 2;
+      const bool forwards = (d % 2 == 0);
+      const int faceVolumeCB = table.faceVolumeCB[mu];
+
+      for (int h=0; h<nHop; h++) {
+	// gather the neighbor color vectors and links of the tile
+	alignas(64) Float psi[6][W];
+	alignas(64) Float u[18][W];
+	for (int l=0; l<W; l++) {
+	  const int x_cb = sites[l < n ? l : n-1];
+	  const int j = nbr[(x_cb*8 + d)*nHop + h];
+	  const Float *v;
+	  const Float *link;
+	  if (j >= 0) {
+	    v = arg.in + (s*arg.volumeCB + j)*6;
+	    link = forwards ? arg.U[h][mu] + (arg.parity*arg.volumeCB + x_cb)*18 :
+	      arg.U[h][mu] + ((1-arg.parity)*arg.volumeCB + j)*18;
+	  } else {
+	    // each halo layer holds every source, and the link halo holds the layers nearest the face
+	    const int i = -j-1;
+	    const int g = arg.ghostFace[h];
+	    v = arg.ghost[2*mu + (forwards ? 1 : 0)] + (i + (table.layer(mu, i)*(arg.nSrc-1) + s)*faceVolumeCB)*6;
+	    link = forwards ? arg.U[h][mu] + (arg.parity*arg.volumeCB + x_cb)*18 :
+	      arg.Ughost[h][mu] + ((1-arg.parity)*g*faceVolumeCB + i - (nFace-g)*faceVolumeCB)*18;
+	  }
+	  for (int i=0; i<6; i++) psi[i][l] = v[i];
+	  for (int i=0; i<18; i++) u[i][l] = link[i];
+	}
+
+	// forwards hops add U psi, backwards hops subtract U^dagger psi
+	const Float sign = forwards ? 1.0 : -1.0;
+	const Float conj = forwards ? 1.0 : -1.0;
+	for (int i=0; i<3; i++) {
+	  Float re[W], im[W];
+	  for (int l=0; l<W; l++) { re[l] = 0.0; im[l] = 0.0; }
+	  for (int j=0; j<3; j++) {
+	    const Float *g_re = forwards ? u[(i*3 + j)*2 + 0] : u[(j*3 + i)*2 + 0];
+	    const Float *g_im = forwards ? u[(i*3 + j)*2 + 1] : u[(j*3 + i)*2 + 1];
+	    for (int l=0; l<W; l++) {
+	      re[l] += g_re[l] * psi[2*j+0][l] - conj * g_im[l] * psi[2*j+1][l];
+	      im[l] += g_re[l] * psi[2*j+1][l] + conj * g_im[l] * psi[2*j+0][l];
+	    }
+	  }
+	  for (int l=0; l<W; l++) {
+	    acc[2*i+0][l] += sign * re[l];
+	    acc[2*i+1][l] += sign * im[l];
+	  }
+	}
+      }
+    }
+
+    // the staggered Dslash is anti-Hermitian
+    const Float scale = arg.dagger ? -1.0 : 1.0;
+    for (int l=0; l<n; l++) {
+      Float *o = arg.out + (s*arg.volumeCB + sites[l])*6;
+      if (arg.xpay) {
+	const Float *x = arg.x + (s*arg.volumeCB + sites[l])*6;
+	for (int i=0; i<6; i++) o[i] = arg.k * x[i] - scale * acc[i][l];
+      } else {
+	for (int i=0; i<6; i++) o[i] = scale * acc[i][l];
+      }
+    }
+  }
+
+  template <typename Float>
+  static void applyTiles(const StaggeredHostArg<Float> &arg, const std::vector<int> &sites,
+			 const std::function<void()> &progress)
+  {
+    constexpr int W = 64 / sizeof(Float); // sites per tile
+    const int tilesPerSrc = (sites.size() + W - 1) / W;
+    host::parallel_for(tilesPerSrc * arg.nSrc, [&](int begin, int end) {
+	for (int t=begin; t<end; t++) {
+	  const int s = t / tilesPerSrc;
+	  const int offset = (t % tilesPerSrc) * W;
+	  computeTile<Float,W>(arg, sites.data() + offset, std::min<int>(W, sites.size() - offset), s);
+	}
+      }, progress);
+  }
+
+  bool hostStaggeredDslashSupported(const ColorSpinorField &field)
+  {
+    return field.Location() == QUDA_CPU_FIELD_LOCATION &&
+      field.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER &&
+      field.Nspin() == 1 && field.Ncolor() == 3 && field.Ndim() == 5 &&
+      (field.Precision() == QUDA_DOUBLE_PRECISION || field.Precision() == QUDA_SINGLE_PRECISION);
+  }
+
+  template <typename Float>
+  static void staggeredHost(ColorSpinorField &out, const GaugeField &fatGauge, const GaugeField &longGauge,
+			    const ColorSpinorField &in, int parity, int dagger, const ColorSpinorField *x, double k)
+  {
+    const int nFace = 3;
+    const host::NeighborTable &table = host::getNeighborTable(fatGauge.X(), nFace);
+
+    StaggeredHostArg<Float> arg;
+    memset(&arg, 0, sizeof(arg));
+    arg.out = static_cast<Float*>(out.V());
+    arg.in = static_cast<const Float*>(in.V());
+    arg.x = x ? static_cast<const Float*>(x->V()) : nullptr;
+    arg.table = &table;
+    arg.parity = parity;
+    arg.dagger = dagger;
+    arg.xpay = x ? true : false;
+    arg.k = k;
+    arg.volumeCB = fatGauge.VolumeCB();
+    arg.nSrc = in.X(4);
+
+    const GaugeField *gauge[2] = { &fatGauge, &longGauge };
+    for (int h=0; h<2; h++) {
+      arg.ghostFace[h] = gauge[h]->Nface();
+      for (int mu=0; mu<4; mu++) {
+	arg.U[h][mu] = static_cast<const Float* const*>(gauge[h]->Gauge_p())[mu];
+	arg.Ughost[h][mu] = comm_dim_partitioned(mu) ? static_cast<const Float*>(gauge[h]->Ghost()[mu]) : nullptr;
+      }
+    }
+
+    bool comms = false;
+    for (int mu=0; mu<4; mu++) if (comm_dim_partitioned(mu)) comms = true;
+
+    if (comms) {
+      const cpuColorSpinorField &in_h = static_cast<const cpuColorSpinorField&>(in);
+      in_h.exchangeGhostStart(static_cast<QudaParity>(1-parity), nFace, dagger);
+      // the interior is overlapped with the halo exchange
+      applyTiles(arg, table.interior[parity], [&]() { in_h.exchangeGhostQuery(); });
+      in_h.exchangeGhostWait();
+      for (int i=0; i<8; i++) arg.ghost[i] = static_cast<const Float*>(in_h.Ghost()[i]);
+      applyTiles(arg, table.boundary[parity], nullptr);
+    } else {
+      applyTiles(arg, table.interior[parity], nullptr);
+    }
+  }
+
+  void improvedStaggeredDslashHost(ColorSpinorField &out, const GaugeField &fatGauge, const GaugeField &longGauge,
+				   const ColorSpinorField &in, int parity, int dagger, const ColorSpinorField *x, double k)
+  {
+    const ColorSpinorField *fields[3] = { &out, &in, x };
+    for (int i=0; i<3; i++) {
+      if (!fields[i]) continue;
+      if (!hostStaggeredDslashSupported(*fields[i]))
+	errorQuda("Host staggered Dslash requires 5-d Nspin=1 Ncolor=3 CPU fields in space-spin-color order");
+      if (fields[i]->SiteSubset() != QUDA_PARITY_SITE_SUBSET)
+	errorQuda("Host staggered Dslash requires single-parity fields");
+      if (fields[i]->Precision() != out.Precision())
+	errorQuda("Precisions %d and %d do not match", fields[i]->Precision(), out.Precision());
+      if (fields[i]->VolumeCB() != out.VolumeCB())
+	errorQuda("Volumes %d and %d do not match", fields[i]->VolumeCB(), out.VolumeCB());
+    }
+    if (in.GhostCompression() != QUDA_GHOST_COMPRESSION_NONE)
+      errorQuda("Host staggered Dslash does not support halo compression %d", in.GhostCompression());
+
+    const GaugeField *gauge[2] = { &fatGauge, &longGauge };
+    for (int h=0; h<2; h++) {
+      if (gauge[h]->Order() != QUDA_QDP_GAUGE_ORDER || gauge[h]->Reconstruct() != QUDA_RECONSTRUCT_NO)
+	errorQuda("Host staggered Dslash requires QDP-ordered gauge fields without reconstruction");
+      if (gauge[h]->Precision() != out.Precision())
+	errorQuda("Gauge precision %d does not match spinor precision %d", gauge[h]->Precision(), out.Precision());
+      if (gauge[h]->VolumeCB() * in.X(4) != out.VolumeCB())
+	errorQuda("Gauge volume %d does not match spinor volume %d", gauge[h]->VolumeCB(), out.VolumeCB());
+      for (int mu=0; mu<4; mu++) {
+	if (!comm_dim_partitioned(mu)) continue;
+	if (!gauge[h]->Ghost()[mu] || gauge[h]->Nface() < 2*h+1)
+	  errorQuda("Gauge field has no depth-%d halo in partitioned dimension %d", 2*h+1, mu);
+      }
+    }
+
+    if (out.Precision() == QUDA_DOUBLE_PRECISION) {
+      staggeredHost<double>(out, fatGauge, longGauge, in, parity, dagger, x, k);
+    } else {
+      staggeredHost<float>(out, fatGauge, longGauge, in, parity, dagger, x, k);
+    }
+  }
+
+} // namespace quda
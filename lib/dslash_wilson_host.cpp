@@ -0,0 +1,378 @@
+// Host Wilson and Wilson-clover Dslash for single-parity fields in
+// space-spin-color order and the DeGrand-Rossi basis.
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+#include <clover_field.h>
+#include <dslash_quda.h>
+#include <neighbor_table.h>
+#include <spin_projector_host.h>
+#include <thread_pool.h>
+
+namespace quda {
+
+  enum HostDslashType {
+    HOST_WILSON,      // out = D in, or x + k D in
+    HOST_CLOVER,      // out = A^{-1} D in, or x + k A^{-1} D in
+    HOST_ASYM_CLOVER, // out = A x + k D in
+    HOST_CLOVER_ONLY  // out = A in, or A^{-1} in
+  };
+
+  template <typename Float>
+  struct WilsonHostArg {
+    Float *out;
+    const Float *in;
+    const Float *x;
+    const Float *U[4];      // links [(parity*volumeCB + x_cb)*18] for each dimension
+    const Float *Ughost[4]; // backward links from the neighboring rank
+    const Float *ghost[8];  // spinor halo, [2*mu+0] backwards, [2*mu+1] forwards
+    const Float *clover;    // packed clover (or its inverse) for the output parity
+    const int *nbr;
+    HostDslashType type;
+    int parity;
+    int dagger;
+    bool xpay;
+    Float k;
+    int volumeCB;
+    int faceVolumeCB[4];
+  };
+
+  /**
+     Multiply the spinor tile in by the packed clover matrices of the
+     tile, which are Hermitian and block diagonal in chirality, each
+     block stored as 6 real diagonal elements followed by the 15
+     complex elements of the strictly lower triangle in column order.
+   */
+  template <typename Float, int W>
+  static inline void cloverTile(Float out[24][W], const Float in[24][W], const Float *clover,
+				const int *sites, int n)
+  {
+    constexpr int N = 6;
+    alignas(64) Float C[72][W];
+    for (int l=0; l<W; l++) {
+      const Float *c = clover + sites[l < n ? l : n-1] * 72;
+      for (int i=0; i<72; i++) C[i][l] = c[i];
+    }
+
+    for (int chi=0; chi<2; chi++) {
+      const int D = chi*36;
+      const int L = D + N;
+      for (int row=0; row<N; row++) {
+	Float re[W], im[W];
+	for (int l=0; l<W; l++) {
+	  re[l] = C[D + row][l] * in[(chi*N + row)*2 + 0][l];
+	  im[l] = C[D + row][l] * in[(chi*N + row)*2 + 1][l];
+	}
+	for (int col=0; col<N; col++) {
+	  if (col == row) continue;
+	  // H[row][col] is stored for row > col, else use its conjugate
+	  const int a = row > col ? row : col;
+	  const int b = row > col ? col : row;
+	  const int kk = N*(N-1)/2 - (N-b)*(N-b-1)/2 + a - b - 1;
+	  const Float sign = row > col ? 1.0 : -1.0;
+	  const Float *in_re = in[(chi*N + col)*2 + 0];
+	  const Float *in_im = in[(chi*N + col)*2 + 1];
+	  const Float *h_re = C[L + 2*kk + 0];
+	  const Float *h_im = C[L + 2*kk + 1];
+	  for (int l=0; l<W; l++) {
+	    re[l] += h_re[l] * in_re[l] - sign * h_im[l] * in_im[l];
+	    im[l] += h_re[l] * in_im[l] + sign * h_im[l] * in_re[l];
+	  }
+	}
+	for (int l=0; l<W; l++) {
+	  out[(chi*N + row)*2 + 0][l] = re[l];
+	  out[(chi*N + row)*2 + 1][l] = im[l];
+	}
+      }
+    }
+  }
+
+  /**
+     Accumulate the hopping term of the n sites of the tile into acc
+   */
+  template <typename Float, int W>
+  static inline void dslashTile(Float acc[24][W], const WilsonHostArg<Float> &arg, const int *sites, int n)
+  {
+    for (int i=0; i<24; i++) for (int l=0; l<W; l++) acc[i][l] = 0.0;
+
+    for (int d=0; d<8; d++) {
+      const int mu = d / 2;
+      const bool forwards = (d % 2 == 0);
+      const host::HalfProjector &P = host::halfProjector(2*mu + (d + arg.dagger) % 2);
+
+      // gather the neighbor spinors and links of the tile
+      alignas(64) Float psi[24][W];
+      alignas(64) Float u[18][W];
+      for (int l=0; l<W; l++) {
+	const int x_cb = sites[l < n ? l : n-1];
+	const int j = arg.nbr[x_cb*8 + d];
+	const Float *s = j >= 0 ? arg.in + j*24 : arg.ghost[2*mu + (forwards ? 1 : 0)] + (-j-1)*24;
+	const Float *link = forwards ? arg.U[mu] + (arg.parity*arg.volumeCB + x_cb)*18 :
+	  j >= 0 ? arg.U[mu] + ((1-arg.parity)*arg.volumeCB + j)*18 :
+	  arg.Ughost[mu] + ((1-arg.parity)*arg.faceVolumeCB[mu] + (-j-1))*18;
+	for (int i=0; i<24; i++) psi[i][l] = s[i];
+	for (int i=0; i<18; i++) u[i][l] = link[i];
+      }
+
+      // project to a half spinor
+      alignas(64) Float h[12][W];
+      for (int r=0; r<2; r++) {
+	const Float p_re = P.phase[r][0], p_im = P.phase[r][1];
+	for (int c=0; c<3; c++) {
+	  const Float *a_re = psi[(r*3 + c)*2 + 0], *a_im = psi[(r*3 + c)*2 + 1];
+	  const Float *b_re = psi[(P.col[r]*3 + c)*2 + 0], *b_im = psi[(P.col[r]*3 + c)*2 + 1];
+	  for (int l=0; l<W; l++) {
+	    h[(r*3 + c)*2 + 0][l] = a_re[l] + p_re * b_re[l] - p_im * b_im[l];
+	    h[(r*3 + c)*2 + 1][l] = a_im[l] + p_re * b_im[l] + p_im * b_re[l];
+	  }
+	}
+      }
+
+      // multiply by U for forwards hops, by U^dagger for backwards hops
+      alignas(64) Float uh[12][W];
+      for (int r=0; r<2; r++) {
+	for (int i=0; i<3; i++) {
+	  Float re[W], im[W];
+	  for (int l=0; l<W; l++) { re[l] = 0.0; im[l] = 0.0; }
+	  for (int j=0; j<3; j++) {
+	    const Float *g_re = forwards ? u[(i*3 + j)*2 + 0] : u[(j*3 + i)*2 + 0];
+	    const Float *g_im = forwards ? u[(i*3 + j)*2 + 1] : u[(j*3 + i)*2 + 1];
+	    const Float conj = forwards ? 1.0 : -1.0;
+	    const Float *v_re = h[(r*3 + j)*2 + 0], *v_im = h[(r*3 + j)*2 + 1];
+	    for (int l=0; l<W; l++) {
+	      re[l] += g_re[l] * v_re[l] - conj * g_im[l] * v_im[l];
+	      im[l] += g_re[l] * v_im[l] + conj * g_im[l] * v_re[l];
+	    }
+	  }
+	  for (int l=0; l<W; l++) {
+	    uh[(r*3 + i)*2 + 0][l] = re[l];
+	    uh[(r*3 + i)*2 + 1][l] = im[l];
+	  }
+	}
+      }
+
+      // reconstruct the full spinor and accumulate
+      for (int r=0; r<2; r++) {
+	const Float c_re = P.coeff[r][0], c_im = P.coeff[r][1];
+	for (int c=0; c<3; c++) {
+	  const Float *a_re = uh[(r*3 + c)*2 + 0], *a_im = uh[(r*3 + c)*2 + 1];
+	  const Float *b_re = uh[(P.src[r]*3 + c)*2 + 0], *b_im = uh[(P.src[r]*3 + c)*2 + 1];
+	  Float *upper_re = acc[(r*3 + c)*2 + 0], *upper_im = acc[(r*3 + c)*2 + 1];
+	  Float *lower_re = acc[((r+2)*3 + c)*2 + 0], *lower_im = acc[((r+2)*3 + c)*2 + 1];
+	  for (int l=0; l<W; l++) {
+	    upper_re[l] += a_re[l];
+	    upper_im[l] += a_im[l];
+	    lower_re[l] += c_re * b_re[l] - c_im * b_im[l];
+	    lower_im[l] += c_re * b_im[l] + c_im * b_re[l];
+	  }
+	}
+      }
+    }
+  }
+
+  template <typename Float, int W>
+  static inline void loadTile(Float v[24][W], const Float *field, const int *sites, int n)
+  {
+    for (int l=0; l<W; l++) {
+      const Float *s = field + sites[l < n ? l : n-1]*24;
+      for (int i=0; i<24; i++) v[i][l] = s[i];
+    }
+  }
+
+  template <typename Float, int W>
+  static void computeTile(const WilsonHostArg<Float> &arg, const int *sites, int n)
+  {
+    alignas(64) Float acc[24][W];
+    alignas(64) Float tmp[24][W];
+
+    switch (arg.type) {
+    case HOST_WILSON:
+      dslashTile<Float,W>(acc, arg, sites, n);
+      break;
+    case HOST_CLOVER:
+      dslashTile<Float,W>(tmp, arg, sites, n);
+      cloverTile<Float,W>(acc, tmp, arg.clover, sites, n);
+      break;
+    case HOST_ASYM_CLOVER:
+      dslashTile<Float,W>(acc, arg, sites, n);
+      break;
+    case HOST_CLOVER_ONLY:
+      loadTile<Float,W>(tmp, arg.in, sites, n);
+      cloverTile<Float,W>(acc, tmp, arg.clover, sites, n);
+      break;
+    }
+
+    if (arg.xpay) {
+      // the term added to k times the hopping term is x, or A x for the asymmetric operator
+      loadTile<Float,W>(tmp, arg.x, sites, n);
+      if (arg.type == HOST_ASYM_CLOVER) {
+	alignas(64) Float ax[24][W];
+	cloverTile<Float,W>(ax, tmp, arg.clover, sites, n);
+	for (int i=0; i<24; i++) for (int l=0; l<W; l++) acc[i][l] = ax[i][l] + arg.k * acc[i][l];
+      } else {
+	for (int i=0; i<24; i++) for (int l=0; l<W; l++) acc[i][l] = tmp[i][l] + arg.k * acc[i][l];
+      }
+    }
+
+    for (int l=0; l<n; l++) {
+      Float *o = arg.out + sites[l]*24;
+      for (int i=0; i<24; i++) o[i] = acc[i][l];
+    }
+  }
+
+  template <typename Float>
+  static void applyTiles(const WilsonHostArg<Float> &arg, const std::vector<int> &sites,
+			 const std::function<void()> &progress)
+  {
+    constexpr int W = 64 / sizeof(Float); // sites per tile
+    const int nTiles = (sites.size() + W - 1) / W;
+    host::parallel_for(nTiles, [&](int begin, int end) {
+	for (int t=begin; t<end; t++) {
+	  const int offset = t*W;
+	  computeTile<Float,W>(arg, sites.data() + offset, std::min<int>(W, sites.size() - offset));
+	}
+      }, progress);
+  }
+
+  bool hostDslashSupported(const ColorSpinorField &field)
+  {
+    return field.Location() == QUDA_CPU_FIELD_LOCATION &&
+      field.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER &&
+      field.GammaBasis() == QUDA_DEGRAND_ROSSI_GAMMA_BASIS &&
+      field.Nspin() == 4 && field.Ncolor() == 3 && field.Ndim() == 4 &&
+      (field.Precision() == QUDA_DOUBLE_PRECISION || field.Precision() == QUDA_SINGLE_PRECISION);
+  }
+
+  static void checkHostFields(const ColorSpinorField &out, const ColorSpinorField &in, const ColorSpinorField *x,
+			      const GaugeField *gauge, const CloverField *clover)
+  {
+    const ColorSpinorField *fields[3] = { &out, &in, x };
+    for (int i=0; i<3; i++) {
+      if (!fields[i]) continue;
+      if (!hostDslashSupported(*fields[i]))
+	errorQuda("Host Dslash requires 4-d Nspin=4 Ncolor=3 CPU fields in space-spin-color order and the DeGrand-Rossi basis");
+      if (fields[i]->SiteSubset() != QUDA_PARITY_SITE_SUBSET)
+	errorQuda("Host Dslash requires single-parity fields");
+      if (fields[i]->Precision() != out.Precision())
+	errorQuda("Precisions %d and %d do not match", fields[i]->Precision(), out.Precision());
+      if (fields[i]->VolumeCB() != out.VolumeCB())
+	errorQuda("Volumes %d and %d do not match", fields[i]->VolumeCB(), out.VolumeCB());
+    }
+    if (in.GhostCompression() != QUDA_GHOST_COMPRESSION_NONE)
+      errorQuda("Host Dslash does not support halo compression %d", in.GhostCompression());
+
+    if (gauge) {
+      if (gauge->Order() != QUDA_QDP_GAUGE_ORDER || gauge->Reconstruct() != QUDA_RECONSTRUCT_NO)
+	errorQuda("Host Dslash requires a QDP-ordered gauge field without reconstruction");
+      if (gauge->Precision() != out.Precision())
+	errorQuda("Gauge precision %d does not match spinor precision %d", gauge->Precision(), out.Precision());
+      if (gauge->VolumeCB() != out.VolumeCB())
+	errorQuda("Gauge volume %d does not match spinor volume %d", gauge->VolumeCB(), out.VolumeCB());
+      for (int mu=0; mu<4; mu++)
+	if (comm_dim_partitioned(mu) && !gauge->Ghost()[mu])
+	  errorQuda("Gauge field has no halo in partitioned dimension %d", mu);
+    }
+
+    if (clover) {
+      if (clover->Order() != QUDA_PACKED_CLOVER_ORDER)
+	errorQuda("Host Dslash requires a packed clover field");
+      if (clover->Precision() != out.Precision())
+	errorQuda("Clover precision %d does not match spinor precision %d", clover->Precision(), out.Precision());
+    }
+  }
+
+  template <typename Float>
+  static void wilsonHost(ColorSpinorField &out, const GaugeField *gauge, const CloverField *clover, bool inverse,
+			 const ColorSpinorField &in, int parity, int dagger, const ColorSpinorField *x, double k,
+			 HostDslashType type)
+  {
+    WilsonHostArg<Float> arg;
+    memset(&arg, 0, sizeof(arg));
+    arg.out = static_cast<Float*>(out.V());
+    arg.in = static_cast<const Float*>(in.V());
+    arg.x = x ? static_cast<const Float*>(x->V()) : nullptr;
+    arg.type = type;
+    arg.parity = parity;
+    arg.dagger = dagger;
+    arg.xpay = x ? true : false;
+    arg.k = k;
+    arg.volumeCB = out.VolumeCB();
+    arg.clover = clover ? static_cast<const Float*>(clover->V(inverse)) + parity*arg.volumeCB*72 : nullptr;
+    if (clover && !clover->V(inverse)) errorQuda("Clover field has no %s term", inverse ? "inverse" : "direct");
+
+    std::vector<int> all;
+    if (type == HOST_CLOVER_ONLY) {
+      // site-local, so no neighbors or halo are needed
+      all.resize(arg.volumeCB);
+      for (int i=0; i<arg.volumeCB; i++) all[i] = i;
+      applyTiles(arg, all, nullptr);
+      return;
+    }
+
+    const host::NeighborTable &table = host::getNeighborTable(gauge->X(), 1); // spinor x[0] is checkerboarded
+    arg.nbr = table.nbr[parity].data();
+    for (int mu=0; mu<4; mu++) {
+      arg.U[mu] = static_cast<const Float* const*>(gauge->Gauge_p())[mu];
+      arg.Ughost[mu] = comm_dim_partitioned(mu) ? static_cast<const Float*>(gauge->Ghost()[mu]) : nullptr;
+      arg.faceVolumeCB[mu] = gauge->SurfaceCB(mu);
+    }
+
+    bool comms = false;
+    for (int mu=0; mu<4; mu++) if (comm_dim_partitioned(mu)) comms = true;
+
+    if (comms) {
+      const cpuColorSpinorField &in_h = static_cast<const cpuColorSpinorField&>(in);
+      in_h.exchangeGhostStart(static_cast<QudaParity>(1-parity), 1, dagger);
+      // the interior is overlapped with the halo exchange
+      applyTiles(arg, table.interior[parity], [&]() { in_h.exchangeGhostQuery(); });
+      in_h.exchangeGhostWait();
+      for (int i=0; i<8; i++) arg.ghost[i] = static_cast<const Float*>(in_h.Ghost()[i]);
+      applyTiles(arg, table.boundary[parity], nullptr);
+    } else {
+      applyTiles(arg, table.interior[parity], nullptr);
+    }
+  }
+
+  static void wilsonHost(ColorSpinorField &out, const GaugeField *gauge, const CloverField *clover, bool inverse,
+			 const ColorSpinorField &in, int parity, int dagger, const ColorSpinorField *x, double k,
+			 HostDslashType type)
+  {
+    checkHostFields(out, in, x, gauge, clover);
+
+    if (out.Precision() == QUDA_DOUBLE_PRECISION) {
+      wilsonHost<double>(out, gauge, clover, inverse, in, parity, dagger, x, k, type);
+    } else {
+      wilsonHost<float>(out, gauge, clover, inverse, in, parity, dagger, x, k, type);
+    }
+  }
+
+  void wilsonDslashHost(ColorSpinorField &out, const GaugeField &gauge, const ColorSpinorField &in,
+			int parity, int dagger, const ColorSpinorField *x, double k)
+  {
+    wilsonHost(out, &gauge, nullptr, false, in, parity, dagger, x, k, HOST_WILSON);
+  }
+
+  void cloverDslashHost(ColorSpinorField &out, const GaugeField &gauge, const CloverField &clover,
+			const ColorSpinorField &in, int parity, int dagger, const ColorSpinorField *x, double k)
+  {
+    wilsonHost(out, &gauge, &clover, true, in, parity, dagger, x, k, HOST_CLOVER);
+  }
+
+  void asymCloverDslashHost(ColorSpinorField &out, const GaugeField &gauge, const CloverField &clover,
+			    const ColorSpinorField &in, int parity, int dagger, const ColorSpinorField &x, double k)
+  {
+    wilsonHost(out, &gauge, &clover, false, in, parity, dagger, &x, k, HOST_ASYM_CLOVER);
+  }
+
+  void ApplyCloverHost(ColorSpinorField &out, const ColorSpinorField &in, const CloverField &clover,
+		       bool inverse, int parity)
+  {
+    wilsonHost(out, nullptr, &clover, inverse, in, parity, 0, nullptr, 0.0, HOST_CLOVER_ONLY);
+  }
+
+} // namespace quda
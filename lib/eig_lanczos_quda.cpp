@@ -12,6 +12,9 @@
 #include <lanczos_quda.h>
 
 #include <iostream>
+#include <vector>
+#include <algorithm>
+#include <Eigen/Dense>
 
 namespace quda {
 
@@ -91,6 +94,218 @@ namespace quda {
     return;
   }
   
+  TRLanczos::TRLanczos(const DiracMatrix &mat, QudaEigParam &eigParam, TimeProfile &profile, int nEv) :
+    mat(mat), eigParam(eigParam), profile(profile), nEv(nEv), nKr(eigParam.nKr), tol(eigParam.Stp_residual),
+    max_restarts(eigParam.max_restarts), poly_deg(eigParam.NPoly),
+    a_min(eigParam.NPoly > 0 ? eigParam.MatPoly_param[0] : 0.0),
+    a_max(eigParam.NPoly > 0 ? eigParam.MatPoly_param[1] : 0.0),
+    r(nullptr), tmp1(nullptr), tmp2(nullptr), alpha(nKr, 0.0), beta(nKr, 0.0), num_keep(0)
+  {
+    if (nEv <= 0) errorQuda("Number of wanted eigenpairs %d must be positive", nEv);
+    if (nKr < nEv + 2) errorQuda("Krylov space size %d must be at least nEv + 2 = %d", nKr, nEv + 2);
+    if (poly_deg > 0 && a_max <= a_min) errorQuda("Invalid Chebyshev interval [%e, %e]", a_min, a_max);
+  }
+
+  TRLanczos::~TRLanczos()
+  {
+    for (auto &w : work) delete w;
+    if (r) delete r;
+    if (tmp1) delete tmp1;
+    if (tmp2) delete tmp2;
+  }
+
+  void TRLanczos::chebyOp(ColorSpinorField &out, const ColorSpinorField &in)
+  {
+    mat(out, in);
+    if (poly_deg == 0) return;
+
+    // y(A) = d1 A + d0 maps [a_min, a_max] onto [-1, 1]
+    const double d1 = -2.0 / (a_max - a_min);
+    const double d0 = (a_max + a_min) / (a_max - a_min);
+
+    ColorSpinorField &x = const_cast<ColorSpinorField&>(in);
+    blas::axpby(d0, x, d1, out); // T_1 = y(A) in
+    if (poly_deg == 1) return;
+
+    ColorSpinorField *tm1 = tmp1, *tk = tmp2;
+    blas::copy(*tm1, x);
+    blas::copy(*tk, out);
+
+    for (int k = 2; k <= poly_deg; k++) {
+      // T_k = 2 y(A) T_{k-1} - T_{k-2}
+      mat(out, *tk);
+      blas::axpby(2.0*d0, *tk, 2.0*d1, out);
+      blas::axpy(-1.0, *tm1, out);
+      if (k < poly_deg) {
+        std::swap(tm1, tk);
+        blas::copy(*tk, out);
+      }
+    }
+  }
+
+  void TRLanczos::blockOrthogonalize(std::vector<ColorSpinorField*> &kSpace, int n)
+  {
+    std::vector<ColorSpinorField*> v(kSpace.begin(), kSpace.begin() + n);
+    std::vector<ColorSpinorField*> rv(1, r);
+
+    Complex *h = new Complex[n];
+    blas::cDotProduct(h, v, rv);
+    for (int i = 0; i < n; i++) h[i] = -h[i];
+    blas::caxpy(h, v, rv);
+    delete []h;
+  }
+
+  void TRLanczos::lanczosStep(std::vector<ColorSpinorField*> &kSpace, int j)
+  {
+    chebyOp(*r, *kSpace[j]);
+
+    if (j == num_keep && num_keep > 0) {
+      // first step after a thick restart: couple to all retained Ritz vectors
+      std::vector<ColorSpinorField*> v(kSpace.begin(), kSpace.begin() + num_keep);
+      std::vector<ColorSpinorField*> rv(1, r);
+      Complex *s = new Complex[num_keep];
+      for (int i = 0; i < num_keep; i++) s[i] = -beta[i];
+      blas::caxpy(s, v, rv);
+      delete []s;
+    } else if (j > 0) {
+      blas::axpy(-beta[j-1], *kSpace[j-1], *r);
+    }
+
+    alpha[j] = blas::reDotProduct(*kSpace[j], *r);
+    blas::axpy(-alpha[j], *kSpace[j], *r);
+
+    // full reorthogonalization against the current basis
+    blockOrthogonalize(kSpace, j+1);
+
+    beta[j] = sqrt(blas::norm2(*r));
+    if (beta[j] == 0.0) errorQuda("Lanczos breakdown at step %d", j);
+    blas::copy(*kSpace[j+1], *r);
+    blas::ax(1.0/beta[j], *kSpace[j+1]);
+  }
+
+  void TRLanczos::restart(std::vector<ColorSpinorField*> &kSpace, const double *Y, const double *theta, int n)
+  {
+    if ((int)work.size() < n) {
+      ColorSpinorParam param(*kSpace[0]);
+      param.create = QUDA_ZERO_FIELD_CREATE;
+      for (int i = work.size(); i < n; i++) work.push_back(ColorSpinorField::Create(param));
+    }
+
+    // work_i = sum_j Y_{ji} v_j
+    std::vector<ColorSpinorField*> v(kSpace.begin(), kSpace.begin() + nKr);
+    std::vector<ColorSpinorField*> w(work.begin(), work.begin() + n);
+    Complex *a = new Complex[nKr*n];
+    for (int j = 0; j < nKr; j++)
+      for (int i = 0; i < n; i++) a[j*n + i] = Y[i*nKr + j];
+    for (int i = 0; i < n; i++) blas::zero(*w[i]);
+    blas::caxpy(a, v, w);
+    delete []a;
+
+    for (int i = 0; i < n; i++) blas::copy(*kSpace[i], *w[i]);
+
+    // the residual vector continues the factorization
+    if (n < nKr) {
+      blas::copy(*kSpace[n], *kSpace[nKr]);
+      const double beta_last = beta[nKr-1];
+      for (int i = 0; i < n; i++) {
+        alpha[i] = theta[i];
+        beta[i] = beta_last * Y[i*nKr + nKr-1];
+      }
+    }
+
+    num_keep = n;
+  }
+
+  int TRLanczos::operator()(std::vector<ColorSpinorField*> &kSpace, double *evals)
+  {
+    using namespace Eigen;
+
+    if ((int)kSpace.size() < nKr+1) errorQuda("Krylov space size %lu less than nKr+1 = %d", kSpace.size(), nKr+1);
+
+    profile.TPSTART(QUDA_PROFILE_INIT);
+    ColorSpinorParam param(*kSpace[0]);
+    param.create = QUDA_ZERO_FIELD_CREATE;
+    if (!r) r = ColorSpinorField::Create(param);
+    if (poly_deg > 1) {
+      if (!tmp1) tmp1 = ColorSpinorField::Create(param);
+      if (!tmp2) tmp2 = ColorSpinorField::Create(param);
+    }
+    profile.TPSTOP(QUDA_PROFILE_INIT);
+
+    profile.TPSTART(QUDA_PROFILE_COMPUTE);
+
+    const double b2 = blas::norm2(*kSpace[0]);
+    if (b2 == 0.0) errorQuda("Initial Lanczos vector is zero");
+    blas::ax(1.0/sqrt(b2), *kSpace[0]);
+    num_keep = 0;
+
+    // with a filter the wanted eigenvalues are the largest of T_n(y(A))
+    const bool largest = (poly_deg > 0);
+
+    std::vector<int> order(nKr);
+    std::vector<double> theta(nKr);
+    std::vector<double> Ysort(nKr*nKr);
+    int nconv = 0;
+    int restart_iter = 0;
+
+    while (true) {
+      for (int j = num_keep; j < nKr; j++) lanczosStep(kSpace, j);
+
+      // projected matrix: arrowhead for the retained block, then tridiagonal
+      MatrixXd T = MatrixXd::Zero(nKr, nKr);
+      for (int i = 0; i < nKr; i++) T(i,i) = alpha[i];
+      for (int i = 0; i < num_keep; i++) T(i,num_keep) = T(num_keep,i) = beta[i];
+      for (int i = num_keep; i < nKr-1; i++) T(i,i+1) = T(i+1,i) = beta[i];
+
+      SelfAdjointEigenSolver<MatrixXd> eigensolver(T);
+      const VectorXd &ev = eigensolver.eigenvalues();     // ascending
+      const MatrixXd &Y = eigensolver.eigenvectors();
+
+      for (int i = 0; i < nKr; i++) order[i] = largest ? nKr-1-i : i;
+      for (int i = 0; i < nKr; i++) {
+        theta[i] = ev(order[i]);
+        for (int j = 0; j < nKr; j++) Ysort[i*nKr + j] = Y(j, order[i]);
+      }
+
+      // residual estimates of the Ritz pairs from the last row of Y
+      nconv = 0;
+      for (int i = 0; i < nEv; i++) {
+        const double res = fabs(beta[nKr-1] * Ysort[i*nKr + nKr-1]);
+        if (res < tol * fabs(theta[i])) nconv++;
+      }
+
+      if (getVerbosity() >= QUDA_VERBOSE)
+        printfQuda("TRLanczos: restart %d, %d of %d eigenpairs converged\n", restart_iter, nconv, nEv);
+
+      if (nconv == nEv || restart_iter == max_restarts) break;
+
+      // keep the wanted Ritz vectors plus some of the nearby unwanted ones
+      const int keep = nEv + std::min(nconv, (nKr - nEv) / 2);
+      restart(kSpace, Ysort.data(), theta.data(), keep);
+      restart_iter++;
+    }
+
+    // rotate the Krylov space onto the nEv wanted Ritz vectors
+    restart(kSpace, Ysort.data(), theta.data(), nEv);
+
+    // eigenvalues and true residuals with respect to the unfiltered operator
+    for (int i = 0; i < nEv; i++) {
+      mat(*r, *kSpace[i]);
+      evals[i] = blas::reDotProduct(*kSpace[i], *r);
+      blas::axpy(-evals[i], *kSpace[i], *r);
+      if (getVerbosity() >= QUDA_SUMMARIZE)
+        printfQuda("TRLanczos: eigenvalue %d = %e, residual = %e\n", i, evals[i], sqrt(blas::norm2(*r)));
+    }
+
+    profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+    if (nconv < nEv) warningQuda("TRLanczos: only %d of %d eigenpairs converged after %d restarts", nconv, nEv, restart_iter);
+    else if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("TRLanczos: %d eigenpairs converged after %d restarts\n", nEv, restart_iter);
+
+    return nconv;
+  }
+
 #if 0
   ImpRstLanczos::ImpRstLanczos(RitzMat &ritz_mat, QudaEigParam &eigParam, TimeProfile &profile) :
     Eig_Solver(eigParam, profile), ritz_mat(ritz_mat)
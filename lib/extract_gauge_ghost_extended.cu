@@ -10,6 +10,7 @@ namespace quda {
     Order order;
     int X[nDim];
     int R[nDim];
+    int r[nDim];
     int surfaceCB[nDim];
     int A0[nDim];
     int A1[nDim];
@@ -21,7 +22,7 @@ namespace quda {
     int fBuf[nDim][nDim];
     int localParity[nDim];
     int threads;
-    ExtractGhostExArg(const Order &order, const int *X_, const int *R_, 
+    ExtractGhostExArg(const Order &order, const int *X_, const int *R_, const int *r_,
 		      const int *surfaceCB_, 
 		      const int *A0_, const int *A1_, const int *B0_, const int *B1_, 
 		      const int *C0_, const int *C1_, const int fBody_[nDim][nDim], 
@@ -33,6 +34,7 @@ namespace quda {
       for (int d=0; d<nDim; d++) {
 	X[d] = X_[d];
 	R[d] = R_[d];
+	r[d] = r_[d];
 	surfaceCB[d] = surfaceCB_[d];
 	A0[d] = A0_[d];
 	A1[d] = A1_[d];
@@ -50,6 +52,19 @@ namespace quda {
 
   };
 
+  /**
+     @brief First slice in the extended dimension dim of the region
+     that is extracted from the body (extract=true) or injected into
+     the halo (extract=false).  The halo depth R may be smaller than
+     the radius r of the extended region, in which case only the
+     innermost R slices of the halo are refreshed.
+  */
+  template <bool extract, int dim, typename Arg>
+  __device__ __host__ inline int haloSlice(const Arg &arg, int dir) {
+    return extract ? (dir ? arg.X[dim] + arg.r[dim] - arg.R[dim] : arg.r[dim]) :
+      (dir ? arg.X[dim] + arg.r[dim] : arg.r[dim] - arg.R[dim]);
+  }
+
   template <typename Float, int length, int dim, typename Arg>
   __device__ __host__ void extractor(Arg &arg, int dir, int a, int b, 
 				     int c, int d, int g, int parity) {
@@ -58,7 +73,7 @@ namespace quda {
 		  c*arg.fBody[dim][2] + d*arg.fBody[dim][3]) >> 1;
     
     int dstIdx = (a*arg.fBuf[dim][0] + b*arg.fBuf[dim][1] + 
-		  c*arg.fBuf[dim][2] + (d-(dir?arg.X[dim]:arg.R[dim]))*arg.fBuf[dim][3]) >> 1;
+		  c*arg.fBuf[dim][2] + (d-haloSlice<true,dim>(arg,dir))*arg.fBuf[dim][3]) >> 1;
     
     // load the ghost element from the bulk
     arg.order.load(u, srcIdx, g, parity); 
@@ -74,7 +89,7 @@ namespace quda {
 				    int c, int d, int g, int parity) {
     typename mapper<Float>::type u[length];
     int srcIdx = (a*arg.fBuf[dim][0] + b*arg.fBuf[dim][1] + 
-		  c*arg.fBuf[dim][2] + (d-dir*(arg.X[dim]+arg.R[dim]))*arg.fBuf[dim][3]) >> 1;
+		  c*arg.fBuf[dim][2] + (d-haloSlice<false,dim>(arg,dir))*arg.fBuf[dim][3]) >> 1;
     
     int dstIdx = (a*arg.fBody[dim][0] + b*arg.fBody[dim][1] + 
 		  c*arg.fBody[dim][2] + d*arg.fBody[dim][3]) >> 1;
@@ -102,7 +117,7 @@ namespace quda {
       // dir = 0 backwards, dir = 1 forwards
       for (int dir = 0; dir<2; dir++) {
 
-	int D0 = extract ? dir*arg.X[dim] + (1-dir)*arg.R[dim] : dir*(arg.X[dim] + arg.R[dim]); 
+	int D0 = haloSlice<extract,dim>(arg, dir);
 	  
 	for (int d=D0; d<D0+arg.R[dim]; d++) {
 	  for (int a=arg.A0[dim]; a<arg.A1[dim]; a++) { // loop over the interior surface
@@ -161,7 +176,7 @@ namespace quda {
 	int dA = arg.A1[dim]-arg.A0[dim];
 	int dB = arg.B1[dim]-arg.B0[dim];
 	int dC = arg.C1[dim]-arg.C0[dim];
-	int D0 = extract ? dir*arg.X[dim] + (1-dir)*arg.R[dim] : dir*(arg.X[dim] + arg.R[dim]); 
+	int D0 = haloSlice<extract,dim>(arg, dir);
 
 	// thread order is optimized to maximize coalescing
 	// X = (((g*R + d) * dA + a)*dB + b)*dC + c
@@ -209,8 +224,8 @@ namespace quda {
       int dB = arg.B1[dim]-arg.B0[dim];
       int dC = arg.C1[dim]-arg.C0[dim];
       size = arg.R[dim]*dA*dB*dC*arg.order.geometry;
-      writeAuxString("prec=%lu,stride=%d,extract=%d,dimension=%d,geometry=%d",
-		     sizeof(Float),arg.order.stride, extract, dim, arg.order.geometry);
+      writeAuxString("prec=%lu,stride=%d,extract=%d,dimension=%d,geometry=%d,depth=%d",
+		     sizeof(Float),arg.order.stride, extract, dim, arg.order.geometry, arg.R[dim]);
     }
     virtual ~ExtractGhostEx() { ; }
   
@@ -219,21 +234,29 @@ namespace quda {
 	if (location==QUDA_CPU_FIELD_LOCATION) {
 	  extractGhostEx<Float,length,nDim,dim,Order,true>(arg);
 	} else {
+#ifndef QUDA_HOST_ONLY
 	  TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	  tp.grid.y = 2;
 	  tp.grid.z = 2;
 	  extractGhostExKernel<Float,length,nDim,dim,Order,true> 
 	    <<<tp.grid, tp.block, tp.shared_bytes, stream>>>(arg);
+#else
+	  errorQuda("GPU fields are not supported in a host-only build");
+#endif
 	}
       } else { // we are injecting
 	if (location==QUDA_CPU_FIELD_LOCATION) {
 	  extractGhostEx<Float,length,nDim,dim,Order,false>(arg);
 	} else {
+#ifndef QUDA_HOST_ONLY
 	  TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	  tp.grid.y = 2;
 	  tp.grid.z = 2;
 	  extractGhostExKernel<Float,length,nDim,dim,Order,false> 
 	    <<<tp.grid, tp.block, tp.shared_bytes, stream>>>(arg);
+#else
+	  errorQuda("GPU fields are not supported in a host-only build");
+#endif
 	}
       }
     }
@@ -249,7 +272,8 @@ namespace quda {
      Generic CPU gauge ghost extraction and packing
      NB This routines is specialized to four dimensions
      @param E the extended gauge dimensions
-     @param R array holding the radius of the extended region 
+     @param R array holding the depth of the halo to be exchanged
+     (at most the radius of the extended region)
      @param extract Whether we are extracting or injecting the ghost zone
   */
   template <typename Float, int length, typename Order>
@@ -260,18 +284,27 @@ namespace quda {
     //A0, B0, C0 the minimum value
     //A0, B0, C0 the maximum value
 
+    // radius of the extended region: fields that are not flagged as
+    // extended are assumed to be exchanged at their full radius
+    int r[nDim];
+    for (int d=0; d<nDim; d++) {
+      r[d] = u.GhostExchange() == QUDA_GHOST_EXCHANGE_EXTENDED ? u.R()[d] : R[d];
+      if (R[d] > r[d]) errorQuda("Halo depth R[%d] = %d exceeds the extended radius %d", d, R[d], r[d]);
+    }
+
     int X[nDim]; // compute interior dimensions
-    for (int d=0; d<nDim; d++) X[d] = E[d] - 2*R[d];
+    for (int d=0; d<nDim; d++) X[d] = E[d] - 2*r[d];
 
+    // previously exchanged dimensions include their (depth R) halos so that corners are filled
     //..........x..........y............z.............t
-    int A0[nDim] = {R[3],      R[3],        R[3],         0};
-    int A1[nDim] = {X[3]+R[3], X[3]+R[3],   X[3]+R[3],    X[2]+2*R[2]};
+    int A0[nDim] = {r[3],      r[3],        r[3],         r[2]-R[2]};
+    int A1[nDim] = {X[3]+r[3], X[3]+r[3],   X[3]+r[3],    X[2]+r[2]+R[2]};
     
-    int B0[nDim] = {R[2],      R[2],        0,            0};
-    int B1[nDim] = {X[2]+R[2], X[2]+R[2],   X[1]+2*R[1],  X[1]+2*R[1]};
+    int B0[nDim] = {r[2],      r[2],        r[1]-R[1],    r[1]-R[1]};
+    int B1[nDim] = {X[2]+r[2], X[2]+r[2],   X[1]+r[1]+R[1], X[1]+r[1]+R[1]};
     
-    int C0[nDim] = {R[1],      0,           0,            0};
-    int C1[nDim] = {X[1]+R[1], X[0]+2*R[0], X[0]+2*R[0],  X[0]+2*R[0]};
+    int C0[nDim] = {r[1],      r[0]-R[0],   r[0]-R[0],    r[0]-R[0]};
+    int C1[nDim] = {X[1]+r[1], X[0]+r[0]+R[0], X[0]+r[0]+R[0], X[0]+r[0]+R[0]};
 
     int fSrc[nDim][nDim] = {
       {E[2]*E[1]*E[0], E[1]*E[0], E[0],              1},
@@ -297,22 +330,22 @@ namespace quda {
     //      localParity[dim] = (X[dim]%2==0 || commDim(dim)) ? 0 : 1;
 
     if (dim==0) {
-      ExtractGhostExArg<Order,nDim,0> arg(order, X, R, surfaceCB, A0, A1, B0, B1, 
+      ExtractGhostExArg<Order,nDim,0> arg(order, X, R, r, surfaceCB, A0, A1, B0, B1, 
 					  C0, C1, fSrc, fBuf, localParity);
       ExtractGhostEx<Float,length,nDim,0,Order> extractor(arg, extract, u, location);
       extractor.apply(0);
     } else if (dim==1) {
-      ExtractGhostExArg<Order,nDim,1> arg(order, X, R, surfaceCB, A0, A1, B0, B1, 
+      ExtractGhostExArg<Order,nDim,1> arg(order, X, R, r, surfaceCB, A0, A1, B0, B1, 
 					  C0, C1, fSrc, fBuf, localParity);
       ExtractGhostEx<Float,length,nDim,1,Order> extractor(arg, extract, u, location);
       extractor.apply(0);
     } else if (dim==2) {
-      ExtractGhostExArg<Order,nDim,2> arg(order, X, R, surfaceCB, A0, A1, B0, B1, 
+      ExtractGhostExArg<Order,nDim,2> arg(order, X, R, r, surfaceCB, A0, A1, B0, B1, 
 					  C0, C1, fSrc, fBuf, localParity);
       ExtractGhostEx<Float,length,nDim,2,Order> extractor(arg, extract, u, location);
       extractor.apply(0);
     } else if (dim==3) {
-      ExtractGhostExArg<Order,nDim,3> arg(order, X, R, surfaceCB, A0, A1, B0, B1, 
+      ExtractGhostExArg<Order,nDim,3> arg(order, X, R, r, surfaceCB, A0, A1, B0, B1, 
 					  C0, C1, fSrc, fBuf, localParity);
       ExtractGhostEx<Float,length,nDim,3,Order> extractor(arg, extract, u, location);
       extractor.apply(0);
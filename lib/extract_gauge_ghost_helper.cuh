@@ -199,6 +199,7 @@ namespace quda {
 	if (extract) extractGhost<Float,length,nDim,Order,true>(arg);
 	else extractGhost<Float,length,nDim,Order,false>(arg);
       } else {
+#ifndef QUDA_HOST_ONLY
 	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	if (extract) {
 	  extractGhostKernel<Float, length, nDim, Order, true>
@@ -207,6 +208,9 @@ namespace quda {
 	  extractGhostKernel<Float, length, nDim, Order, false>
 	    <<<tp.grid, tp.block, tp.shared_bytes, stream>>>(arg);
 	}
+#else
+	errorQuda("GPU fields are not supported in a host-only build");
+#endif
       }
     }
 
@@ -120,6 +120,7 @@ namespace quda {
       }
     }
     staggeredPhaseApplied = true;
+    updateVersion();
   }
 
   void GaugeField::removeStaggeredPhase() {
@@ -133,6 +134,7 @@ namespace quda {
       }
     }
     staggeredPhaseApplied = false;
+    updateVersion();
   }
 
   bool GaugeField::isNative() const {
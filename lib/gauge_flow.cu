@@ -0,0 +1,541 @@
+#include <quda_internal.h>
+#include <quda_matrix.h>
+#include <su3_project.cuh>
+#include <tune_quda.h>
+#include <gauge_field.h>
+#include <gauge_field_order.h>
+#include <launch_kernel.cuh>
+#include <atomic.cuh>
+#include <cub_helper.cuh>
+#include <index_helper.cuh>
+
+#ifndef Pi2
+#define Pi2   6.2831853071795864769252867665590
+#endif
+
+namespace quda {
+
+#ifdef GPU_GAUGE_TOOLS
+
+  /**
+     Gradient flow dV/dt = Z(V) V integrated with Luscher's low-storage
+     third-order Runge-Kutta scheme (arXiv:1006.4518):
+
+       W1 = exp(phi1) W0,  phi1 = 1/4 Z0
+       W2 = exp(phi2) W1,  phi2 = 8/9 Z1 - 17/9 phi1
+       W3 = exp(phi3) W2,  phi3 = 3/4 Z2 - phi2
+
+     with Zi = epsilon Z(Wi).  The gauge field is updated in place, so
+     the only extra storage is the generator field, which holds two
+     traceless anti-Hermitian matrices per link packed into one 3x3
+     complex matrix: phi_i, and phi1 which is kept for the embedded
+     second-order error estimate exp(2 Z1 - Z0) W0 used to steer the
+     step size (Fritzsch and Ramos, arXiv:1301.4388).
+  */
+  template <typename Float, typename Gauge, typename Generator>
+  struct GaugeFlowArg : public ReduceArg<double4> {
+    int threads; // number of active threads required
+    int X[4]; // true grid dimensions
+    int E[4]; // extended grid dimensions
+    int border[4];
+    Gauge U;
+    Generator Z;
+    const Float epsilon;
+    const Float c0; // plaquette coefficient of the flow action
+    const Float c1; // rectangle coefficient of the flow action
+    int stage; // Runge-Kutta stage (1-3), 0 for measurement only
+    bool measure;
+
+    GaugeFlowArg(const Gauge &U, const Generator &Z, const GaugeField &data, Float epsilon, QudaWFlowType type)
+      : ReduceArg<double4>(), threads(1), U(U), Z(Z), epsilon(epsilon),
+	c0(type == QUDA_WFLOW_TYPE_SYMANZIK ? 5.0/3.0 : 1.0),
+	c1(type == QUDA_WFLOW_TYPE_SYMANZIK ? -1.0/12.0 : 0.0), stage(0), measure(false)
+    {
+      for (int dir=0; dir<4; ++dir) {
+	border[dir] = data.R()[dir];
+	E[dir] = data.X()[dir];
+	X[dir] = data.X()[dir] - border[dir]*2;
+	threads *= X[dir];
+      }
+      threads /= 2;
+    }
+  };
+
+  // load the link U_dir(x + a*mu + b*nu)
+  template <typename Float, typename Arg>
+  __host__ __device__ inline Matrix<complex<Float>,3> flowLink(Arg &arg, int dir, const int x[4], int parity,
+							       int mu=0, int a=0, int nu=0, int b=0) {
+    int dx[4] = {0, 0, 0, 0};
+    dx[mu] += a;
+    dx[nu] += b;
+    return arg.U(dir, linkIndexShift(x,dx,arg.E), (parity + a + b) & 1);
+  }
+
+  // lower-triangular storage index of the plane (mu,nu), mu < nu
+  __host__ __device__ inline int planeIndex(int mu, int nu) { return (mu*(7-mu))/2 + nu - mu - 1; }
+
+  // traceless anti-Hermitian projection
+  template <typename Float>
+  __host__ __device__ inline void projectTA(Matrix<complex<Float>,3> &A) {
+    A -= conj(A);
+    A *= static_cast<Float>(0.5);
+    complex<Float> tr = static_cast<Float>(1.0/3.0) * getTrace(A);
+    for (int i=0; i<3; i++) A(i,i) -= tr;
+  }
+
+  /**
+     Pack two traceless anti-Hermitian matrices (8 real parameters
+     each) into the 18 real numbers of a 3x3 complex matrix.
+  */
+  template <typename Float>
+  __host__ __device__ inline void packGenerators(Matrix<complex<Float>,3> &m, const Matrix<complex<Float>,3> &a,
+						 const Matrix<complex<Float>,3> &b) {
+    m(0,0) = complex<Float>(a(0,0).imag(), a(1,1).imag());
+    m(0,1) = a(0,1);
+    m(0,2) = a(0,2);
+    m(1,2) = a(1,2);
+    m(1,1) = complex<Float>(b(0,0).imag(), b(1,1).imag());
+    m(1,0) = b(0,1);
+    m(2,0) = b(0,2);
+    m(2,1) = b(1,2);
+    m(2,2) = complex<Float>(0.0, 0.0);
+  }
+
+  template <typename Float>
+  __host__ __device__ inline void unpackGenerators(Matrix<complex<Float>,3> &a, Matrix<complex<Float>,3> &b,
+						   const Matrix<complex<Float>,3> &m) {
+    a(0,0) = complex<Float>(0.0, m(0,0).real());
+    a(1,1) = complex<Float>(0.0, m(0,0).imag());
+    a(2,2) = complex<Float>(0.0, -m(0,0).real() - m(0,0).imag());
+    a(0,1) = m(0,1); a(1,0) = -conj(m(0,1));
+    a(0,2) = m(0,2); a(2,0) = -conj(m(0,2));
+    a(1,2) = m(1,2); a(2,1) = -conj(m(1,2));
+
+    b(0,0) = complex<Float>(0.0, m(1,1).real());
+    b(1,1) = complex<Float>(0.0, m(1,1).imag());
+    b(2,2) = complex<Float>(0.0, -m(1,1).real() - m(1,1).imag());
+    b(0,1) = m(1,0); b(1,0) = -conj(m(1,0));
+    b(0,2) = m(2,0); b(2,0) = -conj(m(2,0));
+    b(1,2) = m(2,1); b(2,1) = -conj(m(2,1));
+  }
+
+  /**
+     Compute the flow generators of all four links at site x from the
+     current field and advance the Runge-Kutta accumulator.  On
+     measurement passes the clover field strength is assembled from
+     the same staple products, so the plaquette, the clover energy
+     density and the topological charge density come out of the
+     pass.  Returns (plaquette, energy, charge, squared error) site
+     contributions.
+  */
+  template <typename Float, typename Arg>
+  __host__ __device__ inline double4 gaugeFlowStage(Arg &arg, int x_cb, int parity) {
+    typedef Matrix<complex<Float>,3> Link;
+
+    int x[4];
+    getCoords(x, x_cb, arg.X, parity);
+    for (int dr=0; dr<4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
+
+    double4 obs = make_double4(0.0, 0.0, 0.0, 0.0);
+    Link F[6];
+    if (arg.measure) for (int p=0; p<6; p++) setZero(&F[p]);
+
+    for (int mu=0; mu<4; mu++) {
+      Link Umu = flowLink<Float>(arg, mu, x, parity);
+      Link staple, rect;
+      setZero(&staple);
+      setZero(&rect);
+
+      for (int nu=0; nu<4; nu++) {
+	if (nu == mu) continue;
+
+	// upper staple U_nu(x) U_mu(x+nu) U^dag_nu(x+mu)
+	Link U1 = flowLink<Float>(arg, nu, x, parity);
+	Link U2 = flowLink<Float>(arg, mu, x, parity, nu, 1);
+	Link U3 = flowLink<Float>(arg, nu, x, parity, mu, 1);
+	Link up = U1 * U2 * conj(U3);
+
+	// lower staple U^dag_nu(x-nu) U_mu(x-nu) U_nu(x-nu+mu)
+	Link L1 = flowLink<Float>(arg, nu, x, parity, nu, -1);
+	Link L2 = flowLink<Float>(arg, mu, x, parity, nu, -1);
+	Link L3 = flowLink<Float>(arg, nu, x, parity, mu, 1, nu, -1);
+	Link down = conj(L1) * L2 * L3;
+
+	staple += up;
+	staple += down;
+
+	if (arg.measure) {
+	  // the leaves at x in the quadrants (+mu,+nu) and (+mu,-nu);
+	  // the (+mu,+nu) leaf is shared with link nu, so it is only
+	  // taken once, and a reversed leaf enters with a minus sign
+	  // since only the anti-Hermitian part is kept
+	  Link lower_leaf = down * conj(Umu);
+	  if (nu > mu) {
+	    F[planeIndex(mu,nu)] += Umu * conj(up);
+	    F[planeIndex(mu,nu)] += lower_leaf;
+	  } else {
+	    F[planeIndex(nu,mu)] -= lower_leaf;
+	  }
+	}
+
+	if (arg.stage > 0 && arg.c1 != static_cast<Float>(0.0)) {
+	  // 1x2 rectangles along +nu and -nu
+	  rect += U1 * flowLink<Float>(arg, nu, x, parity, nu, 1) * flowLink<Float>(arg, mu, x, parity, nu, 2)
+	    * conj(flowLink<Float>(arg, nu, x, parity, mu, 1, nu, 1)) * conj(U3);
+	  rect += conj(L1) * conj(flowLink<Float>(arg, nu, x, parity, nu, -2)) * flowLink<Float>(arg, mu, x, parity, nu, -2)
+	    * flowLink<Float>(arg, nu, x, parity, mu, 1, nu, -2) * L3;
+
+	  // 2x1 rectangles extending forwards along mu
+	  Link Umu_fwd = flowLink<Float>(arg, mu, x, parity, mu, 1);
+	  rect += U1 * U2 * flowLink<Float>(arg, mu, x, parity, mu, 1, nu, 1)
+	    * conj(flowLink<Float>(arg, nu, x, parity, mu, 2)) * conj(Umu_fwd);
+	  rect += conj(L1) * L2 * flowLink<Float>(arg, mu, x, parity, mu, 1, nu, -1)
+	    * flowLink<Float>(arg, nu, x, parity, mu, 2, nu, -1) * conj(Umu_fwd);
+
+	  // 2x1 rectangles extending backwards along mu
+	  Link Umu_bwd = flowLink<Float>(arg, mu, x, parity, mu, -1);
+	  rect += conj(Umu_bwd) * flowLink<Float>(arg, nu, x, parity, mu, -1)
+	    * flowLink<Float>(arg, mu, x, parity, mu, -1, nu, 1) * U2 * conj(U3);
+	  rect += conj(Umu_bwd) * conj(flowLink<Float>(arg, nu, x, parity, mu, -1, nu, -1))
+	    * flowLink<Float>(arg, mu, x, parity, mu, -1, nu, -1) * L2 * L3;
+	}
+      }
+
+      Link Omega = staple * conj(Umu);
+      if (arg.measure) obs.x += getTrace(Omega).real();
+      if (arg.stage == 0) continue;
+
+      if (arg.c1 != static_cast<Float>(0.0)) Omega = arg.c0 * Omega + arg.c1 * (rect * conj(Umu));
+      projectTA(Omega);
+      Link Zk = arg.epsilon * Omega;
+
+      Link phi, phi1, m;
+      if (arg.stage > 1) {
+	m = arg.Z(mu, x_cb, parity);
+	unpackGenerators(phi, phi1, m);
+      }
+
+      switch (arg.stage) {
+      case 1:
+	phi1 = static_cast<Float>(0.25) * Zk;
+	phi = phi1;
+	break;
+      case 2:
+	phi = static_cast<Float>(8.0/9.0) * Zk - static_cast<Float>(17.0/9.0) * phi;
+	break;
+      case 3:
+	{
+	  // distance to the embedded second-order solution
+	  Link err = Zk - static_cast<Float>(3.0) * phi + phi1;
+	  err *= static_cast<Float>(0.75);
+	  for (int i=0; i<3; i++) for (int j=0; j<3; j++) obs.w += norm(err(i,j));
+	  phi = static_cast<Float>(0.75) * Zk - phi;
+	}
+	break;
+      }
+
+      packGenerators(m, phi, phi1);
+      arg.Z(mu, x_cb, parity) = m;
+    }
+
+    if (arg.measure) {
+      for (int mu=0; mu<3; mu++) {
+	for (int nu=mu+1; nu<4; nu++) {
+	  // remaining leaf in the quadrant (-mu,-nu)
+	  Link leaf = conj(flowLink<Float>(arg, mu, x, parity, mu, -1))
+	    * conj(flowLink<Float>(arg, nu, x, parity, mu, -1, nu, -1))
+	    * flowLink<Float>(arg, mu, x, parity, mu, -1, nu, -1)
+	    * flowLink<Float>(arg, nu, x, parity, nu, -1);
+
+	  Link &f = F[planeIndex(mu,nu)];
+	  f += leaf;
+	  projectTA(f);
+	  f *= static_cast<Float>(0.25); // (Q - Q^dag) / 8
+	}
+      }
+
+      for (int p=0; p<6; p++) obs.y -= getTrace(F[p] * F[p]).real();
+      obs.z = (getTrace(F[0] * F[5]).real() - getTrace(F[1] * F[4]).real() + getTrace(F[2] * F[3]).real()) / (Pi2*Pi2);
+    }
+
+    return obs;
+  }
+
+  template<int blockSize, typename Float, typename Arg>
+  __global__ void computeGaugeFlowStage(Arg arg) {
+    int x_cb = threadIdx.x + blockIdx.x*blockDim.x;
+    int parity = threadIdx.y;
+
+    double4 obs = make_double4(0.0, 0.0, 0.0, 0.0);
+    if (x_cb < arg.threads) obs = gaugeFlowStage<Float>(arg, x_cb, parity);
+
+    // perform final inter-block reduction and write out result
+    reduce2d<blockSize,2>(arg, obs);
+  }
+
+  template<typename Float, typename Arg>
+  void computeGaugeFlowStageCPU(Arg &arg) {
+    double4 obs = make_double4(0.0, 0.0, 0.0, 0.0);
+    for (int parity=0; parity<2; parity++) {
+      for (int x_cb=0; x_cb<arg.threads; x_cb++) {
+	obs += gaugeFlowStage<Float>(arg, x_cb, parity);
+      }
+    }
+    arg.result_h[0] = obs;
+  }
+
+  template<typename Float, typename Arg>
+  class GaugeFlowStage : TunableLocalParity {
+    Arg &arg;
+    const GaugeField &meta;
+    GaugeField &Z;
+
+  private:
+    unsigned int minThreads() const { return arg.threads; }
+
+  public:
+    GaugeFlowStage(Arg &arg, const GaugeField &meta, GaugeField &Z) : arg(arg), meta(meta), Z(Z) { }
+    virtual ~GaugeFlowStage () { }
+
+    void apply(const cudaStream_t &stream) {
+      if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) {
+	arg.result_h[0] = make_double4(0.0, 0.0, 0.0, 0.0);
+	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+	LAUNCH_KERNEL_LOCAL_PARITY(computeGaugeFlowStage, tp, stream, arg, Float, Arg);
+	cudaDeviceSynchronize();
+      } else {
+	computeGaugeFlowStageCPU<Float>(arg);
+      }
+    }
+
+    TuneKey tuneKey() const {
+      std::stringstream aux;
+      aux << "threads=" << arg.threads << ",prec=" << sizeof(Float) << ",stage=" << arg.stage
+	  << (arg.measure ? ",measure" : "") << (rectangles() ? ",rect" : "");
+      return TuneKey(meta.VolString(), typeid(*this).name(), aux.str().c_str());
+    }
+
+    // the generator field is updated in place
+    void preTune() { if (arg.stage > 0) Z.backup(); }
+    void postTune() { if (arg.stage > 0) Z.restore(); }
+
+    bool rectangles() const { return arg.stage > 0 && arg.c1 != static_cast<Float>(0.0); }
+
+    long long flops() const {
+      long long staple = 6*(4*198ll) + (rectangles() ? 6*(6*4*198ll) : 0);
+      long long clover = arg.measure ? 6*(4*198ll) + 7*198ll : 0;
+      return 2ll*arg.threads*(4*(staple + 198) + clover);
+    }
+    long long bytes() const {
+      int links = 1 + 6*6 + (rectangles() ? 6*14 : 0);
+      return 2ll*arg.threads*4*(links*arg.U.Bytes() + (arg.stage > 0 ? 2 : 0)*arg.Z.Bytes());
+    }
+  }; // GaugeFlowStage
+
+  template<typename Float, typename Arg>
+  __host__ __device__ inline void gaugeFlowUpdate(Arg &arg, int x_cb, int parity, int mu) {
+    typedef Matrix<complex<Float>,3> Link;
+
+    int x[4];
+    getCoords(x, x_cb, arg.X, parity);
+    for (int dr=0; dr<4; ++dr) x[dr] += arg.border[dr];
+
+    Link m = arg.Z(mu, x_cb, parity);
+    Link phi, phi1;
+    unpackGenerators(phi, phi1, m);
+
+    // exp(phi) = exp(iQ) with Hermitian Q = -i phi
+    Link Q = complex<Float>(0.0, -1.0) * phi;
+    Link exp_iQ;
+    exponentiate_iQ(Q, &exp_iQ);
+
+    int dx[4] = {0, 0, 0, 0};
+    Link U = arg.U(mu, linkIndexShift(x,dx,arg.E), parity);
+    arg.U(mu, linkIndexShift(x,dx,arg.E), parity) = exp_iQ * U;
+  }
+
+  template<typename Float, typename Arg>
+  __global__ void computeGaugeFlowUpdate(Arg arg) {
+    int x_cb = threadIdx.x + blockIdx.x*blockDim.x;
+    int parity = threadIdx.y + blockIdx.y*blockDim.y;
+    int mu = threadIdx.z + blockIdx.z*blockDim.z;
+    if (x_cb >= arg.threads) return;
+    if (mu >= 4) return;
+    gaugeFlowUpdate<Float>(arg, x_cb, parity, mu);
+  }
+
+  template<typename Float, typename Arg>
+  void computeGaugeFlowUpdateCPU(Arg &arg) {
+    for (int parity=0; parity<2; parity++) {
+      for (int x_cb=0; x_cb<arg.threads; x_cb++) {
+	for (int mu=0; mu<4; mu++) gaugeFlowUpdate<Float>(arg, x_cb, parity, mu);
+      }
+    }
+  }
+
+  template<typename Float, typename Arg>
+  class GaugeFlowUpdate : TunableVectorYZ {
+    Arg &arg;
+    GaugeField &meta;
+
+  private:
+    bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
+    unsigned int minThreads() const { return arg.threads; }
+
+  public:
+    // (2,4) --- 2 for parity in the y thread dim, 4 corresponds to mapping direction to the z thread dim
+    GaugeFlowUpdate(Arg &arg, GaugeField &meta) : TunableVectorYZ(2,4), arg(arg), meta(meta) { }
+    virtual ~GaugeFlowUpdate () { }
+
+    void apply(const cudaStream_t &stream) {
+      if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) {
+	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+	computeGaugeFlowUpdate<Float><<<tp.grid,tp.block,tp.shared_bytes>>>(arg);
+      } else {
+	computeGaugeFlowUpdateCPU<Float>(arg);
+      }
+    }
+
+    TuneKey tuneKey() const {
+      std::stringstream aux;
+      aux << "threads=" << arg.threads << ",prec=" << sizeof(Float);
+      return TuneKey(meta.VolString(), typeid(*this).name(), aux.str().c_str());
+    }
+
+    // the gauge field is updated in place
+    void preTune() { meta.backup(); }
+    void postTune() { meta.restore(); }
+
+    long long flops() const { return 2ll*4*arg.threads*(198 + 300); } // product plus Cayley-Hamilton exponential (approx)
+    long long bytes() const { return 2ll*4*arg.threads*(2*arg.U.Bytes() + arg.Z.Bytes()); }
+  }; // GaugeFlowUpdate
+
+  static void exchangeFlowGhost(GaugeField &U, bool redundant_comms) {
+    if (U.Location() == QUDA_CUDA_FIELD_LOCATION) {
+      static_cast<cudaGaugeField&>(U).exchangeExtendedGhost(U.R(), redundant_comms);
+    } else {
+      static_cast<cpuGaugeField&>(U).exchangeExtendedGhost(U.R(), redundant_comms);
+    }
+  }
+
+  template <typename Float, typename Arg>
+  void normalizeFlowObservables(Arg &arg, double obs[4]) {
+    comm_allreduce_array((double*)arg.result_h, 4);
+    const double volume = 2.0*arg.threads*comm_size();
+    obs[0] = arg.result_h[0].x / (72.0*volume); // each plaquette is seen by its four links
+    obs[1] = arg.result_h[0].y / volume;
+    obs[2] = arg.result_h[0].z;
+    obs[3] = sqrt(arg.result_h[0].w / (4*9*volume));
+  }
+
+  template <typename Float, typename Gauge, typename Generator>
+  void gradientFlow(Gauge u, Generator z, GaugeField &U, GaugeField &Z, double epsilon, QudaWFlowType type,
+		    bool step, double obs[4], bool redundant_comms) {
+    GaugeFlowArg<Float,Gauge,Generator> arg(u, z, U, epsilon, type);
+    GaugeFlowStage<Float,GaugeFlowArg<Float,Gauge,Generator> > stage(arg, U, Z);
+    GaugeFlowUpdate<Float,GaugeFlowArg<Float,Gauge,Generator> > update(arg, U);
+
+    if (!step) {
+      arg.measure = true;
+      stage.apply(0);
+      normalizeFlowObservables<Float>(arg, obs);
+      obs[3] = 0.0;
+      return;
+    }
+
+    double error = 0.0;
+    for (int i=1; i<=3; i++) {
+      arg.stage = i;
+      arg.measure = (i == 1); // observables of the field at the start of the step
+      stage.apply(0);
+      if (i == 1) normalizeFlowObservables<Float>(arg, obs);
+      if (i == 3) {
+	double stage_obs[4];
+	normalizeFlowObservables<Float>(arg, stage_obs);
+	error = stage_obs[3];
+      }
+
+      update.apply(0);
+      if (U.Location() == QUDA_CUDA_FIELD_LOCATION) cudaDeviceSynchronize();
+      checkCudaError();
+      exchangeFlowGhost(U, redundant_comms);
+    }
+    obs[3] = error;
+  }
+
+  template <typename Float>
+  void gradientFlow(GaugeField &U, GaugeField &Z, double epsilon, QudaWFlowType type, bool step,
+		    double obs[4], bool redundant_comms) {
+    if (Z.Reconstruct() != QUDA_RECONSTRUCT_NO) errorQuda("Flow generator field must not be reconstructed");
+    for (int d=0; d<4; d++) {
+      if (Z.X()[d] != U.X()[d] - 2*U.R()[d])
+	errorQuda("Flow generator field dimensions do not match the interior of the gauge field");
+      if (comm_dim_partitioned(d) && U.R()[d] < (type == QUDA_WFLOW_TYPE_SYMANZIK ? 2 : 1))
+	errorQuda("Halo depth %d in dimension %d too small for flow type %d", U.R()[d], d, type);
+    }
+
+    if (U.Location() == QUDA_CUDA_FIELD_LOCATION) {
+      if (!U.isNative()) errorQuda("Order %d with %d reconstruct not supported", U.Order(), U.Reconstruct());
+      if (!Z.isNative()) errorQuda("Order %d with %d reconstruct not supported", Z.Order(), Z.Reconstruct());
+      typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type G;
+
+      if (U.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type GU;
+	gradientFlow<Float>(GU(U), G(Z), U, Z, epsilon, type, step, obs, redundant_comms);
+      } else if (U.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_12>::type GU;
+	gradientFlow<Float>(GU(U), G(Z), U, Z, epsilon, type, step, obs, redundant_comms);
+      } else if (U.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_8>::type GU;
+	gradientFlow<Float>(GU(U), G(Z), U, Z, epsilon, type, step, obs, redundant_comms);
+      } else {
+	errorQuda("Reconstruction type %d of gauge field not supported", U.Reconstruct());
+      }
+    } else {
+      if (U.Order() != QUDA_QDP_GAUGE_ORDER || Z.Order() != QUDA_QDP_GAUGE_ORDER || U.Reconstruct() != QUDA_RECONSTRUCT_NO)
+	errorQuda("Host gradient flow requires QDP ordered fields without reconstruction");
+      typedef gauge::QDPOrder<Float,18> G;
+      gradientFlow<Float>(G(U), G(Z), U, Z, epsilon, type, step, obs, redundant_comms);
+    }
+  }
+
+#endif // GPU_GAUGE_TOOLS
+
+  void gradientFlowStep(GaugeField &U, GaugeField &Z, double epsilon, QudaWFlowType type,
+			double obs[4], bool redundant_comms) {
+#ifdef GPU_GAUGE_TOOLS
+    if (U.Precision() != Z.Precision()) errorQuda("Gauge and generator fields must have the same precision");
+    if (U.Location() != Z.Location()) errorQuda("Gauge and generator fields must have the same location");
+
+    if (U.Precision() == QUDA_DOUBLE_PRECISION) {
+      gradientFlow<double>(U, Z, epsilon, type, true, obs, redundant_comms);
+    } else if (U.Precision() == QUDA_SINGLE_PRECISION) {
+      gradientFlow<float>(U, Z, epsilon, type, true, obs, redundant_comms);
+    } else {
+      errorQuda("Precision %d not supported", U.Precision());
+    }
+#else
+    errorQuda("Gauge tools are not build");
+#endif
+  }
+
+  void gradientFlowMeasure(GaugeField &U, GaugeField &Z, double obs[3]) {
+#ifdef GPU_GAUGE_TOOLS
+    if (U.Precision() != Z.Precision()) errorQuda("Gauge and generator fields must have the same precision");
+    if (U.Location() != Z.Location()) errorQuda("Gauge and generator fields must have the same location");
+
+    double obs_[4];
+    if (U.Precision() == QUDA_DOUBLE_PRECISION) {
+      gradientFlow<double>(U, Z, 0.0, QUDA_WFLOW_TYPE_WILSON, false, obs_, false);
+    } else if (U.Precision() == QUDA_SINGLE_PRECISION) {
+      gradientFlow<float>(U, Z, 0.0, QUDA_WFLOW_TYPE_WILSON, false, obs_, false);
+    } else {
+      errorQuda("Precision %d not supported", U.Precision());
+    }
+    for (int i=0; i<3; i++) obs[i] = obs_[i];
+#else
+    errorQuda("Gauge tools are not build");
+#endif
+  }
+
+} // namespace quda
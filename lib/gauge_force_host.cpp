@@ -0,0 +1,383 @@
+// Host gauge force from compiled programs of shared partial link products.
+
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+#include <quda_internal.h>
+#include <gauge_field.h>
+#include <gauge_force_quda.h>
+#include <thread_pool.h>
+
+namespace quda {
+
+  /**
+     A product of links along a sub-path, built by extending a shorter
+     product by a single link: a prefix node is parent * link and a
+     suffix node is link * parent.
+   */
+  struct PathNode {
+    int parent;    // -1 for a single link
+    int dir;       // direction of the link
+    bool dagger;   // whether the link is traversed backwards
+    int offset[4]; // position of the link relative to the force site
+
+    bool operator==(const PathNode &a) const {
+      return parent == a.parent && dir == a.dir && dagger == a.dagger &&
+	offset[0] == a.offset[0] && offset[1] == a.offset[1] && offset[2] == a.offset[2] && offset[3] == a.offset[3];
+    }
+  };
+
+  /**
+     The loops of one force direction: the sum over paths of coeff
+     * prefix * suffix, grouped by prefix.  A suffix of -1 is the
+     identity.
+   */
+  struct PathProgram {
+    std::vector<PathNode> prefix;
+    std::vector<PathNode> suffix;
+    std::vector<int> group;                            // prefix node of each group
+    std::vector<std::vector<std::pair<int,double> > > terms; // suffix and coefficient of each group term
+    std::vector<bool> join;                            // whether the group needs a multiplication
+    int naive;    // SU(3) multiplies per site when each path is walked separately
+    int compiled; // SU(3) multiplies per site of the compiled program
+  };
+
+  static int findNode(const std::vector<PathNode> &nodes, const PathNode &node)
+  {
+    for (unsigned int i=0; i<nodes.size(); i++) if (nodes[i] == node) return i;
+    return -1;
+  }
+
+  /**
+     @brief Insert the chain of links into the trie and return the index
+     of its last node
+   */
+  static int insertChain(std::vector<PathNode> &nodes, const std::vector<PathNode> &chain)
+  {
+    int parent = -1;
+    for (unsigned int i=0; i<chain.size(); i++) {
+      PathNode node = chain[i];
+      node.parent = parent;
+      const int j = findNode(nodes, node);
+      if (j >= 0) {
+	parent = j;
+      } else {
+	nodes.push_back(node);
+	parent = nodes.size() - 1;
+      }
+    }
+    return parent;
+  }
+
+  /**
+     @brief Build the program from the links of each path, splitting
+     path i after its first split[i] links
+   */
+  static PathProgram buildProgram(const std::vector<std::vector<PathNode> > &links,
+				  const std::vector<double> &coeff, const std::vector<int> &split)
+  {
+    PathProgram program;
+    program.naive = 1; // the final multiplication by U_dir(x)
+
+    for (unsigned int i=0; i<links.size(); i++) {
+      program.naive += links[i].size() - 1;
+      std::vector<PathNode> pre(links[i].begin(), links[i].begin() + split[i]);
+      std::vector<PathNode> suf(links[i].rbegin(), links[i].rend() - split[i]);
+      const int p = insertChain(program.prefix, pre);
+      const int s = suf.size() ? insertChain(program.suffix, suf) : -1;
+
+      int g = std::find(program.group.begin(), program.group.end(), p) - program.group.begin();
+      if (g == (int)program.group.size()) {
+	program.group.push_back(p);
+	program.terms.push_back(std::vector<std::pair<int,double> >());
+	program.join.push_back(false);
+      }
+      program.terms[g].push_back(std::make_pair(s, coeff[i]));
+      if (s >= 0) program.join[g] = true;
+    }
+
+    program.compiled = 1;
+    for (auto j : program.join) if (j) program.compiled++;
+    for (auto &n : program.prefix) if (n.parent >= 0) program.compiled++;
+    for (auto &n : program.suffix) if (n.parent >= 0) program.compiled++;
+    return program;
+  }
+
+  /**
+     @brief Compile the paths of direction dir into two tries of
+     partial link products: prefix products grown from the start of
+     the paths and suffix products grown back from their ends.  Each
+     path is split where it adds the fewest new products, so sub-paths
+     shared by several loops (e.g., the first links of rectangles and
+     chairs that start at the same plaquette corner) are multiplied
+     once per site, and paths with the same prefix sum their suffixes
+     before the one multiplication that joins them.  The split points start
+     from the best choice common to all paths and are then improved one
+     path at a time until no single change reduces the number of
+     multiplications.
+   */
+  static PathProgram compilePaths(int dir, int **input_path, const int *length, const double *path_coeff, int num_paths)
+  {
+    std::vector<std::vector<PathNode> > links;
+    std::vector<double> coeff;
+    int max_length = 0;
+
+    for (int i=0; i<num_paths; i++) {
+      if (path_coeff[i] == 0) continue;
+      const int L = length[i];
+      max_length = std::max(max_length, L);
+
+      // walk the path from the end of the link U_dir(x)
+      std::vector<PathNode> path(L);
+      int x[4] = { 0, 0, 0, 0 };
+      x[dir]++;
+      for (int j=0; j<L; j++) {
+	const int step = input_path[i][j];
+	PathNode &link = path[j];
+	link.parent = -1;
+	link.dagger = step > 3;
+	link.dir = link.dagger ? 7 - step : step;
+	if (link.dagger) x[link.dir]--;
+	for (int d=0; d<4; d++) link.offset[d] = x[d];
+	if (!link.dagger) x[link.dir]++;
+      }
+      links.push_back(path);
+      coeff.push_back(path_coeff[i]);
+    }
+
+    std::vector<int> split(links.size()), best_split;
+    int best = -1;
+    for (int k=1; k<=max_length; k++) {
+      for (unsigned int i=0; i<links.size(); i++) split[i] = std::min<int>(k, links[i].size());
+      const int cost = buildProgram(links, coeff, split).compiled;
+      if (best < 0 || cost < best) { best = cost; best_split = split; }
+    }
+
+    split = best_split;
+    for (bool improved = true; improved; ) {
+      improved = false;
+      for (unsigned int i=0; i<links.size(); i++) {
+	const int k0 = split[i];
+	for (unsigned int k=1; k<=links[i].size(); k++) {
+	  if ((int)k == k0) continue;
+	  split[i] = k;
+	  const int cost = buildProgram(links, coeff, split).compiled;
+	  if (cost < best) { best = cost; best_split = split; improved = true; }
+	}
+	split = best_split;
+      }
+    }
+
+    return buildProgram(links, coeff, split);
+  }
+
+  template <typename Float>
+  struct GaugeForceHostArg {
+    const Float *u[4]; // extended links [(parity*volumeCB_ex + x_cb)*18]
+    Float *mom;        // MILC-ordered compressed momentum [((parity*volumeCB + x_cb)*4 + dir)*10]
+    int X[4];
+    int E[4];
+    int R[4];
+    int volumeCB;
+    int volumeCB_ex;
+    double coeff;
+  };
+
+  template <typename Float>
+  static inline const Float *link(const GaugeForceHostArg<Float> &arg, int mu, const int x[4])
+  {
+    int y[4];
+    int parity = 0;
+    for (int d=0; d<4; d++) {
+      y[d] = arg.R[d] ? x[d] + arg.R[d] : (x[d] + arg.X[d]) % arg.X[d];
+      parity += y[d] - arg.R[d];
+    }
+    const int x_cb = (((y[3]*arg.E[2] + y[2])*arg.E[1] + y[1])*arg.E[0] + y[0]) >> 1;
+    return arg.u[mu] + ((parity & 1)*arg.volumeCB_ex + x_cb)*18;
+  }
+
+  /**
+     @brief c = op(a) * op(b), where op is the identity or the
+     Hermitian conjugate
+  */
+  template <typename Float>
+  static inline void mul(Float *c, const Float *a, bool dagA, const Float *b, bool dagB)
+  {
+    for (int i=0; i<3; i++) {
+      for (int j=0; j<3; j++) {
+	Float re = 0.0, im = 0.0;
+	for (int k=0; k<3; k++) {
+	  const int ik = dagA ? k*3 + i : i*3 + k;
+	  const int kj = dagB ? j*3 + k : k*3 + j;
+	  const Float a_re = a[2*ik+0], a_im = dagA ? -a[2*ik+1] : a[2*ik+1];
+	  const Float b_re = b[2*kj+0], b_im = dagB ? -b[2*kj+1] : b[2*kj+1];
+	  re += a_re * b_re - a_im * b_im;
+	  im += a_re * b_im + a_im * b_re;
+	}
+	c[2*(i*3+j)+0] = re;
+	c[2*(i*3+j)+1] = im;
+      }
+    }
+  }
+
+  template <typename Float>
+  static inline void loadLink(Float *out, const Float *in, bool dagger)
+  {
+    for (int i=0; i<3; i++) {
+      for (int j=0; j<3; j++) {
+	const int ij = dagger ? j*3 + i : i*3 + j;
+	out[2*(i*3+j)+0] = in[2*ij+0];
+	out[2*(i*3+j)+1] = dagger ? -in[2*ij+1] : in[2*ij+1];
+      }
+    }
+  }
+
+  /**
+     @brief Evaluate the program for direction dir at site x, using
+     arena to hold the partial products, and update the momentum
+   */
+  template <typename Float>
+  static void computeForce(const GaugeForceHostArg<Float> &arg, const PathProgram &program, int dir,
+			   const int x[4], int parity, int x_cb, Float *arena)
+  {
+    Float *P = arena;
+    Float *S = arena + program.prefix.size()*18;
+
+    for (unsigned int i=0; i<program.prefix.size(); i++) {
+      const PathNode &n = program.prefix[i];
+      const int y[4] = { x[0] + n.offset[0], x[1] + n.offset[1], x[2] + n.offset[2], x[3] + n.offset[3] };
+      if (n.parent < 0) loadLink(P + i*18, link(arg, n.dir, y), n.dagger);
+      else mul(P + i*18, P + n.parent*18, false, link(arg, n.dir, y), n.dagger);
+    }
+
+    for (unsigned int i=0; i<program.suffix.size(); i++) {
+      const PathNode &n = program.suffix[i];
+      const int y[4] = { x[0] + n.offset[0], x[1] + n.offset[1], x[2] + n.offset[2], x[3] + n.offset[3] };
+      if (n.parent < 0) loadLink(S + i*18, link(arg, n.dir, y), n.dagger);
+      else mul(S + i*18, link(arg, n.dir, y), n.dagger, S + n.parent*18, false);
+    }
+
+    Float staple[18], sum[18], tmp[18];
+    for (int i=0; i<18; i++) staple[i] = 0.0;
+    for (unsigned int g=0; g<program.group.size(); g++) {
+      const Float *p = P + program.group[g]*18;
+      if (!program.join[g]) {
+	// only whole paths end here
+	Float c = 0.0;
+	for (auto &t : program.terms[g]) c += t.second;
+	for (int i=0; i<18; i++) staple[i] += c * p[i];
+	continue;
+      }
+
+      for (int i=0; i<18; i++) sum[i] = 0.0;
+      for (auto &t : program.terms[g]) {
+	const Float c = t.second;
+	if (t.first < 0) for (int i=0; i<3; i++) sum[2*(i*3+i)] += c;
+	else for (int i=0; i<18; i++) sum[i] += c * S[t.first*18 + i];
+      }
+      mul(tmp, p, false, sum, false);
+      for (int i=0; i<18; i++) staple[i] += tmp[i];
+    }
+
+    // multiply by U(x) and take the traceless anti-Hermitian part
+    mul(tmp, link(arg, dir, x), false, staple, false);
+    Float ah[18];
+    for (int i=0; i<3; i++) {
+      for (int j=0; j<3; j++) {
+	ah[2*(i*3+j)+0] = 0.5 * (tmp[2*(i*3+j)+0] - tmp[2*(j*3+i)+0]);
+	ah[2*(i*3+j)+1] = 0.5 * (tmp[2*(i*3+j)+1] + tmp[2*(j*3+i)+1]);
+      }
+    }
+    const Float trace = (ah[1] + ah[9] + ah[17]) / 3.0;
+    ah[1] -= trace; ah[9] -= trace; ah[17] -= trace;
+
+    Float *m = arg.mom + ((parity*arg.volumeCB + x_cb)*4 + dir)*10;
+    const Float c = arg.coeff;
+    m[0] -= c * ah[2];  m[1] -= c * ah[3];
+    m[2] -= c * ah[4];  m[3] -= c * ah[5];
+    m[4] -= c * ah[10]; m[5] -= c * ah[11];
+    m[6] -= c * ah[1];  m[7] -= c * ah[9];  m[8] -= c * ah[17];
+  }
+
+  /**
+     @brief Evaluate the compiled programs over sites in parallel; each
+     chunk of sites holds its partial products in a private arena.
+   */
+  template <typename Float>
+  static void gaugeForceHost(GaugeField &mom, const GaugeField &u, double coeff, const PathProgram program[4])
+  {
+    GaugeForceHostArg<Float> arg;
+    memset(&arg, 0, sizeof(arg));
+    for (int mu=0; mu<4; mu++) arg.u[mu] = static_cast<const Float* const*>(static_cast<const cpuGaugeField&>(u).Gauge_p())[mu];
+    arg.mom = static_cast<Float*>(static_cast<cpuGaugeField&>(mom).Gauge_p());
+    for (int d=0; d<4; d++) {
+      arg.X[d] = mom.X()[d];
+      arg.E[d] = u.X()[d];
+      arg.R[d] = (arg.E[d] - arg.X[d]) / 2;
+    }
+    arg.volumeCB = mom.VolumeCB();
+    arg.volumeCB_ex = u.VolumeCB();
+    arg.coeff = coeff;
+
+    size_t arena_size = 0;
+    for (int dir=0; dir<4; dir++)
+      arena_size = std::max(arena_size, (program[dir].prefix.size() + program[dir].suffix.size())*18);
+
+    host::parallel_for(2*arg.volumeCB, [&](int begin, int end) {
+	std::vector<Float> arena(arena_size);
+	for (int i=begin; i<end; i++) {
+	  const int parity = i / arg.volumeCB;
+	  const int x_cb = i - parity*arg.volumeCB;
+	  int x[4];
+	  int za = x_cb / (arg.X[0]/2);
+	  const int x1h = x_cb - za*(arg.X[0]/2);
+	  int zb = za / arg.X[1];
+	  x[1] = za - zb*arg.X[1];
+	  x[3] = zb / arg.X[2];
+	  x[2] = zb - x[3]*arg.X[2];
+	  x[0] = 2*x1h + ((x[1] + x[2] + x[3] + parity) & 1);
+	  for (int dir=0; dir<4; dir++) computeForce(arg, program[dir], dir, x, parity, x_cb, arena.data());
+	}
+      });
+  }
+
+  void gaugeForceHost(GaugeField &mom, const GaugeField &u, double coeff, int ***input_path,
+		      int *length, double *path_coeff, int num_paths, int max_length)
+  {
+    if (mom.Location() != QUDA_CPU_FIELD_LOCATION || u.Location() != QUDA_CPU_FIELD_LOCATION)
+      errorQuda("Host gauge force requires CPU fields");
+    if (mom.Precision() != u.Precision()) errorQuda("Mixed precision not supported");
+    if (u.Order() != QUDA_QDP_GAUGE_ORDER || u.Reconstruct() != QUDA_RECONSTRUCT_NO)
+      errorQuda("Host gauge force requires a QDP-ordered gauge field without reconstruction");
+    if (mom.Order() != QUDA_MILC_GAUGE_ORDER || mom.Reconstruct() != QUDA_RECONSTRUCT_10)
+      errorQuda("Host gauge force requires a MILC-ordered compressed momentum field");
+
+    PathProgram program[4];
+    for (int dir=0; dir<4; dir++) {
+      program[dir] = compilePaths(dir, input_path[dir], length, path_coeff, num_paths);
+      if (getVerbosity() >= QUDA_VERBOSE)
+	printfQuda("Gauge force direction %d: %d SU(3) multiplies per site (%d without path compilation)\n",
+		   dir, program[dir].compiled, program[dir].naive);
+
+      // the paths must stay within the border in partitioned dimensions
+      for (int d=0; d<4; d++) {
+	if (!comm_dim_partitioned(d)) continue;
+	const int R = (u.X()[d] - mom.X()[d]) / 2;
+	const std::vector<PathNode> *nodes[2] = { &program[dir].prefix, &program[dir].suffix };
+	for (int t=0; t<2; t++)
+	  for (auto &n : *nodes[t])
+	    if (n.offset[d] < -R || n.offset[d] > R)
+	      errorQuda("Path reaches %d sites from the force site in partitioned dimension %d with border %d", n.offset[d], d, R);
+      }
+    }
+
+    switch (mom.Precision()) {
+    case QUDA_DOUBLE_PRECISION: gaugeForceHost<double>(mom, u, coeff, program); break;
+    case QUDA_SINGLE_PRECISION: gaugeForceHost<float>(mom, u, coeff, program); break;
+    default: errorQuda("Unsupported precision %d", mom.Precision());
+    }
+  }
+
+} // namespace quda
@@ -173,10 +173,14 @@ namespace quda {
 
     void apply(const cudaStream_t &stream) {
       if (location == QUDA_CUDA_FIELD_LOCATION) {
+#ifndef QUDA_HOST_ONLY
 	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	tp.grid.y = 2; // parity is the y grid dimension
 	gaugePhaseKernel<Float, length, phaseType, Arg> 
 	  <<<tp.grid, tp.block, tp.shared_bytes, stream>>>(arg);
+#else
+	errorQuda("GPU fields are not supported in a host-only build");
+#endif
       } else {
 	gaugePhase<Float, length, phaseType, Arg>(arg);
       }
@@ -197,6 +197,7 @@ namespace quda {
       } else {
 	  errorQuda("Precision %d not supported", dataDs.Precision());
       }
+      dataDs.updateVersion();
       return;
 #else
       errorQuda("Gauge tools are not build");
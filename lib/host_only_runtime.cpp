@@ -0,0 +1,349 @@
+/**
+ * Host implementation of the subset of the CUDA runtime and driver
+ * APIs declared in include/host_only, used by builds with
+ * QUDA_HOST_ONLY.  There is no device: "device" allocations are
+ * aligned host allocations, copies and sets are immediate, streams
+ * are synchronous, and events record the host time at which they are
+ * recorded so that the timing in the tuning and profiling code keeps
+ * working.  Interprocess handles and texture objects need a device
+ * and are reported as not supported.
+ *
+ * The end of the file defines the few pieces of interface_quda.cpp,
+ * dslash_quda.cu, blas_quda.cu, copy_quda.cu and reduce_quda.cu that
+ * the host code needs, since those files are not part of the host-only build.
+ */
+
+#ifdef QUDA_HOST_ONLY
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+
+#include <cuda.h>
+#include <cuda_runtime.h>
+
+#include <quda.h>
+#include <quda_internal.h>
+#include <comm_quda.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+#include <worker.h>
+
+// device built-ins; only referenced by kernels, which are never launched
+const uint3 threadIdx = { 0, 0, 0 };
+const uint3 blockIdx = { 0, 0, 0 };
+const dim3 blockDim(1, 1, 1);
+const dim3 gridDim(1, 1, 1);
+
+static const size_t alignment = 256; // the alignment guaranteed by cudaMalloc
+
+static void *aligned_malloc(size_t size)
+{
+  void *ptr = nullptr;
+  if (posix_memalign(&ptr, alignment, size ? size : alignment) != 0) return nullptr;
+  return ptr;
+}
+
+static cudaError_t lastError = cudaSuccess;
+
+static cudaError_t setError(cudaError_t error)
+{
+  if (error != cudaSuccess) lastError = error;
+  return error;
+}
+
+// device management
+
+cudaError_t cudaGetDeviceCount(int *count) { *count = 0; return setError(cudaErrorNoDevice); }
+cudaError_t cudaGetDevice(int *device) { *device = 0; return cudaSuccess; }
+cudaError_t cudaSetDevice(int device) { return device == 0 ? cudaSuccess : setError(cudaErrorInvalidValue); }
+
+cudaError_t cudaGetDeviceProperties(cudaDeviceProp *prop, int device)
+{
+  if (device != 0) return setError(cudaErrorInvalidValue);
+  memset(prop, 0, sizeof(cudaDeviceProp));
+  strncpy(prop->name, "host", sizeof(prop->name) - 1);
+  prop->warpSize = warpSize;
+  // one warp per block and no limit on the grid: the tuning code can
+  // form launch parameters for any volume but has a single block size
+  // to try, and the host paths ignore the launch parameters anyway
+  prop->maxThreadsPerBlock = warpSize;
+  prop->maxThreadsDim[0] = prop->maxThreadsDim[1] = prop->maxThreadsDim[2] = warpSize;
+  prop->maxGridSize[0] = prop->maxGridSize[1] = prop->maxGridSize[2] = 0x7fffffff;
+  prop->multiProcessorCount = 1;
+  // a known architecture, since the tuning of shared memory bounds the
+  // blocks per SM by it; with no shared memory there is one setting
+  prop->major = 7;
+  prop->minor = 0;
+  prop->canMapHostMemory = 1;
+  prop->unifiedAddressing = 1;
+  prop->managedMemory = 1;
+  prop->pageableMemoryAccess = 1;
+  prop->maxTexture1DLinear = 1 << 27;
+  return cudaSuccess;
+}
+
+cudaError_t cudaDeviceSynchronize() { return cudaSuccess; }
+cudaError_t cudaDeviceReset() { return cudaSuccess; }
+cudaError_t cudaDeviceSetCacheConfig(cudaFuncCache) { return cudaSuccess; }
+cudaError_t cudaDeviceCanAccessPeer(int *canAccessPeer, int, int) { *canAccessPeer = 0; return cudaSuccess; }
+cudaError_t cudaDeviceGetP2PAttribute(int *value, cudaDeviceP2PAttr, int, int) { *value = 0; return cudaSuccess; }
+
+// errors
+
+cudaError_t cudaGetLastError() { cudaError_t error = lastError; lastError = cudaSuccess; return error; }
+cudaError_t cudaPeekAtLastError() { return lastError; }
+
+const char* cudaGetErrorString(cudaError_t error)
+{
+  switch (error) {
+  case cudaSuccess: return "no error";
+  case cudaErrorMemoryAllocation: return "out of memory";
+  case cudaErrorInvalidValue: return "invalid argument";
+  case cudaErrorNotReady: return "device not ready";
+  case cudaErrorNoDevice: return "no CUDA-capable device is detected (host-only build)";
+  case cudaErrorNotSupported: return "operation not supported (host-only build)";
+  default: return "unknown error";
+  }
+}
+
+// memory
+
+cudaError_t cudaMalloc(void **devPtr, size_t size)
+{
+  *devPtr = aligned_malloc(size);
+  return *devPtr ? cudaSuccess : setError(cudaErrorMemoryAllocation);
+}
+
+cudaError_t cudaMallocManaged(void **devPtr, size_t size, unsigned int) { return cudaMalloc(devPtr, size); }
+cudaError_t cudaFree(void *devPtr) { free(devPtr); return cudaSuccess; }
+cudaError_t cudaHostAlloc(void **pHost, size_t size, unsigned int) { return cudaMalloc(pHost, size); }
+cudaError_t cudaMallocHost(void **ptr, size_t size) { return cudaMalloc(ptr, size); }
+cudaError_t cudaFreeHost(void *ptr) { free(ptr); return cudaSuccess; }
+cudaError_t cudaHostRegister(void *, size_t, unsigned int) { return cudaSuccess; }
+cudaError_t cudaHostUnregister(void *) { return cudaSuccess; }
+cudaError_t cudaHostGetDevicePointer(void **pDevice, void *pHost, unsigned int) { *pDevice = pHost; return cudaSuccess; }
+
+cudaError_t cudaPointerGetAttributes(cudaPointerAttributes *attributes, const void *ptr)
+{
+  attributes->memoryType = cudaMemoryTypeHost;
+  attributes->type = cudaMemoryTypeHost;
+  attributes->device = 0;
+  attributes->devicePointer = const_cast<void*>(ptr);
+  attributes->hostPointer = const_cast<void*>(ptr);
+  attributes->isManaged = 0;
+  return cudaSuccess;
+}
+
+cudaError_t cudaMemcpy(void *dst, const void *src, size_t count, cudaMemcpyKind)
+{
+  if (dst != src && count) memmove(dst, src, count);
+  return cudaSuccess;
+}
+
+cudaError_t cudaMemcpyAsync(void *dst, const void *src, size_t count, cudaMemcpyKind kind, cudaStream_t)
+{ return cudaMemcpy(dst, src, count, kind); }
+
+cudaError_t cudaMemcpy2D(void *dst, size_t dpitch, const void *src, size_t spitch, size_t width, size_t height,
+			 cudaMemcpyKind)
+{
+  for (size_t i=0; i<height; i++)
+    memmove(static_cast<char*>(dst) + i*dpitch, static_cast<const char*>(src) + i*spitch, width);
+  return cudaSuccess;
+}
+
+cudaError_t cudaMemcpy2DAsync(void *dst, size_t dpitch, const void *src, size_t spitch, size_t width, size_t height,
+			      cudaMemcpyKind kind, cudaStream_t)
+{ return cudaMemcpy2D(dst, dpitch, src, spitch, width, height, kind); }
+
+cudaError_t cudaMemset(void *devPtr, int value, size_t count) { memset(devPtr, value, count); return cudaSuccess; }
+cudaError_t cudaMemsetAsync(void *devPtr, int value, size_t count, cudaStream_t) { return cudaMemset(devPtr, value, count); }
+
+cudaError_t cudaMemset2D(void *devPtr, size_t pitch, int value, size_t width, size_t height)
+{
+  for (size_t i=0; i<height; i++) memset(static_cast<char*>(devPtr) + i*pitch, value, width);
+  return cudaSuccess;
+}
+
+cudaError_t cudaMemset2DAsync(void *devPtr, size_t pitch, int value, size_t width, size_t height, cudaStream_t)
+{ return cudaMemset2D(devPtr, pitch, value, width, height); }
+
+// streams and events
+
+struct CUstream_st { };
+struct CUevent_st { std::chrono::steady_clock::time_point time; };
+
+cudaError_t cudaStreamCreate(cudaStream_t *stream) { *stream = new CUstream_st; return cudaSuccess; }
+cudaError_t cudaStreamCreateWithFlags(cudaStream_t *stream, unsigned int) { return cudaStreamCreate(stream); }
+cudaError_t cudaStreamCreateWithPriority(cudaStream_t *stream, unsigned int, int) { return cudaStreamCreate(stream); }
+cudaError_t cudaStreamDestroy(cudaStream_t stream) { delete stream; return cudaSuccess; }
+cudaError_t cudaStreamSynchronize(cudaStream_t) { return cudaSuccess; }
+cudaError_t cudaStreamQuery(cudaStream_t) { return cudaSuccess; }
+cudaError_t cudaStreamWaitEvent(cudaStream_t, cudaEvent_t, unsigned int) { return cudaSuccess; }
+
+cudaError_t cudaDeviceGetStreamPriorityRange(int *leastPriority, int *greatestPriority)
+{
+  *leastPriority = 0;
+  *greatestPriority = 0;
+  return cudaSuccess;
+}
+
+cudaError_t cudaEventCreate(cudaEvent_t *event)
+{
+  *event = new CUevent_st;
+  (*event)->time = std::chrono::steady_clock::now();
+  return cudaSuccess;
+}
+
+cudaError_t cudaEventCreate(cudaEvent_t *event, unsigned int) { return cudaEventCreate(event); }
+cudaError_t cudaEventCreateWithFlags(cudaEvent_t *event, unsigned int) { return cudaEventCreate(event); }
+cudaError_t cudaEventDestroy(cudaEvent_t event) { delete event; return cudaSuccess; }
+cudaError_t cudaEventRecord(cudaEvent_t event, cudaStream_t) { event->time = std::chrono::steady_clock::now(); return cudaSuccess; }
+cudaError_t cudaEventQuery(cudaEvent_t) { return cudaSuccess; }
+cudaError_t cudaEventSynchronize(cudaEvent_t) { return cudaSuccess; }
+
+cudaError_t cudaEventElapsedTime(float *ms, cudaEvent_t start, cudaEvent_t end)
+{
+  *ms = std::chrono::duration<float, std::milli>(end->time - start->time).count();
+  return cudaSuccess;
+}
+
+// interprocess communication and texture objects
+
+cudaError_t cudaIpcGetMemHandle(cudaIpcMemHandle_t *, void *) { return setError(cudaErrorNotSupported); }
+cudaError_t cudaIpcOpenMemHandle(void **, cudaIpcMemHandle_t, unsigned int) { return setError(cudaErrorNotSupported); }
+cudaError_t cudaIpcCloseMemHandle(void *) { return setError(cudaErrorNotSupported); }
+cudaError_t cudaIpcGetEventHandle(cudaIpcEventHandle_t *, cudaEvent_t) { return setError(cudaErrorNotSupported); }
+cudaError_t cudaIpcOpenEventHandle(cudaEvent_t *, cudaIpcEventHandle_t) { return setError(cudaErrorNotSupported); }
+
+cudaError_t cudaCreateTextureObject(cudaTextureObject_t *texObject, const cudaResourceDesc *, const cudaTextureDesc *,
+				    const void *)
+{
+  *texObject = 0;
+  return setError(cudaErrorNotSupported);
+}
+
+cudaError_t cudaDestroyTextureObject(cudaTextureObject_t) { return cudaSuccess; }
+
+// driver API
+
+CUresult cuMemAlloc(CUdeviceptr *dptr, size_t bytesize)
+{
+  *dptr = reinterpret_cast<CUdeviceptr>(aligned_malloc(bytesize));
+  return *dptr ? CUDA_SUCCESS : CUDA_ERROR_OUT_OF_MEMORY;
+}
+
+CUresult cuMemFree(CUdeviceptr dptr) { free(reinterpret_cast<void*>(dptr)); return CUDA_SUCCESS; }
+
+CUresult cuGetErrorString(CUresult error, const char **pStr)
+{
+  switch (error) {
+  case CUDA_SUCCESS: *pStr = "no error"; break;
+  case CUDA_ERROR_OUT_OF_MEMORY: *pStr = "out of memory"; break;
+  case CUDA_ERROR_NO_DEVICE: *pStr = "no CUDA-capable device is detected (host-only build)"; break;
+  default: *pStr = "operation not supported (host-only build)"; break;
+  }
+  return CUDA_SUCCESS;
+}
+
+CUresult cuDeviceGet(CUdevice *device, int ordinal) { *device = ordinal; return CUDA_SUCCESS; }
+CUresult cuDeviceGetAttribute(int *pi, CUdevice_attribute, CUdevice) { *pi = 0; return CUDA_SUCCESS; }
+CUresult cuStreamWaitValue32(CUstream, CUdeviceptr, unsigned int, unsigned int) { return CUDA_ERROR_NOT_SUPPORTED; }
+
+// interface
+
+#define INIT_PARAM
+#include "check_params.h"
+#undef INIT_PARAM
+
+static cudaDeviceProp hostDeviceProp()
+{
+  cudaDeviceProp prop;
+  cudaGetDeviceProperties(&prop, 0);
+  return prop;
+}
+
+cudaDeviceProp deviceProp = hostDeviceProp();
+cudaStream_t *streams = nullptr;
+
+namespace {
+  struct LexMapData { int ndim; int dims[QUDA_MAX_DIM]; };
+
+  // lexicographical with t varying fastest, as in interface_quda.cpp
+  int lex_rank_from_coords(const int *coords, void *fdata)
+  {
+    LexMapData *md = static_cast<LexMapData *>(fdata);
+    int rank = coords[0];
+    for (int i = 1; i < md->ndim; i++) rank = md->dims[i] * rank + coords[i];
+    return rank;
+  }
+}
+
+void initCommsGridQuda(int nDim, const int *dims, QudaCommsMap func, void *fdata)
+{
+  if (nDim != 4) errorQuda("Number of communication grid dimensions must be 4");
+
+  LexMapData map_data;
+  if (!func) {
+    map_data.ndim = nDim;
+    for (int i=0; i<nDim; i++) map_data.dims[i] = dims[i];
+    fdata = static_cast<void*>(&map_data);
+    func = lex_rank_from_coords;
+  }
+  comm_init(nDim, dims, func, fdata);
+}
+
+namespace quda {
+
+  // dslash
+
+  static bool kernelPackT = false;
+
+  void setKernelPackT(bool packT) { kernelPackT = packT; }
+
+  bool getKernelPackT() { return kernelPackT; }
+
+  namespace dslash {
+    Worker *aux_worker = nullptr;
+  }
+
+  namespace blas {
+
+    // the flop counter the coarse-link construction accumulates into
+    unsigned long long flops = 0;
+
+    // every field is a host field, so this is always the generic copy
+    void copy(ColorSpinorField &dst, const ColorSpinorField &src) { dst = src; }
+
+    // reductions, as used by the norms of the gauge and clover fields
+
+    template <typename Float, bool l1>
+    static double hostNorm(const ColorSpinorField &a)
+    {
+      const Float *v = static_cast<const Float*>(a.V());
+      double sum = 0.0;
+      for (size_t i=0; i<a.Length(); i++) sum += l1 ? fabs(v[i]) : static_cast<double>(v[i]) * v[i];
+      return sum;
+    }
+
+    template <bool l1>
+    static double hostNorm(const ColorSpinorField &a)
+    {
+      if (a.Location() != QUDA_CPU_FIELD_LOCATION) errorQuda("GPU fields are not supported in a host-only build");
+      double sum = 0.0;
+      if (a.Precision() == QUDA_DOUBLE_PRECISION) sum = hostNorm<double,l1>(a);
+      else if (a.Precision() == QUDA_SINGLE_PRECISION) sum = hostNorm<float,l1>(a);
+      else errorQuda("Precision %d not supported for host fields", a.Precision());
+      comm_allreduce(&sum);
+      return sum;
+    }
+
+    double norm1(const ColorSpinorField &a) { return hostNorm<true>(a); }
+    double norm2(const ColorSpinorField &a) { return hostNorm<false>(a); }
+
+  } // namespace blas
+
+} // namespace quda
+
+#endif // QUDA_HOST_ONLY
@@ -4,6 +4,7 @@
 #include <math.h>
 #include <string.h>
 #include <sys/time.h>
+#include <thread>
 
 #include <quda.h>
 #include <quda_fortran.h>
@@ -23,6 +24,7 @@
 #include <llfat_quda.h>
 #include <unitarization_links.h>
 #include <algorithm>
+#include <string>
 #include <staggered_oprod.h>
 #include <ks_improved_force.h>
 #include <ks_force_quda.h>
@@ -45,9 +47,7 @@ extern void exchange_cpu_sitelink_ex(int* X, int *R, void** sitelink, QudaGaugeF
 
 #include <ks_force_quda.h>
 
-#ifdef GPU_GAUGE_FORCE
 #include <gauge_force_quda.h>
-#endif
 #include <gauge_update_quda.h>
 
 #define MAX(a,b) ((a)>(b)? (a):(b))
@@ -145,6 +145,26 @@ std::vector<cudaColorSpinorField*> solutionResident;
 // each entry is a pair for both p and Ap storage
 std::vector< std::vector< std::pair<ColorSpinorField*,ColorSpinorField*> > > chronoResident(QUDA_MAX_CHRONO);
 
+// GMRES-DR recycled subspace kept between solves, and the operator state it was built for
+static RecycleSpace *recycleResident = nullptr;
+static std::string recycleKey;
+
+// Residency of the sloppy and preconditioner variants of the resident
+// gauge (fat and long) and clover fields.  With lazy creation these
+// are built on first use by a solver rather than when the precise
+// field is loaded, and with a device memory budget the least recently
+// used variants that are not needed are evicted, to be rebuilt on
+// their next use.
+enum SloppyVariant { SLOPPY_GAUGE, SLOPPY_CLOVER, SLOPPY_VARIANTS };
+static const char *sloppy_variant_str[SLOPPY_VARIANTS] = { "gauge", "clover" };
+static unsigned long sloppy_last_use[SLOPPY_VARIANTS] = { };
+static unsigned long sloppy_clock = 0; // logical, so all processes agree on the eviction order
+static bool lazy_sloppy = false;
+static double device_memory_budget = 0.0; // in bytes, zero for no budget
+static double host_memory_budget = 0.0; // in bytes, zero for no budget
+static int sloppy_field_users = 0; // live multigrid and deflation instances, which hold the sloppy fields
+static void evictSloppyVariants(const bool need[SLOPPY_VARIANTS], size_t bytes);
+
 // Mapped memory buffer used to hold unitarization failures
 static int *num_failures_h = NULL;
 static int *num_failures_d = NULL;
@@ -157,6 +177,9 @@ pthread_mutex_t pthread_mutex;
 
 static bool initialized = false;
 
+// where computeKSLinkQuda and computeGaugeForceQuda run when the device kernels are built
+static QudaFieldLocation link_location = QUDA_CUDA_FIELD_LOCATION;
+
 //!< Profiler for initQuda
 static TimeProfile profileInit("initQuda");
 
@@ -175,6 +198,9 @@ static TimeProfile profileInvert("invertQuda");
 //!< Profiler for invertMultiShiftQuda
 static TimeProfile profileMulti("invertMultiShiftQuda");
 
+//!< Profiler for invertPropagatorQuda
+static TimeProfile profilePropagator("invertPropagatorQuda");
+
 //!< Profiler for computeFatLinkQuda
 static TimeProfile profileFatLink("computeKSLinkQuda");
 
@@ -223,6 +249,9 @@ static TimeProfile profileSTOUT("STOUTQuda");
 //!< Profiler for OvrImpSTOUTQuda
 static TimeProfile profileOvrImpSTOUT("OvrImpSTOUTQuda");
 
+//!< Profiler for GFlowQuda
+static TimeProfile profileGFlow("GFlowQuda");
+
 //!< Profiler for projectSU3Quda
 static TimeProfile profileProject("projectSU3Quda");
 
@@ -467,6 +496,17 @@ void initQudaDevice(int dev) {
     }
   }
 
+  { // determine if the links and the gauge force are computed on the CPU or GPU (default is GPU)
+    char *link_str = getenv("QUDA_LINK_LOCATION");
+
+    if (link_str && (!strcmp(link_str,"CPU") || !strcmp(link_str,"cpu")) ) {
+      warningQuda("Links and gauge force computed on CPU (set with QUDA_LINK_LOCATION=GPU/CPU)");
+      link_location = QUDA_CPU_FIELD_LOCATION;
+    } else {
+      link_location = QUDA_CUDA_FIELD_LOCATION;
+    }
+  }
+
   profileInit.TPSTOP(QUDA_PROFILE_INIT);
   profileInit.TPSTOP(QUDA_PROFILE_TOTAL);
 }
@@ -507,6 +547,26 @@ void initQudaMemory()
   num_failures_h = static_cast<int*>(mapped_malloc(sizeof(int)));
   cudaHostGetDevicePointer(&num_failures_d, num_failures_h, 0);
 
+  { // determine if the sloppy fields are created on first use and the device memory budget for them
+    char *lazy_str = getenv("QUDA_LAZY_SLOPPY");
+    lazy_sloppy = lazy_str && strcmp(lazy_str, "0");
+    if (lazy_sloppy) warningQuda("Sloppy fields created on first use (set with QUDA_LAZY_SLOPPY=0/1)");
+
+    char *budget_str = getenv("QUDA_DEVICE_MEMORY_BUDGET");
+    device_memory_budget = budget_str ? atof(budget_str) * (1<<30) : 0.0;
+    if (device_memory_budget < 0.0) errorQuda("Invalid device memory budget %s", budget_str);
+    if (device_memory_budget > 0.0)
+      warningQuda("Sloppy fields evicted above %.2f GiB of device memory (set with QUDA_DEVICE_MEMORY_BUDGET)",
+		  device_memory_budget / (1<<30));
+
+    char *host_budget_str = getenv("QUDA_HOST_MEMORY_BUDGET");
+    host_memory_budget = host_budget_str ? atof(host_budget_str) * (1<<30) : 0.0;
+    if (host_memory_budget < 0.0) errorQuda("Invalid host memory budget %s", host_budget_str);
+    if (host_memory_budget > 0.0)
+      warningQuda("Pinned memory pool flushed above %.2f GiB of host memory (set with QUDA_HOST_MEMORY_BUDGET)",
+		  host_memory_budget / (1<<30));
+  }
+
   loadTuneCache();
 
   for (int d=0; d<4; d++) R[d] = 2 * (redundant_comms || commDimPartitioned(d));
@@ -568,6 +628,35 @@ static cudaGaugeField* createExtendedGauge(cudaGaugeField &in, const int *R, Tim
   return out;
 }
 
+// helper for creating QDP-ordered extended gauge fields for the host kernels
+static cpuGaugeField* createExtendedGaugeHost(const cpuGaugeField &in, const int *R, TimeProfile &profile)
+{
+  profile.TPSTART(QUDA_PROFILE_INIT);
+  GaugeFieldParam gParamEx(in);
+  for (int d=0; d<4; d++) {
+    gParamEx.x[d] = in.X()[d] + 2*R[d];
+    gParamEx.r[d] = R[d];
+  }
+  gParamEx.pad = 0;
+  gParamEx.create = QUDA_ZERO_FIELD_CREATE;
+  gParamEx.order = QUDA_QDP_GAUGE_ORDER;
+  gParamEx.reconstruct = QUDA_RECONSTRUCT_NO;
+  gParamEx.ghostExchange = QUDA_GHOST_EXCHANGE_EXTENDED;
+  gParamEx.siteSubset = QUDA_FULL_SITE_SUBSET;
+  gParamEx.nFace = 1;
+
+  cpuGaugeField *out = new cpuGaugeField(gParamEx);
+  copyExtendedGauge(*out, in, QUDA_CPU_FIELD_LOCATION);
+  profile.TPSTOP(QUDA_PROFILE_INIT);
+
+  // halos are always filled since the host kernels index the border directly
+  profile.TPSTART(QUDA_PROFILE_COMMS);
+  out->exchangeExtendedGhost(R, true);
+  profile.TPSTOP(QUDA_PROFILE_COMMS);
+
+  return out;
+}
+
 // This is a flag used to signal when we have downloaded new gauge
 // field.  Set by loadGaugeQuda and consumed by loadCloverQuda as one
 // possible flag to indicate we need to recompute the clover field
@@ -612,6 +701,12 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
     invalidate_clover = true;
   }
 
+  // make room for the new precise field, whose sloppy variants are rebuilt on their next use
+  {
+    bool need[SLOPPY_VARIANTS] = { };
+    evictSloppyVariants(need, (size_t)in->Volume() * in->Geometry() * param->reconstruct * param->cuda_prec);
+  }
+
   // free any current gauge field before new allocations to reduce memory overhead
   switch (param->type) {
     case QUDA_WILSON_LINKS:
@@ -650,25 +745,75 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
     QUDA_FLOAT2_GAUGE_ORDER : QUDA_FLOAT4_GAUGE_ORDER;
 
   precise = new cudaGaugeField(gauge_param);
+  param->gaugeGiB += precise->GBytes();
 
   if (param->use_resident_gauge) {
     if(gaugePrecise == NULL) errorQuda("No resident gauge field");
     // copy rather than point at to ensure that the padded region is filled in
     precise->copy(*gaugePrecise);
     precise->exchangeGhost();
+    // free the old field before the rest of the ladder is allocated
     delete gaugePrecise;
     gaugePrecise = NULL;
+  }
+
+  // for gaugeSmeared we are interested only in the precise version,
+  // and with lazy creation the others are made by the first solver
+  // that uses them (unless the extended preconditioner field needs them now)
+  cudaGaugeField *sloppy = precise;
+  cudaGaugeField *precondition = precise;
+  if (param->type != QUDA_SMEARED_LINKS && lazy_sloppy && !param->overlap) {
+    sloppy = NULL;
+    precondition = NULL;
+  } else if (param->type != QUDA_SMEARED_LINKS) {
+    // switch the parameters for creating the mirror sloppy cuda gauge field
+    gauge_param.precision = param->cuda_prec_sloppy;
+    gauge_param.reconstruct = param->reconstruct_sloppy;
+    gauge_param.order = (gauge_param.precision == QUDA_DOUBLE_PRECISION ||
+			 gauge_param.reconstruct == QUDA_RECONSTRUCT_NO ) ?
+      QUDA_FLOAT2_GAUGE_ORDER : QUDA_FLOAT4_GAUGE_ORDER;
+    if (param->cuda_prec != param->cuda_prec_sloppy ||
+	param->reconstruct != param->reconstruct_sloppy) {
+      sloppy = new cudaGaugeField(gauge_param);
+      param->gaugeGiB += sloppy->GBytes();
+    }
+
+    // switch the parameters for creating the mirror preconditioner cuda gauge field
+    gauge_param.precision = param->cuda_prec_precondition;
+    gauge_param.reconstruct = param->reconstruct_precondition;
+    gauge_param.order = (gauge_param.precision == QUDA_DOUBLE_PRECISION ||
+			 gauge_param.reconstruct == QUDA_RECONSTRUCT_NO ) ?
+      QUDA_FLOAT2_GAUGE_ORDER : QUDA_FLOAT4_GAUGE_ORDER;
+    if (param->cuda_prec_sloppy != param->cuda_prec_precondition ||
+	param->reconstruct_sloppy != param->reconstruct_precondition) {
+      precondition = new cudaGaugeField(gauge_param);
+      param->gaugeGiB += precondition->GBytes();
+    } else {
+      precondition = sloppy;
+    }
+  }
+
+  // the fields of the ladder that are not aliases of a more precise one
+  std::vector<cudaGaugeField*> ladder(1, precise);
+  if (sloppy && sloppy != precise) ladder.push_back(sloppy);
+  if (precondition && precondition != sloppy) ladder.push_back(precondition);
+  if (sloppy) sloppy_last_use[SLOPPY_GAUGE] = ++sloppy_clock;
+
+  if (param->use_resident_gauge) {
     profileGauge.TPSTOP(QUDA_PROFILE_INIT);
+
+    // creating sloppy fields isn't really compute, but it is work done on the gpu
+    profileGauge.TPSTART(QUDA_PROFILE_COMPUTE);
+    cudaGaugeField::copyLadder(std::vector<cudaGaugeField*>(ladder.begin()+1, ladder.end()), *precise);
+    profileGauge.TPSTOP(QUDA_PROFILE_COMPUTE);
   } else {
     profileGauge.TPSTOP(QUDA_PROFILE_INIT);
     profileGauge.TPSTART(QUDA_PROFILE_H2D);
-    precise->copy(*in);
+    // the precise, sloppy and preconditioner fields are filled in one pass over the input
+    cudaGaugeField::copyLadder(ladder, *in);
     profileGauge.TPSTOP(QUDA_PROFILE_H2D);
   }
 
-  param->gaugeGiB += precise->GBytes();
-
-  // for gaugeSmeared we are interested only in the precise version
   if (param->type == QUDA_SMEARED_LINKS) {
     gaugeSmeared = createExtendedGauge(*precise, R, profileGauge);
 
@@ -681,43 +826,6 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
     return;
   }
 
-  // creating sloppy fields isn't really compute, but it is work done on the gpu
-  profileGauge.TPSTART(QUDA_PROFILE_COMPUTE);
-
-  // switch the parameters for creating the mirror sloppy cuda gauge field
-  gauge_param.precision = param->cuda_prec_sloppy;
-  gauge_param.reconstruct = param->reconstruct_sloppy;
-  gauge_param.order = (gauge_param.precision == QUDA_DOUBLE_PRECISION ||
-      gauge_param.reconstruct == QUDA_RECONSTRUCT_NO ) ?
-    QUDA_FLOAT2_GAUGE_ORDER : QUDA_FLOAT4_GAUGE_ORDER;
-  cudaGaugeField *sloppy = NULL;
-  if (param->cuda_prec != param->cuda_prec_sloppy ||
-      param->reconstruct != param->reconstruct_sloppy) {
-    sloppy = new cudaGaugeField(gauge_param);
-    sloppy->copy(*precise);
-    param->gaugeGiB += sloppy->GBytes();
-  } else {
-    sloppy = precise;
-  }
-
-  // switch the parameters for creating the mirror preconditioner cuda gauge field
-  gauge_param.precision = param->cuda_prec_precondition;
-  gauge_param.reconstruct = param->reconstruct_precondition;
-  gauge_param.order = (gauge_param.precision == QUDA_DOUBLE_PRECISION ||
-      gauge_param.reconstruct == QUDA_RECONSTRUCT_NO ) ?
-    QUDA_FLOAT2_GAUGE_ORDER : QUDA_FLOAT4_GAUGE_ORDER;
-  cudaGaugeField *precondition = NULL;
-  if (param->cuda_prec_sloppy != param->cuda_prec_precondition ||
-      param->reconstruct_sloppy != param->reconstruct_precondition) {
-    precondition = new cudaGaugeField(gauge_param);
-    precondition->copy(*sloppy);
-    param->gaugeGiB += precondition->GBytes();
-  } else {
-    precondition = sloppy;
-  }
-
-  profileGauge.TPSTOP(QUDA_PROFILE_COMPUTE);
-
   // create an extended preconditioning field
   cudaGaugeField* extended = nullptr;
   if (param->overlap){
@@ -910,6 +1018,12 @@ void loadCloverQuda(void *h_clover, void *h_clovinv, QudaInvertParam *inv_param)
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Creating new clover field\n");
     freeSloppyCloverQuda();
     if (cloverPrecise) delete cloverPrecise;
+    cloverPrecise = nullptr;
+
+    // make room for the new precise field, whose sloppy variants are rebuilt on their next use
+    bool need[SLOPPY_VARIANTS] = { };
+    evictSloppyVariants(need, (size_t)gaugePrecise->Volume() * 72 * clover_param.precision *
+			((clover_param.direct ? 1 : 0) + (clover_param.inverse ? 1 : 0)));
 
     profileClover.TPSTART(QUDA_PROFILE_INIT);
     cloverPrecise = new cudaCloverField(clover_param);
@@ -963,7 +1077,11 @@ void loadCloverQuda(void *h_clover, void *h_clovinv, QudaInvertParam *inv_param)
 
   cloverPrecise->setRho(inv_param->clover_rho);
 
-  loadSloppyCloverQuda(inv_param->clover_cuda_prec_sloppy, inv_param->clover_cuda_prec_precondition);
+  // with lazy creation the sloppy clover fields are made by the first solver that uses them
+  if (!lazy_sloppy) {
+    loadSloppyCloverQuda(inv_param->clover_cuda_prec_sloppy, inv_param->clover_cuda_prec_precondition);
+    sloppy_last_use[SLOPPY_CLOVER] = ++sloppy_clock;
+  }
 
   // if requested, copy back the clover / inverse field
   if ( inv_param->return_clover || inv_param->return_clover_inverse ) {
@@ -1137,10 +1255,11 @@ void loadSloppyGaugeQuda(QudaPrecision prec_sloppy, QudaPrecision prec_precondit
 
     if (gaugeSloppy) errorQuda("gaugeSloppy already exists");
 
+    std::vector<cudaGaugeField*> ladder;
     if (gauge_param.precision != gaugePrecise->Precision() ||
 	gauge_param.reconstruct != gaugePrecise->Reconstruct()) {
       gaugeSloppy = new cudaGaugeField(gauge_param);
-      gaugeSloppy->copy(*gaugePrecise);
+      ladder.push_back(gaugeSloppy);
     } else {
       gaugeSloppy = gaugePrecise;
     }
@@ -1154,16 +1273,19 @@ void loadSloppyGaugeQuda(QudaPrecision prec_sloppy, QudaPrecision prec_precondit
     if (gauge_param.precision != gaugeSloppy->Precision() ||
 	gauge_param.reconstruct != gaugeSloppy->Reconstruct()) {
       gaugePrecondition = new cudaGaugeField(gauge_param);
-      gaugePrecondition->copy(*gaugeSloppy);
+      ladder.push_back(gaugePrecondition);
     } else {
       gaugePrecondition = gaugeSloppy;
     }
+
+    cudaGaugeField::copyLadder(ladder, *gaugePrecise);
   }
 
   // fat links (if they exist)
   if (gaugeFatPrecise) {
     GaugeFieldParam gauge_param(*gaugeFatPrecise);
 
+    std::vector<cudaGaugeField*> ladder;
     if (gaugeFatSloppy != gaugeSloppy) {
       gauge_param.setPrecision(prec_sloppy);
       //gauge_param.reconstruct = param->reconstruct_sloppy; // FIXME
@@ -1174,7 +1296,7 @@ void loadSloppyGaugeQuda(QudaPrecision prec_sloppy, QudaPrecision prec_precondit
       if (gauge_param.precision != gaugeFatPrecise->Precision() ||
 	  gauge_param.reconstruct != gaugeFatPrecise->Reconstruct()) {
 	gaugeFatSloppy = new cudaGaugeField(gauge_param);
-	gaugeFatSloppy->copy(*gaugeFatPrecise);
+	ladder.push_back(gaugeFatSloppy);
       } else {
 	gaugeFatSloppy = gaugeFatPrecise;
       }
@@ -1190,11 +1312,13 @@ void loadSloppyGaugeQuda(QudaPrecision prec_sloppy, QudaPrecision prec_precondit
       if (gauge_param.precision != gaugeFatSloppy->Precision() ||
 	  gauge_param.reconstruct != gaugeFatSloppy->Reconstruct()) {
 	gaugeFatPrecondition = new cudaGaugeField(gauge_param);
-	gaugeFatPrecondition->copy(*gaugeFatSloppy);
+	ladder.push_back(gaugeFatPrecondition);
       } else {
 	gaugeFatPrecondition = gaugeFatSloppy;
       }
     }
+
+    cudaGaugeField::copyLadder(ladder, *gaugeFatPrecise);
   }
 
   // long links (if they exist)
@@ -1206,10 +1330,11 @@ void loadSloppyGaugeQuda(QudaPrecision prec_sloppy, QudaPrecision prec_precondit
     if (gaugeLongSloppy) errorQuda("gaugeLongSloppy already exists");
     if (gaugeLongSloppy != gaugeLongPrecise) delete gaugeLongSloppy;
 
+    std::vector<cudaGaugeField*> ladder;
     if (gauge_param.precision != gaugeLongPrecise->Precision() ||
 	gauge_param.reconstruct != gaugeLongPrecise->Reconstruct()) {
       gaugeLongSloppy = new cudaGaugeField(gauge_param);
-      gaugeLongSloppy->copy(*gaugeLongPrecise);
+      ladder.push_back(gaugeLongSloppy);
     } else {
       gaugeLongSloppy = gaugeLongPrecise;
     }
@@ -1223,10 +1348,12 @@ void loadSloppyGaugeQuda(QudaPrecision prec_sloppy, QudaPrecision prec_precondit
     if (gauge_param.precision != gaugeLongSloppy->Precision() ||
 	gauge_param.reconstruct != gaugeLongSloppy->Reconstruct()) {
       gaugeLongPrecondition = new cudaGaugeField(gauge_param);
-      gaugeLongPrecondition->copy(*gaugeLongSloppy);
+      ladder.push_back(gaugeLongPrecondition);
     } else {
       gaugeLongPrecondition = gaugeLongSloppy;
     }
+
+    cudaGaugeField::copyLadder(ladder, *gaugeLongPrecise);
   }
 }
 
@@ -1247,6 +1374,46 @@ void freeCloverQuda(void)
   cloverPrecise = nullptr;
 }
 
+void flushRecycleQuda(void)
+{
+  if (recycleResident) delete recycleResident;
+  recycleResident = nullptr;
+  recycleKey.clear();
+}
+
+/**
+   Return the resident recycled subspace for this solve, discarding
+   it if the gauge / clover fields or operator parameters have changed
+   since it was built.  The fields are identified by their versions,
+   which are unique across fields, so replacing a resident field
+   flushes the subspace.  Routines that overwrite a field in place
+   (copies, staggered phases, SU(3) projection, Gaussian gauge
+   generation and clover computation) renew its version, so they flush
+   it too.
+ */
+static RecycleSpace* getRecycleSpace(const QudaInvertParam &param)
+{
+  auto version = [](const LatticeField *field) { return field ? static_cast<unsigned long long>(field->Version()) : 0ull; };
+
+  char key[512];
+  snprintf(key, sizeof(key), "%llu,%llu,%llu,%d,%d,%d,%d,%d,%.16e,%.16e,%.16e,%.16e,%d,%d,%e",
+	   version(gaugePrecise), version(gaugeLongPrecise), version(cloverPrecise), param.dslash_type, param.solve_type, param.matpc_type,
+	   param.dagger, param.cuda_prec_sloppy, param.kappa, param.mu, param.mass, param.clover_coeff,
+	   param.max_search_dim, param.max_recycle_dim, param.recycle_mem_limit);
+
+  if (recycleResident && recycleKey != key) {
+    if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Operator changed - flushing recycled subspace\n");
+    flushRecycleQuda();
+  }
+
+  if (!recycleResident) {
+    recycleResident = new RecycleSpace(param.max_recycle_dim, param.recycle_mem_limit);
+    recycleKey = key;
+  }
+
+  return recycleResident;
+}
+
 void flushChronoQuda(int i)
 {
   if (i >= QUDA_MAX_CHRONO)
@@ -1272,6 +1439,8 @@ void endQuda(void)
 
   for (int i=0; i<QUDA_MAX_CHRONO; i++) flushChronoQuda(i);
 
+  flushRecycleQuda();
+
   for (auto v : solutionResident) if (v) delete v;
   solutionResident.clear();
 
@@ -1315,6 +1484,7 @@ void endQuda(void)
     profileDslash.Print();
     profileInvert.Print();
     profileMulti.Print();
+    profilePropagator.Print();
     profileFatLink.Print();
     profileGaugeForce.Print();
     profileGaugeUpdate.Print();
@@ -1330,6 +1500,7 @@ void endQuda(void)
     profileQCharge.Print();
     profileAPE.Print();
     profileSTOUT.Print();
+    profileGFlow.Print();
     profileProject.Print();
     profilePhase.Print();
     profileMomAction.Print();
@@ -1974,6 +2145,108 @@ bool canReuseResidentGauge(QudaInvertParam *param){
 }
 }
 
+/**
+   @return The device memory held by the sloppy and preconditioner
+   variants of a resident field, not counting those that alias a more
+   precise variant
+ */
+static size_t sloppyVariantBytes(SloppyVariant v)
+{
+  size_t bytes = 0;
+  switch (v) {
+  case SLOPPY_GAUGE:
+    if (gaugeSloppy && gaugeSloppy != gaugePrecise) bytes += gaugeSloppy->TotalBytes();
+    if (gaugePrecondition && gaugePrecondition != gaugeSloppy) bytes += gaugePrecondition->TotalBytes();
+    if (gaugeLongSloppy && gaugeLongSloppy != gaugeLongPrecise) bytes += gaugeLongSloppy->TotalBytes();
+    if (gaugeLongPrecondition && gaugeLongPrecondition != gaugeLongSloppy) bytes += gaugeLongPrecondition->TotalBytes();
+    break;
+  case SLOPPY_CLOVER:
+    if (cloverSloppy && cloverSloppy != cloverPrecise) bytes += cloverSloppy->TotalBytes();
+    if (cloverPrecondition && cloverPrecondition != cloverSloppy) bytes += cloverPrecondition->TotalBytes();
+    break;
+  default: errorQuda("Invalid sloppy variant %d", v);
+  }
+  return bytes;
+}
+
+/**
+   Evict the least recently used sloppy and preconditioner variants
+   that the caller does not need while the device memory in use, plus
+   what the caller is about to allocate, exceeds the budget.  This is
+   only called on entry to a solver or when a resident field is
+   loaded, where no operator of the interface refers to the sloppy
+   fields, and the evicted variants are rebuilt on their next use.
+   Nothing is evicted while a multigrid or deflation instance, whose
+   operators refer to the sloppy fields, is alive.  The sloppy fields
+   are device fields, so host memory pressure is relieved by returning
+   the cached pinned allocations of the pool allocator instead.
+   @param need Which variants the caller needs
+   @param bytes The device memory the caller is about to allocate
+ */
+static void evictSloppyVariants(const bool need[SLOPPY_VARIANTS], size_t bytes)
+{
+  if (host_memory_budget > 0.0 && pool::host_allocated() > host_memory_budget) {
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("Host memory %.2f GiB exceeds the budget, flushing the pinned memory pool\n",
+		 pool::host_allocated() / (double)(1<<30));
+    pool::flush_pinned();
+  }
+
+  if (device_memory_budget == 0.0) return;
+
+  while (true) {
+    // all processes evict together so that they agree on which fields are resident
+    double allocated = pool::device_allocated() + bytes;
+    comm_allreduce_max(&allocated);
+    if (allocated <= device_memory_budget) return;
+
+    if (sloppy_field_users > 0) {
+      if (getVerbosity() >= QUDA_VERBOSE)
+	printfQuda("Device memory %.2f GiB exceeds the budget but %d multigrid or deflation instances hold the sloppy fields\n",
+		   allocated / (1<<30), sloppy_field_users);
+      return;
+    }
+
+    int lru = -1;
+    for (int v=0; v<SLOPPY_VARIANTS; v++) {
+      if (need[v] || sloppyVariantBytes(static_cast<SloppyVariant>(v)) == 0) continue;
+      if (lru < 0 || sloppy_last_use[v] < sloppy_last_use[lru]) lru = v;
+    }
+
+    if (lru < 0) {
+      if (getVerbosity() >= QUDA_VERBOSE)
+	printfQuda("Device memory %.2f GiB exceeds the budget with no sloppy fields left to evict\n", allocated / (1<<30));
+      return;
+    }
+
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("Evicting the sloppy %s fields (%.2f GiB) to meet the device memory budget\n",
+		 sloppy_variant_str[lru], sloppyVariantBytes(static_cast<SloppyVariant>(lru)) / (double)(1<<30));
+
+    if (lru == SLOPPY_GAUGE) freeSloppyGaugeQuda();
+    else freeSloppyCloverQuda();
+
+    // the evicted fields land in the device memory pool, which
+    // device_allocated() does not count, so return them to the device
+    pool::flush_device();
+  }
+}
+
+/**
+   Determine which sloppy variants are used by a solve.  A solve whose
+   sloppy and preconditioner precisions match the precise one only
+   uses aliases of the precise fields, so it needs no variant.
+   @param need Set to whether each variant is used
+   @param param The parameters of the solve
+ */
+static void sloppyVariantsNeeded(bool need[SLOPPY_VARIANTS], const QudaInvertParam &param)
+{
+  const bool mixed = param.cuda_prec_sloppy != param.cuda_prec || param.cuda_prec_precondition != param.cuda_prec;
+  need[SLOPPY_GAUGE] = mixed;
+  need[SLOPPY_CLOVER] = mixed &&
+    (param.dslash_type == QUDA_CLOVER_WILSON_DSLASH || param.dslash_type == QUDA_TWISTED_CLOVER_DSLASH);
+}
+
 void checkClover(QudaInvertParam *param) {
 
   if (param->dslash_type != QUDA_CLOVER_WILSON_DSLASH && param->dslash_type != QUDA_TWISTED_CLOVER_DSLASH) {
@@ -1987,8 +2260,16 @@ void checkClover(QudaInvertParam *param) {
   if ((!cloverSloppy || param->cuda_prec_sloppy != cloverSloppy->Precision()) ||
       (!cloverPrecondition || param->cuda_prec_precondition != cloverPrecondition->Precision())) {
     freeSloppyCloverQuda();
+
+    // (over)estimate the size of the new variants assuming none alias the precise field
+    bool need[SLOPPY_VARIANTS];
+    sloppyVariantsNeeded(need, *param);
+    evictSloppyVariants(need, cloverPrecise->TotalBytes() / cloverPrecise->Precision() *
+			(param->cuda_prec_sloppy + param->cuda_prec_precondition));
+
     loadSloppyCloverQuda(param->cuda_prec_sloppy, param->cuda_prec_precondition);
   }
+  sloppy_last_use[SLOPPY_CLOVER] = ++sloppy_clock;
 
   if (cloverPrecise == nullptr) errorQuda("Precise gauge field doesn't exist");
   if (cloverSloppy == nullptr) errorQuda("Sloppy gauge field doesn't exist");
@@ -2001,11 +2282,16 @@ quda::cudaGaugeField* checkGauge(QudaInvertParam *param) {
     errorQuda("Solve precision %d doesn't match gauge precision %d", param->cuda_prec, gaugePrecise->Precision());
   }
 
+  bool need[SLOPPY_VARIANTS];
+  sloppyVariantsNeeded(need, *param);
+
   quda::cudaGaugeField *cudaGauge = NULL;
   if (param->dslash_type != QUDA_ASQTAD_DSLASH) {
-    if (param->cuda_prec_sloppy != gaugeSloppy->Precision() ||
-	param->cuda_prec_precondition != gaugePrecondition->Precision()) {
+    if (!gaugeSloppy || param->cuda_prec_sloppy != gaugeSloppy->Precision() ||
+	!gaugePrecondition || param->cuda_prec_precondition != gaugePrecondition->Precision()) {
       freeSloppyGaugeQuda();
+      evictSloppyVariants(need, gaugePrecise->TotalBytes() / gaugePrecise->Precision() *
+			  (param->cuda_prec_sloppy + param->cuda_prec_precondition));
       loadSloppyGaugeQuda(param->cuda_prec_sloppy, param->cuda_prec_precondition);
     }
 
@@ -2017,11 +2303,14 @@ quda::cudaGaugeField* checkGauge(QudaInvertParam *param) {
     }
     cudaGauge = gaugePrecise;
   } else {
-    if (param->cuda_prec_sloppy != gaugeFatSloppy->Precision() ||
-	param->cuda_prec_precondition != gaugeFatPrecondition->Precision() ||
-	param->cuda_prec_sloppy != gaugeLongSloppy->Precision() ||
-	param->cuda_prec_precondition != gaugeLongPrecondition->Precision()) {
+    if (!gaugeFatSloppy || param->cuda_prec_sloppy != gaugeFatSloppy->Precision() ||
+	!gaugeFatPrecondition || param->cuda_prec_precondition != gaugeFatPrecondition->Precision() ||
+	!gaugeLongSloppy || param->cuda_prec_sloppy != gaugeLongSloppy->Precision() ||
+	!gaugeLongPrecondition || param->cuda_prec_precondition != gaugeLongPrecondition->Precision()) {
       freeSloppyGaugeQuda();
+      evictSloppyVariants(need, (gaugeFatPrecise->TotalBytes() / gaugeFatPrecise->Precision() +
+				 gaugeLongPrecise->TotalBytes() / gaugeLongPrecise->Precision()) *
+			  (param->cuda_prec_sloppy + param->cuda_prec_precondition));
       loadSloppyGaugeQuda(param->cuda_prec_sloppy, param->cuda_prec_precondition);
     }
 
@@ -2040,6 +2329,7 @@ quda::cudaGaugeField* checkGauge(QudaInvertParam *param) {
     }
     cudaGauge = gaugeFatPrecise;
   }
+  sloppy_last_use[SLOPPY_GAUGE] = ++sloppy_clock;
 
   checkClover(param);
 
@@ -2340,6 +2630,7 @@ void* newMultigridQuda(QudaMultigridParam *mg_param) {
   profileInvert.TPSTART(QUDA_PROFILE_TOTAL);
 
   multigrid_solver *mg = new multigrid_solver(*mg_param, profileInvert);
+  sloppy_field_users++;
 
   profileInvert.TPSTOP(QUDA_PROFILE_TOTAL);
 
@@ -2351,6 +2642,7 @@ void* newMultigridQuda(QudaMultigridParam *mg_param) {
 
 void destroyMultigridQuda(void *mg) {
   delete static_cast<multigrid_solver*>(mg);
+  sloppy_field_users--;
 }
 
 void updateMultigridQuda(void *mg_, QudaMultigridParam *mg_param) {
@@ -2470,6 +2762,35 @@ deflated_solver::deflated_solver(QudaEigParam &eig_param, TimeProfile &profile)
   defl = new Deflation(*deflParam, profile);
 
   profile.TPSTOP(QUDA_PROFILE_INIT);
+
+  // seed the deflation space with the lowest eigenvectors from thick-restart Lanczos
+  if (eig_param.eig_type == QUDA_IMP_RST_LANCZOS && !eig_param.import_vectors) {
+    if (!pc_solve) errorQuda("Thick-restart Lanczos requires a Hermitian operator (QUDA_NORMOP_PC_SOLVE)");
+
+    const int nev = std::min(eig_param.nk, deflParam->tot_dim);
+    if (nev <= 0) errorQuda("Invalid number of Lanczos eigenvectors %d", nev);
+
+    // parameters left unset get a Krylov space twice the number of wanted vectors
+    QudaEigParam lanczos_param = eig_param;
+    if (lanczos_param.nKr <= 0) lanczos_param.nKr = std::max(2*nev, nev+2);
+    if (lanczos_param.max_restarts <= 0) lanczos_param.max_restarts = 100;
+    if (lanczos_param.Stp_residual <= 0.0) lanczos_param.Stp_residual = 1e-6;
+
+    profile.TPSTART(QUDA_PROFILE_INIT);
+    ColorSpinorParam kParam(ritzParam);
+    kParam.composite_dim = lanczos_param.nKr + 1;
+    ColorSpinorField *kSpace = ColorSpinorField::Create(kParam);
+
+    kSpace->Component(0).Source(QUDA_RANDOM_SOURCE);
+    profile.TPSTOP(QUDA_PROFILE_INIT);
+
+    std::vector<double> evals(nev);
+    TRLanczos eig_solve(*m, lanczos_param, profile, nev);
+    eig_solve(kSpace->Components(), evals.data());
+
+    defl->increment(*kSpace, nev);
+    delete kSpace;
+  }
 }
 
 void* newDeflationQuda(QudaEigParam *eig_param) {
@@ -2478,6 +2799,7 @@ void* newDeflationQuda(QudaEigParam *eig_param) {
   openMagma();
 #endif
   deflated_solver *defl = new deflated_solver(*eig_param, profileInvert);
+  sloppy_field_users++;
 
   profileInvert.TPSTOP(QUDA_PROFILE_TOTAL);
 
@@ -2491,6 +2813,7 @@ void destroyDeflationQuda(void *df) {
   closeMagma();
 #endif
   delete static_cast<deflated_solver*>(df);
+  sloppy_field_users--;
 }
 
 void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
@@ -2676,6 +2999,14 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
     errorQuda("Chronological forcasting only presently supported for M^dagger M solver");
   }
 
+  // ghost compression statistics and V-cycle component times are accumulated per solve
+  MG *mg = (param->inv_type_precondition == QUDA_MG_INVERTER && param->preconditioner) ?
+    static_cast<multigrid_solver*>(param->preconditioner)->mg : nullptr;
+  if (mg) {
+    mg->resetGhostCompressionStats();
+    mg->resetComponentTimers();
+  }
+
   if (mat_solution && !direct_solve && !norm_error_solve) { // prepare source: b' = A^dag b
     cudaColorSpinorField tmp(*in);
     dirac.Mdag(*in, tmp);
@@ -2689,9 +3020,12 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
     delete solve;
   }
 
+  const bool use_recycling = (param->inv_type == QUDA_GMRESDR_INVERTER && param->max_recycle_dim > 0);
+
   if (direct_solve) {
     DiracM m(dirac), mSloppy(diracSloppy), mPre(diracPre);
     SolverParam solverParam(*param);
+    if (use_recycling) solverParam.recycle_space = getRecycleSpace(*param);
     Solver *solve = Solver::create(solverParam, m, mSloppy, mPre, profileInvert);
     (*solve)(*out, *in);
     solverParam.updateInvertParam(*param);
@@ -2716,6 +3050,7 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
       mre(*out, tmp, basis);
     }
 
+    if (use_recycling) solverParam.recycle_space = getRecycleSpace(*param);
     Solver *solve = Solver::create(solverParam, m, mSloppy, mPre, profileInvert);
     (*solve)(*out, *in);
     solverParam.updateInvertParam(*param);
@@ -2731,6 +3066,11 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
     delete solve;
   }
 
+  if (mg && getVerbosity() >= QUDA_SUMMARIZE) {
+    mg->printGhostCompressionStats();
+    if (profileMGComponents()) mg->printComponentTimers();
+  }
+
   if (getVerbosity() >= QUDA_VERBOSE){
     double nx = blas::norm2(*x);
    printfQuda("Solution = %g\n",nx);
@@ -2812,6 +3152,167 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
 }
 
 
+/*!
+ * Solve for a batch of sources with a two-deep pipeline around
+ * invertQuda.  Each solve reads its source from, and writes its
+ * solution to, a device staging field in native order at the host
+ * precision (input_location = output_location = QUDA_CUDA_FIELD_LOCATION),
+ * and while solve i runs
+ *
+ * - source i+1 is uploaded from its pinned buffer on a non-blocking stream,
+ * - source i+2 is reordered into the pinned buffer freed by source i,
+ * - solution i-1 is reordered from its pinned buffer into host order,
+ *
+ * with the reordering done on a helper thread, so that only the
+ * download of each solution, which is queued behind the solve, is not
+ * overlapped with a solve.
+ */
+void invertPropagatorQuda(void **hp_x, void **hp_b, int n_src, QudaInvertParam *param)
+{
+  profilePropagator.TPSTART(QUDA_PROFILE_TOTAL);
+  profilePropagator.TPSTART(QUDA_PROFILE_INIT);
+
+  if (!initialized) errorQuda("QUDA not initialized");
+  if (n_src < 1) errorQuda("Invalid number of sources %d", n_src);
+  if (!gaugePrecise) errorQuda("Gauge field not allocated");
+  if (param->input_location != QUDA_CPU_FIELD_LOCATION || param->output_location != QUDA_CPU_FIELD_LOCATION)
+    errorQuda("Propagator pipeline requires host sources and solutions");
+  if (param->use_init_guess == QUDA_USE_INIT_GUESS_YES)
+    errorQuda("Initial guess not supported by the propagator pipeline");
+  if (param->make_resident_solution) errorQuda("Resident solution not supported by the propagator pipeline");
+
+  bool pc_solution = (param->solution_type == QUDA_MATPC_SOLUTION) ||
+    (param->solution_type == QUDA_MATPCDAG_MATPC_SOLUTION);
+
+  // wrap the host sources and solutions here, since field creation is not thread safe
+  ColorSpinorParam cpuParam(hp_b[0], *param, gaugePrecise->X(), pc_solution, QUDA_CPU_FIELD_LOCATION);
+  std::vector<ColorSpinorField*> h_b(n_src), h_x(n_src);
+  for (int i=0; i<n_src; i++) {
+    cpuParam.v = hp_b[i];
+    h_b[i] = ColorSpinorField::Create(cpuParam);
+    cpuParam.v = hp_x[i];
+    h_x[i] = ColorSpinorField::Create(cpuParam);
+  }
+
+  // the staging fields are unpadded so that invertQuda can wrap them as internal-order fields
+  ColorSpinorParam cudaParam(cpuParam, *param);
+  cudaParam.create = QUDA_NULL_FIELD_CREATE;
+  cudaParam.setPrecision(param->cpu_prec);
+  cudaParam.pad = 0;
+
+  cudaColorSpinorField *b_stage[2], *x_stage[2];
+  void *b_pinned[2], *x_pinned[2];
+  cudaEvent_t uploaded[2], downloaded[2], solved;
+  for (int k=0; k<2; k++) {
+    b_stage[k] = new cudaColorSpinorField(cudaParam);
+    x_stage[k] = new cudaColorSpinorField(cudaParam);
+    b_pinned[k] = pool_pinned_malloc(b_stage[k]->Bytes());
+    x_pinned[k] = pool_pinned_malloc(x_stage[k]->Bytes());
+    cudaEventCreateWithFlags(&uploaded[k], cudaEventDisableTiming);
+    cudaEventCreateWithFlags(&downloaded[k], cudaEventDisableTiming);
+  }
+  cudaEventCreateWithFlags(&solved, cudaEventDisableTiming);
+
+  // the solver runs on the default stream, so the transfers need a stream that does not synchronize with it
+  cudaStream_t copy_stream;
+  cudaStreamCreateWithFlags(&copy_stream, cudaStreamNonBlocking);
+
+  // each solve sees its staging fields as internal-order fields at the host precision
+  QudaInvertParam stage_param = *param;
+  stage_param.input_location = QUDA_CUDA_FIELD_LOCATION;
+  stage_param.output_location = QUDA_CUDA_FIELD_LOCATION;
+  stage_param.dirac_order = QUDA_INTERNAL_DIRAC_ORDER;
+  stage_param.gamma_basis = b_stage[0]->GammaBasis();
+
+  // reordering is done by the host threads only, so can run alongside the solver
+  auto reorderSource = [&](int i) {
+    copyGenericColorSpinor(*b_stage[i%2], *h_b[i], QUDA_CPU_FIELD_LOCATION, b_pinned[i%2], 0);
+  };
+  auto reorderSolution = [&](int i) {
+    copyGenericColorSpinor(*h_x[i], *x_stage[i%2], QUDA_CPU_FIELD_LOCATION, 0, x_pinned[i%2]);
+  };
+  auto upload = [&](int i) {
+    cudaMemcpyAsync(b_stage[i%2]->V(), b_pinned[i%2], b_stage[i%2]->Bytes(), cudaMemcpyHostToDevice, copy_stream);
+    cudaEventRecord(uploaded[i%2], copy_stream);
+  };
+
+  profilePropagator.TPSTOP(QUDA_PROFILE_INIT);
+
+  // fill the pipeline: upload the first source and stage the second
+  profilePropagator.TPSTART(QUDA_PROFILE_H2D);
+  reorderSource(0);
+  upload(0);
+  if (n_src > 1) reorderSource(1);
+  profilePropagator.TPSTOP(QUDA_PROFILE_H2D);
+
+  param->secs = 0;
+  param->gflops = 0;
+  param->iter = 0;
+  param->true_res = 0;
+  param->true_res_hq = 0;
+
+  for (int i=0; i<n_src; i++) {
+    profilePropagator.TPSTART(QUDA_PROFILE_H2D);
+    if (i+1 < n_src) upload(i+1);
+    if (i >= 1) cudaEventSynchronize(downloaded[(i-1)%2]);
+    cudaEventSynchronize(uploaded[i%2]);
+    profilePropagator.TPSTOP(QUDA_PROFILE_H2D);
+
+    std::thread helper([&, i]() {
+	if (i+2 < n_src) reorderSource(i+2);
+	if (i >= 1) reorderSolution(i-1);
+      });
+
+    profilePropagator.TPSTART(QUDA_PROFILE_COMPUTE);
+    invertQuda(x_stage[i%2]->V(), b_stage[i%2]->V(), &stage_param);
+    cudaEventRecord(solved, 0);
+    profilePropagator.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+    cudaStreamWaitEvent(copy_stream, solved, 0);
+    cudaMemcpyAsync(x_pinned[i%2], x_stage[i%2]->V(), x_stage[i%2]->Bytes(), cudaMemcpyDeviceToHost, copy_stream);
+    cudaEventRecord(downloaded[i%2], copy_stream);
+
+    param->secs += stage_param.secs;
+    param->gflops += stage_param.gflops;
+    param->iter += stage_param.iter;
+    param->true_res = std::max(param->true_res, stage_param.true_res);
+    param->true_res_hq = std::max(param->true_res_hq, stage_param.true_res_hq);
+
+    profilePropagator.TPSTART(QUDA_PROFILE_EPILOGUE);
+    helper.join();
+    profilePropagator.TPSTOP(QUDA_PROFILE_EPILOGUE);
+  }
+
+  // drain the pipeline
+  profilePropagator.TPSTART(QUDA_PROFILE_D2H);
+  cudaEventSynchronize(downloaded[(n_src-1)%2]);
+  reorderSolution(n_src-1);
+  profilePropagator.TPSTOP(QUDA_PROFILE_D2H);
+
+  if (getVerbosity() >= QUDA_SUMMARIZE)
+    printfQuda("Propagator pipeline: %d sources, %d iterations, %g secs, worst true residual %e\n",
+	       n_src, param->iter, param->secs, param->true_res);
+
+  profilePropagator.TPSTART(QUDA_PROFILE_FREE);
+  cudaStreamDestroy(copy_stream);
+  cudaEventDestroy(solved);
+  for (int k=0; k<2; k++) {
+    cudaEventDestroy(downloaded[k]);
+    cudaEventDestroy(uploaded[k]);
+    pool_pinned_free(x_pinned[k]);
+    pool_pinned_free(b_pinned[k]);
+    delete x_stage[k];
+    delete b_stage[k];
+  }
+  for (int i=0; i<n_src; i++) {
+    delete h_x[i];
+    delete h_b[i];
+  }
+  profilePropagator.TPSTOP(QUDA_PROFILE_FREE);
+
+  profilePropagator.TPSTOP(QUDA_PROFILE_TOTAL);
+}
+
 /*!
  * Generic version of the multi-shift solver. Should work for
  * most fermions. Note that offset[0] is not folded into the mass parameter.
@@ -3061,6 +3562,14 @@ for(int i=0; i < param->num_src; i++) {
     if (param->inv_type_precondition == QUDA_MG_INVERTER && (pc_solve || pc_solution || !direct_solve || !mat_solution))
       errorQuda("Multigrid preconditioning only supported for direct non-red-black solve");
 
+    // ghost compression statistics and V-cycle component times are accumulated per solve
+    MG *mg = (param->inv_type_precondition == QUDA_MG_INVERTER && param->preconditioner) ?
+      static_cast<multigrid_solver*>(param->preconditioner)->mg : nullptr;
+    if (mg) {
+      mg->resetGhostCompressionStats();
+      mg->resetComponentTimers();
+    }
+
     if (mat_solution && !direct_solve && !norm_error_solve) { // prepare source: b' = A^dag b
       for(int i=0; i < param->num_src; i++) {
         cudaColorSpinorField tmp((in->Component(i)));
@@ -3104,6 +3613,11 @@ for(int i=0; i < param->num_src; i++) {
       // delete solve;
     }
 
+    if (mg && getVerbosity() >= QUDA_SUMMARIZE) {
+      mg->printGhostCompressionStats();
+      if (profileMGComponents()) mg->printComponentTimers();
+    }
+
     if (getVerbosity() >= QUDA_VERBOSE){
       for(int i=0; i < param->num_src; i++) {
         double nx = blas::norm2(x->Component(i));
@@ -3534,9 +4048,85 @@ void invertMultiShiftQuda(void **_hp_x, void *_hp_b, QudaInvertParam *param)
   profileMulti.TPSTOP(QUDA_PROFILE_TOTAL);
 }
 
+/**
+   Compute the fat, long and unitarized links on the host, when
+   QUDA_LINK_LOCATION=CPU or when the device kernels are not built.
+   The links are built by fatLongKSLinkHost on an extended host copy
+   of the input.
+*/
+static void computeKSLinkHost(void* fatlink, void* longlink, void* ulink, void* inlink, double *path_coeff, QudaGaugeParam *param)
+{
+  profileFatLink.TPSTART(QUDA_PROFILE_TOTAL);
+  profileFatLink.TPSTART(QUDA_PROFILE_INIT);
+
+  checkGaugeParam(param);
+
+  GaugeFieldParam gParam(fatlink, *param, QUDA_GENERAL_LINKS);
+  cpuGaugeField cpuFatLink(gParam);   // create the host fatlink
+  gParam.gauge = longlink;
+  cpuGaugeField cpuLongLink(gParam);  // create the host longlink
+  gParam.gauge = ulink;
+  cpuGaugeField cpuUnitarizedLink(gParam);
+  gParam.link_type = param->type;
+  gParam.gauge     = inlink;
+  cpuGaugeField cpuInLink(gParam);    // create the host sitelink
+
+  // the host engine works on QDP-ordered fields at the host precision
+  gParam.order = QUDA_QDP_GAUGE_ORDER;
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  gParam.gauge = nullptr;
+  gParam.link_type = QUDA_GENERAL_LINKS;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  cpuGaugeField *fat = new cpuGaugeField(gParam);
+  cpuGaugeField *lng = longlink ? new cpuGaugeField(gParam) : nullptr;
+  cpuGaugeField *unitarized = ulink ? new cpuGaugeField(gParam) : nullptr;
+  profileFatLink.TPSTOP(QUDA_PROFILE_INIT);
+
+  cpuGaugeField *inLinkEx = createExtendedGaugeHost(cpuInLink, R, profileFatLink);
+
+  profileFatLink.TPSTART(QUDA_PROFILE_COMPUTE);
+  fatLongKSLinkHost(fat, lng, *inLinkEx, path_coeff);
+  profileFatLink.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+  if (ulink) {
+    profileFatLink.TPSTART(QUDA_PROFILE_COMPUTE);
+    const double unitarize_eps = 1e-14;
+    const double max_error = 1e-10;
+    const bool reunit_allow_svd = true;
+    const bool reunit_svd_only  = false;
+    const double svd_rel_error = 1e-6;
+    const double svd_abs_error = 1e-6;
+    int num_failures = unitarizeLinksHost(*unitarized, *fat, unitarize_eps, max_error, reunit_allow_svd, reunit_svd_only,
+					  svd_rel_error, svd_abs_error);
+    comm_allreduce_int(&num_failures);
+    if (num_failures>0) errorQuda("Error in unitarization component of the hisq fattening: %d failures\n", num_failures);
+    profileFatLink.TPSTOP(QUDA_PROFILE_COMPUTE);
+  }
+
+  profileFatLink.TPSTART(QUDA_PROFILE_EPILOGUE);
+  if (fatlink) cpuFatLink.copy(*fat);
+  if (longlink) cpuLongLink.copy(*lng);
+  if (ulink) cpuUnitarizedLink.copy(*unitarized);
+  profileFatLink.TPSTOP(QUDA_PROFILE_EPILOGUE);
+
+  profileFatLink.TPSTART(QUDA_PROFILE_FREE);
+  delete fat;
+  if (lng) delete lng;
+  if (unitarized) delete unitarized;
+  delete inLinkEx;
+  profileFatLink.TPSTOP(QUDA_PROFILE_FREE);
+
+  profileFatLink.TPSTOP(QUDA_PROFILE_TOTAL);
+}
+
 void computeKSLinkQuda(void* fatlink, void* longlink, void* ulink, void* inlink, double *path_coeff, QudaGaugeParam *param) {
 
 #ifdef GPU_FATLINK
+  if (link_location == QUDA_CPU_FIELD_LOCATION) {
+    computeKSLinkHost(fatlink, longlink, ulink, inlink, path_coeff, param);
+    return;
+  }
+
   profileFatLink.TPSTART(QUDA_PROFILE_TOTAL);
   profileFatLink.TPSTART(QUDA_PROFILE_INIT);
 
@@ -3617,7 +4207,8 @@ void computeKSLinkQuda(void* fatlink, void* longlink, void* ulink, void* inlink,
 
   profileFatLink.TPSTOP(QUDA_PROFILE_TOTAL);
 #else
-  errorQuda("Fat-link has not been built");
+  // without the device kernels the links are computed on the host
+  computeKSLinkHost(fatlink, longlink, ulink, inlink, path_coeff, param);
 #endif // GPU_FATLINK
 
   return;
@@ -3635,10 +4226,77 @@ int getGaugePadding(GaugeFieldParam& param){
   return pad;
 }
 
+/**
+   Compute the gauge force on the host, when QUDA_LINK_LOCATION=CPU
+   or when the device kernels are not built.  The force is accumulated
+   by gaugeForceHost into a MILC-ordered host copy of the momentum.
+*/
+static void computeGaugeForceHost(void* mom, void* siteLink, int*** input_path_buf, int* path_length,
+                                  double* loop_coeff, int num_paths, int max_length, double eb3, QudaGaugeParam* qudaGaugeParam)
+{
+  profileGaugeForce.TPSTART(QUDA_PROFILE_TOTAL);
+  profileGaugeForce.TPSTART(QUDA_PROFILE_INIT);
+
+  checkGaugeParam(qudaGaugeParam);
+
+  if (qudaGaugeParam->use_resident_gauge || qudaGaugeParam->use_resident_mom ||
+      qudaGaugeParam->make_resident_gauge || qudaGaugeParam->make_resident_mom)
+    errorQuda("Resident fields are not supported by the host gauge force");
+
+  GaugeFieldParam gParam(siteLink, *qudaGaugeParam);
+  gParam.site_offset = qudaGaugeParam->gauge_offset;
+  gParam.site_size = qudaGaugeParam->site_size;
+  cpuGaugeField cpuSiteLink(gParam);
+
+  GaugeFieldParam gParamMom(mom, *qudaGaugeParam, QUDA_ASQTAD_MOM_LINKS);
+  // FIXME - test program always uses MILC for mom but can use QDP for gauge
+  if (gParamMom.order == QUDA_QDP_GAUGE_ORDER) gParamMom.order = QUDA_MILC_GAUGE_ORDER;
+  if (gParamMom.order == QUDA_TIFR_GAUGE_ORDER || gParamMom.order == QUDA_TIFR_PADDED_GAUGE_ORDER)
+    errorQuda("Host gauge force does not support momentum order %d", gParamMom.order);
+  gParamMom.reconstruct = QUDA_RECONSTRUCT_10;
+  gParamMom.site_offset = qudaGaugeParam->mom_offset;
+  gParamMom.site_size = qudaGaugeParam->site_size;
+  cpuGaugeField cpuMom(gParamMom);
+
+  // the host engine updates a MILC-ordered copy of the momentum
+  gParamMom.order = QUDA_MILC_GAUGE_ORDER;
+  gParamMom.gauge = nullptr;
+  gParamMom.site_offset = 0;
+  gParamMom.site_size = 0;
+  gParamMom.create = qudaGaugeParam->overwrite_mom ? QUDA_ZERO_FIELD_CREATE : QUDA_NULL_FIELD_CREATE;
+  cpuGaugeField *hostMom = new cpuGaugeField(gParamMom);
+  if (!qudaGaugeParam->overwrite_mom) hostMom->copy(cpuMom);
+  profileGaugeForce.TPSTOP(QUDA_PROFILE_INIT);
+
+  cpuGaugeField *gauge = createExtendedGaugeHost(cpuSiteLink, R, profileGaugeForce);
+
+  profileGaugeForce.TPSTART(QUDA_PROFILE_COMPUTE);
+  gaugeForceHost(*hostMom, *gauge, eb3, input_path_buf, path_length, loop_coeff, num_paths, max_length);
+  profileGaugeForce.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+  if (qudaGaugeParam->return_result_mom) {
+    profileGaugeForce.TPSTART(QUDA_PROFILE_EPILOGUE);
+    cpuMom.copy(*hostMom);
+    profileGaugeForce.TPSTOP(QUDA_PROFILE_EPILOGUE);
+  }
+
+  profileGaugeForce.TPSTART(QUDA_PROFILE_FREE);
+  delete hostMom;
+  delete gauge;
+  profileGaugeForce.TPSTOP(QUDA_PROFILE_FREE);
+
+  profileGaugeForce.TPSTOP(QUDA_PROFILE_TOTAL);
+}
+
 int computeGaugeForceQuda(void* mom, void* siteLink,  int*** input_path_buf, int* path_length,
 			  double* loop_coeff, int num_paths, int max_length, double eb3, QudaGaugeParam* qudaGaugeParam)
 {
 #ifdef GPU_GAUGE_FORCE
+  if (link_location == QUDA_CPU_FIELD_LOCATION) {
+    computeGaugeForceHost(mom, siteLink, input_path_buf, path_length, loop_coeff, num_paths, max_length, eb3, qudaGaugeParam);
+    return 0;
+  }
+
   profileGaugeForce.TPSTART(QUDA_PROFILE_TOTAL);
   profileGaugeForce.TPSTART(QUDA_PROFILE_INIT);
 
@@ -3747,7 +4405,8 @@ int computeGaugeForceQuda(void* mom, void* siteLink,  int*** input_path_buf, int
 
   checkCudaError();
 #else
-  errorQuda("Gauge force has not been built");
+  // without the device kernels the force is computed on the host
+  computeGaugeForceHost(mom, siteLink, input_path_buf, path_length, loop_coeff, num_paths, max_length, eb3, qudaGaugeParam);
 #endif // GPU_GAUGE_FORCE
   return 0;
 }
@@ -5004,6 +5663,8 @@ void invert_multishift_quda_(void *h_x, void *hp_b, QudaInvertParam *param) {
 
 void flush_chrono_quda_(int *index) { flushChronoQuda(*index); }
 
+void flush_recycle_quda_() { flushRecycleQuda(); }
+
 void register_pinned_quda_(void *ptr, size_t *bytes) {
   cudaHostRegister(ptr, *bytes, cudaHostRegisterDefault);
   checkCudaError();
@@ -5299,17 +5960,20 @@ void performWuppertalnStep(void *h_out, void *h_in, QudaInvertParam *inv_param,
   }
 
   cudaParam.create = QUDA_NULL_FIELD_CREATE;
-  cudaColorSpinorField out(in, cudaParam);
+  cudaColorSpinorField tmp(in, cudaParam);
   int parity = 0;
 
+  // ping-pong between the two fields rather than copying the output back each step
+  cudaColorSpinorField *src = &in, *dst = &tmp;
   for (unsigned int i=0; i<nSteps; i++) {
-    if(i) in = out;
-    wuppertalStep(out, in, parity, *precise, alpha);
+    wuppertalStep(*dst, *src, parity, *precise, alpha);
+    std::swap(src, dst);
     if (getVerbosity() >= QUDA_DEBUG_VERBOSE) {
-      double norm = blas::norm2(out);
+      double norm = blas::norm2(*src);
       printfQuda("Step %d, vector norm %e\n", i, norm);
     }
   }
+  cudaColorSpinorField &out = *src;
 
   cpuParam.v = h_out;
   cpuParam.location = inv_param->output_location;
@@ -5333,6 +5997,16 @@ void performWuppertalnStep(void *h_out, void *h_in, QudaInvertParam *inv_param,
   profileWuppertal.TPSTOP(QUDA_PROFILE_TOTAL);
 }
 
+/**
+   Halo depth that a smearing step whose stencil reaches reach sites
+   from the origin needs to have refreshed, limited to the radius of
+   the extended fields
+*/
+static void smearingHaloDepth(int depth[4], int reach)
+{
+  for (int d=0; d<4; d++) depth[d] = std::min(R[d], reach);
+}
+
 void performAPEnStep(unsigned int nSteps, double alpha)
 {
   profileAPE.TPSTART(QUDA_PROFILE_TOTAL);
@@ -5350,16 +6024,29 @@ void performAPEnStep(unsigned int nSteps, double alpha)
     printfQuda("Plaquette after 0 APE steps: %le %le %le\n", plq.x, plq.y, plq.z);
   }
 
+  // the two fields swap roles each step, and only the halo the stencil reads is refreshed
+  int depth[4];
+  smearingHaloDepth(depth, 1);
+
+  profileAPE.TPSTART(QUDA_PROFILE_COMPUTE);
+  cudaGaugeField *in = gaugeSmeared, *out = cudaGaugeTemp;
   for (unsigned int i=0; i<nSteps; i++) {
-    cudaGaugeTemp->copy(*gaugeSmeared);
-    cudaGaugeTemp->exchangeExtendedGhost(R,redundant_comms);
-    APEStep(*gaugeSmeared, *cudaGaugeTemp, alpha);
+    if (i) in->exchangeExtendedGhost(depth,redundant_comms);
+    APEStep(*out, *in, alpha);
+    std::swap(in, out);
   }
+  gaugeSmeared = in;
+  cudaGaugeTemp = out;
+  cudaDeviceSynchronize();
+  profileAPE.TPSTOP(QUDA_PROFILE_COMPUTE);
 
   delete cudaGaugeTemp;
 
   gaugeSmeared->exchangeExtendedGhost(R,redundant_comms);
 
+  if (getVerbosity() >= QUDA_VERBOSE && nSteps > 0)
+    printfQuda("APE: %e secs per step\n", profileAPE.Last(QUDA_PROFILE_COMPUTE)/nSteps);
+
   if (getVerbosity() == QUDA_VERBOSE) {
     double3 plq = plaquette(*gaugeSmeared, QUDA_CUDA_FIELD_LOCATION);
     printfQuda("Plaquette after %d APE steps: %le %le %le\n", nSteps, plq.x, plq.y, plq.z);
@@ -5385,16 +6072,29 @@ void performSTOUTnStep(unsigned int nSteps, double rho)
     printfQuda("Plaquette after 0 STOUT steps: %le %le %le\n", plq.x, plq.y, plq.z);
   }
 
+  // the two fields swap roles each step, and only the halo the stencil reads is refreshed
+  int depth[4];
+  smearingHaloDepth(depth, 1);
+
+  profileSTOUT.TPSTART(QUDA_PROFILE_COMPUTE);
+  cudaGaugeField *in = gaugeSmeared, *out = cudaGaugeTemp;
   for (unsigned int i=0; i<nSteps; i++) {
-    cudaGaugeTemp->copy(*gaugeSmeared);
-    cudaGaugeTemp->exchangeExtendedGhost(R,redundant_comms);
-    STOUTStep(*gaugeSmeared, *cudaGaugeTemp, rho);
+    if (i) in->exchangeExtendedGhost(depth,redundant_comms);
+    STOUTStep(*out, *in, rho);
+    std::swap(in, out);
   }
+  gaugeSmeared = in;
+  cudaGaugeTemp = out;
+  cudaDeviceSynchronize();
+  profileSTOUT.TPSTOP(QUDA_PROFILE_COMPUTE);
 
   delete cudaGaugeTemp;
 
   gaugeSmeared->exchangeExtendedGhost(R,redundant_comms);
 
+  if (getVerbosity() >= QUDA_VERBOSE && nSteps > 0)
+    printfQuda("STOUT: %e secs per step\n", profileSTOUT.Last(QUDA_PROFILE_COMPUTE)/nSteps);
+
   if (getVerbosity() == QUDA_VERBOSE) {
     double3 plq = plaquette(*gaugeSmeared, QUDA_CUDA_FIELD_LOCATION);
     printfQuda("Plaquette after %d STOUT steps: %le %le %le\n", nSteps, plq.x, plq.y, plq.z);
@@ -5420,16 +6120,29 @@ void performSTOUTnStep(unsigned int nSteps, double rho)
     printfQuda("Plaquette after 0 OvrImpSTOUT steps: %le %le %le\n", plq.x, plq.y, plq.z);
   }
 
+  // the two fields swap roles each step, and only the halo the stencil reads is refreshed
+  int depth[4];
+  smearingHaloDepth(depth, 2);
+
+  profileOvrImpSTOUT.TPSTART(QUDA_PROFILE_COMPUTE);
+  cudaGaugeField *in = gaugeSmeared, *out = cudaGaugeTemp;
   for (unsigned int i=0; i<nSteps; i++) {
-    cudaGaugeTemp->copy(*gaugeSmeared);
-    cudaGaugeTemp->exchangeExtendedGhost(R,redundant_comms);
-    OvrImpSTOUTStep(*gaugeSmeared, *cudaGaugeTemp, rho, epsilon);
+    if (i) in->exchangeExtendedGhost(depth,redundant_comms);
+    OvrImpSTOUTStep(*out, *in, rho, epsilon);
+    std::swap(in, out);
   }
+  gaugeSmeared = in;
+  cudaGaugeTemp = out;
+  cudaDeviceSynchronize();
+  profileOvrImpSTOUT.TPSTOP(QUDA_PROFILE_COMPUTE);
 
   delete cudaGaugeTemp;
 
   gaugeSmeared->exchangeExtendedGhost(R,redundant_comms);
 
+  if (getVerbosity() >= QUDA_VERBOSE && nSteps > 0)
+    printfQuda("OvrImpSTOUT: %e secs per step\n", profileOvrImpSTOUT.Last(QUDA_PROFILE_COMPUTE)/nSteps);
+
   if (getVerbosity() == QUDA_VERBOSE) {
     double3 plq = plaquette(*gaugeSmeared, QUDA_CUDA_FIELD_LOCATION);
     printfQuda("Plaquette after %d OvrImpSTOUT steps: %le %le %le\n", nSteps, plq.x, plq.y, plq.z);
@@ -5438,6 +6151,59 @@ void performSTOUTnStep(unsigned int nSteps, double rho)
   profileOvrImpSTOUT.TPSTOP(QUDA_PROFILE_TOTAL);
 }
 
+void performGFlownStep(unsigned int nSteps, double epsilon, double tol, QudaWFlowType type, double *obs)
+{
+  profileGFlow.TPSTART(QUDA_PROFILE_TOTAL);
+
+  if (gaugePrecise == NULL) errorQuda("Gauge field must be loaded");
+  if (type != QUDA_WFLOW_TYPE_WILSON && type != QUDA_WFLOW_TYPE_SYMANZIK) errorQuda("Flow type %d not supported", type);
+
+  if (gaugeSmeared != NULL) delete gaugeSmeared;
+  gaugeSmeared = createExtendedGauge(*gaugePrecise, R, profileGFlow);
+
+  profileGFlow.TPSTART(QUDA_PROFILE_INIT);
+  // the flow generator is the only additional field
+  GaugeFieldParam gParam(*gaugePrecise);
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  gParam.reconstruct = QUDA_RECONSTRUCT_NO;
+  gParam.order = QUDA_FLOAT2_GAUGE_ORDER;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  gParam.pad = 0;
+  cudaGaugeField Z(gParam);
+  profileGFlow.TPSTOP(QUDA_PROFILE_INIT);
+
+  profileGFlow.TPSTART(QUDA_PROFILE_COMPUTE);
+  double t = 0.0;
+  double step_obs[4];
+  for (unsigned int i=0; i<=nSteps; i++) {
+    if (i < nSteps) gradientFlowStep(*gaugeSmeared, Z, epsilon, type, step_obs, redundant_comms);
+    else gradientFlowMeasure(*gaugeSmeared, Z, step_obs);
+
+    if (obs) {
+      obs[4*i+0] = t;
+      for (int j=0; j<3; j++) obs[4*i+1+j] = step_obs[j];
+    }
+
+    if (getVerbosity() >= QUDA_VERBOSE || (i == nSteps && getVerbosity() >= QUDA_SUMMARIZE))
+      printfQuda("GFlow t = %e plaquette = %e E = %e t^2 E = %e Q = %e\n",
+		 t, step_obs[0], step_obs[1], t*t*step_obs[1], step_obs[2]);
+
+    if (i == nSteps) break;
+    t += epsilon;
+
+    // steps cannot be rejected without a copy of the field, so the
+    // error estimate only sets the size of the next step
+    if (tol > 0.0 && step_obs[3] > 0.0) {
+      epsilon *= std::min(2.0, 0.95*cbrt(tol/step_obs[3]));
+      if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
+	printfQuda("GFlow step %u error = %e next epsilon = %e\n", i, step_obs[3], epsilon);
+    }
+  }
+  profileGFlow.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+  profileGFlow.TPSTOP(QUDA_PROFILE_TOTAL);
+}
+
 
 int computeGaugeFixingOVRQuda(void* gauge, const unsigned int gauge_dir,  const unsigned int Nsteps, \
   const unsigned int verbose_interval, const double relax_boost, const double tolerance, const unsigned int reunit_interval, \
@@ -0,0 +1,201 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <complex>
+
+#include <quda_internal.h>
+#include <blas_quda.h>
+#include <dslash_quda.h>
+#include <invert_quda.h>
+#include <util_quda.h>
+#include <color_spinor_field.h>
+
+#include <Eigen/Dense>
+
+namespace quda {
+
+  using namespace Eigen;
+
+  CAGCR::CAGCR(DiracMatrix &mat, DiracMatrix &matSloppy, SolverParam &param, TimeProfile &profile) :
+    Solver(param, profile), mat(mat), matSloppy(matSloppy), nKrylov(param.Nkrylov),
+    rp(nullptr), tmpp(nullptr), yp(nullptr), gram(nullptr), alpha(nullptr), init(false), allocate_r(false)
+  {
+    if (nKrylov < 1) errorQuda("Invalid s-step basis size %d", nKrylov);
+  }
+
+  CAGCR::~CAGCR() {
+    if (!param.is_preconditioner) profile.TPSTART(QUDA_PROFILE_FREE);
+    if (init) {
+      if (allocate_r) delete rp;
+      delete tmpp;
+      delete yp;
+      for (int i=0; i<nKrylov; i++) delete q[i];
+      delete []gram;
+      delete []alpha;
+    }
+    if (!param.is_preconditioner) profile.TPSTOP(QUDA_PROFILE_FREE);
+  }
+
+  double CAGCR::solve(int s)
+  {
+    // gram is the (s+1) x (s+1) row-major matrix of inner products
+    // of {q_0, ..., q_{s-1}, r}, so the leading s x s block is Q^dag Q
+    // and the last column is Q^dag r
+    const int ld = s+1;
+    MatrixXcd G(s, s);
+    VectorXcd c(s);
+    for (int j=0; j<s; j++) {
+      for (int i=0; i<s; i++) G(j,i) = gram[j*ld+i];
+      c(j) = gram[j*ld+s];
+    }
+
+    VectorXcd a = G.ldlt().solve(c);
+    for (int j=0; j<s; j++) alpha[j] = a(j);
+
+    // since the new residual is orthogonal to the range of Q, its
+    // norm follows from the old norm without another reduction
+    return c.dot(a).real();
+  }
+
+  void CAGCR::operator()(ColorSpinorField &x, ColorSpinorField &b)
+  {
+    // the Gram matrix and basis updates use the multi-blas kernels, which only exist for device fields
+    if (x.Location() == QUDA_CPU_FIELD_LOCATION || b.Location() == QUDA_CPU_FIELD_LOCATION)
+      errorQuda("CA-GCR requires device fields (x location = %d, b location = %d)", x.Location(), b.Location());
+
+    commGlobalReductionSet(param.global_reduction); // use local reductions for DD solver
+
+    if (!init) {
+      ColorSpinorParam csParam(x);
+      csParam.create = QUDA_ZERO_FIELD_CREATE;
+      csParam.precision = param.precision_sloppy;
+      tmpp = ColorSpinorField::Create(csParam); //temporary for mat-vec
+      yp = ColorSpinorField::Create(csParam);
+      q.resize(nKrylov);
+      for (int i=0; i<nKrylov; i++) q[i] = ColorSpinorField::Create(csParam);
+      gram = new Complex[(nKrylov+1)*(nKrylov+1)];
+      alpha = new Complex[nKrylov];
+      init = true;
+    }
+
+    // Source needs to be preserved if initial guess is used or if different precision is requested
+    if (!allocate_r &&
+       ((param.preserve_source == QUDA_PRESERVE_SOURCE_YES) || (param.use_init_guess == QUDA_USE_INIT_GUESS_YES) || (param.precision_sloppy != b.Precision()) )) {
+      ColorSpinorParam csParam(x);
+      csParam.create = QUDA_ZERO_FIELD_CREATE;
+      csParam.precision = param.precision_sloppy;
+      rp = ColorSpinorField::Create(csParam);
+      allocate_r = true;
+    }
+
+    ColorSpinorField &r = allocate_r ? *rp : b;
+    ColorSpinorField &tmp = *tmpp;
+    ColorSpinorField &y = *yp;
+
+    double r2 = 0.0; // if zero source then we will exit immediately doing no work
+    if (param.use_init_guess == QUDA_USE_INIT_GUESS_YES) {
+      blas::copy(tmp, x);
+      matSloppy(r, tmp, *q[0]);
+      blas::copy(y, b);
+      r2 = blas::xmyNorm(y, r);   //r = b - Ax0
+    } else {
+      if (&r != &b) blas::copy(r, b);
+      r2 = blas::norm2(r);
+      blas::zero(x);
+    }
+
+    blas::zero(y);
+    const double b2 = blas::norm2(b);
+    const double stop = stopping(param.tol, b2, param.residual_type);
+
+    if (!param.is_preconditioner) {
+      blas::flops = 0;
+      profile.TPSTART(QUDA_PROFILE_COMPUTE);
+    }
+
+    if (getVerbosity() >= QUDA_VERBOSE) printfQuda("CA-GCR: %d iterations, r2 = %e\n", 0, r2);
+
+    std::vector<ColorSpinorField*> Y(1, &y), R(1, &r);
+
+    int k = 0;
+    while (k < param.maxiter && r2 > stop) {
+      const int s = std::min(nKrylov, param.maxiter - k);
+
+      // matrix-powers kernel: q_i = A^{i+1} r
+      matSloppy(*q[0], r, tmp);
+      for (int i=1; i<s; i++) matSloppy(*q[i], *q[i-1], tmp);
+
+      // Gram matrix of the basis and its overlap with r in a single reduction
+      std::vector<ColorSpinorField*> qr(q.begin(), q.begin()+s);
+      qr.push_back(&r);
+      blas::hDotProduct(gram, qr, qr);
+
+      double dr2 = solve(s);
+
+      // y += sum_i alpha_i A^i r, with basis p = {r, q_0, ..., q_{s-2}}
+      std::vector<ColorSpinorField*> p(1, &r);
+      p.insert(p.end(), q.begin(), q.begin()+s-1);
+      blas::caxpy(alpha, p, Y);
+
+      // r -= sum_i alpha_i q_i
+      for (int i=0; i<s; i++) alpha[i] = -alpha[i];
+      std::vector<ColorSpinorField*> qs(q.begin(), q.begin()+s);
+      blas::caxpy(alpha, qs, R);
+
+      r2 = std::max(r2 - dr2, 0.0);
+      k += s;
+
+      if (getVerbosity() >= QUDA_DEBUG_VERBOSE) {
+	double r2_true = blas::norm2(r);
+	printfQuda("CA-GCR: %d iterations, r2 = %e, true r2 = %e\n", k, r2, r2_true);
+      } else if (getVerbosity() >= QUDA_VERBOSE) {
+	printfQuda("CA-GCR: %d iterations, r2 = %e\n", k, r2);
+      }
+    }
+
+    // Add back initial guess (if appropriate)
+    if (param.use_init_guess == QUDA_USE_INIT_GUESS_YES) blas::axpy(1.0, y, x);
+    else blas::copy(x, y);
+
+    // if not preserving source then overide source with residual
+    if (param.preserve_source == QUDA_PRESERVE_SOURCE_NO && &r != &b) blas::copy(b, r);
+
+    if (!param.is_preconditioner) {
+      profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+      profile.TPSTART(QUDA_PROFILE_EPILOGUE);
+      param.secs += profile.Last(QUDA_PROFILE_COMPUTE);
+
+      double gflops = (blas::flops + mat.flops() + matSloppy.flops())*1e-9;
+
+      param.gflops += gflops;
+      param.iter += k;
+
+      // calculate the true sloppy residual
+      if (param.preserve_source == QUDA_PRESERVE_SOURCE_YES) {
+	mat(r, x, tmp);
+	double true_res = blas::xmyNorm(b, r);
+	param.true_res = sqrt(true_res / b2);
+
+	if (getVerbosity() >= QUDA_SUMMARIZE) {
+	  printfQuda("CA-GCR: Converged after %d iterations, relative residual: iterated = %e, true = %e\n",
+		     k, sqrt(r2 / b2), param.true_res);
+	}
+      } else {
+	if (getVerbosity() >= QUDA_SUMMARIZE) {
+	  printfQuda("CA-GCR: Converged after %d iterations, relative residual: iterated = %e\n", k, sqrt(r2 / b2));
+	}
+      }
+
+      // reset the flops counters
+      blas::flops = 0;
+      mat.flops();
+      matSloppy.flops();
+      profile.TPSTOP(QUDA_PROFILE_EPILOGUE);
+    }
+
+    commGlobalReductionSet(true); // renable global reductions for outer solver
+    return;
+  }
+
+} // namespace quda
@@ -61,6 +61,7 @@ namespace quda {
       public:
        VectorSet   ritzVecs;
        DenseMatrix H;
+       DenseMatrix B;//projection of A Z onto the recycled space C (GCRO-DR)
        Vector      eta;
 
        int m;
@@ -77,6 +78,7 @@ namespace quda {
        inline void ResetArgs() {
          ritzVecs.setZero();
          H.setZero();
+         B.setZero();
          eta.setZero();
        }
 
@@ -208,9 +210,92 @@ namespace quda {
     }
 
 
+ RecycleSpace::RecycleSpace(int max_dim, double mem_limit) : max_dim(max_dim), mem_limit(mem_limit) { }
+
+ RecycleSpace::~RecycleSpace() { clear(); }
+
+ void RecycleSpace::clear()
+ {
+   for (auto v : U) delete v;
+   for (auto v : C) delete v;
+   U.clear();
+   C.clear();
+ }
+
+ int RecycleSpace::capacity(const ColorSpinorField &meta) const
+ {
+   int n = max_dim;
+   if (mem_limit > 0.0) {
+     const double pair_bytes = 2.0 * (meta.Bytes() + meta.NormBytes());
+     n = std::min(n, static_cast<int>(mem_limit * (1<<30) / pair_bytes));
+   }
+   return n;
+ }
+
+ void RecycleSpace::add(std::vector<ColorSpinorField*> &Unew, std::vector<ColorSpinorField*> &Cnew)
+ {
+   if (Unew.size() != Cnew.size()) errorQuda("Mismatched recycled vector sets %lu %lu", Unew.size(), Cnew.size());
+
+   U.insert(U.end(), Unew.begin(), Unew.end());
+   C.insert(C.end(), Cnew.begin(), Cnew.end());
+   Unew.clear();
+   Cnew.clear();
+
+   if (U.size() == 0) return;
+
+   const int cap = capacity(*U[0]);
+   if (size() > cap) compress(cap);
+ }
+
+ void RecycleSpace::compress(int n)
+ {
+   const int k = size();
+
+   if (n >= k) return;
+   if (n <= 0) { clear(); return; }
+
+   // harmonic Ritz vectors on span(U): with A U = C, C^dag C = I, they
+   // solve (C^dag U) g = theta^{-1} g, so keep the largest |theta^{-1}|
+   std::unique_ptr<Complex[] > m(new Complex[k*k]);
+   blas::cDotProduct(m.get(), C, U);
+
+   Map<RowMajorDenseMatrix, Unaligned> M(m.get(), k, k);
+   ComplexEigenSolver<DenseMatrix> es(M);
+
+   std::vector<SortedEvals> sorted_evals;
+   sorted_evals.reserve(k);
+   for(int e = 0; e < k; e++) sorted_evals.push_back( SortedEvals( -abs(es.eigenvalues()(e)), e ));
+   std::stable_sort(sorted_evals.begin(), sorted_evals.end(), SortedEvals::SelectSmall);
+
+   DenseMatrix G(k, n);
+   for(int e = 0; e < n; e++) G.col(e) = es.eigenvectors().col(sorted_evals[e]._idx);
+
+   // re-orthonormalize C G: (C G)^dag (C G) = G^dag G = R^dag R
+   LLT<DenseMatrix> chol(G.adjoint() * G);
+   if (chol.info() != Success) errorQuda("Cannot orthonormalize compressed recycled space");
+   G = G * chol.matrixU().solve(MatrixXcd::Identity(n, n));
+
+   std::vector<ColorSpinorField*> Unew, Cnew;
+   for(int i = 0; i < n; i++) {
+     Unew.push_back(ColorSpinorField::Create(*U[0]));
+     Cnew.push_back(ColorSpinorField::Create(*C[0]));
+     blas::zero(*Unew[i]);
+     blas::zero(*Cnew[i]);
+   }
+
+   RowMajorDenseMatrix Alpha(G);
+   blas::caxpy(static_cast<Complex*>(Alpha.data()), U, Unew);
+   blas::caxpy(static_cast<Complex*>(Alpha.data()), C, Cnew);
+
+   clear();
+   U = Unew;
+   C = Cnew;
+ }
+
  GMResDR::GMResDR(DiracMatrix &mat, DiracMatrix &matSloppy, DiracMatrix &matPrecon, SolverParam &param, TimeProfile &profile) :
     Solver(param, profile), mat(mat), matSloppy(matSloppy), matPrecon(matPrecon), K(nullptr), Kparam(param),
-    Vm(nullptr), Zm(nullptr), profile(profile), gmresdr_args(nullptr), init(false)
+    Vm(nullptr), Zm(nullptr), profile(profile), gmresdr_args(nullptr),
+    recycle(static_cast<RecycleSpace*>(param.recycle_space)), init(false)
  {
      fillFGMResDRInnerSolveParam(Kparam, param);
 
@@ -233,7 +318,8 @@ namespace quda {
 
  GMResDR::GMResDR(DiracMatrix &mat, Solver &K, DiracMatrix &matSloppy, DiracMatrix &matPrecon, SolverParam &param, TimeProfile &profile) :
     Solver(param, profile), mat(mat), matSloppy(matSloppy), matPrecon(matPrecon), K(&K), Kparam(param),
-    Vm(nullptr), Zm(nullptr), profile(profile), gmresdr_args(nullptr), init(false) { }
+    Vm(nullptr), Zm(nullptr), profile(profile), gmresdr_args(nullptr),
+    recycle(static_cast<RecycleSpace*>(param.recycle_space)), init(false) { }
 
 
  GMResDR::~GMResDR() {
@@ -290,6 +376,11 @@ namespace quda {
 
    blas::caxpy( static_cast<Complex*> ( args.eta.data()), Z_, x_);
 
+   if(args.B.rows() > 0) {//x -= U B eta
+     Vector minusBeta = - (args.B * args.eta);
+     blas::caxpy(static_cast<Complex*>(minusBeta.data()), recycle->U, x_);
+   }
+
    VectorXcd minusHeta = - (args.H * args.eta);
    Map<VectorXcd, Unaligned> c_(args.c, args.m+1);
    c_ += minusHeta;
@@ -320,6 +411,12 @@ namespace quda {
    args.H.setZero();
    args.H.topLeftCorner(args.k+1, args.k) = Res;
 
+   if(args.B.rows() > 0) {
+     DenseMatrix Bk = args.B*Qkp1.topLeftCorner(args.m, args.k);
+     args.B.setZero();
+     args.B.leftCols(args.k) = Bk;
+   }
+
    blas::zero( *args.Vkp1 );
 
    std::vector<ColorSpinorField*> vkp1(args.Vkp1->Components());
@@ -368,6 +465,59 @@ namespace quda {
  }
 
 
+ void GMResDR::UpdateRecycleSpace()
+ {
+   GMResDRArgs &args = *gmresdr_args;
+
+   if ( param.extlib_type == QUDA_MAGMA_EXTLIB ) {
+     ComputeHarmonicRitz<libtype::magma_lib>(args);
+   } else if(param.extlib_type == QUDA_EIGEN_EXTLIB) {
+     ComputeHarmonicRitz<libtype::eigen_lib>(args);
+   } else {
+     errorQuda("Library type %d is currently not supported.\n", param.extlib_type);
+   }
+
+   // A (Z P - U B P) = V H P = (V Q) R, so Unew = (Z P - U B P) R^{-1} and Cnew = V Q
+   DenseMatrix P  = args.ritzVecs.topLeftCorner(args.m, args.k);
+   DenseMatrix HP = args.H * P;
+
+   HouseholderQR<MatrixXcd> qr(HP);
+   DenseMatrix Q = qr.householderQ() * MatrixXcd::Identity(args.m+1, args.k);
+   DenseMatrix R = Q.adjoint() * HP;
+   DenseMatrix PRinv = P * R.triangularView<Upper>().solve(MatrixXcd::Identity(args.k, args.k));
+
+   ColorSpinorParam csParam(Vm->Component(0));
+   csParam.create = QUDA_ZERO_FIELD_CREATE;
+
+   std::vector<ColorSpinorField*> Unew, Cnew;
+   for(int i = 0; i < args.k; i++) {
+     Unew.push_back(ColorSpinorField::Create(csParam));
+     Cnew.push_back(ColorSpinorField::Create(csParam));
+   }
+
+   std::vector<ColorSpinorField*> Z_(Zm->Components().begin(), Zm->Components().begin()+args.m);
+   std::vector<ColorSpinorField*> V_(Vm->Components());
+
+   RowMajorDenseMatrix Alpha(PRinv);
+   blas::caxpy(static_cast<Complex*>(Alpha.data()), Z_, Unew);
+
+   if(args.B.rows() > 0) {
+     RowMajorDenseMatrix Beta(- args.B * PRinv);
+     blas::caxpy(static_cast<Complex*>(Beta.data()), recycle->U, Unew);
+   }
+
+   RowMajorDenseMatrix Gamma(Q);
+   blas::caxpy(static_cast<Complex*>(Gamma.data()), V_, Cnew);
+
+   recycle->add(Unew, Cnew);
+
+   // B refers to the old recycled space from here on
+   args.B = DenseMatrix::Zero(0, args.m);
+
+   if (getVerbosity() >= QUDA_VERBOSE) printfQuda("\nRecycled space size %d\n", recycle->size());
+   return;
+ }
+
 int GMResDR::FlexArnoldiProcedure(const int start_idx, const bool do_givens = false)
  {
    int j = start_idx;
@@ -396,6 +546,15 @@ int GMResDR::FlexArnoldiProcedure(const int start_idx, const bool do_givens = fa
      }
      matSloppy(Vm->Component(j+1), Zm->Component(j), tmp);
 
+     if(args.B.rows() > 0) {//GCRO-DR: w = (I - C C^dag) A z_j
+       std::vector<ColorSpinorField*> w_;
+       w_.push_back(&Vm->Component(j+1));
+
+       blas::cDotProduct(args.B.col(j).data(), recycle->C, w_);
+       Vector minusB = - args.B.col(j);
+       blas::caxpy(static_cast<Complex*>(minusB.data()), recycle->C, w_);
+     }
+
      args.H(0, j) = cDotProduct(Vm->Component(0), Vm->Component(j+1));
      caxpy(-args.H(0, j), Vm->Component(0), Vm->Component(j+1));
 
@@ -503,6 +662,8 @@ int GMResDR::FlexArnoldiProcedure(const int start_idx, const bool do_givens = fa
 
     GMResDRArgs &args = *gmresdr_args;
 
+    args.B = DenseMatrix::Zero(recycle ? recycle->size() : 0, args.m);
+
     ColorSpinorField &r   = *rp;
     ColorSpinorField &y   = *yp;
     ColorSpinorField &e   = *ep;
@@ -521,6 +682,25 @@ int GMResDR::FlexArnoldiProcedure(const int start_idx, const bool do_givens = fa
     
     double r2 = xmyNorm(b, r);
     double b2 = r2;
+
+    if(args.B.rows() > 0) {//GCRO-DR: minimize the residual over the recycled space, x += U C^dag r
+      rSloppy = r;
+
+      std::vector<ColorSpinorField*> r_, x_;
+      r_.push_back(r_sloppy);
+      x_.push_back(&x);
+
+      Vector h = Vector::Zero(args.B.rows());
+      blas::cDotProduct(static_cast<Complex*>(h.data()), recycle->C, r_);
+      blas::caxpy(static_cast<Complex*>(h.data()), recycle->U, x_);
+
+      mat(r, x);
+      r2 = xmyNorm(b, r);
+
+      if (getVerbosity() >= QUDA_VERBOSE)
+	printfQuda("\nRecycled space of %d vectors: residual squared %1.16e -> %1.16e\n", recycle->size(), b2, r2);
+    }
+
     args.c[0] = Complex(sqrt(r2), 0.0);
 
     printfQuda("\nInitial residual squared: %1.16e, source %1.16e, tolerance %1.16e\n", r2, sqrt(normb), param.tol);
@@ -556,6 +736,8 @@ int GMResDR::FlexArnoldiProcedure(const int start_idx, const bool do_givens = fa
 
       r2 = norm2(rSloppy);
 
+      if(recycle && (restart_idx == param.deflation_grid-1 || convergence(r2, heavy_quark_res, stop, param.tol_hq) || !(r2 > stop))) UpdateRecycleSpace();
+
       bool   do_clean_restart = false;
       double ext_r2 = 1.0;
 
@@ -111,6 +111,41 @@ namespace quda {
     extern Worker* aux_worker;
   }  
 
+  /**
+     Evaluate the removal criteria of all active shifts together.  The
+     residual of every shift is first formed from the recurrence r2_j
+     = zeta_j^2 r2_0, from the heaviest shift down; then a shift is
+     removed if it has converged and the shift above it has been
+     removed, or if its zeta is zero and the shift above it has
+     converged.
+     @return The number of shifts removed
+  */
+  static int removeConvergedShifts(double *r2, int *iter, const double *zeta, const double *stop, double b2,
+				   double prec_tol, int num_offset_now, int k)
+  {
+    bool stalled[QUDA_MAX_MULTI_SHIFT];
+    for (int j=num_offset_now-1; j>=1; j--) {
+      stalled[j] = (zeta[j] == 0.0 && r2[j+1] < stop[j+1]);
+      if (!stalled[j]) r2[j] = zeta[j] * zeta[j] * r2[0];
+    }
+
+    int converged = 0;
+    for (int j=num_offset_now-1; j>=1; j--) {
+      if (stalled[j]) {
+	converged++;
+      } else if ((r2[j] < stop[j] || sqrt(r2[j] / b2) < prec_tol) && iter[j+1]) { // only remove if shift above has converged
+	converged++;
+	iter[j] = k+1;
+      } else {
+	continue;
+      }
+      if (getVerbosity() >= QUDA_VERBOSE)
+	printfQuda("MultiShift CG: Shift %d converged after %d iterations\n", j, k+1);
+    }
+
+    return converged;
+  }
+
   MultiShiftCG::MultiShiftCG(DiracMatrix &mat, DiracMatrix &matSloppy, SolverParam &param,
 			     TimeProfile &profile) 
     : MultiShiftSolver(param, profile), mat(mat), matSloppy(matSloppy) {
@@ -398,10 +433,15 @@ namespace quda {
 	  resIncrease = 0;
 	}
 
-	// explicitly restore the orthogonality of the gradient vector
-	for (int j=0; j<num_offset_now; j++) {
-	  Complex rp = blas::cDotProduct(*r_sloppy, *p[j]) / (r2[0]);
-	  blas::caxpy(-rp, *r_sloppy, *p[j]);
+	// explicitly restore the orthogonality of the gradient vectors,
+	// computing the projections of all shifts in one multi-reduction
+	{
+	  std::vector<ColorSpinorField*> r_(1, r_sloppy);
+	  std::vector<ColorSpinorField*> p_(p.begin(), p.begin() + num_offset_now);
+	  Complex rp[QUDA_MAX_MULTI_SHIFT];
+	  blas::cDotProduct(rp, r_, p_);
+	  for (int j=0; j<num_offset_now; j++) rp[j] = -rp[j] / r2[0];
+	  blas::caxpy(rp, r_, p_);
 	}
 
 	// update beta and p
@@ -422,24 +462,7 @@ namespace quda {
       }
 
       // now we can check if any of the shifts have converged and remove them
-      int converged = 0;
-      for (int j=num_offset_now-1; j>=1; j--) {
-        if (zeta[j] == 0.0 && r2[j+1] < stop[j+1]) {
-          converged++;
-          if (getVerbosity() >= QUDA_VERBOSE)
-              printfQuda("MultiShift CG: Shift %d converged after %d iterations\n", j, k+1);
-        } else {
-	  r2[j] = zeta[j] * zeta[j] * r2[0];
-	  // only remove if shift above has converged
-	  if ((r2[j] < stop[j] || sqrt(r2[j] / b2) < prec_tol) && iter[j+1] ) {
-	    converged++;
-	    iter[j] = k+1;
-	    if (getVerbosity() >= QUDA_VERBOSE)
-	      printfQuda("MultiShift CG: Shift %d converged after %d iterations\n", j, k+1);
-          }
-	}
-      }
-      num_offset_now -= converged;
+      num_offset_now -= removeConvergedShifts(r2, iter, zeta, stop, b2, prec_tol, num_offset_now, k);
 
       // this ensure we do the update on any shifted systems that
       // happen to converge when the un-shifted system converges
@@ -486,17 +509,25 @@ namespace quda {
       ColorSpinorField *tmp5_p = mat.isStaggered() ? tmp4_p :
 	reliable ? y[1] : (tmp2.Precision() == x[0]->Precision() && &tmp1 != tmp2_p) ? tmp2_p : ColorSpinorField::Create(csParam);
 
+      // each shift's residual and its L2 and heavy-quark norms are
+      // formed in one fused kernel, with the norms of all shifts
+      // reduced across processes together at the end
+      double3 true_res[QUDA_MAX_MULTI_SHIFT];
+      const bool global_reduction = commGlobalReduction();
       for(int i=0; i < num_offset; i++) {
 	mat(*r, *x[i], *tmp4_p, *tmp5_p);
-	if (r->Nspin()==4) {
-	  blas::axpy(offset[i], *x[i], *r); // Offset it.
-	} else if (i!=0) {
-	  blas::axpy(offset[i]-offset[0], *x[i], *r); // Offset it.
-	}
-	double true_res = blas::xmyNorm(b, *r);
-	param.true_res_offset[i] = sqrt(true_res/b2);
+	// the staggered operator already includes the lightest shift
+	const double shift = r->Nspin()==4 ? offset[i] : offset[i]-offset[0];
+	commGlobalReductionSet(false);
+	true_res[i] = blas::axpyXmyHeavyQuarkResidualNorm(shift, *x[i], b, *r);
+	commGlobalReductionSet(global_reduction);
+      }
+      reduceDoubleArray(reinterpret_cast<double*>(true_res), 3*num_offset);
+
+      for(int i=0; i < num_offset; i++) {
+	param.true_res_offset[i] = sqrt(true_res[i].y/b2);
 	param.iter_res_offset[i] = sqrt(r2[i]/b2);
-	param.true_res_hq_offset[i] = sqrt(blas::HeavyQuarkResidualNorm(*x[i], *r).z);
+	param.true_res_hq_offset[i] = sqrt(true_res[i].z);
       }
 
       if (getVerbosity() >= QUDA_SUMMARIZE){
@@ -223,11 +223,16 @@ namespace quda {
       if( !(updateR || updateX) ){
 
         if(K){
+          // the cross-process reduction of <r, M^-1 r_old> is overlapped with the preconditioner
+	  commGlobalReductionSet(false);
           r_new_Minvr_old = reDotProduct(rSloppy,*minvrSloppy);
+	  commGlobalReductionSet(true);
+          CollectiveHandle *pending = reduceDoubleArrayStart(&r_new_Minvr_old, 1);
           *rPre = rSloppy;
 	  commGlobalReductionSet(false);
           (*K)(*minvrPre, *rPre);
 	  commGlobalReductionSet(true);
+          reduceDoubleArrayWait(pending);
       
 
           *minvrSloppy = *minvrPre;
@@ -40,6 +40,8 @@ namespace quda {
 
   int LatticeField::bufferIndex = 0;
 
+  uint64_t LatticeField::version_counter = 0;
+
   LatticeFieldParam::LatticeFieldParam(const LatticeField &field)
     : nDim(field.Ndim()), pad(field.Pad()), precision(field.Precision()),
       siteSubset(field.SiteSubset()), mem_type(field.MemType()), ghostExchange(field.GhostExchange())
@@ -55,7 +57,7 @@ namespace quda {
       siteSubset(param.siteSubset), ghostExchange(param.ghostExchange), ghost_bytes(0),
       ghost_face_bytes{ }, ghostOffset( ), ghostNormOffset( ),
       my_face_h{ }, my_face_hd{ }, initComms(false), mem_type(param.mem_type),
-      backup_h(nullptr), backup_norm_h(nullptr), backed_up(false)
+      backup_h(nullptr), backup_norm_h(nullptr), backed_up(false), version(++version_counter)
   {
     for (int i=0; i<nDim; i++) {
       x[i] = param.x[i];
@@ -96,7 +98,7 @@ namespace quda {
       siteSubset(field.siteSubset), ghostExchange(field.ghostExchange), ghost_bytes(0),
       ghost_face_bytes{ }, ghostOffset( ), ghostNormOffset( ),
       my_face_h{ }, my_face_hd{ }, initComms(false), mem_type(field.mem_type),
-      backup_h(nullptr), backup_norm_h(nullptr), backed_up(false)
+      backup_h(nullptr), backup_norm_h(nullptr), backed_up(false), version(++version_counter)
   {
     for (int i=0; i<nDim; i++) {
       x[i] = field.x[i];
@@ -580,7 +582,11 @@ namespace quda {
     return output;  // for multiple << operators.
   }
 
+#ifndef QUDA_HOST_ONLY
   static QudaFieldLocation reorder_location_ = QUDA_CUDA_FIELD_LOCATION;
+#else
+  static QudaFieldLocation reorder_location_ = QUDA_CPU_FIELD_LOCATION; // there are no kernels to reorder with
+#endif
 
   QudaFieldLocation reorder_location() { return reorder_location_; }
   void reorder_location_set(QudaFieldLocation _reorder_location) { reorder_location_ = _reorder_location; }
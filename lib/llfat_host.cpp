@@ -0,0 +1,296 @@
+// Host construction of the improved staggered fat and long links.
+
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+#include <quda_internal.h>
+#include <gauge_field.h>
+#include <llfat_quda.h>
+#include <thread_pool.h>
+
+#define MIN_COEFF 1e-7
+
+namespace quda {
+
+  template <typename Float>
+  struct KSLinkHostArg {
+    const Float *u[4]; // extended links [(parity*volumeCB_ex + x_cb)*18]
+    Float *fat[4];
+    Float *lng[4];
+    int X[4];  // local volume
+    int E[4];  // extended volume
+    int R[4];  // border of the extended links
+    int B[4];  // border of the staple region
+    int S[4];  // staple region
+    int volumeCB;
+    int volumeCB_ex;
+    int volumeS;
+  };
+
+  /**
+     @return Pointer to the link in direction mu at local coordinates
+     x, which may lie in the border of the extended field
+  */
+  template <typename Float>
+  static inline const Float *link(const KSLinkHostArg<Float> &arg, int mu, const int x[4])
+  {
+    int y[4];
+    int parity = 0;
+    for (int d=0; d<4; d++) {
+      y[d] = arg.R[d] ? x[d] + arg.R[d] : (x[d] + arg.X[d]) % arg.X[d];
+      parity += y[d] - arg.R[d];
+    }
+    const int x_cb = (((y[3]*arg.E[2] + y[2])*arg.E[1] + y[1])*arg.E[0] + y[0]) >> 1;
+    return arg.u[mu] + ((parity & 1)*arg.volumeCB_ex + x_cb)*18;
+  }
+
+  /**
+     @return Offset of the staple-region site at local coordinates x
+  */
+  template <typename Float>
+  static inline int stapleIndex(const KSLinkHostArg<Float> &arg, const int x[4])
+  {
+    int y[4];
+    for (int d=0; d<4; d++) y[d] = arg.B[d] ? x[d] + arg.B[d] : (x[d] + arg.X[d]) % arg.X[d];
+    return (((y[3]*arg.S[2] + y[2])*arg.S[1] + y[1])*arg.S[0] + y[0])*18;
+  }
+
+  template <typename Float>
+  static inline int fatIndex(const KSLinkHostArg<Float> &arg, const int x[4])
+  {
+    const int parity = (x[0] + x[1] + x[2] + x[3]) & 1;
+    return (parity*arg.volumeCB + ((((x[3]*arg.X[2] + x[2])*arg.X[1] + x[1])*arg.X[0] + x[0]) >> 1))*18;
+  }
+
+  /**
+     @brief c = op(a) * op(b), where op is the identity or the
+     Hermitian conjugate
+  */
+  template <typename Float, bool dagA, bool dagB>
+  static inline void mul(Float *c, const Float *a, const Float *b)
+  {
+    for (int i=0; i<3; i++) {
+      for (int j=0; j<3; j++) {
+	Float re = 0.0, im = 0.0;
+	for (int k=0; k<3; k++) {
+	  const int ik = dagA ? k*3 + i : i*3 + k;
+	  const int kj = dagB ? j*3 + k : k*3 + j;
+	  const Float a_re = a[2*ik+0], a_im = dagA ? -a[2*ik+1] : a[2*ik+1];
+	  const Float b_re = b[2*kj+0], b_im = dagB ? -b[2*kj+1] : b[2*kj+1];
+	  re += a_re * b_re - a_im * b_im;
+	  im += a_re * b_im + a_im * b_re;
+	}
+	c[2*(i*3+j)+0] = re;
+	c[2*(i*3+j)+1] = im;
+      }
+    }
+  }
+
+  /**
+     @brief Staple of the mu-directed link field mulink in the nu
+     direction at x:
+       U_nu(x) M(x+nu) U_nu(x+mu)^dag + U_nu(x-nu)^dag M(x-nu) U_nu(x-nu+mu)
+     where M is read from the staple buffer, or is the gauge field if
+     mulink is null.
+  */
+  template <typename Float>
+  static inline void staple(Float *out, const KSLinkHostArg<Float> &arg, const Float *mulink,
+			    int mu, int nu, const int x[4])
+  {
+    Float ab[18], tmp[18];
+    int y[4] = { x[0], x[1], x[2], x[3] };
+
+    // upper staple
+    y[nu]++;
+    const Float *b = mulink ? mulink + stapleIndex(arg, y) : link(arg, mu, y);
+    y[nu]--;
+    mul<Float,false,false>(ab, link(arg, nu, y), b);
+    y[mu]++;
+    mul<Float,false,true>(out, ab, link(arg, nu, y));
+    y[mu]--;
+
+    // lower staple
+    y[nu]--;
+    b = mulink ? mulink + stapleIndex(arg, y) : link(arg, mu, y);
+    mul<Float,true,false>(ab, link(arg, nu, y), b);
+    y[mu]++;
+    mul<Float,false,false>(tmp, ab, link(arg, nu, y));
+    for (int i=0; i<18; i++) out[i] += tmp[i];
+  }
+
+  /**
+     @return Local coordinates of site idx of a lexicographic region of
+     dimensions X that extends B sites beyond the local volume
+  */
+  static inline void regionCoords(int x[4], int idx, const int X[4], const int B[4])
+  {
+    for (int d=0; d<4; d++) {
+      x[d] = idx % X[d] - B[d];
+      idx /= X[d];
+    }
+  }
+
+  template <typename Float>
+  static inline bool interior(const KSLinkHostArg<Float> &arg, const int x[4])
+  {
+    for (int d=0; d<4; d++) if (x[d] < 0 || x[d] >= arg.X[d]) return false;
+    return true;
+  }
+
+  /**
+     @brief Compute the staple of mulink for direction mu in the nu
+     plane on the staple region, storing it if out is non-null and
+     adding coeff times it to the fat link on the local volume.  Sites
+     whose nu neighbors lie outside the staple region are skipped,
+     since their staples are never used.
+  */
+  template <typename Float>
+  static void computeStaple(const KSLinkHostArg<Float> &arg, Float *out, const Float *mulink,
+			    int mu, int nu, double coeff)
+  {
+    const bool region = out != nullptr;
+    const int n = region ? arg.volumeS : 2*arg.volumeCB;
+    const int zero[4] = { 0, 0, 0, 0 };
+    host::parallel_for(n, [&](int begin, int end) {
+	for (int i=begin; i<end; i++) {
+	  int x[4];
+	  regionCoords(x, i, region ? arg.S : arg.X, region ? arg.B : zero);
+	  if (mulink && (x[nu] < 0 || x[nu] >= arg.X[nu])) continue;
+
+	  Float s[18];
+	  staple(s, arg, mulink, mu, nu, x);
+	  if (out) memcpy(out + i*18, s, 18*sizeof(Float));
+	  if (interior(arg, x)) {
+	    Float *f = arg.fat[mu] + fatIndex(arg, x);
+	    for (int j=0; j<18; j++) f[j] += static_cast<Float>(coeff) * s[j];
+	  }
+	}
+      });
+  }
+
+  /**
+     @brief Compute the fat and long links from the extended links,
+     whose border is filled by the halo exchange in partitioned
+     dimensions and addressed periodically in local ones.  The staples
+     are reused in the same order as on the device: for each mu and
+     nu the 3-link staple is computed once on the local volume plus a
+     one-site border and reused for the Lepage term and all of the
+     5-link staples, each of which is reused for the 7-link staples
+     that extend it.  Only two single-direction staple buffers are
+     alive at a time, and each pass runs in parallel over sites.
+  */
+  template <typename Float>
+  static void fatLongKSLinkHost(KSLinkHostArg<Float> &arg, const double *coeff)
+  {
+    // one link and long link
+    host::parallel_for(2*arg.volumeCB, [&](int begin, int end) {
+	for (int i=begin; i<end; i++) {
+	  int x[4], y[4];
+	  const int zero[4] = { 0, 0, 0, 0 };
+	  regionCoords(x, i, arg.X, zero);
+	  for (int mu=0; mu<4; mu++) {
+	    const Float *a = link(arg, mu, x);
+	    Float *f = arg.fat[mu] + fatIndex(arg, x);
+	    for (int j=0; j<18; j++) f[j] = (coeff[0] - 6.0*coeff[5]) * a[j];
+
+	    if (arg.lng[mu]) {
+	      Float ab[18];
+	      for (int d=0; d<4; d++) y[d] = x[d];
+	      y[mu]++;
+	      mul<Float,false,false>(ab, a, link(arg, mu, y));
+	      y[mu]++;
+	      Float *l = arg.lng[mu] + fatIndex(arg, x);
+	      mul<Float,false,false>(l, ab, link(arg, mu, y));
+	      for (int j=0; j<18; j++) l[j] *= coeff[1];
+	    }
+	  }
+	}
+      });
+
+    if (fabs(coeff[2]) < MIN_COEFF && fabs(coeff[3]) < MIN_COEFF &&
+	fabs(coeff[4]) < MIN_COEFF && fabs(coeff[5]) < MIN_COEFF) return;
+
+    std::vector<Float> staple3(arg.volumeS*18);
+    std::vector<Float> staple5(arg.volumeS*18);
+
+    for (int mu=0; mu<4; mu++) {
+      for (int nu=0; nu<4; nu++) {
+	if (nu == mu) continue;
+	computeStaple(arg, staple3.data(), static_cast<const Float*>(nullptr), mu, nu, coeff[2]);
+
+	// Lepage term
+	if (coeff[5] != 0.0) computeStaple(arg, static_cast<Float*>(nullptr), staple3.data(), mu, nu, coeff[5]);
+
+	for (int rho=0; rho<4; rho++) {
+	  if (rho == mu || rho == nu) continue;
+	  computeStaple(arg, staple5.data(), staple3.data(), mu, rho, coeff[3]);
+
+	  if (fabs(coeff[4]) > MIN_COEFF) {
+	    for (int sig=0; sig<4; sig++) {
+	      if (sig == mu || sig == nu || sig == rho) continue;
+	      computeStaple(arg, static_cast<Float*>(nullptr), staple5.data(), mu, sig, coeff[4]);
+	    }
+	  }
+	}
+      }
+    }
+  }
+
+  template <typename Float>
+  static void fatLongKSLinkHost(cpuGaugeField *fat, cpuGaugeField *lng, const cpuGaugeField &u, const double *coeff)
+  {
+    KSLinkHostArg<Float> arg;
+    memset(&arg, 0, sizeof(arg));
+    arg.volumeCB = fat->VolumeCB();
+    arg.volumeCB_ex = u.VolumeCB();
+    arg.volumeS = 1;
+    for (int d=0; d<4; d++) {
+      arg.X[d] = fat->X()[d];
+      arg.E[d] = u.X()[d];
+      arg.R[d] = (arg.E[d] - arg.X[d]) / 2;
+      arg.B[d] = arg.R[d] ? 1 : 0;
+      arg.S[d] = arg.X[d] + 2*arg.B[d];
+      arg.volumeS *= arg.S[d];
+    }
+    for (int mu=0; mu<4; mu++) {
+      arg.u[mu] = static_cast<const Float* const*>(u.Gauge_p())[mu];
+      arg.fat[mu] = static_cast<Float**>(fat->Gauge_p())[mu];
+      arg.lng[mu] = lng ? static_cast<Float**>(lng->Gauge_p())[mu] : nullptr;
+    }
+
+    fatLongKSLinkHost(arg, coeff);
+  }
+
+  void fatLongKSLinkHost(cpuGaugeField *fat, cpuGaugeField *lng, const cpuGaugeField &u, const double *coeff)
+  {
+    const GaugeField *fields[3] = { fat, lng, &u };
+    for (int i=0; i<3; i++) {
+      if (!fields[i]) continue;
+      if (fields[i]->Order() != QUDA_QDP_GAUGE_ORDER || fields[i]->Reconstruct() != QUDA_RECONSTRUCT_NO)
+	errorQuda("Host fat-link computation requires QDP-ordered gauge fields without reconstruction");
+      if (fields[i]->Precision() != u.Precision())
+	errorQuda("Precisions %d and %d do not match", fields[i]->Precision(), u.Precision());
+      if (i < 2 && fields[i]->VolumeCB() != fat->VolumeCB())
+	errorQuda("Volumes %d and %d do not match", fields[i]->VolumeCB(), fat->VolumeCB());
+    }
+
+    for (int d=0; d<4; d++) {
+      const int R = (u.X()[d] - fat->X()[d]) / 2;
+      if (R != 0 && R != 2) errorQuda("Unsupported border %d in dimension %d", R, d);
+      if (comm_dim_partitioned(d) && R != 2)
+	errorQuda("Partitioned dimension %d requires a border of 2 (have %d)", d, R);
+    }
+
+    if (u.Precision() == QUDA_DOUBLE_PRECISION) {
+      fatLongKSLinkHost<double>(fat, lng, u, coeff);
+    } else if (u.Precision() == QUDA_SINGLE_PRECISION) {
+      fatLongKSLinkHost<float>(fat, lng, u, coeff);
+    } else {
+      errorQuda("Unsupported precision %d", u.Precision());
+    }
+  }
+
+#undef MIN_COEFF
+
+} // namespace quda
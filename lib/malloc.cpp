@@ -546,6 +546,18 @@ namespace quda {
       }
     }
 
+    size_t device_allocated()
+    {
+      size_t cached = 0;
+      for (auto &entry : deviceCache) cached += entry.first;
+      return static_cast<size_t>(total_bytes[DEVICE]) > cached ? total_bytes[DEVICE] - cached : 0;
+    }
+
+    size_t host_allocated()
+    {
+      return total_bytes[HOST] + total_bytes[PINNED] + total_bytes[MAPPED];
+    }
+
   } // namespace pool
 
 } // namespace quda
@@ -17,7 +17,7 @@ namespace quda {
       coarse(nullptr), fine(param.fine), coarse_solver(nullptr),
       param_coarse(nullptr), param_presmooth(nullptr), param_postsmooth(nullptr),
       r(nullptr), r_coarse(nullptr), x_coarse(nullptr), tmp_coarse(nullptr),
-      diracCoarseResidual(nullptr), diracCoarseSmoother(nullptr), matCoarseResidual(nullptr), matCoarseSmoother(nullptr) {
+      ghost_stats(std::make_shared<GhostCompressionStats>()), diracCoarseResidual(nullptr), diracCoarseSmoother(nullptr), matCoarseResidual(nullptr), matCoarseSmoother(nullptr) {
 
     // for reporting level 1 is the fine level but internally use level 0 for indexing
     sprintf(prefix,"MG level %d (%s): ", param.level+1, param.location == QUDA_CUDA_FIELD_LOCATION ? "GPU" : "CPU" );
@@ -27,7 +27,11 @@ namespace quda {
 
     if (param.level < param.Nlevel-1) {
       if (param.mg_global.compute_null_vector == QUDA_COMPUTE_NULL_VECTOR_YES) {
-	if (param.mg_global.generate_all_levels == QUDA_BOOLEAN_YES || param.level == 0) generateNullVectors(param.B);
+	if (param.mg_global.generate_all_levels == QUDA_BOOLEAN_YES || param.level == 0) {
+	  startComponent(MG_COMPONENT_NULL_VECTORS);
+	  generateNullVectors(param.B);
+	  stopComponent(MG_COMPONENT_NULL_VECTORS);
+	}
       } else if (strcmp(param.mg_global.vec_infile,"")!=0) { // only load if infile is defined and not computing
 	loadVectors(param.B);
       }
@@ -69,8 +73,10 @@ namespace quda {
 
       // create transfer operator
       printfQuda("start creating transfer operator\n");
+      startComponent(MG_COMPONENT_BLOCK_ORTHO);
       transfer = new Transfer(param.B, param.Nvec, param.geoBlockSize, param.spinBlockSize,
 			      param.location == QUDA_CUDA_FIELD_LOCATION ? true : false, profile);
+      stopComponent(MG_COMPONENT_BLOCK_ORTHO);
       for (int i=0; i<QUDA_MAX_MG_LEVEL; i++) param.mg_global.geo_block_size[param.level][i] = param.geoBlockSize[i];
 
       //transfer->setTransferGPU(false); // use this to force location of transfer
@@ -85,6 +91,17 @@ namespace quda {
       // create coarse temporary vector
       tmp_coarse = param.B[0]->CreateCoarse(param.geoBlockSize, param.spinBlockSize, param.Nvec, param.mg_global.location[param.level+1]);
 
+      // compressed halos are only supported by the host coarse operator
+      QudaGhostCompression ghost_compression = param.mg_global.ghost_compression[param.level+1];
+      if (ghost_compression != QUDA_GHOST_COMPRESSION_NONE && param.mg_global.location[param.level+1] != QUDA_CPU_FIELD_LOCATION) {
+	warningQuda("Ghost compression %d is not supported for GPU level %d, ignoring", ghost_compression, param.level+1);
+	ghost_compression = QUDA_GHOST_COMPRESSION_NONE;
+      }
+      // the work fields of the coarse solver and operators are created from these, so share their statistics
+      r_coarse->setGhostCompression(ghost_compression, ghost_stats);
+      x_coarse->setGhostCompression(ghost_compression, ghost_stats);
+      tmp_coarse->setGhostCompression(ghost_compression, ghost_stats);
+
       // check if we are coarsening the preconditioned system then
       bool preconditioned_coarsen = (param.coarse_grid_solution_type == QUDA_MATPC_SOLUTION && param.smoother_solve_type == QUDA_DIRECT_PC_SOLVE);
 
@@ -101,6 +118,7 @@ namespace quda {
       diracParam.matpcType = matpc_type;
       diracParam.tmp1 = tmp_coarse;
       // use even-odd preconditioning for the coarse grid solver
+      startComponent(MG_COMPONENT_COARSE_OP);
       diracCoarseResidual = new DiracCoarse(diracParam);
       matCoarseResidual = new DiracM(*diracCoarseResidual);
 
@@ -115,6 +133,7 @@ namespace quda {
 
       matCoarseSmoother = new DiracM(*diracCoarseSmoother);
       matCoarseSmootherSloppy = new DiracM(*diracCoarseSmootherSloppy);
+      stopComponent(MG_COMPONENT_COARSE_OP);
 
       printfQuda("Creating coarse null-space vectors\n");
       B_coarse = new std::vector<ColorSpinorField*>();
@@ -209,6 +228,91 @@ namespace quda {
     if (param.level < param.Nlevel-2) coarse->reset();
   }
 
+  void MG::resetGhostCompressionStats() {
+    ghost_stats->reset();
+    if (param.level < param.Nlevel-2) coarse->resetGhostCompressionStats();
+  }
+
+  void MG::ghostCompressionStats(std::vector<GhostCompressionStats> &stats) const {
+    stats.push_back(*ghost_stats);
+    if (param.level < param.Nlevel-2) coarse->ghostCompressionStats(stats);
+  }
+
+  void MG::printGhostCompressionStats() const {
+    std::vector<GhostCompressionStats> stats;
+    ghostCompressionStats(stats);
+    for (unsigned int i=0; i<stats.size(); i++) {
+      if (stats[i].compressed_bytes == 0) continue;
+      printfQuda("MG level %d ghost compression: packed %lu bytes as %lu (ratio %.2f), max relative error %e\n",
+		 param.level+1+i, stats[i].raw_bytes, stats[i].compressed_bytes,
+		 (double)stats[i].raw_bytes / stats[i].compressed_bytes, stats[i].max_error);
+    }
+  }
+
+
+  const char *getMGComponentName(MGComponent component) {
+    switch (component) {
+    case MG_COMPONENT_NULL_VECTORS: return "null_vectors";
+    case MG_COMPONENT_BLOCK_ORTHO: return "block_ortho";
+    case MG_COMPONENT_COARSE_OP: return "coarse_op";
+    case MG_COMPONENT_SMOOTHER: return "smoother";
+    case MG_COMPONENT_RESTRICT: return "restrict";
+    case MG_COMPONENT_PROLONG: return "prolong";
+    case MG_COMPONENT_COARSE_SOLVE: return "coarse_solve";
+    default: errorQuda("Unknown multigrid component %d", component);
+    }
+    return nullptr;
+  }
+
+  // component timing is disabled by default, since it synchronizes the
+  // device around each timed region, but can be enabled with the
+  // QUDA_ENABLE_MG_PROFILE environment variable
+  bool profileMGComponents() {
+    static bool init = false;
+    static bool profile = false;
+
+    if (!init) {
+      char *enable_profile = getenv("QUDA_ENABLE_MG_PROFILE");
+      if (enable_profile && strcmp(enable_profile, "1") == 0) profile = true;
+      init = true;
+    }
+
+    return profile;
+  }
+
+  void MG::startComponent(MGComponent component) {
+    if (!profileMGComponents()) return;
+    cudaDeviceSynchronize();
+    component_timer[component].Start(__func__, __FILE__, __LINE__);
+  }
+
+  void MG::stopComponent(MGComponent component) {
+    if (!profileMGComponents()) return;
+    cudaDeviceSynchronize();
+    component_timer[component].Stop(__func__, __FILE__, __LINE__);
+  }
+
+  void MG::resetComponentTimers() {
+    for (int c=MG_COMPONENT_SMOOTHER; c<MG_COMPONENT_COUNT; c++) component_timer[c].Reset(__func__, __FILE__, __LINE__);
+    if (param.level < param.Nlevel-1) coarse->resetComponentTimers();
+  }
+
+  void MG::componentTimers(std::vector<std::vector<Timer> > &timers) const {
+    timers.push_back(std::vector<Timer>(component_timer, component_timer + MG_COMPONENT_COUNT));
+    if (param.level < param.Nlevel-1) coarse->componentTimers(timers);
+  }
+
+  void MG::printComponentTimers() const {
+    std::vector<std::vector<Timer> > timers;
+    componentTimers(timers);
+    for (unsigned int i=0; i<timers.size(); i++) {
+      for (int c=0; c<MG_COMPONENT_COUNT; c++) {
+	if (timers[i][c].count == 0) continue;
+	printfQuda("MG level %d %-13s %10.4f secs in %6d calls\n", param.level+1+i,
+		   getMGComponentName(static_cast<MGComponent>(c)), timers[i][c].time, timers[i][c].count);
+      }
+    }
+  }
 
   void MG::createSmoother() {
     // create the smoother for this level
@@ -566,7 +670,9 @@ namespace quda {
       if (param.smoother_solve_type == QUDA_DIRECT_PC_SOLVE) *b_tilde = *in;
       else b_tilde = &b;
 
+      startComponent(MG_COMPONENT_SMOOTHER);
       (*presmoother)(*out, *in);
+      stopComponent(MG_COMPONENT_SMOOTHER);
 
       ColorSpinorField &solution = inner_solution_type == outer_solution_type ? x : x.Even();
       dirac.reconstruct(solution, b, inner_solution_type);
@@ -589,11 +695,15 @@ namespace quda {
       }
 
       // restrict to the coarse grid
+      startComponent(MG_COMPONENT_RESTRICT);
       transfer->R(*r_coarse, residual);
+      stopComponent(MG_COMPONENT_RESTRICT);
       if ( debug ) printfQuda("after pre-smoothing x2 = %e, r2 = %e, r_coarse2 = %e\n", norm2(x), r2, norm2(*r_coarse));
 
       // recurse to the next lower level
+      startComponent(MG_COMPONENT_COARSE_SOLVE);
       (*coarse_solver)(*x_coarse, *r_coarse);
+      stopComponent(MG_COMPONENT_COARSE_SOLVE);
 
       setOutputPrefix(prefix); // restore prefix after return from coarse grid
 
@@ -601,7 +711,9 @@ namespace quda {
 
       // prolongate back to this grid
       ColorSpinorField &x_coarse_2_fine = inner_solution_type == QUDA_MAT_SOLUTION ? *r : r->Even(); // define according to inner solution type
+      startComponent(MG_COMPONENT_PROLONG);
       transfer->P(x_coarse_2_fine, *x_coarse); // repurpose residual storage
+      stopComponent(MG_COMPONENT_PROLONG);
 
       xpy(x_coarse_2_fine, solution); // sum to solution FIXME - sum should be done inside the transfer operator
       if ( debug ) {
@@ -621,7 +733,9 @@ namespace quda {
 
       //dirac.prepare(in, out, solution, residual, inner_solution_type);
       // we should keep a copy of the prepared right hand side as we've already destroyed it
+      startComponent(MG_COMPONENT_SMOOTHER);
       (*postsmoother)(*out, *in); // for inner solve preconditioned, in the should be the original prepared rhs
+      stopComponent(MG_COMPONENT_SMOOTHER);
 
       dirac.reconstruct(x, b, outer_solution_type);
 
@@ -631,7 +745,9 @@ namespace quda {
       ColorSpinorField *out=nullptr, *in=nullptr;
 
       dirac.prepare(in, out, x, b, outer_solution_type);
+      startComponent(MG_COMPONENT_SMOOTHER);
       (*presmoother)(*out, *in);
+      stopComponent(MG_COMPONENT_SMOOTHER);
       dirac.reconstruct(x, b, outer_solution_type);
     }
 
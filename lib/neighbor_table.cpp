@@ -0,0 +1,86 @@
+#include <mutex>
+
+#include <quda_internal.h>
+#include <comm_quda.h>
+#include <index_helper.cuh>
+#include <neighbor_table.h>
+
+namespace quda {
+
+  namespace host {
+
+    NeighborTable::NeighborTable(const int *X_, const int *partitioned_, int nFace) :
+      nFace(nFace), nHop(nFace > 1 ? 2 : 1)
+    {
+      if (nFace != 1 && nFace != 3) errorQuda("Unsupported halo depth %d", nFace);
+      hop[0] = 1;
+      hop[1] = nFace;
+
+      for (int i=0; i<4; i++) {
+	X[i] = X_[i];
+	partitioned[i] = partitioned_[i];
+	if (partitioned[i] && X[i] < nFace) errorQuda("Local dimension %d = %d is smaller than the halo depth %d", i, X[i], nFace);
+      }
+      const int volume = X[0]*X[1]*X[2]*X[3];
+      const int volumeCB = volume / 2;
+      for (int i=0; i<4; i++) faceVolumeCB[i] = volume / (2 * X[i]);
+      const int Xg[5] = { X[0], X[1], X[2], X[3], 1 }; // ghostFaceIndex expects a fifth dimension
+
+      for (int parity=0; parity<2; parity++) {
+	nbr[parity].resize(volumeCB*8*nHop);
+	for (int x_cb=0; x_cb<volumeCB; x_cb++) {
+	  int x[4];
+	  getCoords(x, x_cb, X, parity);
+	  bool halo = false;
+
+	  for (int mu=0; mu<4; mu++) {
+	    for (int dir=0; dir<2; dir++) {
+	      for (int h=0; h<nHop; h++) {
+		int y[5] = { x[0], x[1], x[2], x[3], 0 };
+		y[mu] = dir == 0 ? y[mu] + hop[h] : y[mu] - hop[h];
+
+		int idx;
+		if (partitioned[mu] && (y[mu] < 0 || y[mu] >= X[mu])) {
+		  // forwards halo layers start at the face, backwards ones end at it
+		  y[mu] = y[mu] < 0 ? y[mu] + nFace : y[mu] - X[mu];
+		  idx = -(1 + ghostFaceIndex<0>(y, Xg, mu, nFace));
+		  halo = true;
+		} else {
+		  y[mu] = (y[mu] + X[mu]) % X[mu];
+		  idx = (((y[3]*X[2] + y[2])*X[1] + y[1])*X[0] + y[0]) >> 1;
+		}
+		nbr[parity][(x_cb*8 + 2*mu + dir)*nHop + h] = idx;
+	      }
+	    }
+	  }
+
+	  if (halo) boundary[parity].push_back(x_cb);
+	  else interior[parity].push_back(x_cb);
+	}
+      }
+    }
+
+    bool NeighborTable::match(const int *X_, const int *partitioned_, int nFace_) const
+    {
+      if (nFace != nFace_) return false;
+      for (int i=0; i<4; i++) if (X[i] != X_[i] || partitioned[i] != partitioned_[i]) return false;
+      return true;
+    }
+
+    const NeighborTable &getNeighborTable(const int *X, int nFace)
+    {
+      static std::vector<NeighborTable*> tables;
+      static std::mutex mutex;
+
+      int partitioned[4];
+      for (int i=0; i<4; i++) partitioned[i] = comm_dim_partitioned(i);
+
+      std::lock_guard<std::mutex> lock(mutex);
+      for (auto t : tables) if (t->match(X, partitioned, nFace)) return *t;
+      tables.push_back(new NeighborTable(X, partitioned, nFace));
+      return *tables.back();
+    }
+
+  } // namespace host
+
+} // namespace quda
@@ -169,6 +169,7 @@ namespace quda {
 	  errorQuda("Unsupported field order %d", out.FieldOrder());
 	}
       } else {
+#ifndef QUDA_HOST_ONLY
 	if (out.FieldOrder() == QUDA_FLOAT2_FIELD_ORDER) {
 	  TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	  ProlongateArg<Float,fineSpin,fineColor,coarseSpin,coarseColor,QUDA_FLOAT2_FIELD_ORDER>
@@ -178,6 +179,9 @@ namespace quda {
 	} else {
 	  errorQuda("Unsupported field order %d", out.FieldOrder());
 	}
+#else
+	errorQuda("GPU fields are not supported in a host-only build");
+#endif
       }
     }
 
@@ -1138,11 +1138,26 @@ namespace quda {
       //We now find: exp(iQ) = f0*I + f1*Q + f2*Q^2
       //      where       fj = fj(c0,c1), j=0,1,2.
       
+      //[34] Test for c0 < 0.  This must be done before theta is
+      //computed, since u and w below are only valid for c0 >= 0.
+      int parity = 0;
+      if(c0 < 0) {
+	c0 *= -1.0;
+	parity = 1;
+	//calculate fj with c0 > 0 and then convert all fj.
+      }
+
       //[17]
       c0_max = 2*pow(c1*inv3,1.5);
-      
-      //[25]
-      theta  = acos(c0/c0_max);
+
+      // exp(iQ) = 1 to working precision, and theta below is undefined
+      if (c0_max == 0) {
+	setIdentity(exp_iQ);
+	return;
+      }
+
+      //[25] c0 <= c0_max analytically, but rounding can push it over
+      theta  = acos(c0 < c0_max ? c0/c0_max : static_cast<undMatType>(1.0));
       
       //[23]
       u_p = sqrt(c1*inv3)*cos(theta*inv3);
@@ -1171,14 +1186,6 @@ namespace quda {
       else sinc_w = sin(w_p)/w_p;
       
     
-      //[34] Test for c0 < 0.
-      int parity = 0;
-      if(c0 < 0) {
-	c0 *= -1.0;
-	parity = 1;
-	//calculate fj with c0 > 0 and then convert all fj.
-      }
-      
       //Get all the numerators for fj,
       //[30] f0
       hj_re = (u_sq - w_sq)*exp_2iu_re + 8*u_sq*cos_w*exp_iu_re + 2*u_p*(3*u_sq + w_sq)*sinc_w*exp_iu_im;
@@ -747,6 +747,46 @@ namespace quda {
       return rtn;
     }
 
+    /**
+      Variant of the HeavyQuarkResidualNorm kernel that first forms
+      the residual of a shifted system, r = b - (r + a * x), where r
+      holds the unshifted operator applied to the solution x.  This
+      fuses the offset, the residual and both the L2 and heavy-quark
+      norms of the true residual check into a single kernel.
+    */
+    template <typename ReduceType, typename Float2, typename FloatN>
+    struct axpyXmyHeavyQuarkResidualNorm_ : public ReduceFunctor<ReduceType, Float2, FloatN> {
+      typedef typename scalar<ReduceType>::type real;
+      Float2 a;
+      Float2 b;
+      ReduceType aux;
+      axpyXmyHeavyQuarkResidualNorm_(const Float2 &a, const Float2 &b) : a(a), b(b), aux{ } { ; }
+
+      __device__ __host__ void pre() { aux.x = 0; aux.y = 0; }
+
+      __device__ __host__ void operator()(ReduceType &sum, FloatN &x, FloatN &y, FloatN &z, FloatN &w, FloatN &v) {
+	z += a.x*x; z = y - z;
+	norm2_<real>(aux.x,x); norm2_<real>(aux.y,z);
+      }
+
+      //! sum the solution and residual norms, and compute the heavy-quark norm
+      __device__ __host__ void post(ReduceType &sum)
+      {
+	sum.x += aux.x; sum.y += aux.y; sum.z += (aux.x > 0.0) ? (aux.y / aux.x) : static_cast<real>(1.0);
+      }
+
+      static int streams() { return 4; } //! total number of input and output streams
+      static int flops() { return 7; } //! undercounts since it excludes the per-site division
+    };
+
+    double3 axpyXmyHeavyQuarkResidualNorm(const double &a, ColorSpinorField &x, ColorSpinorField &b,
+					  ColorSpinorField &r) {
+      double3 rtn = reduce::reduceCuda<double3,QudaSumFloat3,axpyXmyHeavyQuarkResidualNorm_,0,0,1,0,0,true>
+	(make_double2(a, 0.0), make_double2(0.0, 0.0), x, b, r, r, r);
+      rtn.z /= (x.Volume()*comm_size());
+      return rtn;
+    }
+
     /**
        double3 tripleCGReduction(V x, V y, V z){}
        First performs the operation norm2(x)
@@ -1,7 +1,9 @@
 #include <color_spinor_field.h>
 #include <color_spinor_field_order.h>
 #include <tune_quda.h>
+#ifndef QUDA_HOST_ONLY
 #include <cub/cub.cuh>
+#endif
 #include <typeinfo>
 #include <multigrid_helper.cuh>
 #include <fast_intdiv.h>
@@ -149,6 +151,7 @@ namespace quda {
     }
   };
 
+#ifndef QUDA_HOST_ONLY
   /**
      Here, we ensure that each thread block maps exactly to a
      geometric block.  Each thread block corresponds to one geometric
@@ -236,6 +239,7 @@ namespace quda {
       }
     }
   }
+#endif // QUDA_HOST_ONLY
 
   template <typename Float, int fineSpin, int fineColor, int coarseSpin, int coarseColor,
 	    int coarse_colors_per_thread>
@@ -284,6 +288,7 @@ namespace quda {
 	  errorQuda("Unsupported field order %d", out.FieldOrder());
 	}
       } else {
+#ifndef QUDA_HOST_ONLY
 	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 
 	if (out.FieldOrder() == QUDA_FLOAT2_FIELD_ORDER) {
@@ -341,6 +346,9 @@ namespace quda {
 	} else {
 	  errorQuda("Unsupported field order %d", out.FieldOrder());
 	}
+#else
+	errorQuda("GPU fields are not supported in a host-only build");
+#endif
       }
     }
 
@@ -48,6 +48,10 @@ namespace quda {
       report("MR");
       solver = new MR(mat, matSloppy, param, profile);
       break;
+    case QUDA_CA_GCR_INVERTER:
+      report("CA-GCR");
+      solver = new CAGCR(mat, matSloppy, param, profile);
+      break;
     case QUDA_SD_INVERTER:
       report("SD");
       solver = new SD(mat, param, profile);
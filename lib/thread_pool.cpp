@@ -0,0 +1,122 @@
+#include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <quda_internal.h>
+#include <thread_pool.h>
+
+namespace quda {
+
+  namespace host {
+
+    // set on the pool's worker threads, and on the calling thread while it takes part in a job
+    static thread_local bool in_pool = false;
+
+    class ThreadPool {
+
+      std::vector<std::thread> workers;
+      std::mutex mutex;
+      std::condition_variable start_cv;
+      std::condition_variable done_cv;
+      unsigned long generation; // incremented for every job
+      std::atomic<int> busy; // number of workers that have not finished the current job
+
+      // the current job
+      const std::function<void(int,int)> *f;
+      int n;
+      int chunk;
+      std::atomic<int> next;
+
+      bool runChunk() {
+	int begin = next.fetch_add(chunk, std::memory_order_relaxed);
+	if (begin >= n) return false;
+	(*f)(begin, std::min(begin + chunk, n));
+	return true;
+      }
+
+      void worker() {
+	in_pool = true;
+	unsigned long seen = 0;
+	while (true) {
+	  {
+	    std::unique_lock<std::mutex> lock(mutex);
+	    start_cv.wait(lock, [&] { return generation != seen; });
+	    seen = generation;
+	  }
+	  while (runChunk()) { }
+	  {
+	    std::lock_guard<std::mutex> lock(mutex);
+	    if (--busy == 0) done_cv.notify_one();
+	  }
+	}
+      }
+
+    public:
+      ThreadPool(int nThreads) : generation(0), busy(0), f(nullptr), n(0), chunk(1), next(0) {
+	for (int i=0; i<nThreads-1; i++) workers.emplace_back(&ThreadPool::worker, this);
+      }
+
+      int size() const { return workers.size() + 1; }
+
+      void run(int n_, const std::function<void(int,int)> &f_, const std::function<void()> &progress) {
+	{
+	  std::lock_guard<std::mutex> lock(mutex);
+	  f = &f_;
+	  n = n_;
+	  chunk = std::max(1, n / (8 * size())); // several chunks per thread for load balance
+	  next.store(0, std::memory_order_relaxed);
+	  busy = workers.size();
+	  generation++;
+	}
+	start_cv.notify_all();
+
+	in_pool = true;
+	while (runChunk()) if (progress) progress();
+	in_pool = false;
+
+	if (progress) {
+	  // keep progressing until the workers are done rather than sleeping
+	  while (busy.load() > 0) {
+	    progress();
+	    std::this_thread::yield();
+	  }
+	}
+
+	std::unique_lock<std::mutex> lock(mutex);
+	done_cv.wait(lock, [&] { return busy == 0; });
+      }
+    };
+
+    int nThreads() {
+      static int n = 0;
+      if (n == 0) {
+	char *threads_env = getenv("QUDA_HOST_THREADS");
+	n = threads_env ? atoi(threads_env) : std::thread::hardware_concurrency();
+	if (n < 1) n = 1;
+      }
+      return n;
+    }
+
+    void parallel_for(int n, const std::function<void(int,int)> &f, const std::function<void()> &progress) {
+      // the pool is never destroyed: its threads are idle between jobs and end with the process
+      static ThreadPool *pool = nullptr;
+
+      if (nThreads() == 1 || n < 2 || in_pool) {
+	f(0, n);
+	if (progress) progress();
+	return;
+      }
+
+      static std::mutex pool_mutex; // serialize jobs from different user threads
+      std::lock_guard<std::mutex> lock(pool_mutex);
+      if (!pool) pool = new ThreadPool(nThreads());
+      pool->run(n, f, progress);
+    }
+
+  } // namespace host
+
+} // namespace quda
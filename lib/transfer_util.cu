@@ -1,6 +1,7 @@
 #include <color_spinor_field.h>
 #include <color_spinor_field_order.h>
 #include <tune_quda.h>
+#include <blas_quda.h>
 #include <typeinfo>
 #include <vector>
 #include <assert.h>
@@ -79,12 +80,16 @@ namespace quda {
 	  errorQuda("Field order not implemented %d", V.FieldOrder());
 	}
       } else {
+#ifndef QUDA_HOST_ONLY
 	if (V.FieldOrder() == QUDA_FLOAT2_FIELD_ORDER) {
 	  FillVArg<real,nSpin,nColor,nVec,QUDA_FLOAT2_FIELD_ORDER> arg(V,B,v);
 	  FillVGPU<real,nSpin,nColor,nVec> <<<tp.grid,tp.block,tp.shared_bytes>>>(arg,v);
 	} else {
 	  errorQuda("Field order not implemented %d", V.FieldOrder());
 	}
+#else
+	errorQuda("GPU fields are not supported in a host-only build");
+#endif
       }
     }
 
@@ -584,6 +589,7 @@ namespace quda {
 
       BlockGramSchmidt<double,Float,nVec> ortho(Vblock, numblocks, blocksize, V);
       ortho.apply(0);
+      blas::flops += ortho.flops();
 
       BlockOrderV<false,nVec,Float,VectorField> reset(Vblock, vOrder, geo_map, geo_bs, spin_bs, V);
       reset.apply(0);
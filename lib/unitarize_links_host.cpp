@@ -0,0 +1,317 @@
+// Host unitarization of gauge fields in MILC or QDP order.
+
+#include <math.h>
+#include <vector>
+
+#include <quda_internal.h>
+#include <gauge_field.h>
+#include <unitarization_links.h>
+#include <thread_pool.h>
+#include <quda_matrix.h>
+
+namespace quda {
+
+  namespace {
+#include <svd_quda.h>
+  }
+
+  static constexpr int W = 8; // links per batch
+
+  /**
+     @return Pointer to link t of the field, counting the links in
+     memory order for MILC order and direction by direction for QDP
+     order
+   */
+  template <typename Float>
+  static inline Float *linkPtr(const GaugeField &u, size_t t)
+  {
+    if (u.Order() == QUDA_MILC_GAUGE_ORDER) return static_cast<Float*>(const_cast<void*>(u.Gauge_p())) + t*18;
+    const size_t volume = u.Volume();
+    return static_cast<Float**>(const_cast<void*>(u.Gauge_p()))[t / volume] + (t % volume)*18;
+  }
+
+  template <typename Float>
+  static inline void gather(double v_re[3][3][W], double v_im[3][3][W], const GaugeField &u, size_t first, int n)
+  {
+    for (int l=0; l<W; l++) {
+      const Float *v = l < n ? linkPtr<Float>(u, first + l) : nullptr;
+      for (int i=0; i<3; i++) {
+	for (int j=0; j<3; j++) {
+	  // pad the unused lanes with the identity
+	  v_re[i][j][l] = v ? v[(i*3 + j)*2 + 0] : (i == j ? 1.0 : 0.0);
+	  v_im[i][j][l] = v ? v[(i*3 + j)*2 + 1] : 0.0;
+	}
+      }
+    }
+  }
+
+  /**
+     c = a^dagger b (dagA) or a b for batches of 3x3 matrices
+   */
+  template <bool dagA>
+  static inline void mul(double c_re[3][3][W], double c_im[3][3][W], const double a_re[3][3][W],
+			 const double a_im[3][3][W], const double b_re[3][3][W], const double b_im[3][3][W])
+  {
+    for (int i=0; i<3; i++) {
+      for (int j=0; j<3; j++) {
+	for (int l=0; l<W; l++) { c_re[i][j][l] = 0.0; c_im[i][j][l] = 0.0; }
+	for (int k=0; k<3; k++) {
+	  const double *ar = dagA ? a_re[k][i] : a_re[i][k], *ai = dagA ? a_im[k][i] : a_im[i][k];
+	  const double sign = dagA ? -1.0 : 1.0;
+	  for (int l=0; l<W; l++) {
+	    c_re[i][j][l] += ar[l] * b_re[k][j][l] - sign * ai[l] * b_im[k][j][l];
+	    c_im[i][j][l] += ar[l] * b_im[k][j][l] + sign * ai[l] * b_re[k][j][l];
+	  }
+	}
+      }
+    }
+  }
+
+  /**
+     Compute the largest deviation of u^dagger u from the identity for
+     each lane; NaN links give a NaN deviation
+   */
+  static inline void unitarityError(double err[W], const double u_re[3][3][W], const double u_im[3][3][W])
+  {
+    alignas(64) double p_re[3][3][W], p_im[3][3][W];
+    mul<true>(p_re, p_im, u_re, u_im, u_re, u_im);
+    for (int l=0; l<W; l++) err[l] = 0.0;
+    for (int i=0; i<3; i++) {
+      for (int j=0; j<3; j++) {
+	for (int l=0; l<W; l++) {
+	  const double re = fabs(p_re[i][j][l] - (i == j ? 1.0 : 0.0)), im = fabs(p_im[i][j][l]);
+	  err[l] = (re > err[l] || re != re) ? re : err[l];
+	  err[l] = (im > err[l] || im != im) ? im : err[l];
+	}
+      }
+    }
+  }
+
+  struct UnitarizeHostArg {
+    double unitarize_eps;
+    double max_error;
+    bool allow_svd;
+    bool svd_only;
+    double svd_rel_error;
+    double svd_abs_error;
+  };
+
+  /**
+     Unitarize the n <= W links starting at link first of in into out
+     @return The number of links that failed
+   */
+  template <typename Float>
+  static int unitarizeBatch(GaugeField &out, const GaugeField &in, size_t first, int n, const UnitarizeHostArg &arg)
+  {
+    alignas(64) double v_re[3][3][W], v_im[3][3][W];
+    alignas(64) double q_re[3][3][W], q_im[3][3][W];
+    alignas(64) double q2_re[3][3][W], q2_im[3][3][W];
+    gather<Float>(v_re, v_im, in, first, n);
+
+    // Q = V^dagger V and Q^2
+    mul<true>(q_re, q_im, v_re, v_im, v_re, v_im);
+    mul<false>(q2_re, q2_im, q_re, q_im, q_re, q_im);
+
+    // the eigenvalues g of Q from the traces c of Q, Q^2 and Q^3
+    const double one_third = 0.333333333333333333333;
+    const double one_ninth = 0.111111111111111111111;
+    const double one_eighteenth = 0.055555555555555555555;
+    const double pi = 3.14159265358979323846;
+    alignas(64) double c[3][W], g[3][W], det[W];
+    bool flag[W];
+
+    for (int l=0; l<W; l++) {
+      c[0][l] = q_re[0][0][l] + q_re[1][1][l] + q_re[2][2][l];
+      c[1][l] = 0.5 * (q2_re[0][0][l] + q2_re[1][1][l] + q2_re[2][2][l]);
+      c[2][l] = 0.0;
+    }
+    for (int i=0; i<3; i++) {
+      for (int j=0; j<3; j++) {
+	for (int l=0; l<W; l++) c[2][l] += q2_re[i][j][l] * q_re[j][i][l] - q2_im[i][j][l] * q_im[j][i][l];
+      }
+    }
+
+    for (int l=0; l<W; l++) {
+      c[2][l] *= one_third;
+      g[0][l] = g[1][l] = g[2][l] = c[0][l] * one_third;
+      const double s = c[1][l]*one_third - c[0][l]*c[0][l]*one_eighteenth;
+      if (fabs(s) >= arg.unitarize_eps) {
+	const double sqrt_s = sqrt(s);
+	const double r = c[2][l]*0.5 - (c[0][l]*one_third)*(c[1][l] - c[0][l]*c[0][l]*one_ninth);
+	const double cosTheta = r / (s*sqrt_s);
+	const double theta = fabs(cosTheta) >= 1.0 ? (r > 0 ? 0.0 : pi) : acos(cosTheta);
+	for (int k=0; k<3; k++) g[k][l] = c[0][l]*one_third + 2*sqrt_s*cos(theta*one_third + k*2*pi*one_third);
+      }
+
+      // the determinant of the Hermitian Q is real
+      det[l] = q_re[0][0][l] * (q_re[1][1][l]*q_re[2][2][l] - q_re[1][2][l]*q_re[1][2][l] - q_im[1][2][l]*q_im[1][2][l])
+	- q_re[1][1][l] * (q_re[0][2][l]*q_re[0][2][l] + q_im[0][2][l]*q_im[0][2][l])
+	- q_re[2][2][l] * (q_re[0][1][l]*q_re[0][1][l] + q_im[0][1][l]*q_im[0][1][l])
+	+ 2.0 * (q_re[0][1][l] * (q_re[1][2][l]*q_re[0][2][l] + q_im[1][2][l]*q_im[0][2][l])
+		 - q_im[0][1][l] * (q_im[1][2][l]*q_re[0][2][l] - q_re[1][2][l]*q_im[0][2][l]));
+
+      // the analytic result is only used if the determinant agrees with the eigenvalues
+      flag[l] = arg.svd_only || fabs(det[l]) < arg.svd_abs_error
+	|| !(fabs((g[0][l]*g[1][l]*g[2][l] - det[l]) / det[l]) < arg.svd_rel_error);
+    }
+
+    // Q^{-1/2} = f0 + f1 Q + f2 Q^2, written into q
+    for (int l=0; l<W; l++) {
+      const double s0 = sqrt(g[0][l]), s1 = sqrt(g[1][l]), s2 = sqrt(g[2][l]);
+      const double u = s0 + s1 + s2, v = s0*s1 + s0*s2 + s1*s2, w = s0*s1*s2;
+      const double denominator = 1.0 / (w*(u*v - w));
+      c[0][l] = (u*v*v - w*(u*u + v)) * denominator;
+      c[1][l] = (-u*u*u - w + 2.0*u*v) * denominator;
+      c[2][l] = u * denominator;
+    }
+    for (int i=0; i<3; i++) {
+      for (int j=0; j<3; j++) {
+	for (int l=0; l<W; l++) {
+	  q_re[i][j][l] = c[1][l]*q_re[i][j][l] + c[2][l]*q2_re[i][j][l] + (i == j ? c[0][l] : 0.0);
+	  q_im[i][j][l] = c[1][l]*q_im[i][j][l] + c[2][l]*q2_im[i][j][l];
+	}
+      }
+    }
+
+    // W = V Q^{-1/2}, written into q2, and its unitarity
+    mul<false>(q2_re, q2_im, v_re, v_im, q_re, q_im);
+    alignas(64) double err[W];
+    unitarityError(err, q2_re, q2_im);
+
+    int fails = 0;
+    for (int l=0; l<n; l++) {
+      Float *o = linkPtr<Float>(out, first + l);
+
+      if (flag[l]) {
+	if (!arg.allow_svd) {
+	  // the analytic unitarization is not reliable and SVD is not allowed
+	  for (int i=0; i<3; i++) {
+	    for (int j=0; j<3; j++) { o[(i*3 + j)*2 + 0] = v_re[i][j][l]; o[(i*3 + j)*2 + 1] = v_im[i][j][l]; }
+	  }
+	  fails++;
+	  continue;
+	}
+
+	Matrix<complex<double>,3> link, u, v;
+	for (int i=0; i<3; i++)
+	  for (int j=0; j<3; j++) link(i,j) = complex<double>(v_re[i][j][l], v_im[i][j][l]);
+	double singular_values[3];
+	computeSVD<double>(link, u, v, singular_values);
+	link = u*conj(v);
+	if (!isUnitary(link, arg.max_error)) fails++;
+	for (int i=0; i<3; i++) {
+	  for (int j=0; j<3; j++) { o[(i*3 + j)*2 + 0] = link(i,j).x; o[(i*3 + j)*2 + 1] = link(i,j).y; }
+	}
+      } else {
+	if (!(err[l] <= arg.max_error)) fails++;
+	for (int i=0; i<3; i++) {
+	  for (int j=0; j<3; j++) { o[(i*3 + j)*2 + 0] = q2_re[i][j][l]; o[(i*3 + j)*2 + 1] = q2_im[i][j][l]; }
+	}
+      }
+    }
+
+    return fails;
+  }
+
+  static void checkField(const GaugeField &u)
+  {
+    if (u.Location() != QUDA_CPU_FIELD_LOCATION) errorQuda("Host unitarization requires a CPU field");
+    if (u.Order() != QUDA_MILC_GAUGE_ORDER && u.Order() != QUDA_QDP_GAUGE_ORDER)
+      errorQuda("Host unitarization requires MILC or QDP order, not %d", u.Order());
+    if (u.Reconstruct() != QUDA_RECONSTRUCT_NO) errorQuda("Host unitarization requires links without reconstruction");
+    if (u.Geometry() != QUDA_VECTOR_GEOMETRY) errorQuda("Host unitarization requires vector geometry");
+  }
+
+  template <typename Float>
+  static int unitarizeLinksHost(GaugeField &out, const GaugeField &in, const UnitarizeHostArg &arg)
+  {
+    const size_t nLink = 4*static_cast<size_t>(in.Volume());
+    const int nBatch = (nLink + W - 1) / W;
+
+    std::vector<int> fails(nBatch);
+    host::parallel_for(nBatch, [&](int begin, int end) {
+	for (int b=begin; b<end; b++) {
+	  const size_t first = static_cast<size_t>(b) * W;
+	  fails[b] = unitarizeBatch<Float>(out, in, first, std::min<size_t>(W, nLink - first), arg);
+	}
+      });
+
+    int num_failures = 0;
+    for (int b=0; b<nBatch; b++) num_failures += fails[b];
+    return num_failures;
+  }
+
+  int unitarizeLinksHost(cpuGaugeField &out, const cpuGaugeField &in, double unitarize_eps, double max_error,
+			 bool allow_svd, bool svd_only, double svd_rel_error, double svd_abs_error)
+  {
+    checkField(in);
+    checkField(out);
+    if (in.Precision() != out.Precision())
+      errorQuda("Precisions must match (out=%d != in=%d)", out.Precision(), in.Precision());
+    if (in.Order() != out.Order()) errorQuda("Orders must match (out=%d != in=%d)", out.Order(), in.Order());
+    if (in.Volume() != out.Volume()) errorQuda("Volumes must match (out=%d != in=%d)", out.Volume(), in.Volume());
+
+    const UnitarizeHostArg arg = { unitarize_eps, max_error, allow_svd, svd_only, svd_rel_error, svd_abs_error };
+    if (in.Precision() == QUDA_DOUBLE_PRECISION) {
+      return unitarizeLinksHost<double>(out, in, arg);
+    } else if (in.Precision() == QUDA_SINGLE_PRECISION) {
+      return unitarizeLinksHost<float>(out, in, arg);
+    } else {
+      errorQuda("Precision %d not supported", in.Precision());
+    }
+    return 0;
+  }
+
+  template <typename Float>
+  static bool isUnitaryHost(const GaugeField &field, double max_error)
+  {
+    const size_t nLink = 4*static_cast<size_t>(field.Volume());
+    const int nBatch = (nLink + W - 1) / W;
+
+    // the first failing link of each batch, so that we report the first one overall
+    std::vector<size_t> failure(nBatch);
+    host::parallel_for(nBatch, [&](int begin, int end) {
+	for (int b=begin; b<end; b++) {
+	  const size_t first = static_cast<size_t>(b) * W;
+	  const int n = std::min<size_t>(W, nLink - first);
+	  alignas(64) double u_re[3][3][W], u_im[3][3][W], err[W];
+	  gather<Float>(u_re, u_im, field, first, n);
+	  unitarityError(err, u_re, u_im);
+	  failure[b] = nLink;
+	  for (int l=n-1; l>=0; l--) if (!(err[l] <= max_error)) failure[b] = first + l;
+	}
+      });
+
+    for (int b=0; b<nBatch; b++) {
+      if (failure[b] == nLink) continue;
+      const size_t t = failure[b];
+      const int i = field.Order() == QUDA_MILC_GAUGE_ORDER ? t / 4 : t % field.Volume();
+      const int dir = field.Order() == QUDA_MILC_GAUGE_ORDER ? t % 4 : t / field.Volume();
+      Matrix<complex<double>,3> link, identity;
+      const Float *u = linkPtr<Float>(field, t);
+      for (int r=0; r<3; r++)
+	for (int s=0; s<3; s++) link(r,s) = complex<double>(u[(r*3 + s)*2 + 0], u[(r*3 + s)*2 + 1]);
+      printf("Unitarity failure\n");
+      printf("site index = %d,\t direction = %d\n", i, dir);
+      printLink(link);
+      identity = conj(link)*link;
+      printLink(identity);
+      return false;
+    }
+    return true;
+  }
+
+  bool isUnitary(const cpuGaugeField& field, double max_error)
+  {
+    checkField(field);
+    if (field.Precision() == QUDA_DOUBLE_PRECISION) {
+      return isUnitaryHost<double>(field, max_error);
+    } else if (field.Precision() == QUDA_SINGLE_PRECISION) {
+      return isUnitaryHost<float>(field, max_error);
+    } else {
+      errorQuda("Unsupported precision\n");
+    }
+    return false;
+  }
+
+} // namespace quda
@@ -28,7 +28,6 @@ namespace{
 #define FL_UNITARIZE_PI23 FL_UNITARIZE_PI*0.66666666666666666666
 #endif 
  
-  static const int max_iter_newton = 20;
   static const int max_iter = 20;
 
   static double unitarize_eps = 1e-14;
@@ -80,27 +79,6 @@ namespace{
   }
 
 
-  template<class Cmplx>
-  __device__ __host__
-  bool isUnitarizedLinkConsistent(const Matrix<Cmplx,3>& initial_matrix,
-				  const Matrix<Cmplx,3>& unitary_matrix,
-				  double max_error)	
-  {
-    Matrix<Cmplx,3> temporary; 
-    temporary = conj(initial_matrix)*unitary_matrix;
-    temporary = temporary*temporary - conj(initial_matrix)*initial_matrix;
-   
-    for(int i=0; i<3; ++i){
-      for(int j=0; j<3; ++j){
-	if( fabs(temporary(i,j).x) > max_error || fabs(temporary(i,j).y) > max_error){
-	  return false;
-	}
-      }
-    }
-    return true;
-  }
-
-
   template<class T>
   __device__ __host__
   T getAbsMin(const T* const array, int size){
@@ -267,78 +245,12 @@ namespace{
   }
 
 
-  template<class Float>
-  __host__ __device__
-  bool unitarizeLinkNewton(const Matrix<complex<Float>,3>& in, Matrix<complex<Float>,3>* const result, int max_iter)
-  {
-    Matrix<complex<Float>,3> u, uinv;
-    u = in;
-
-    for(int i=0; i<max_iter; ++i){
-      computeMatrixInverse(u, &uinv);
-      u = 0.5*(u + conj(uinv));
-    }
-
-    if(isUnitarizedLinkConsistent(in,u,0.0000001)==false)
-      {
-        printf("ERROR: Unitarized link is not consistent with incoming link\n");
-	return false;
-      }
-    *result = u;
-
-    return true;
-  }   
-
   void unitarizeLinksCPU(cpuGaugeField &outfield, const cpuGaugeField& infield)
   {
-    if (infield.Precision() != outfield.Precision())
-      errorQuda("Precisions must match (out=%d != in=%d)", outfield.Precision(), infield.Precision());
-    
-    int num_failures = 0;
-    Matrix<complex<double>,3> inlink, outlink;
-      
-    for (int i=0; i<infield.Volume(); ++i){
-      for (int dir=0; dir<4; ++dir){
-	if (infield.Precision() == QUDA_SINGLE_PRECISION){
-	  copyArrayToLink(&inlink, ((float*)(infield.Gauge_p()) + (i*4 + dir)*18)); // order of arguments?
-	  if( unitarizeLinkNewton<double>(inlink, &outlink, max_iter_newton) == false ) num_failures++;
-	  copyLinkToArray(((float*)(outfield.Gauge_p()) + (i*4 + dir)*18), outlink); 
-	} else if (infield.Precision() == QUDA_DOUBLE_PRECISION){
-	  copyArrayToLink(&inlink, ((double*)(infield.Gauge_p()) + (i*4 + dir)*18)); // order of arguments?
-	  if( unitarizeLinkNewton<double>(inlink, &outlink, max_iter_newton) == false ) num_failures++;
-	  copyLinkToArray(((double*)(outfield.Gauge_p()) + (i*4 + dir)*18), outlink); 
-	} // precision?
-      } // dir
-    }  // loop over volume
-    return;
+    int num_failures = unitarizeLinksHost(outfield, infield, unitarize_eps, max_error,
+					  reunit_allow_svd, reunit_svd_only, svd_rel_error, svd_abs_error);
+    if (num_failures) warningQuda("Unitarization failed for %d links", num_failures);
   }
-    
-  // CPU function which checks that the gauge field is unitary
-  bool isUnitary(const cpuGaugeField& field, double max_error)
-  {
-    Matrix<complex<double>,3> link, identity;
-      
-    for(int i=0; i<field.Volume(); ++i){
-      for(int dir=0; dir<4; ++dir){
-	if(field.Precision() == QUDA_SINGLE_PRECISION){
-	  copyArrayToLink(&link, ((float*)(field.Gauge_p()) + (i*4 + dir)*18)); // order of arguments?
-	}else if(field.Precision() == QUDA_DOUBLE_PRECISION){     
-	  copyArrayToLink(&link, ((double*)(field.Gauge_p()) + (i*4 + dir)*18)); // order of arguments?
-	}else{
-	  errorQuda("Unsupported precision\n");
-	}
-	if(isUnitary(link,max_error) == false){ 
-	  printf("Unitarity failure\n");
-	  printf("site index = %d,\t direction = %d\n", i, dir);
-	  printLink(link);
-	  identity = conj(link)*link;
-	  printLink(identity);
-	  return false;
-	}
-      } // dir
-    } // i	  
-    return true;
-  } // is unitary
 
 
   template<typename Float, typename Out, typename In>
@@ -607,6 +519,7 @@ void unitarizeLinks(cudaGaugeField& output, const cudaGaugeField &input, int* fa
     } else {
       errorQuda("Precision %d not supported", u.Precision());
     }
+    u.updateVersion(); // the links are projected in place
 #else
     errorQuda("Unitarization has not been built");
 #endif
@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+
+#include <test_util.h>
+#include <misc.h>
+
+#include <dirac_quda.h>
+#include <random>
+
+// Test of the compressed halo exchange of the host coarse operator.
+// Every dimension is partitioned, so that with a single process the
+// halo is exchanged with itself, and the result is compared with the
+// unpartitioned operator for each halo format.
+
+extern int device;
+extern int xdim;
+extern int ydim;
+extern int zdim;
+extern int tdim;
+extern int gridsize_from_cmdline[];
+extern int nvec[];
+
+extern void usage(char** );
+
+using namespace quda;
+
+cpuColorSpinorField *in, *out, *ref;
+cpuGaugeField *Y_h, *X_h;
+
+int Nspin;
+int Ncolor;
+
+void
+display_test_info()
+{
+  printfQuda("running the following test:\n");
+  printfQuda("S_dimension T_dimension Nspin Ncolor\n");
+  printfQuda("%3d /%3d / %3d   %3d      %d     %d\n", xdim, ydim, zdim, tdim, Nspin, Ncolor);
+  printfQuda("Grid partition info:     X  Y  Z  T\n");
+  printfQuda("                         %d  %d  %d  %d\n",
+	     dimPartitioned(0),
+	     dimPartitioned(1),
+	     dimPartitioned(2),
+	     dimPartitioned(3));
+  return;
+}
+
+void initFields()
+{
+  ColorSpinorParam param;
+  param.nColor = Ncolor;
+  param.nSpin = Nspin;
+  param.nDim = 4;
+
+  param.pad = 0; // padding must be zero for cpu fields
+  param.siteSubset = QUDA_FULL_SITE_SUBSET;
+  param.x[0] = xdim;
+  param.x[1] = ydim;
+  param.x[2] = zdim;
+  param.x[3] = tdim;
+  param.PCtype = QUDA_4D_PC;
+
+  param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  param.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  param.precision = QUDA_DOUBLE_PRECISION;
+  param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  param.create = QUDA_ZERO_FIELD_CREATE;
+
+  in = new cpuColorSpinorField(param);
+  out = new cpuColorSpinorField(param);
+  ref = new cpuColorSpinorField(param);
+
+  GaugeFieldParam gParam;
+  gParam.x[0] = xdim;
+  gParam.x[1] = ydim;
+  gParam.x[2] = zdim;
+  gParam.x[3] = tdim;
+  gParam.nColor = param.nColor*param.nSpin;
+  gParam.reconstruct = QUDA_RECONSTRUCT_NO;
+  gParam.order = QUDA_QDP_GAUGE_ORDER;
+  gParam.link_type = QUDA_COARSE_LINKS;
+  gParam.t_boundary = QUDA_PERIODIC_T;
+  gParam.create = QUDA_ZERO_FIELD_CREATE;
+  gParam.precision = param.precision;
+  gParam.nDim = 4;
+  gParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+  gParam.nFace = 1;
+
+  gParam.geometry = QUDA_COARSE_GEOMETRY;
+  Y_h = new cpuGaugeField(gParam);
+
+  gParam.geometry = QUDA_SCALAR_GEOMETRY;
+  gParam.nFace = 0;
+  X_h = new cpuGaugeField(gParam);
+
+  // random hopping and site terms, with sites whose magnitudes vary
+  // over several orders so that the shared exponents differ
+  std::mt19937 rng(1234 + comm_rank());
+  std::normal_distribution<double> gauss(0.0, 1.0);
+  const int n = gParam.nColor;
+  const double scale = 0.5 / n;
+
+  for (int d = 0; d < 2*gParam.nDim; d++) {
+    double *y = static_cast<double**>(Y_h->Gauge_p())[d];
+    for (int i = 0; i < Y_h->Volume()*n*n*2; i++) y[i] = scale * gauss(rng);
+  }
+
+  double *x = static_cast<double**>(X_h->Gauge_p())[0];
+  for (int s = 0; s < X_h->Volume(); s++) {
+    for (int i = 0; i < n*n*2; i++) x[(s*n*n)*2 + i] = scale * gauss(rng);
+    for (int i = 0; i < n; i++) x[(s*n*n + i*n + i)*2] += 4.0;
+  }
+
+  double *v = static_cast<double*>(in->V());
+  for (int s = 0; s < in->Volume(); s++) {
+    double site_scale = pow(10.0, 3.0 * gauss(rng));
+    for (int i = 0; i < n*2; i++) v[s*n*2 + i] = site_scale * gauss(rng);
+  }
+}
+
+void freeFields()
+{
+  delete in;
+  delete out;
+  delete ref;
+  delete Y_h;
+  delete X_h;
+}
+
+const char *compression_str(QudaGhostCompression compression)
+{
+  switch (compression) {
+  case QUDA_GHOST_COMPRESSION_NONE: return "none";
+  case QUDA_GHOST_COMPRESSION_BLOCK_FLOAT_16: return "block-float-16";
+  case QUDA_GHOST_COMPRESSION_BLOCK_FLOAT_8: return "block-float-8";
+  default: return "invalid";
+  }
+}
+
+int main(int argc, char** argv)
+{
+  for (int i = 1; i < argc; i++){
+    if(process_command_line_option(argc, argv, &i) == 0){
+      continue;
+    }
+    printfQuda("ERROR: Invalid option:%s\n", argv[i]);
+    usage(argv);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+
+  Nspin = 2;
+  Ncolor = nvec[0] > 0 ? nvec[0] : 24;
+
+  initQuda(device);
+
+  setVerbosity(QUDA_SUMMARIZE);
+
+  initFields();
+
+  DiracParam param;
+  param.kappa = 1.0;
+  DiracCoarse dirac(param, Y_h, X_h, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+
+  // reference without communication, unless the grid is already partitioned
+  dirac.M(*ref, *in);
+
+  // now partition every dimension and refresh the link halos
+  for (int d = 0; d < 4; d++) commDimPartitionedSet(d);
+  Y_h->exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+
+  display_test_info();
+
+  // the relative deviation allowed for each format
+  const QudaGhostCompression compression[] = { QUDA_GHOST_COMPRESSION_NONE,
+					       QUDA_GHOST_COMPRESSION_BLOCK_FLOAT_16,
+					       QUDA_GHOST_COMPRESSION_BLOCK_FLOAT_8 };
+  const double tol[] = { 1e-12, 1e-4, 2e-2 };
+
+  const double ref_norm = blas::norm2(*ref);
+  int fail = 0;
+  for (int i = 0; i < 3; i++) {
+    auto stats = std::make_shared<GhostCompressionStats>();
+    in->setGhostCompression(compression[i], stats);
+    dirac.M(*out, *in);
+    double deviation = sqrt(blas::xmyNorm(*ref, *out) / ref_norm); // out = ref - out
+
+    printfQuda("Halo format %-14s: relative deviation = %e (tolerance %e) %s\n", compression_str(compression[i]),
+	       deviation, tol[i], deviation < tol[i] ? "PASSED" : "FAILED");
+    if (!(deviation < tol[i])) fail++;
+
+    if (stats->compressed_bytes > 0) {
+      printfQuda("%-26s  packed %lu bytes as %lu (ratio %.2f), max relative error %e\n", "",
+		 stats->raw_bytes, stats->compressed_bytes, (double)stats->raw_bytes / stats->compressed_bytes, stats->max_error);
+    } else if (compression[i] != QUDA_GHOST_COMPRESSION_NONE) {
+      printfQuda("No compressed halos were recorded for %s\n", compression_str(compression[i]));
+      fail++;
+    }
+  }
+  in->setGhostCompression(QUDA_GHOST_COMPRESSION_NONE);
+
+  freeFields();
+
+  endQuda();
+
+  finalizeComms();
+
+  return fail;
+}
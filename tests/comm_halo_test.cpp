@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+#include <algorithm>
+
+#include <quda_internal.h>
+#include <comm_quda.h>
+
+#include <test_util.h>
+#include <misc.h>
+
+// Test of halo exchange through the comm layer with the halo depth
+// changing between exchanges.  Each rank sends the boundary slab of
+// the given depth with a strided send and checks the received ghost
+// against the neighbor's global coordinates; with a single process
+// the halo is exchanged with itself.  With MPI the shared-memory
+// transport is enabled with a small ring (unless overridden in the
+// environment), so that messages wrap around and exceed the ring.
+
+extern int xdim;
+extern int ydim;
+extern int zdim;
+extern int tdim;
+extern int gridsize_from_cmdline[];
+
+extern void usage(char** );
+
+// number of doubles per site (a Wilson spinor)
+static const int Ncomp = 24;
+
+static int X[4];
+
+void
+display_test_info()
+{
+  printfQuda("running the following test:\n");
+  printfQuda("S_dimension T_dimension Ncomp\n");
+  printfQuda("%3d /%3d / %3d   %3d      %d\n", xdim, ydim, zdim, tdim, Ncomp);
+  printfQuda("Grid partition info:     X  Y  Z  T\n");
+  printfQuda("                         %d  %d  %d  %d\n",
+	     comm_dim(0), comm_dim(1), comm_dim(2), comm_dim(3));
+  return;
+}
+
+// value of component c at global coordinate g, with local coordinate x[mu] allowed to leave the local volume
+static double siteValue(const int x[4], int c)
+{
+  double v = 0.0;
+  for (int mu = 3; mu >= 0; mu--) {
+    const int G = X[mu] * comm_dim(mu);
+    const int g = ((comm_coord(mu) * X[mu] + x[mu]) % G + G) % G;
+    v = v * G + g;
+  }
+  return v * Ncomp + c;
+}
+
+/**
+   Exchange the depth-d boundary slabs in dimension mu in both
+   directions and check the ghosts
+   @return Number of incorrect values
+ */
+static int exchange(std::vector<double> &field, int mu, int d, int repeats)
+{
+  const size_t site_bytes = Ncomp * sizeof(double);
+  int inner = 1, outer = 1;
+  for (int nu = 0; nu < mu; nu++) inner *= X[nu];
+  for (int nu = mu+1; nu < 4; nu++) outer *= X[nu];
+
+  const size_t blksize = d * inner * site_bytes;
+  const size_t stride = X[mu] * inner * site_bytes;
+  const size_t ghost_bytes = blksize * outer;
+
+  std::vector<double> ghost_back(ghost_bytes / sizeof(double)), ghost_fwd(ghost_bytes / sizeof(double));
+
+  char *top = reinterpret_cast<char*>(field.data()) + (X[mu] - d) * inner * site_bytes;
+  char *bottom = reinterpret_cast<char*>(field.data());
+
+  // the top slab goes forwards into the neighbor's backwards ghost and vice versa
+  MsgHandle *send_fwd = comm_declare_strided_send_relative(top, mu, +1, blksize, outer, stride);
+  MsgHandle *send_back = comm_declare_strided_send_relative(bottom, mu, -1, blksize, outer, stride);
+  MsgHandle *recv_back = comm_declare_receive_relative(ghost_back.data(), mu, -1, ghost_bytes);
+  MsgHandle *recv_fwd = comm_declare_receive_relative(ghost_fwd.data(), mu, +1, ghost_bytes);
+
+  int fail = 0;
+  for (int r = 0; r < repeats; r++) {
+    std::fill(ghost_back.begin(), ghost_back.end(), -1.0);
+    std::fill(ghost_fwd.begin(), ghost_fwd.end(), -1.0);
+
+    comm_start(recv_back);
+    comm_start(recv_fwd);
+    comm_start(send_fwd);
+    comm_start(send_back);
+
+    comm_wait(send_fwd);
+    comm_wait(send_back);
+    comm_wait(recv_back);
+    comm_wait(recv_fwd);
+
+    // ghosts are packed as [outer][depth][inner]
+    for (int o = 0; o < outer; o++) {
+      for (int k = 0; k < d; k++) {
+	for (int i = 0; i < inner; i++) {
+	  int x[4];
+	  int rem = i;
+	  for (int nu = 0; nu < mu; nu++) { x[nu] = rem % X[nu]; rem /= X[nu]; }
+	  rem = o;
+	  for (int nu = mu+1; nu < 4; nu++) { x[nu] = rem % X[nu]; rem /= X[nu]; }
+
+	  const size_t idx = ((size_t)(o * d + k) * inner + i) * Ncomp;
+	  for (int c = 0; c < Ncomp; c++) {
+	    x[mu] = k - d;
+	    if (ghost_back[idx + c] != siteValue(x, c)) fail++;
+	    x[mu] = X[mu] + k;
+	    if (ghost_fwd[idx + c] != siteValue(x, c)) fail++;
+	  }
+	}
+      }
+    }
+  }
+
+  comm_free(send_fwd);
+  comm_free(send_back);
+  comm_free(recv_back);
+  comm_free(recv_fwd);
+
+  return fail;
+}
+
+int main(int argc, char** argv)
+{
+  for (int i = 1; i < argc; i++){
+    if(process_command_line_option(argc, argv, &i) == 0){
+      continue;
+    }
+    printfQuda("ERROR: Invalid option:%s\n", argv[i]);
+    usage(argv);
+  }
+
+  // must be set before the comm layer is initialized; rank 0's environment is used
+  setenv("QUDA_ENABLE_SHM", "1", 0);
+  setenv("QUDA_SHM_RING_BYTES", "4096", 0);
+
+  initComms(argc, argv, gridsize_from_cmdline);
+
+  X[0] = xdim;
+  X[1] = ydim;
+  X[2] = zdim;
+  X[3] = tdim;
+
+  display_test_info();
+
+  int volume = 1;
+  for (int mu = 0; mu < 4; mu++) volume *= X[mu];
+  std::vector<double> field((size_t)volume * Ncomp);
+  for (int s = 0; s < volume; s++) {
+    int x[4];
+    int rem = s;
+    for (int mu = 0; mu < 4; mu++) { x[mu] = rem % X[mu]; rem /= X[mu]; }
+    for (int c = 0; c < Ncomp; c++) field[(size_t)s * Ncomp + c] = siteValue(x, c);
+  }
+
+  // the depth changes between exchanges, both up and down, as with ping-pong smearing
+  const int depths[] = { 1, 3, 2, 3, 1, 4 };
+
+  int fail = 0;
+  for (int mu = 0; mu < 4; mu++) {
+    for (int d : depths) {
+      if (d > X[mu]) continue;
+      int dim_fail = exchange(field, mu, d, 2);
+      comm_allreduce_int(&dim_fail);
+      printfQuda("dim %d depth %d: %s\n", mu, d, dim_fail ? "FAILED" : "passed");
+      fail += dim_fail;
+    }
+  }
+
+  printfQuda("Halo exchange test %s (%d incorrect values)\n", fail ? "FAILED" : "passed", fail);
+
+  comm_finalize();
+  finalizeComms();
+
+  return fail ? 1 : 0;
+}
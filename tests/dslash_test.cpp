@@ -971,6 +971,65 @@ TEST(dslash, verify) {
   ASSERT_LE(deviation, tol) << "CPU and CUDA implementations do not agree";
 }
 
+// apply the same operator to the host fields with the library's host Dslash
+TEST(dslash, host) {
+  bool dwf = (dslash_type == QUDA_DOMAIN_WALL_DSLASH || dslash_type == QUDA_DOMAIN_WALL_4D_DSLASH ||
+	      dslash_type == QUDA_MOBIUS_DWF_DSLASH);
+  bool supported = dwf ? hostDomainWallDslashSupported(*spinor) :
+    (dslash_type == QUDA_WILSON_DSLASH || dslash_type == QUDA_CLOVER_WILSON_DSLASH) && hostDslashSupported(*spinor);
+  if (transfer || !supported) {
+    printfQuda("Host Dslash not available for this configuration\n");
+    return;
+  }
+
+  ColorSpinorParam param(*spinorOut);
+  param.create = QUDA_NULL_FIELD_CREATE;
+  cpuColorSpinorField hostOut(param);
+
+  // the benchmark operator holds device temporaries, so use one that allocates host ones
+  bool pc = (dslash_type == QUDA_DOMAIN_WALL_4D_DSLASH || dslash_type == QUDA_MOBIUS_DWF_DSLASH) ?
+    true : (test_type != 2 && test_type != 4);
+  DiracParam diracParam;
+  setDiracParam(diracParam, &inv_param, pc);
+
+  if (dslash_type == QUDA_DOMAIN_WALL_4D_DSLASH) {
+    DiracDomainWall4DPC hostDirac(diracParam);
+    switch (test_type) {
+    case 0: hostDirac.Dslash4(hostOut, *spinor, parity); break;
+    case 1: hostDirac.Dslash5(hostOut, *spinor, parity); break;
+    case 2: hostDirac.Dslash5inv(hostOut, *spinor, parity, kappa5); break;
+    case 3: hostDirac.M(hostOut, *spinor); break;
+    case 4: hostDirac.MdagM(hostOut, *spinor); break;
+    }
+  } else if (dslash_type == QUDA_MOBIUS_DWF_DSLASH) {
+    DiracMobiusPC hostDirac(diracParam);
+    switch (test_type) {
+    case 0: hostDirac.Dslash4(hostOut, *spinor, parity); break;
+    case 1: hostDirac.Dslash5(hostOut, *spinor, parity); break;
+    case 2: hostDirac.Dslash4pre(hostOut, *spinor, parity); break;
+    case 3: hostDirac.Dslash5inv(hostOut, *spinor, parity); break;
+    case 4: hostDirac.M(hostOut, *spinor); break;
+    case 5: hostDirac.MdagM(hostOut, *spinor); break;
+    }
+  } else {
+    Dirac *hostDirac = Dirac::create(diracParam);
+    switch (test_type) {
+    case 0: hostDirac->Dslash(hostOut, *spinor, parity); break;
+    case 1:
+    case 2: hostDirac->M(hostOut, *spinor); break;
+    case 3:
+    case 4: hostDirac->MdagM(hostOut, *spinor); break;
+    }
+    delete hostDirac;
+  }
+
+  // the host gauge and clover fields are converted from the device precision
+  double deviation = pow(10, -(double)(cpuColorSpinorField::Compare(*spinorRef, hostOut)));
+  double tol = (inv_param.cuda_prec == QUDA_DOUBLE_PRECISION ? 1e-12 :
+		(inv_param.cuda_prec == QUDA_SINGLE_PRECISION ? 1e-3 : 1e-1));
+  ASSERT_LE(deviation, tol) << "CPU reference and host Dslash do not agree";
+}
+
 int main(int argc, char **argv)
 {
   // initalize google test, includes command line options
@@ -0,0 +1,273 @@
+/*
+  Accuracy and bandwidth of the fixed-point storage formats of the
+  native field accessors: half (16-bit) and quarter (8-bit) precision,
+  with complex numbers stored in Cartesian or in polar form.  Each
+  format encodes a double-precision host field through the accessor's
+  save and decodes it through its load, for a Gaussian random spinor
+  and for a random SU(3) gauge field (or the gauge field read from
+  --load-gauge).  We report the relative L2 and the maximum absolute
+  error of the decoded field, and the encode and decode throughput in
+  GB/s of stored data.  A format fails if its relative L2 error exceeds
+  l2_tol, a few times the error seen on an 8^4 lattice.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <color_spinor_field_order.h>
+#include <gauge_field.h>
+#include <gauge_field_order.h>
+#include <thread_pool.h>
+
+#include <test_util.h>
+#include <dslash_util.h>
+#include "misc.h"
+
+#include <qio_field.h>
+
+using namespace quda;
+
+extern int xdim;
+extern int ydim;
+extern int zdim;
+extern int tdim;
+extern int gridsize_from_cmdline[];
+extern char latfile[];
+
+const int niter = 10;
+
+// tolerance on the relative L2 error for the given storage type
+template <typename Float> constexpr double l2_tol() { return sizeof(Float) == 1 ? 2e-2 : 1e-4; }
+
+int printResult(const char *name, int bits, double l2, double max, double tol,
+		double bytes, double encode, double decode) {
+  const bool pass = l2 <= tol;
+  printfQuda("%-28s %3d bits  L2 = %e  max = %e  encode = %6.2f GB/s  decode = %6.2f GB/s  %s\n",
+	     name, bits, l2, max, niter * bytes / encode / 1e9, niter * bytes / decode / 1e9, pass ? "PASSED" : "FAILED");
+  return pass ? 0 : 1;
+}
+
+template <typename Float, bool polar>
+int spinorTest(const char *name, const cpuColorSpinorField &ref) {
+  typedef colorspinor::FloatNOrder<Float, 4, 3, 4, false, polar> Accessor;
+  constexpr int length = 24;
+  const int volumeCB = ref.VolumeCB();
+
+  colorspinor::SpaceSpinorColorOrder<double, 4, 3> in(ref);
+  std::vector<Float> data(static_cast<size_t>(volumeCB) * length);
+  std::vector<float> norm(volumeCB);
+  Accessor out(ref, 1, data.data(), norm.data(), nullptr, true);
+
+  stopwatchStart();
+  for (int i=0; i<niter; i++) {
+    host::parallel_for(volumeCB, [&](int begin, int end) {
+	for (int x=begin; x<end; x++) {
+	  double v[length];
+	  float f[length];
+	  in.load(v, x);
+	  for (int j=0; j<length; j++) f[j] = v[j];
+	  out.save(f, x);
+	}
+      });
+  }
+  double encode = stopwatchReadSeconds();
+
+  std::vector<float> decoded(static_cast<size_t>(volumeCB) * length);
+  stopwatchStart();
+  for (int i=0; i<niter; i++) {
+    host::parallel_for(volumeCB, [&](int begin, int end) {
+	for (int x=begin; x<end; x++) out.load(&decoded[static_cast<size_t>(x) * length], x);
+      });
+  }
+  double decode = stopwatchReadSeconds();
+
+  double diff = 0.0, nrm = 0.0, max = 0.0;
+  for (int x=0; x<volumeCB; x++) {
+    double v[length];
+    in.load(v, x);
+    for (int j=0; j<length; j++) {
+      double d = fabs(decoded[static_cast<size_t>(x) * length + j] - v[j]);
+      diff += d * d;
+      nrm += v[j] * v[j];
+      max = d > max ? d : max;
+    }
+  }
+
+  return printResult(name, 8*sizeof(Float), sqrt(diff / nrm), max, l2_tol<Float>(),
+		     static_cast<double>(volumeCB) * (length * sizeof(Float) + sizeof(float)), encode, decode);
+}
+
+template <typename Float, int N, int recon, bool polar>
+int gaugeTest(const char *name, const cpuGaugeField &ref) {
+  typedef gauge::FloatNOrder<Float, 18, N, recon, QUDA_STAGGERED_PHASE_NO, true, polar> Accessor;
+  constexpr int length = 18;
+  const int volumeCB = ref.VolumeCB();
+
+  gauge::QDPOrder<double, length> in(ref);
+  std::vector<Float> data(ref.Bytes() / sizeof(Float)); // large enough for any packing of the links
+  Accessor out(ref, data.data(), nullptr, true);
+
+  stopwatchStart();
+  for (int i=0; i<niter; i++) {
+    host::parallel_for(2*volumeCB, [&](int begin, int end) {
+	for (int t=begin; t<end; t++) {
+	  const int parity = t / volumeCB, x = t % volumeCB;
+	  for (int d=0; d<4; d++) {
+	    double v[length];
+	    float f[length];
+	    in.load(v, x, d, parity);
+	    for (int j=0; j<length; j++) f[j] = v[j];
+	    out.save(f, x, d, parity);
+	  }
+	}
+      });
+  }
+  double encode = stopwatchReadSeconds();
+
+  std::vector<float> decoded(static_cast<size_t>(2*volumeCB) * 4 * length);
+  stopwatchStart();
+  for (int i=0; i<niter; i++) {
+    host::parallel_for(2*volumeCB, [&](int begin, int end) {
+	for (int t=begin; t<end; t++) {
+	  const int parity = t / volumeCB, x = t % volumeCB;
+	  for (int d=0; d<4; d++) out.load(&decoded[(static_cast<size_t>(t) * 4 + d) * length], x, d, parity);
+	}
+      });
+  }
+  double decode = stopwatchReadSeconds();
+
+  double diff = 0.0, nrm = 0.0, max = 0.0;
+  for (int t=0; t<2*volumeCB; t++) {
+    const int parity = t / volumeCB, x = t % volumeCB;
+    for (int d=0; d<4; d++) {
+      double v[length];
+      in.load(v, x, d, parity);
+      for (int j=0; j<length; j++) {
+	double e = fabs(decoded[(static_cast<size_t>(t) * 4 + d) * length + j] - v[j]);
+	diff += e * e;
+	nrm += v[j] * v[j];
+	max = e > max ? e : max;
+      }
+    }
+  }
+
+  return printResult(name, 8*sizeof(Float), sqrt(diff / nrm), max, l2_tol<Float>(),
+		     static_cast<double>(2*volumeCB) * 4 * recon * sizeof(Float), encode, decode);
+}
+
+// The host f2i and d2i round to nearest, ties to even, as the device
+// versions do, so that a value encoded in half precision on the host
+// is within half a unit of 1/MAX_SHORT and matches the device encoding.
+int roundingTest() {
+  const float value[] = { 0.5f, 1.5f, 2.5f, -0.5f, -1.5f, 2.4f, 2.6f, -2.6f };
+  const int nearest[] = { 0, 2, 2, 0, -2, 2, 3, -3 };
+  int wrong = 0;
+  for (unsigned int i=0; i<sizeof(value)/sizeof(value[0]); i++) {
+    if (f2i(value[i]) != nearest[i]) wrong++;
+    if (d2i(static_cast<double>(value[i])) != nearest[i]) wrong++;
+  }
+
+  double max = 0.0;
+  for (int i=0; i<=10000; i++) {
+    const float v = -1.0f + 2.0f * i / 10000;
+    short s;
+    copy(s, v);
+    const double units = fabs(s2f(s) - v) * MAX_SHORT;
+    max = units > max ? units : max;
+  }
+
+  const bool pass = wrong == 0 && max <= 0.5 + 1e-3;
+  printfQuda("%-28s %d wrong ties, max half-precision error %.3f units  %s\n",
+	     "host rounding", wrong, max, pass ? "PASSED" : "FAILED");
+  return pass ? 0 : 1;
+}
+
+extern void usage(char**);
+
+int main(int argc, char **argv) {
+
+  for (int i=1; i<argc; i++) {
+    if (process_command_line_option(argc, argv, &i) == 0) continue;
+    printf("ERROR: Invalid option:%s\n", argv[i]);
+    usage(argv);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  initRand();
+
+  QudaGaugeParam gauge_param = newQudaGaugeParam();
+  gauge_param.X[0] = xdim;
+  gauge_param.X[1] = ydim;
+  gauge_param.X[2] = zdim;
+  gauge_param.X[3] = tdim;
+  gauge_param.anisotropy = 1.0;
+  gauge_param.type = QUDA_WILSON_LINKS;
+  gauge_param.gauge_order = QUDA_QDP_GAUGE_ORDER;
+  gauge_param.t_boundary = QUDA_PERIODIC_T;
+  gauge_param.cpu_prec = QUDA_DOUBLE_PRECISION;
+  gauge_param.cuda_prec = QUDA_DOUBLE_PRECISION;
+  gauge_param.reconstruct = QUDA_RECONSTRUCT_NO;
+  gauge_param.gauge_fix = QUDA_GAUGE_FIXED_NO;
+  setDims(gauge_param.X);
+
+  void *gauge[4];
+  for (int d=0; d<4; d++) gauge[d] = malloc(V*gaugeSiteSize*sizeof(double));
+  if (strcmp(latfile, "")) {
+    read_gauge_field(latfile, gauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
+  } else {
+    construct_gauge_field(gauge, 1, gauge_param.cpu_prec, &gauge_param);
+  }
+
+  GaugeFieldParam gParam(gauge, gauge_param);
+  gParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  cpuGaugeField u(gParam);
+
+  ColorSpinorParam csParam;
+  csParam.nColor = 3;
+  csParam.nSpin = 4;
+  csParam.nDim = 4;
+  for (int d=0; d<4; d++) csParam.x[d] = gauge_param.X[d];
+  csParam.x[0] /= 2;
+  csParam.precision = QUDA_DOUBLE_PRECISION;
+  csParam.pad = 0;
+  csParam.siteSubset = QUDA_PARITY_SITE_SUBSET;
+  csParam.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  csParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  csParam.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  csParam.create = QUDA_NULL_FIELD_CREATE;
+  cpuColorSpinorField spinor(csParam);
+  spinor.Source(QUDA_RANDOM_SOURCE);
+
+  int fail = 0;
+
+  fail += roundingTest();
+
+  printfQuda("Spinor field (Gaussian random)\n");
+  fail += spinorTest<short, false>("half", spinor);
+  fail += spinorTest<short, true>("half polar", spinor);
+  fail += spinorTest<char, false>("quarter", spinor);
+  fail += spinorTest<char, true>("quarter polar", spinor);
+
+  printfQuda("Gauge field (%s)\n", strcmp(latfile, "") ? latfile : "random SU(3)");
+  fail += gaugeTest<short, 2, 18, false>("half reconstruct-18", u);
+  fail += gaugeTest<short, 2, 18, true>("half polar reconstruct-18", u);
+  fail += gaugeTest<short, 4, 12, false>("half reconstruct-12", u);
+  fail += gaugeTest<short, 4, 12, true>("half polar reconstruct-12", u);
+  fail += gaugeTest<char, 2, 18, false>("quarter reconstruct-18", u);
+  fail += gaugeTest<char, 2, 18, true>("quarter polar reconstruct-18", u);
+  fail += gaugeTest<char, 4, 12, false>("quarter reconstruct-12", u);
+  fail += gaugeTest<char, 4, 12, true>("quarter polar reconstruct-12", u);
+
+  for (int d=0; d<4; d++) free(gauge[d]);
+
+  printfQuda("%s\n", fail ? "FAILED" : "PASSED");
+
+  finalizeComms();
+
+  return fail ? 1 : 0;
+}
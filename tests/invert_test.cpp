@@ -20,6 +20,9 @@
 
 #include <qio_field.h>
 
+#include <vector>
+#include <chrono>
+
 #define MAX(a,b) ((a)>(b)?(a):(b))
 
 // In a typical application, quda.h is the only QUDA header required.
@@ -47,6 +50,8 @@ extern QudaReconstructType link_recon_precondition;
 extern QudaInverterType  inv_type;
 extern QudaInverterType  precon_type;
 extern int multishift; // whether to test multi-shift or standard solver
+extern int propagator; // whether to compare the propagator solver with sequential solves
+extern int Nsrc; // number of sources for the propagator solver
 extern double mass; // mass of Dirac operator
 extern double mu;
 extern double anisotropy; // temporal anisotropy
@@ -667,6 +672,76 @@ int main(int argc, char **argv)
 
   }
 
+  // solve Nsrc sources with the propagator solver and again one at a
+  // time with invertQuda, and compare the solutions and the worst
+  // true residuals
+  int fail = 0;
+  if (propagator) {
+    if (multishift) errorQuda("Propagator test not supported with multi-shift solves");
+
+    const size_t spinor_bytes = V*spinorSiteSize*sSize*inv_param.Ls;
+    const int len = (inv_param.solution_type == QUDA_MAT_SOLUTION ? V : Vh)*spinorSiteSize*inv_param.Ls;
+    std::vector<void*> src(Nsrc), x_prop(Nsrc), x_seq(Nsrc);
+    for (int i=0; i<Nsrc; i++) {
+      src[i] = malloc(spinor_bytes);
+      x_prop[i] = malloc(spinor_bytes);
+      x_seq[i] = malloc(spinor_bytes);
+      memset(x_prop[i], 0, spinor_bytes);
+      memset(x_seq[i], 0, spinor_bytes);
+      if (inv_param.cpu_prec == QUDA_SINGLE_PRECISION) {
+	for (int j=0; j<inv_param.Ls*V*spinorSiteSize; j++) ((float*)src[i])[j] = rand() / (float)RAND_MAX;
+      } else {
+	for (int j=0; j<inv_param.Ls*V*spinorSiteSize; j++) ((double*)src[i])[j] = rand() / (double)RAND_MAX;
+      }
+    }
+
+    QudaInvertParam prop_param = inv_param;
+    auto start = std::chrono::high_resolution_clock::now();
+    invertPropagatorQuda(x_prop.data(), src.data(), Nsrc, &prop_param);
+    double prop_secs = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    double seq_true_res = 0.0;
+    int seq_iter = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i=0; i<Nsrc; i++) {
+      QudaInvertParam seq_param = inv_param;
+      invertQuda(x_seq[i], src[i], &seq_param);
+      seq_true_res = MAX(seq_true_res, seq_param.true_res);
+      seq_iter += seq_param.iter;
+    }
+    double seq_secs = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    // largest relative deviation of the propagator solutions from the sequential ones
+    double deviation = 0.0;
+    for (int i=0; i<Nsrc; i++) {
+      double x2 = norm_2(x_seq[i], len, inv_param.cpu_prec);
+      mxpy(x_seq[i], x_prop[i], len, inv_param.cpu_prec);
+      deviation = MAX(deviation, sqrt(norm_2(x_prop[i], len, inv_param.cpu_prec) / x2));
+    }
+
+    printfQuda("Propagator: %d sources, %d iter / %g secs; sequential: %d iter / %g secs; speedup %.2f\n",
+	       Nsrc, prop_param.iter, prop_secs, seq_iter, seq_secs, seq_secs / prop_secs);
+    printfQuda("Worst true residual: tol %g, propagator = %g, sequential = %g; largest solution deviation = %g\n",
+	       inv_param.tol, prop_param.true_res, seq_true_res, deviation);
+
+    // the two paths run the same solver on the same sources, so they agree up to reduction order
+    if (prop_param.true_res > 1.5 * MAX(seq_true_res, inv_param.tol)) {
+      printfQuda("Propagator worst true residual %g exceeds the sequential one %g\n", prop_param.true_res, seq_true_res);
+      fail++;
+    }
+    if (deviation > 100 * inv_param.tol) {
+      printfQuda("Propagator solutions deviate by %g from the sequential ones\n", deviation);
+      fail++;
+    }
+    printfQuda("Propagator test %s\n", fail ? "FAILED" : "passed");
+
+    for (int i=0; i<Nsrc; i++) {
+      free(src[i]);
+      free(x_prop[i]);
+      free(x_seq[i]);
+    }
+  }
+
   freeGaugeQuda();
   if (dslash_type == QUDA_CLOVER_WILSON_DSLASH || dslash_type == QUDA_TWISTED_CLOVER_DSLASH) freeCloverQuda();
   
@@ -682,5 +757,5 @@ int main(int argc, char **argv)
 
   for (int dir = 0; dir<4; dir++) free(gauge[dir]);
 
-  return 0;
+  return fail;
 }
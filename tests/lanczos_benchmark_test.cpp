@@ -0,0 +1,262 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+
+#include <test_util.h>
+#include <misc.h>
+
+#include <dirac_quda.h>
+#include <lanczos_quda.h>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+// Benchmark of the thick-restart Lanczos eigensolver.  The operator
+// is MdagM of a random coarse-grid operator, so no gauge
+// configuration is required.  The Krylov space and the operator live
+// on the device: the block orthogonalization goes through the
+// multi-blas kernels, which have no host implementation, so this
+// benchmark is not part of the QUDA_HOST_ONLY build.
+
+extern int device;
+extern int xdim;
+extern int ydim;
+extern int zdim;
+extern int tdim;
+extern int gridsize_from_cmdline[];
+extern int niter;
+extern int nvec[];
+extern int nev;
+extern int max_search_dim;
+extern double tol;
+extern QudaPrecision prec;
+
+extern void usage(char** );
+
+using namespace quda;
+
+std::vector<ColorSpinorField*> kSpace;
+cpuGaugeField *Y_h, *X_h, *Xinv_h, *Yhat_h;
+cudaGaugeField *Y_d, *X_d, *Xinv_d, *Yhat_d;
+
+int Nspin;
+int Ncolor;
+
+void
+display_test_info()
+{
+  printfQuda("running the following test:\n");
+  printfQuda("prec    S_dimension T_dimension Nspin Ncolor nEv nKr\n");
+  printfQuda("%6s   %3d /%3d / %3d   %3d      %d     %d   %d   %d\n", get_prec_str(prec), xdim, ydim, zdim, tdim, Nspin, Ncolor, nev, max_search_dim);
+  printfQuda("Grid partition info:     X  Y  Z  T\n");
+  printfQuda("                         %d  %d  %d  %d\n",
+	     dimPartitioned(0),
+	     dimPartitioned(1),
+	     dimPartitioned(2),
+	     dimPartitioned(3));
+  return;
+}
+
+void initFields()
+{
+  ColorSpinorParam param;
+  param.nColor = Ncolor;
+  param.nSpin = Nspin;
+  param.nDim = 4;
+
+  param.pad = 0;
+  param.siteSubset = QUDA_FULL_SITE_SUBSET;
+  param.x[0] = xdim;
+  param.x[1] = ydim;
+  param.x[2] = zdim;
+  param.x[3] = tdim;
+  param.PCtype = QUDA_4D_PC;
+
+  param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  param.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  param.precision = prec;
+  param.fieldOrder = QUDA_FLOAT2_FIELD_ORDER;
+  param.create = QUDA_ZERO_FIELD_CREATE;
+
+  // the Krylov space lives on the device since the block
+  // orthogonalization uses the multi-blas kernels
+  kSpace.resize(max_search_dim+1);
+  for (auto &v : kSpace) v = new cudaColorSpinorField(param);
+
+  // check for successful allocation
+  checkCudaError();
+
+  GaugeFieldParam gParam;
+  gParam.x[0] = xdim;
+  gParam.x[1] = ydim;
+  gParam.x[2] = zdim;
+  gParam.x[3] = tdim;
+  gParam.nColor = param.nColor*param.nSpin;
+  gParam.reconstruct = QUDA_RECONSTRUCT_NO;
+  gParam.order = QUDA_QDP_GAUGE_ORDER;
+  gParam.link_type = QUDA_COARSE_LINKS;
+  gParam.t_boundary = QUDA_PERIODIC_T;
+  gParam.create = QUDA_ZERO_FIELD_CREATE;
+  gParam.precision = QUDA_DOUBLE_PRECISION;
+  gParam.nDim = 4;
+  gParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+  gParam.nFace = 1;
+
+  gParam.geometry = QUDA_COARSE_GEOMETRY;
+  Y_h = new cpuGaugeField(gParam);
+  Yhat_h = new cpuGaugeField(gParam);
+
+  gParam.geometry = QUDA_SCALAR_GEOMETRY;
+  gParam.nFace = 0;
+  X_h = new cpuGaugeField(gParam);
+  Xinv_h = new cpuGaugeField(gParam);
+
+  // random hopping terms and a diagonally dominant site term
+  std::mt19937 rng(1234 + comm_rank());
+  std::normal_distribution<double> gauss(0.0, 1.0);
+  const int n = gParam.nColor;
+  const double scale = 0.5 / n;
+
+  for (int d = 0; d < 2*gParam.nDim; d++) {
+    double *y = static_cast<double**>(Y_h->Gauge_p())[d];
+    for (int i = 0; i < Y_h->Volume()*n*n*2; i++) y[i] = scale * gauss(rng);
+  }
+
+  double *x = static_cast<double**>(X_h->Gauge_p())[0];
+  for (int s = 0; s < X_h->Volume(); s++) {
+    for (int i = 0; i < n*n*2; i++) x[(s*n*n)*2 + i] = scale * gauss(rng);
+    for (int i = 0; i < n; i++) x[(s*n*n + i*n + i)*2] += 4.0;
+  }
+
+  Y_h->exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+
+  gParam.precision = prec;
+  gParam.order = QUDA_FLOAT2_GAUGE_ORDER;
+  gParam.geometry = QUDA_COARSE_GEOMETRY;
+  gParam.nFace = 1;
+  int pad = std::max( { (gParam.x[0]*gParam.x[1]*gParam.x[2])/2,
+	(gParam.x[1]*gParam.x[2]*gParam.x[3])/2,
+	(gParam.x[0]*gParam.x[2]*gParam.x[3])/2,
+	(gParam.x[0]*gParam.x[1]*gParam.x[3])/2 } );
+  gParam.pad = gParam.nFace * pad * 2;
+  Y_d = new cudaGaugeField(gParam);
+  Yhat_d = new cudaGaugeField(gParam);
+  Y_d->copy(*Y_h);
+  Yhat_d->copy(*Yhat_h);
+
+  gParam.geometry = QUDA_SCALAR_GEOMETRY;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  gParam.nFace = 0;
+  X_d = new cudaGaugeField(gParam);
+  Xinv_d = new cudaGaugeField(gParam);
+  X_d->copy(*X_h);
+  Xinv_d->copy(*Xinv_h);
+}
+
+void freeFields()
+{
+  for (auto &v : kSpace) delete v;
+  kSpace.clear();
+
+  delete Y_h;
+  delete X_h;
+  delete Xinv_h;
+  delete Yhat_h;
+
+  delete Y_d;
+  delete X_d;
+  delete Xinv_d;
+  delete Yhat_d;
+}
+
+// estimate the largest eigenvalue of the operator with a few power iterations
+double powerIteration(const DiracMatrix &mat, ColorSpinorField &x, ColorSpinorField &y, int n)
+{
+  x.Source(QUDA_RANDOM_SOURCE);
+  double lambda = 0.0;
+  for (int i = 0; i < n; i++) {
+    blas::ax(1.0/sqrt(blas::norm2(x)), x);
+    mat(y, x);
+    lambda = blas::reDotProduct(x, y);
+    blas::copy(x, y);
+  }
+  return lambda;
+}
+
+double benchmark(const DiracMatrix &mat, QudaEigParam &eig_param, std::vector<double> &evals, int &nconv)
+{
+  TimeProfile profile("TRLanczos");
+  kSpace[0]->Source(QUDA_RANDOM_SOURCE);
+
+  stopwatchStart();
+  TRLanczos eig_solve(mat, eig_param, profile, nev);
+  nconv = eig_solve(kSpace, evals.data());
+  return stopwatchReadSeconds();
+}
+
+int main(int argc, char** argv)
+{
+  nev = 16;
+  for (int i = 1; i < argc; i++){
+    if(process_command_line_option(argc, argv, &i) == 0){
+      continue;
+    }
+    printfQuda("ERROR: Invalid option:%s\n", argv[i]);
+    usage(argv);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+
+  Nspin = 2;
+  Ncolor = nvec[0] > 0 ? nvec[0] : 24;
+  if (max_search_dim < nev + 2) max_search_dim = 2*nev;
+
+  display_test_info();
+  initQuda(device);
+
+  setVerbosity(QUDA_SUMMARIZE);
+
+  initFields();
+
+  DiracParam param;
+  param.kappa = 1.0;
+  DiracCoarse dirac(param, Y_h, X_h, Xinv_h, Yhat_h, Y_d, X_d, Xinv_d, Yhat_d);
+  DiracMdagM mat(dirac);
+
+  QudaEigParam eig_param = newQudaEigParam();
+  eig_param.nKr = max_search_dim;
+  eig_param.max_restarts = niter;
+  eig_param.Stp_residual = tol;
+  eig_param.NPoly = 0;
+
+  std::vector<double> evals(nev);
+  int nconv = 0;
+
+  dirac.Flops(); // reset flops counter
+  double secs = benchmark(mat, eig_param, evals, nconv);
+  double gflops = (dirac.Flops()*1e-9)/secs;
+  printfQuda("Plain Lanczos      : %d / %d converged, time = %6.2f s, operator Gflop/s = %6.2f\n", nconv, nev, secs, gflops);
+
+  // Chebyshev acceleration: suppress [1.2 * lambda_nEv, 1.1 * lambda_max]
+  double a_max = 1.1 * powerIteration(mat, *kSpace[0], *kSpace[1], 20);
+  double poly_param[2] = { 1.2 * evals[nev-1], a_max };
+  eig_param.NPoly = 8;
+  eig_param.MatPoly_param = poly_param;
+
+  dirac.Flops(); // reset flops counter
+  secs = benchmark(mat, eig_param, evals, nconv);
+  gflops = (dirac.Flops()*1e-9)/secs;
+  printfQuda("Chebyshev (deg %2d) : %d / %d converged, time = %6.2f s, operator Gflop/s = %6.2f\n",
+	     eig_param.NPoly, nconv, nev, secs, gflops);
+
+  freeFields();
+
+  endQuda();
+
+  finalizeComms();
+}
@@ -0,0 +1,396 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include <quda_internal.h>
+#include <gauge_field.h>
+#include <multigrid.h>
+#include <unitarization_links.h>
+
+#include <test_util.h>
+#include <misc.h>
+#include <qio_field.h>
+
+#include <quda.h>
+
+// Benchmark of a full multigrid hierarchy on the device.  The
+// hierarchy is built over the Wilson or clover operator of the gauge
+// field given with --load-gauge, or else of a weak field (the unit
+// field plus noise, unitarized), and --nsrc GCR solves preconditioned
+// with it are run.  The time of each setup and V-cycle component on
+// each level (see quda::MGComponent) is printed as one JSON object per
+// line, in the format of the mg_* records of quda_cpu_bench, so that
+// runs can be compared across commits and with the host hierarchy.
+// Profiling of the components is enabled here by setting
+// QUDA_ENABLE_MG_PROFILE=1.
+
+extern QudaDslashType dslash_type;
+extern int device;
+extern int xdim;
+extern int ydim;
+extern int zdim;
+extern int tdim;
+extern int gridsize_from_cmdline[];
+extern QudaReconstructType link_recon;
+extern QudaPrecision prec;
+extern QudaPrecision prec_sloppy;
+extern QudaPrecision prec_precondition;
+extern double mass;
+extern double tol;
+extern double tol_hq;
+extern char latfile[];
+extern int niter;
+extern int Nsrc;
+extern int gcrNkrylov;
+extern int nvec[];
+extern int mg_levels;
+extern int nu_pre;
+extern int nu_post;
+extern int geo_block_size[QUDA_MAX_MG_LEVEL][QUDA_MAX_DIM];
+extern double mu_factor[QUDA_MAX_MG_LEVEL];
+extern QudaVerbosity mg_verbosity[QUDA_MAX_MG_LEVEL];
+extern QudaInverterType setup_inv[QUDA_MAX_MG_LEVEL];
+extern double setup_tol;
+extern double omega;
+extern QudaInverterType smoother_type;
+extern QudaMatPCType matpc_type;
+extern double clover_coeff;
+
+extern void usage(char** );
+
+void
+display_test_info()
+{
+  printfQuda("running the following test:\n");
+  printfQuda("prec    sloppy_prec    precondition_prec  S_dimension T_dimension\n");
+  printfQuda("%s   %s             %s                 %d/%d/%d          %d\n",
+	     get_prec_str(prec), get_prec_str(prec_sloppy), get_prec_str(prec_precondition),
+	     xdim, ydim, zdim, tdim);
+  printfQuda("MG parameters\n");
+  printfQuda(" - number of levels %d\n", mg_levels);
+  for (int i=0; i<mg_levels-1; i++) printfQuda(" - level %d number of null-space vectors %d\n", i+1, nvec[i]);
+  printfQuda(" - number of pre-smoother applications %d\n", nu_pre);
+  printfQuda(" - number of post-smoother applications %d\n", nu_post);
+  printfQuda("Grid partition info:     X  Y  Z  T\n");
+  printfQuda("                         %d  %d  %d  %d\n",
+	     dimPartitioned(0),
+	     dimPartitioned(1),
+	     dimPartitioned(2),
+	     dimPartitioned(3));
+  return;
+}
+
+void setGaugeParam(QudaGaugeParam &gauge_param) {
+  gauge_param.X[0] = xdim;
+  gauge_param.X[1] = ydim;
+  gauge_param.X[2] = zdim;
+  gauge_param.X[3] = tdim;
+
+  gauge_param.anisotropy = 1.0;
+  gauge_param.type = QUDA_WILSON_LINKS;
+  gauge_param.gauge_order = QUDA_QDP_GAUGE_ORDER;
+  gauge_param.t_boundary = QUDA_PERIODIC_T;
+
+  gauge_param.cpu_prec = QUDA_DOUBLE_PRECISION;
+  gauge_param.cuda_prec = prec;
+  gauge_param.reconstruct = link_recon;
+  gauge_param.cuda_prec_sloppy = prec_sloppy;
+  gauge_param.reconstruct_sloppy = link_recon;
+  gauge_param.cuda_prec_precondition = prec_precondition;
+  gauge_param.reconstruct_precondition = link_recon;
+  gauge_param.gauge_fix = QUDA_GAUGE_FIXED_NO;
+
+  gauge_param.ga_pad = 0;
+#ifdef MULTI_GPU
+  int pad_size = 0;
+  for (int mu=0; mu<4; mu++) {
+    int face_size = 1;
+    for (int nu=0; nu<4; nu++) if (nu != mu) face_size *= gauge_param.X[nu];
+    if (face_size/2 > pad_size) pad_size = face_size/2;
+  }
+  gauge_param.ga_pad = pad_size;
+#endif
+}
+
+void setInvertParam(QudaInvertParam &inv_param) {
+  inv_param.Ls = 1;
+  inv_param.sp_pad = 0;
+  inv_param.cl_pad = 0;
+
+  inv_param.cpu_prec = QUDA_DOUBLE_PRECISION;
+  inv_param.cuda_prec = prec;
+  inv_param.cuda_prec_sloppy = prec_sloppy;
+  inv_param.cuda_prec_precondition = prec_precondition;
+  inv_param.preserve_source = QUDA_PRESERVE_SOURCE_NO;
+  inv_param.gamma_basis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  inv_param.dirac_order = QUDA_DIRAC_ORDER;
+
+  if (dslash_type == QUDA_CLOVER_WILSON_DSLASH) {
+    inv_param.clover_cpu_prec = QUDA_DOUBLE_PRECISION;
+    inv_param.clover_cuda_prec = prec;
+    inv_param.clover_cuda_prec_sloppy = prec_sloppy;
+    inv_param.clover_cuda_prec_precondition = prec_precondition;
+    inv_param.clover_order = QUDA_PACKED_CLOVER_ORDER;
+    inv_param.clover_coeff = clover_coeff;
+  }
+
+  inv_param.input_location = QUDA_CPU_FIELD_LOCATION;
+  inv_param.output_location = QUDA_CPU_FIELD_LOCATION;
+
+  inv_param.dslash_type = dslash_type;
+  inv_param.mass = mass;
+  inv_param.kappa = 1.0 / (2.0 * (4.0 + mass));
+
+  inv_param.dagger = QUDA_DAG_NO;
+  inv_param.mass_normalization = QUDA_KAPPA_NORMALIZATION;
+  inv_param.matpc_type = matpc_type;
+  inv_param.solution_type = QUDA_MAT_SOLUTION;
+  inv_param.solve_type = QUDA_DIRECT_SOLVE;
+
+  inv_param.inv_type = QUDA_GCR_INVERTER;
+  inv_param.inv_type_precondition = QUDA_MG_INVERTER;
+  inv_param.gcrNkrylov = gcrNkrylov;
+  inv_param.tol = tol;
+  inv_param.residual_type = QUDA_L2_RELATIVE_RESIDUAL;
+  inv_param.maxiter = niter;
+  inv_param.reliable_delta = 1e-4;
+
+  inv_param.schwarz_type = QUDA_ADDITIVE_SCHWARZ;
+  inv_param.precondition_cycle = 1;
+  inv_param.tol_precondition = 1e-1;
+  inv_param.maxiter_precondition = 1;
+  inv_param.omega = 1.0;
+
+  inv_param.verbosity = QUDA_SUMMARIZE;
+  inv_param.verbosity_precondition = mg_verbosity[0];
+}
+
+void setMultigridParam(QudaMultigridParam &mg_param) {
+  QudaInvertParam &inv_param = *mg_param.invert_param;
+  setInvertParam(inv_param);
+
+  // these need to be set for now but are ignored by the MG setup
+  inv_param.inv_type_precondition = QUDA_INVALID_INVERTER;
+  inv_param.tol = 1e-10;
+  inv_param.maxiter = 1000;
+  inv_param.reliable_delta = 1e-10;
+  inv_param.gcrNkrylov = 10;
+  inv_param.verbosity_precondition = QUDA_SUMMARIZE;
+
+  mg_param.n_level = mg_levels;
+  for (int i=0; i<mg_param.n_level; i++) {
+    for (int j=0; j<QUDA_MAX_DIM; j++) mg_param.geo_block_size[i][j] = geo_block_size[i][j] ? geo_block_size[i][j] : 4;
+    mg_param.verbosity[i] = mg_verbosity[i];
+    mg_param.setup_inv_type[i] = setup_inv[i];
+    mg_param.setup_tol[i] = setup_tol;
+    mg_param.spin_block_size[i] = 1;
+    mg_param.n_vec[i] = nvec[i] == 0 ? 24 : nvec[i];
+    mg_param.nu_pre[i] = nu_pre;
+    mg_param.nu_post[i] = nu_post;
+    mg_param.mu_factor[i] = mu_factor[i];
+    mg_param.cycle_type[i] = QUDA_MG_CYCLE_RECURSIVE;
+    mg_param.smoother[i] = smoother_type;
+    mg_param.smoother_tol[i] = tol_hq; // repurpose heavy-quark tolerance as in multigrid_invert_test
+    mg_param.global_reduction[i] = QUDA_BOOLEAN_YES;
+    mg_param.smoother_solve_type[i] = QUDA_DIRECT_PC_SOLVE;
+    mg_param.coarse_grid_solution_type[i] = QUDA_MAT_SOLUTION;
+    mg_param.omega[i] = omega;
+    mg_param.location[i] = QUDA_CUDA_FIELD_LOCATION;
+  }
+
+  // only coarsen the spin on the first restriction, and solve the coarsest grid with GCR
+  mg_param.spin_block_size[0] = 2;
+  mg_param.smoother[mg_levels-1] = QUDA_GCR_INVERTER;
+
+  mg_param.compute_null_vector = QUDA_COMPUTE_NULL_VECTOR_YES;
+  mg_param.generate_all_levels = QUDA_BOOLEAN_YES;
+  mg_param.run_verify = QUDA_BOOLEAN_NO;
+  strcpy(mg_param.vec_infile, "");
+  strcpy(mg_param.vec_outfile, "");
+}
+
+/**
+   Replace the gauge field with a weak field, the unit field with
+   Gaussian noise on every link projected back onto U(3), on which
+   multigrid is effective
+ */
+void weakField(void **gauge, QudaGaugeParam &gauge_param) {
+  construct_gauge_field(gauge, 0, gauge_param.cpu_prec, &gauge_param);
+
+  quda::GaugeFieldParam gParam(gauge, gauge_param);
+  gParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  quda::cpuGaugeField in(gParam);
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  quda::cpuGaugeField out(gParam);
+
+  std::mt19937 rng(1234 + comm_rank());
+  std::normal_distribution<double> noise(0.0, 0.1);
+  const size_t n = in.Volume() * gaugeSiteSize;
+  for (int d=0; d<4; d++) for (size_t i=0; i<n; i++) ((double*)gauge[d])[i] += noise(rng);
+
+  int fails = quda::unitarizeLinksHost(out, in, 1e-14, 1e-10, true, false, 1e-6, 1e-6);
+  if (fails) warningQuda("Unitarization failed for %d links", fails);
+  for (int d=0; d<4; d++) memcpy(gauge[d], ((void**)out.Gauge_p())[d], n * sizeof(double));
+}
+
+/**
+   Print the time of one component on one level as a JSON object
+   @param phase "setup" or "vcycle"
+   @param component Component name
+   @param level Level of the hierarchy, zero being the finest
+   @param volume Number of lattice sites of the level
+   @param timer The component timer
+ */
+void reportLevel(const char *phase, const char *component, int level, long volume, const quda::Timer &timer) {
+  if (comm_rank() != 0) return;
+  printf("{\"kernel\": \"mg_%s\", \"level\": %d, \"component\": \"%s\", \"precision\": \"%s\", \"volume\": %ld, "
+	 "\"niter\": %d, \"seconds\": %e, \"total_seconds\": %e}\n",
+	 phase, level, component, get_prec_str(prec_precondition), volume, timer.count,
+	 timer.count ? timer.time / timer.count : 0.0, timer.time);
+  fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+  for (int i=0; i<QUDA_MAX_MG_LEVEL; i++) {
+    mg_verbosity[i] = QUDA_SILENT;
+    setup_inv[i] = QUDA_BICGSTAB_INVERTER;
+    mu_factor[i] = 1.;
+  }
+
+  for (int i = 1; i < argc; i++){
+    if(process_command_line_option(argc, argv, &i) == 0){
+      continue;
+    }
+    printfQuda("ERROR: Invalid option:%s\n", argv[i]);
+    usage(argv);
+  }
+
+  if (prec_sloppy == QUDA_INVALID_PRECISION) prec_sloppy = prec;
+  if (prec_precondition == QUDA_INVALID_PRECISION) prec_precondition = prec_sloppy;
+
+  if (dslash_type != QUDA_WILSON_DSLASH && dslash_type != QUDA_CLOVER_WILSON_DSLASH) {
+    printfQuda("dslash_type %d not supported\n", dslash_type);
+    exit(0);
+  }
+
+  // the component timers are only kept when profiling is enabled
+  setenv("QUDA_ENABLE_MG_PROFILE", "1", 1);
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  initRand();
+
+  display_test_info();
+
+  QudaGaugeParam gauge_param = newQudaGaugeParam();
+  setGaugeParam(gauge_param);
+
+  QudaInvertParam mg_inv_param = newQudaInvertParam();
+  QudaMultigridParam mg_param = newQudaMultigridParam();
+  mg_param.invert_param = &mg_inv_param;
+  setMultigridParam(mg_param);
+
+  QudaInvertParam inv_param = newQudaInvertParam();
+  setInvertParam(inv_param);
+
+  setDims(gauge_param.X);
+  setSpinorSiteSize(24);
+
+  void *gauge[4], *clover = nullptr;
+  for (int dir = 0; dir < 4; dir++) gauge[dir] = malloc(V*gaugeSiteSize*sizeof(double));
+
+  if (strcmp(latfile,"")) {
+    read_gauge_field(latfile, gauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
+    construct_gauge_field(gauge, 2, gauge_param.cpu_prec, &gauge_param);
+  } else {
+    weakField(gauge, gauge_param);
+  }
+
+  void *spinorIn = malloc(V*spinorSiteSize*sizeof(double));
+  void *spinorOut = malloc(V*spinorSiteSize*sizeof(double));
+
+  initQuda(device);
+
+  loadGaugeQuda(gauge, &gauge_param);
+
+  if (dslash_type == QUDA_CLOVER_WILSON_DSLASH) {
+    clover = malloc(V*cloverSiteSize*sizeof(double));
+    inv_param.compute_clover = 1;
+    inv_param.compute_clover_inverse = 1;
+    // the clover inverse is needed by the even-odd preconditioned smoother
+    inv_param.solve_type = QUDA_DIRECT_PC_SOLVE;
+    loadCloverQuda(clover, nullptr, &inv_param);
+    inv_param.solve_type = QUDA_DIRECT_SOLVE;
+  }
+
+  void *mg_preconditioner = newMultigridQuda(&mg_param);
+  inv_param.preconditioner = mg_preconditioner;
+  quda::MG *mg = static_cast<quda::multigrid_solver*>(mg_preconditioner)->mg;
+
+  // the V-cycle timers are reset by each solve, so accumulate them here (they are zero after the setup)
+  std::vector<std::vector<quda::Timer> > timers;
+  mg->componentTimers(timers);
+  std::vector<std::vector<quda::Timer> > vcycle = timers;
+
+  double secs = 0.0, gflops = 0.0, true_res = 0.0;
+  int iter = 0;
+  for (int k=0; k<Nsrc; k++) {
+    for (int i=0; i<V*spinorSiteSize; i++) ((double*)spinorIn)[i] = rand() / (double)RAND_MAX;
+    memset(spinorOut, 0, V*spinorSiteSize*sizeof(double));
+    invertQuda(spinorOut, spinorIn, &inv_param);
+    secs += inv_param.secs;
+    gflops += inv_param.gflops;
+    iter += inv_param.iter;
+    true_res = std::max(true_res, inv_param.true_res);
+
+    std::vector<std::vector<quda::Timer> > solve;
+    mg->componentTimers(solve);
+    for (unsigned int l=0; l<solve.size(); l++) {
+      for (int c=quda::MG_COMPONENT_SMOOTHER; c<quda::MG_COMPONENT_COUNT; c++) {
+	vcycle[l][c].time += solve[l][c].time;
+	vcycle[l][c].count += solve[l][c].count;
+      }
+    }
+  }
+
+  long volume = V;
+  for (unsigned int l=0; l<timers.size(); l++) {
+    for (int c=0; c<quda::MG_COMPONENT_COUNT; c++) {
+      const char *name = quda::getMGComponentName(static_cast<quda::MGComponent>(c));
+      if (c < quda::MG_COMPONENT_SMOOTHER) {
+	if (timers[l][c].count) reportLevel("setup", name, l, volume, timers[l][c]);
+      } else if (vcycle[l][c].count) {
+	reportLevel("vcycle", name, l, volume, vcycle[l][c]);
+      }
+    }
+    for (int d=0; d<4; d++) volume /= mg_param.geo_block_size[l][d];
+  }
+
+  if (comm_rank() == 0) {
+    printf("{\"kernel\": \"mg_solve\", \"precision\": \"%s\", \"volume\": %d, \"niter\": %d, \"iter\": %d, "
+	   "\"seconds\": %e, \"gflops\": %.3f, \"residual\": %e}\n",
+	   get_prec_str(prec), V, Nsrc, iter, Nsrc ? secs / Nsrc : 0.0, secs > 0.0 ? gflops / secs : 0.0, true_res);
+    fflush(stdout);
+  }
+
+  destroyMultigridQuda(mg_preconditioner);
+
+  freeGaugeQuda();
+  if (dslash_type == QUDA_CLOVER_WILSON_DSLASH) freeCloverQuda();
+  endQuda();
+
+  for (int dir = 0; dir < 4; dir++) free(gauge[dir]);
+  if (clover) free(clover);
+  free(spinorIn);
+  free(spinorOut);
+
+  finalizeComms();
+
+  return 0;
+}
@@ -586,5 +586,6 @@ int main(int argc, char **argv)
 
   for (int dir = 0; dir<4; dir++) free(gauge[dir]);
 
-  return 0;
+  // allow for some loss against the host residual from the sloppy precisions
+  return l2r < 10*inv_param.tol ? 0 : 1;
 }
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 #include <iostream>
 
 #include <quda_internal.h>
@@ -191,6 +192,117 @@ void packTest() {
 
 }
 
+/**
+   Relative L2 difference of two host buffers of n reals
+ */
+template <typename Float>
+double bufferDeviation(const void *a_, const void *b_, size_t n) {
+  const Float *a = static_cast<const Float*>(a_), *b = static_cast<const Float*>(b_);
+  double a2 = 0.0, d2 = 0.0;
+  for (size_t i=0; i<n; i++) {
+    a2 += (double)a[i] * a[i];
+    d2 += ((double)a[i] - b[i]) * ((double)a[i] - b[i]);
+  }
+  return a2 > 0.0 ? sqrt(d2 / a2) : sqrt(d2);
+}
+
+double bufferDeviation(const void *a, const void *b, size_t n, QudaPrecision precision) {
+  return precision == QUDA_DOUBLE_PRECISION ? bufferDeviation<double>(a, b, n) : bufferDeviation<float>(a, b, n);
+}
+
+/**
+   Check the host reorder engine used when sending spinors to and
+   receiving them from the GPU against the generic accessor path, for
+   each host order, device order and pair of gamma bases, and report
+   the throughput of the send and receive reorders.
+   @return The number of failed checks
+ */
+int reorderTest() {
+
+  const QudaFieldOrder host_order[] = { QUDA_SPACE_SPIN_COLOR_FIELD_ORDER, QUDA_SPACE_COLOR_SPIN_FIELD_ORDER };
+  const QudaFieldOrder device_order[] = { QUDA_FLOAT2_FIELD_ORDER, QUDA_FLOAT4_FIELD_ORDER };
+  // host basis, device basis
+  const QudaGammaBasis basis[][2] = { { QUDA_DEGRAND_ROSSI_GAMMA_BASIS, QUDA_UKQCD_GAMMA_BASIS },
+				      { QUDA_CHIRAL_GAMMA_BASIS, QUDA_UKQCD_GAMMA_BASIS },
+				      { QUDA_DEGRAND_ROSSI_GAMMA_BASIS, QUDA_DEGRAND_ROSSI_GAMMA_BASIS } };
+  const int niter = 10;
+  const double tol = (prec == QUDA_DOUBLE_PRECISION && prec_cpu == QUDA_DOUBLE_PRECISION) ? 1e-14 : 1e-6;
+
+  printf("\nHost reorder (host %d-byte <-> device %d-byte), deviation from the accessor path and round trip:\n",
+	 prec_cpu, prec);
+
+  int fail = 0;
+  for (int h=0; h<2; h++) {
+    for (int b=0; b<3; b++) {
+      ColorSpinorParam hostParam(csParam);
+      hostParam.setPrecision(prec_cpu);
+      hostParam.pad = 0;
+      hostParam.fieldOrder = host_order[h];
+      hostParam.gammaBasis = basis[b][0];
+      hostParam.create = QUDA_NULL_FIELD_CREATE;
+      cpuColorSpinorField hostSpinor(hostParam);
+      cpuColorSpinorField hostSpinor2(hostParam);
+      hostSpinor.Source(QUDA_RANDOM_SOURCE);
+
+      for (int d=0; d<2; d++) {
+	if (device_order[d] == QUDA_FLOAT4_FIELD_ORDER && prec == QUDA_DOUBLE_PRECISION) continue;
+	ColorSpinorParam deviceParam(csParam);
+	deviceParam.setPrecision(prec);
+	deviceParam.fieldOrder = device_order[d];
+	deviceParam.gammaBasis = basis[b][1];
+	deviceParam.pad = 0; // so that the whole buffer is compared
+	deviceParam.create = QUDA_NULL_FIELD_CREATE;
+	cudaColorSpinorField deviceSpinor(deviceParam);
+
+	if (!hostCopyColorSpinorSupported(deviceSpinor, hostSpinor)) {
+	  printf("host order %d basis %d <-> device order %d basis %d: not supported by the host engine\n",
+		 host_order[h], basis[b][0], device_order[d], basis[b][1]);
+	  continue;
+	}
+
+	// the reorder is into a host buffer of the device layout, as done by the field copy
+	const size_t bytes = deviceSpinor.Bytes() + deviceSpinor.NormBytes();
+	void *buffer = pool_pinned_malloc(bytes);
+	void *reference = pool_pinned_malloc(bytes);
+	void *bufferNorm = static_cast<char*>(buffer) + deviceSpinor.Bytes();
+	const double GB = (double)(hostSpinor.Bytes() + bytes) * niter / 1e9;
+
+	copyColorSpinorHost(deviceSpinor, hostSpinor, buffer, 0);
+	copyGenericColorSpinorAccessor(deviceSpinor, hostSpinor, QUDA_CPU_FIELD_LOCATION, reference, 0);
+	const double send_dev = bufferDeviation(reference, buffer, deviceSpinor.Bytes() / prec, prec);
+
+	copyColorSpinorHost(hostSpinor2, deviceSpinor, 0, buffer);
+	const double trip_dev = bufferDeviation(hostSpinor.V(), hostSpinor2.V(), hostSpinor.Bytes() / prec_cpu, prec_cpu);
+
+	copyGenericColorSpinorAccessor(hostSpinor, deviceSpinor, QUDA_CPU_FIELD_LOCATION, 0, buffer);
+	const double recv_dev = bufferDeviation(hostSpinor.V(), hostSpinor2.V(), hostSpinor.Bytes() / prec_cpu, prec_cpu);
+
+	stopwatchStart();
+	for (int i=0; i<niter; i++)
+	  copyGenericColorSpinor(deviceSpinor, hostSpinor, QUDA_CPU_FIELD_LOCATION, buffer, 0, bufferNorm, 0);
+	double sendTime = stopwatchReadSeconds();
+
+	stopwatchStart();
+	for (int i=0; i<niter; i++)
+	  copyGenericColorSpinor(hostSpinor, deviceSpinor, QUDA_CPU_FIELD_LOCATION, 0, buffer, 0, bufferNorm);
+	double recTime = stopwatchReadSeconds();
+
+	const bool pass = send_dev < tol && recv_dev < tol && trip_dev < tol;
+	printf("host order %d basis %d <-> device order %d basis %d: send %.2f GB/s, receive %.2f GB/s, "
+	       "deviation send %e receive %e round trip %e %s\n",
+	       host_order[h], basis[b][0], device_order[d], basis[b][1], GB / sendTime, GB / recTime,
+	       send_dev, recv_dev, trip_dev, pass ? "PASSED" : "FAILED");
+	if (!pass) fail++;
+
+	pool_pinned_free(reference);
+	pool_pinned_free(buffer);
+      }
+    }
+  }
+
+  return fail;
+}
+
 extern void usage(char**);
 
 int main(int argc, char **argv) {
@@ -207,8 +319,11 @@ int main(int argc, char **argv) {
 
   init();
   packTest();
+  int fail = reorderTest();
   end();
 
   finalizeComms();
+
+  return fail;
 }
 
@@ -0,0 +1,1250 @@
+/*
+  Benchmark suite of the host code paths, built by the host-only
+  (QUDA_HOST_ONLY) configuration on nodes without a GPU.  We time the
+  reference blas kernels, the host spinor reorder, the threaded and the
+  reference Wilson Dslash, the analytic and the SVD link unitarization,
+  the threaded and the reference fat- and long-link construction,
+  gauge force and clover inversion,
+  the single-pass and the rung-by-rung creation of a precise, sloppy
+  and preconditioner gauge-field ladder and, with QUDA_MULTIGRID, the coarse Dslash, prolongator and
+  restrictor on the lattice given by --dim, with the precision given by
+  --prec, the coarse-grid dimension by --mg-nvec 0 and the aggregate
+  size by --mg-block-size 0.  Each kernel is reported as
+  one JSON object per line on stdout, with the time per application
+  and the rates from the flops and the compulsory memory traffic (every
+  field read or written once); the log of the library goes to stderr.
+  The library kernels are applied once before they are timed, so that
+  the autotuning is not included.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <utility>
+#include <complex>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+#include <clover_field.h>
+#include <dslash_quda.h>
+#include <unitarization_links.h>
+#include <llfat_quda.h>
+#include <gauge_force_quda.h>
+#include <thread_pool.h>
+#ifdef GPU_MULTIGRID
+#include <multigrid.h>
+#include <transfer.h>
+#endif
+
+#include <test_util.h>
+#include <dslash_util.h>
+#include <blas_reference.h>
+#include <wilson_dslash_reference.h>
+#include <llfat_reference.h>
+#include <gauge_force_reference.h>
+#include <gauge_force_paths.h>
+#include <qio_field.h>
+#include "misc.h"
+
+using namespace quda;
+
+extern int xdim;
+extern int ydim;
+extern int zdim;
+extern int tdim;
+extern int gridsize_from_cmdline[];
+extern QudaPrecision prec;
+extern int niter;
+extern int nvec[];
+extern int geo_block_size[][QUDA_MAX_DIM];
+extern bool verify_results;
+extern char latfile[];
+extern int mg_levels;
+extern int nu_pre;
+extern int nu_post;
+extern double omega;
+extern double mass;
+
+/**
+   Print the result of one kernel as a JSON object
+   @param name Kernel name
+   @param precision Precision of the kernel
+   @param volume Number of lattice sites the kernel runs over
+   @param threads Number of host threads the kernel uses
+   @param seconds Total time of the niter applications
+   @param flops Floating-point operations per application
+   @param bytes Compulsory memory traffic per application
+   @param deviation Relative L2 deviation from the reference, or negative if not checked
+ */
+void report(const char *name, QudaPrecision precision, long volume, int threads, double seconds,
+	    double flops, double bytes, double deviation=-1.0) {
+  if (comm_rank() != 0) return;
+  printf("{\"kernel\": \"%s\", \"precision\": \"%s\", \"volume\": %ld, \"threads\": %d, \"niter\": %d, "
+	 "\"seconds\": %e, \"gflops\": %.3f, \"gbytes_per_s\": %.3f",
+	 name, get_prec_str(precision), volume, threads, niter, seconds / niter,
+	 niter * flops / seconds / 1e9, niter * bytes / seconds / 1e9);
+  if (deviation >= 0.0) printf(", \"deviation\": %e", deviation);
+  printf("}\n");
+  fflush(stdout);
+}
+
+template <typename Float>
+void gaussian(void *v, size_t n, std::mt19937 &rng, double scale) {
+  std::normal_distribution<double> gauss(0.0, 1.0);
+  Float *f = static_cast<Float*>(v);
+  for (size_t i=0; i<n; i++) f[i] = scale * gauss(rng);
+}
+
+/**
+   Fill n real numbers of a host buffer with Gaussian random numbers
+ */
+void gaussian(void *v, size_t n, QudaPrecision precision, std::mt19937 &rng, double scale=1.0) {
+  if (precision == QUDA_DOUBLE_PRECISION) gaussian<double>(v, n, rng, scale);
+  else gaussian<float>(v, n, rng, scale);
+}
+
+/**
+   Relative L2 deviation of b from a for host buffers of n real numbers
+ */
+double deviation(void *a, void *b, int n, QudaPrecision precision) {
+  double a2 = norm_2(a, n, precision);
+  mxpy(a, b, n, precision); // b = b - a
+  return sqrt(norm_2(b, n, precision) / a2);
+}
+
+void blasBench(QudaPrecision precision, std::mt19937 &rng) {
+  const int n = V * spinorSiteSize;
+  const size_t size = n * precision;
+  void *x = malloc(size);
+  void *y = malloc(size);
+  gaussian(x, n, precision, rng);
+  gaussian(y, n, precision, rng);
+
+  // the small coefficients keep the fields bounded over the iterations
+  stopwatchStart();
+  for (int i=0; i<niter; i++) axpy(1e-3, x, y, n, precision);
+  report("axpy", precision, V, 1, stopwatchReadSeconds(), 2.0*n, 3.0*size);
+
+  stopwatchStart();
+  for (int i=0; i<niter; i++) xpay(x, -0.5, y, n, precision);
+  report("xpay", precision, V, 1, stopwatchReadSeconds(), 2.0*n, 3.0*size);
+
+  stopwatchStart();
+  for (int i=0; i<niter; i++) mxpy(y, x, n, precision);
+  report("mxpy", precision, V, 1, stopwatchReadSeconds(), 1.0*n, 3.0*size);
+
+  stopwatchStart();
+  for (int i=0; i<niter; i++) ax(1.0 + 1e-3, x, n, precision);
+  report("ax", precision, V, 1, stopwatchReadSeconds(), 1.0*n, 2.0*size);
+
+  stopwatchStart();
+  for (int i=0; i<niter; i++) norm_2(x, n, precision);
+  report("norm2", precision, V, 1, stopwatchReadSeconds(), 2.0*n, 1.0*size);
+
+  free(y);
+  free(x);
+}
+
+void reorderBench(const ColorSpinorParam &param) {
+  ColorSpinorParam csParam(param);
+  csParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  csParam.x[0] *= 2;
+  csParam.precision = QUDA_DOUBLE_PRECISION;
+  cpuColorSpinorField src(csParam);
+  src.Source(QUDA_RANDOM_SOURCE);
+
+  csParam.create = QUDA_NULL_FIELD_CREATE;
+  csParam.fieldOrder = QUDA_SPACE_COLOR_SPIN_FIELD_ORDER;
+  cpuColorSpinorField order(csParam);
+
+  csParam.precision = QUDA_SINGLE_PRECISION;
+  csParam.gammaBasis = QUDA_UKQCD_GAMMA_BASIS;
+  cpuColorSpinorField basis(csParam);
+
+  if (!hostCopyColorSpinorSupported(order, src) || !hostCopyColorSpinorSupported(basis, src))
+    errorQuda("Host reorder of space-spin-color fields is not available");
+
+  // the generic accessor path is the reference for the host engine
+  cpuColorSpinorField order_ref(order), basis_ref(basis);
+  copyGenericColorSpinorAccessor(order_ref, src, QUDA_CPU_FIELD_LOCATION);
+  copyGenericColorSpinorAccessor(basis_ref, src, QUDA_CPU_FIELD_LOCATION);
+
+  copyColorSpinorHost(order, src);
+  stopwatchStart();
+  for (int i=0; i<niter; i++) copyColorSpinorHost(order, src);
+  double order_time = stopwatchReadSeconds();
+  report("reorder_ssc_to_scs", QUDA_DOUBLE_PRECISION, src.Volume(), host::nThreads(), order_time,
+	 0.0, src.Bytes() + order.Bytes(),
+	 verify_results ? deviation(order_ref.V(), order.V(), order.Bytes() / order.Precision(), order.Precision()) : -1.0);
+
+  copyColorSpinorHost(basis, src);
+  stopwatchStart();
+  for (int i=0; i<niter; i++) copyColorSpinorHost(basis, src);
+  double basis_time = stopwatchReadSeconds();
+  report("reorder_ssc_to_scs_ukqcd_single", QUDA_SINGLE_PRECISION, src.Volume(), host::nThreads(), basis_time,
+	 0.0, src.Bytes() + basis.Bytes(),
+	 verify_results ? deviation(basis_ref.V(), basis.V(), basis.Bytes() / basis.Precision(), basis.Precision()) : -1.0);
+}
+
+void dslashBench(const ColorSpinorParam &param, void **gauge, QudaGaugeParam &gauge_param) {
+  GaugeFieldParam gParam(gauge, gauge_param);
+  gParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+  cpuGaugeField u(gParam);
+
+  bool partitioned = false;
+  for (int mu=0; mu<4; mu++) if (comm_dim_partitioned(mu)) partitioned = true;
+  if (partitioned) u.exchangeGhost(QUDA_LINK_BACKWARDS);
+
+  cpuColorSpinorField in(param);
+  in.Source(QUDA_RANDOM_SOURCE);
+  ColorSpinorParam csParam(param);
+  csParam.create = QUDA_ZERO_FIELD_CREATE;
+  cpuColorSpinorField out(csParam);
+  cpuColorSpinorField ref(csParam);
+
+  const int parity = 1;
+  const double flops = 1320.0 * in.VolumeCB();
+  const double bytes = (8.0 * (gaugeSiteSize + spinorSiteSize) + spinorSiteSize) * in.VolumeCB() * in.Precision();
+
+  wilsonDslashHost(out, u, in, parity, 0, nullptr, 0.0);
+  stopwatchStart();
+  for (int i=0; i<niter; i++) wilsonDslashHost(out, u, in, parity, 0, nullptr, 0.0);
+  double host_time = stopwatchReadSeconds();
+
+  stopwatchStart();
+  for (int i=0; i<niter; i++) wil_dslash(ref.V(), gauge, in.V(), parity, 0, in.Precision(), gauge_param);
+  double ref_time = stopwatchReadSeconds();
+
+  const int n = in.VolumeCB() * spinorSiteSize;
+  report("wilson_dslash", in.Precision(), in.VolumeCB(), host::nThreads(), host_time, flops, bytes,
+	 verify_results ? deviation(ref.V(), out.V(), n, in.Precision()) : -1.0);
+  report("wilson_dslash_reference", in.Precision(), in.VolumeCB(), 1, ref_time, flops, bytes);
+}
+
+void unitarizeBench(void **gauge, QudaGaugeParam &gauge_param, std::mt19937 &rng) {
+  GaugeFieldParam gParam(gauge, gauge_param);
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  cpuGaugeField in(gParam);
+  cpuGaugeField out(gParam);
+  cpuGaugeField ref(gParam);
+
+  // perturb the links away from SU(3), as smearing does
+  const size_t n = in.Volume() * gaugeSiteSize;
+  for (int d=0; d<4; d++) {
+    memcpy(((void**)in.Gauge_p())[d], gauge[d], n * in.Precision());
+    void *noise = malloc(n * in.Precision());
+    gaussian(noise, n, in.Precision(), rng, 0.2);
+    axpy(1.0, noise, ((void**)in.Gauge_p())[d], n, in.Precision());
+    free(noise);
+  }
+
+  const double eps = 1e-14, max_error = in.Precision() == QUDA_DOUBLE_PRECISION ? 1e-10 : 1e-6;
+  const double rel_error = 1e-6, abs_error = 1e-6;
+  const double flops = 1147.0 * 4 * in.Volume(); // as counted by the device kernel
+  const double bytes = 2.0 * 4 * in.Volume() * gaugeSiteSize * in.Precision();
+
+  int fails = unitarizeLinksHost(out, in, eps, max_error, true, false, rel_error, abs_error);
+  stopwatchStart();
+  for (int i=0; i<niter; i++) fails = unitarizeLinksHost(out, in, eps, max_error, true, false, rel_error, abs_error);
+  double host_time = stopwatchReadSeconds();
+  if (fails) warningQuda("Unitarization failed for %d links", fails);
+
+  unitarizeLinksHost(ref, in, eps, max_error, true, true, rel_error, abs_error);
+  stopwatchStart();
+  for (int i=0; i<niter; i++) unitarizeLinksHost(ref, in, eps, max_error, true, true, rel_error, abs_error);
+  double svd_time = stopwatchReadSeconds();
+
+  double dev = 0.0;
+  if (verify_results) {
+    double r2 = 0.0, d2 = 0.0;
+    for (int d=0; d<4; d++) {
+      r2 += norm_2(((void**)ref.Gauge_p())[d], n, in.Precision());
+      mxpy(((void**)ref.Gauge_p())[d], ((void**)out.Gauge_p())[d], n, in.Precision());
+      d2 += norm_2(((void**)out.Gauge_p())[d], n, in.Precision());
+    }
+    dev = sqrt(d2 / r2);
+  }
+
+  report("unitarize_links", in.Precision(), in.Volume(), host::nThreads(), host_time, flops, bytes,
+	 verify_results ? dev : -1.0);
+  report("unitarize_links_svd", in.Precision(), in.Volume(), host::nThreads(), svd_time, 0.0, bytes);
+}
+
+void ladderBench(void **gauge, QudaGaugeParam &gauge_param) {
+  GaugeFieldParam gParam(gauge, gauge_param);
+  gParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+  cpuGaugeField in(gParam);
+
+  // the usual double/single/half ladder with 12 reconstruction below the top
+  const QudaPrecision precision[] = { QUDA_DOUBLE_PRECISION, QUDA_SINGLE_PRECISION, QUDA_HALF_PRECISION };
+  const QudaReconstructType reconstruct[] = { QUDA_RECONSTRUCT_NO, QUDA_RECONSTRUCT_12, QUDA_RECONSTRUCT_12 };
+  std::vector<cudaGaugeField*> ladder, rungs;
+  double bytes = in.Bytes();
+  int pad = 0;
+  for (int d=0; d<4; d++) pad = std::max(pad, in.SurfaceCB(d));
+  for (int i=0; i<3; i++) {
+    gParam.create = QUDA_NULL_FIELD_CREATE;
+    gParam.precision = precision[i];
+    gParam.reconstruct = reconstruct[i];
+    gParam.pad = pad;
+    gParam.order = (precision[i] == QUDA_DOUBLE_PRECISION || reconstruct[i] == QUDA_RECONSTRUCT_NO) ?
+      QUDA_FLOAT2_GAUGE_ORDER : QUDA_FLOAT4_GAUGE_ORDER;
+    ladder.push_back(new cudaGaugeField(gParam));
+    rungs.push_back(new cudaGaugeField(gParam));
+    bytes += ladder[i]->Bytes();
+  }
+
+  cudaGaugeField::copyLadder(ladder, in);
+  stopwatchStart();
+  for (int i=0; i<niter; i++) cudaGaugeField::copyLadder(ladder, in);
+  double ladder_time = stopwatchReadSeconds();
+
+  stopwatchStart();
+  for (int i=0; i<niter; i++) for (auto u : rungs) u->copy(in);
+  double rungs_time = stopwatchReadSeconds();
+
+  // the two must agree bit for bit
+  double dev = 0.0;
+  for (int i=0; i<3; i++) dev += memcmp(ladder[i]->Gauge_p(), rungs[i]->Gauge_p(), ladder[i]->Bytes()) ? 1.0 : 0.0;
+
+  report("gauge_ladder", in.Precision(), in.Volume(), host::nThreads(), ladder_time, 0.0, bytes,
+	 verify_results ? dev : -1.0);
+  report("gauge_ladder_by_rung", in.Precision(), in.Volume(), 1, rungs_time, 0.0, 3*in.Bytes() + bytes - in.Bytes());
+
+  for (int i=0; i<3; i++) { delete ladder[i]; delete rungs[i]; }
+}
+
+/**
+   QDP-ordered copy of in with a border of R[d] sites, filled by the halo exchange
+ */
+cpuGaugeField* extendedGauge(const cpuGaugeField &in, const int *R) {
+  GaugeFieldParam gParamEx(in);
+  for (int d=0; d<4; d++) {
+    gParamEx.x[d] = in.X()[d] + 2*R[d];
+    gParamEx.r[d] = R[d];
+  }
+  gParamEx.pad = 0;
+  gParamEx.create = QUDA_ZERO_FIELD_CREATE;
+  gParamEx.order = QUDA_QDP_GAUGE_ORDER;
+  gParamEx.reconstruct = QUDA_RECONSTRUCT_NO;
+  gParamEx.ghostExchange = QUDA_GHOST_EXCHANGE_EXTENDED;
+  gParamEx.siteSubset = QUDA_FULL_SITE_SUBSET;
+  gParamEx.nFace = 1;
+
+  cpuGaugeField *out = new cpuGaugeField(gParamEx);
+  copyExtendedGauge(*out, in, QUDA_CPU_FIELD_LOCATION);
+  out->exchangeExtendedGhost(R, true);
+  return out;
+}
+
+void fatLinkBench(void **gauge, QudaGaugeParam &gauge_param) {
+  GaugeFieldParam gParam(gauge, gauge_param);
+  gParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  cpuGaugeField in(gParam);
+
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  gParam.gauge = nullptr;
+  gParam.link_type = QUDA_GENERAL_LINKS;
+  cpuGaugeField fat(gParam);
+  cpuGaugeField lng(gParam);
+
+  // the host engine needs a border of 2 in partitioned dimensions
+  int R[4];
+  for (int d=0; d<4; d++) R[d] = comm_dim_partitioned(d) ? 2 : 0;
+  cpuGaugeField *u = extendedGauge(in, R);
+
+  // asqtad: one-link, Naik, 3-staple, 5-staple, 7-staple, Lepage
+  double coeff[6] = { 5.0/8.0, -1.0/24.0, -1.0/16.0, 1.0/64.0, -1.0/384.0, -1.0/16.0 };
+  const double flops = (61632.0 + 252.0*4) * in.Volume(); // as counted by llfat_test
+  const double bytes = 3.0 * 4 * in.Volume() * gaugeSiteSize * in.Precision();
+
+  fatLongKSLinkHost(&fat, &lng, *u, coeff);
+  stopwatchStart();
+  for (int i=0; i<niter; i++) fatLongKSLinkHost(&fat, &lng, *u, coeff);
+  double host_time = stopwatchReadSeconds();
+  delete u;
+
+  double dev = -1.0;
+#ifndef MULTI_GPU
+  void *fat_ref[4], *lng_ref[4];
+  const size_t n = in.Volume() * gaugeSiteSize;
+  for (int d=0; d<4; d++) {
+    fat_ref[d] = malloc(n * in.Precision());
+    lng_ref[d] = malloc(n * in.Precision());
+  }
+  float coeff_f[6];
+  for (int i=0; i<6; i++) coeff_f[i] = coeff[i];
+  void *ref_coeff = in.Precision() == QUDA_DOUBLE_PRECISION ? static_cast<void*>(coeff) : static_cast<void*>(coeff_f);
+
+  stopwatchStart();
+  for (int i=0; i<niter; i++) {
+    llfat_reference(fat_ref, gauge, in.Precision(), ref_coeff);
+    computeLongLinkCPU(lng_ref, gauge, in.Precision(), ref_coeff);
+  }
+  double ref_time = stopwatchReadSeconds();
+
+  if (verify_results) {
+    double r2 = 0.0, d2 = 0.0;
+    for (int d=0; d<4; d++) {
+      void *out[2] = { ((void**)fat.Gauge_p())[d], ((void**)lng.Gauge_p())[d] };
+      void *ref[2] = { fat_ref[d], lng_ref[d] };
+      for (int l=0; l<2; l++) {
+	r2 += norm_2(ref[l], n, in.Precision());
+	mxpy(ref[l], out[l], n, in.Precision());
+	d2 += norm_2(out[l], n, in.Precision());
+      }
+    }
+    dev = sqrt(d2 / r2);
+  }
+  report("fat_long_links_reference", in.Precision(), in.Volume(), 1, ref_time, flops, bytes);
+
+  for (int d=0; d<4; d++) { free(fat_ref[d]); free(lng_ref[d]); }
+#endif
+
+  report("fat_long_links", in.Precision(), in.Volume(), host::nThreads(), host_time, flops, bytes, dev);
+}
+
+/**
+   Remove the trace of the n compressed anti-Hermitian matrices of a
+   momentum buffer, so that it holds a valid su(3) momentum: the
+   reference projects the updated momentum, including the input, onto
+   the traceless part, while the host engine only adds a traceless
+   force
+ */
+template <typename Float>
+void tracelessMom(void *v, size_t n) {
+  Float *m = static_cast<Float*>(v);
+  for (size_t i=0; i<n; i++, m+=momSiteSize) {
+    const Float trace = (m[6] + m[7] + m[8]) / 3.0; // the imaginary diagonal
+    for (int j=6; j<9; j++) m[j] -= trace;
+  }
+}
+
+void gaugeForceBench(void **gauge, QudaGaugeParam &gauge_param, std::mt19937 &rng) {
+  GaugeFieldParam gParam(gauge, gauge_param);
+  gParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  cpuGaugeField in(gParam);
+
+  const size_t n = 4 * in.Volume() * momSiteSize;
+  void *mom0 = malloc(n * in.Precision());
+  void *mom_h = malloc(n * in.Precision());
+  gaussian(mom0, n, in.Precision(), rng);
+  if (in.Precision() == QUDA_DOUBLE_PRECISION) tracelessMom<double>(mom0, n / momSiteSize);
+  else tracelessMom<float>(mom0, n / momSiteSize);
+  memcpy(mom_h, mom0, n * in.Precision());
+
+  GaugeFieldParam momParam(mom_h, gauge_param, QUDA_ASQTAD_MOM_LINKS);
+  momParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  momParam.order = QUDA_MILC_GAUGE_ORDER;
+  momParam.reconstruct = QUDA_RECONSTRUCT_10;
+  cpuGaugeField mom(momParam);
+
+  int R[4];
+  for (int d=0; d<4; d++) R[d] = comm_dim_partitioned(d) ? 2 : 0;
+  cpuGaugeField *u = extendedGauge(in, R);
+
+  // the Symanzik path table of gauge_force_test
+  const int num_paths = sizeof(path_dir_x) / sizeof(path_dir_x[0]);
+  int max_length = 0;
+  for (int i=0; i<num_paths; i++) max_length = std::max(max_length, length[i]);
+  int (*path_dir[4])[5] = { path_dir_x, path_dir_y, path_dir_z, path_dir_t };
+  std::vector<int*> paths[4];
+  int **input_path[4];
+  for (int dir=0; dir<4; dir++) {
+    for (int i=0; i<num_paths; i++) paths[dir].push_back(path_dir[dir][i]);
+    input_path[dir] = paths[dir].data();
+  }
+  double loop_coeff[sizeof(loop_coeff_f) / sizeof(float)];
+  for (int i=0; i<num_paths; i++) loop_coeff[i] = loop_coeff_f[i];
+  const double eb3 = 0.3;
+
+  const double flops = 153004.0 * in.Volume(); // as counted by gauge_force_test
+  const double bytes = 4.0 * in.Volume() * (gaugeSiteSize + 2*momSiteSize) * in.Precision();
+
+  // each call accumulates into the momentum, so it is reset before the checked call
+  gaugeForceHost(mom, *u, eb3, input_path, length, loop_coeff, num_paths, max_length);
+  stopwatchStart();
+  for (int i=0; i<niter; i++) gaugeForceHost(mom, *u, eb3, input_path, length, loop_coeff, num_paths, max_length);
+  double host_time = stopwatchReadSeconds();
+  memcpy(mom_h, mom0, n * in.Precision());
+  gaugeForceHost(mom, *u, eb3, input_path, length, loop_coeff, num_paths, max_length);
+  delete u;
+
+  double dev = -1.0;
+#ifndef MULTI_GPU
+  void *mom_ref = malloc(n * in.Precision());
+  void *ref_coeff = in.Precision() == QUDA_DOUBLE_PRECISION ? static_cast<void*>(loop_coeff) :
+    static_cast<void*>(loop_coeff_f);
+
+  stopwatchStart();
+  for (int i=0; i<niter; i++) {
+    memcpy(mom_ref, mom0, n * in.Precision());
+    gauge_force_reference(mom_ref, eb3, gauge, nullptr, in.Precision(), input_path, length, ref_coeff, num_paths);
+  }
+  double ref_time = stopwatchReadSeconds();
+
+  // compare the force, mom - mom0, rather than the momentum
+  if (verify_results) {
+    mxpy(mom0, mom_ref, n, in.Precision());
+    mxpy(mom0, mom_h, n, in.Precision());
+    dev = deviation(mom_ref, mom_h, n, in.Precision());
+  }
+  report("gauge_force_reference", in.Precision(), in.Volume(), 1, ref_time, flops, bytes);
+  free(mom_ref);
+#endif
+
+  report("gauge_force", in.Precision(), in.Volume(), host::nThreads(), host_time, flops, bytes, dev);
+
+  free(mom_h);
+  free(mom0);
+}
+
+/**
+   Offset of element (i,j), i > j, of a packed 6x6 chiral clover block
+ */
+static inline int cloverOffDiag(int i, int j) { return 6 + 2*(15 - (6-j)*(5-j)/2 + i - j - 1); }
+
+/**
+   Reference inversion of nBlock packed chiral clover blocks by
+   Gauss-Jordan elimination in double precision
+   @return The sum of the log determinants of the blocks
+ */
+template <typename Float>
+double cloverInvertReference(Float *inv, const Float *clover, size_t nBlock) {
+  typedef std::complex<double> Complex;
+  double trlog = 0.0;
+  for (size_t b=0; b<nBlock; b++) {
+    const Float *c = clover + 36*b;
+    Complex a[6][12];
+    for (int i=0; i<6; i++) {
+      for (int j=0; j<6; j++) {
+	if (i == j) a[i][j] = c[i];
+	else if (i > j) a[i][j] = Complex(c[cloverOffDiag(i,j)], c[cloverOffDiag(i,j)+1]);
+	else a[i][j] = Complex(c[cloverOffDiag(j,i)], -c[cloverOffDiag(j,i)+1]);
+	a[i][6+j] = i == j ? 1.0 : 0.0;
+      }
+    }
+
+    for (int k=0; k<6; k++) {
+      int p = k;
+      for (int i=k+1; i<6; i++) if (std::abs(a[i][k]) > std::abs(a[p][k])) p = i;
+      if (p != k) for (int j=0; j<12; j++) std::swap(a[k][j], a[p][j]);
+      const Complex pivot = a[k][k];
+      trlog += log(std::abs(pivot));
+      for (int j=0; j<12; j++) a[k][j] /= pivot;
+      for (int i=0; i<6; i++) {
+	if (i == k) continue;
+	const Complex f = a[i][k];
+	for (int j=0; j<12; j++) a[i][j] -= f * a[k][j];
+      }
+    }
+
+    Float *o = inv + 36*b;
+    for (int i=0; i<6; i++) {
+      o[i] = a[i][6+i].real();
+      for (int j=0; j<i; j++) {
+	o[cloverOffDiag(i,j)] = a[i][6+j].real();
+	o[cloverOffDiag(i,j)+1] = a[i][6+j].imag();
+      }
+    }
+  }
+  return trlog;
+}
+
+void cloverInvertBench(const ColorSpinorParam &param, std::mt19937 &rng) {
+  CloverFieldParam cParam;
+  cParam.nDim = 4;
+  for (int d=0; d<4; d++) cParam.x[d] = param.x[d];
+  cParam.x[0] *= 2;
+  cParam.precision = param.precision;
+  cParam.order = QUDA_PACKED_CLOVER_ORDER;
+  cParam.create = QUDA_NULL_FIELD_CREATE;
+  cParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  cParam.pad = 0;
+  cParam.direct = true;
+  cParam.inverse = true;
+  cpuCloverField clover(cParam);
+
+  // Hermitian, diagonally dominant chiral blocks, so they are positive definite with trlog well away from zero
+  const size_t nBlock = 2 * clover.Volume();
+  const size_t n = 36 * nBlock;
+  gaussian(clover.V(false), n, clover.Precision(), rng, 0.05);
+  for (size_t b=0; b<nBlock; b++) {
+    for (int i=0; i<6; i++) {
+      if (clover.Precision() == QUDA_DOUBLE_PRECISION) static_cast<double*>(clover.V(false))[36*b + i] += 2.0;
+      else static_cast<float*>(clover.V(false))[36*b + i] += 2.0;
+    }
+  }
+
+  const double bytes = 2.0 * clover.Bytes();
+
+  cloverInvertHost(clover, true);
+  stopwatchStart();
+  for (int i=0; i<niter; i++) cloverInvertHost(clover, true);
+  double host_time = stopwatchReadSeconds();
+
+  void *ref = malloc(n * clover.Precision());
+  double ref_trlog[2];
+  stopwatchStart();
+  for (int i=0; i<niter; i++) {
+    for (int parity=0; parity<2; parity++) {
+      const size_t offset = parity * n / 2;
+      ref_trlog[parity] = clover.Precision() == QUDA_DOUBLE_PRECISION ?
+	cloverInvertReference(static_cast<double*>(ref) + offset, static_cast<double*>(clover.V(false)) + offset, nBlock/2) :
+	cloverInvertReference(static_cast<float*>(ref) + offset, static_cast<float*>(clover.V(false)) + offset, nBlock/2);
+    }
+  }
+  double ref_time = stopwatchReadSeconds();
+  comm_allreduce_array(ref_trlog, 2);
+
+  // the larger of the deviations of the inverse and of the trlog of each parity
+  double dev = -1.0;
+  if (verify_results) {
+    dev = deviation(ref, clover.V(true), n, clover.Precision());
+    for (int parity=0; parity<2; parity++)
+      dev = std::max(dev, fabs(clover.TrLog()[parity] - ref_trlog[parity]) / fabs(ref_trlog[parity]));
+  }
+
+  report("clover_invert", clover.Precision(), clover.Volume(), host::nThreads(), host_time, 0.0, bytes, dev);
+  report("clover_invert_reference", clover.Precision(), clover.Volume(), 1, ref_time, 0.0, bytes);
+  free(ref);
+}
+
+#ifdef GPU_MULTIGRID
+
+void coarseBench(ColorSpinorField &in, std::mt19937 &rng) {
+  const int Ns = in.Nspin(), Nc = in.Ncolor();
+
+  GaugeFieldParam gParam;
+  for (int d=0; d<4; d++) gParam.x[d] = in.X(d);
+  gParam.nColor = Ns*Nc;
+  gParam.reconstruct = QUDA_RECONSTRUCT_NO;
+  gParam.order = QUDA_QDP_GAUGE_ORDER;
+  gParam.link_type = QUDA_COARSE_LINKS;
+  gParam.t_boundary = QUDA_PERIODIC_T;
+  gParam.create = QUDA_ZERO_FIELD_CREATE;
+  gParam.precision = in.Precision();
+  gParam.nDim = 4;
+  gParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+  gParam.nFace = 1;
+
+  gParam.geometry = QUDA_COARSE_GEOMETRY;
+  cpuGaugeField Y(gParam);
+
+  gParam.geometry = QUDA_SCALAR_GEOMETRY;
+  gParam.nFace = 0;
+  cpuGaugeField X(gParam);
+
+  const int n = gParam.nColor;
+  for (int d=0; d<8; d++) gaussian(static_cast<void**>(Y.Gauge_p())[d], 2*n*n*Y.Volume(), Y.Precision(), rng, 0.5/n);
+  gaussian(static_cast<void**>(X.Gauge_p())[0], 2*n*n*X.Volume(), X.Precision(), rng, 0.5/n);
+  Y.exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+
+  ColorSpinorParam csParam(in);
+  csParam.create = QUDA_ZERO_FIELD_CREATE;
+  cpuColorSpinorField out(csParam);
+
+  const double flops = ((2*4 + 1) * (8.0*Ns*Nc*Ns*Nc) - 2*Ns*Nc) * in.Volume();
+  const double bytes = (2*4 + 1) * in.Bytes() + Y.Bytes() + X.Bytes() + out.Bytes();
+
+  ApplyCoarse(out, in, in, Y, X, 1.0);
+  stopwatchStart();
+  for (int i=0; i<niter; i++) ApplyCoarse(out, in, in, Y, X, 1.0);
+  report("coarse_dslash", in.Precision(), in.Volume(), host::nThreads(), stopwatchReadSeconds(), flops, bytes);
+}
+
+void transferBench(const ColorSpinorParam &param, std::mt19937 &rng) {
+  const int Nvec = nvec[0] > 0 ? nvec[0] : 24;
+  int geo_bs[QUDA_MAX_DIM];
+  for (int d=0; d<4; d++) {
+    geo_bs[d] = geo_block_size[0][d] > 0 ? geo_block_size[0][d] : 2;
+    const int X = d == 0 ? 2*param.x[0] : param.x[d];
+    if (X % geo_bs[d] != 0 || (X / geo_bs[d]) % 2 != 0)
+      errorQuda("Block size %d does not give an even coarse extent of dimension %d of length %d", geo_bs[d], d, X);
+  }
+
+  // the host multigrid paths are instantiated in single and double precision only
+  const QudaPrecision precision = param.precision;
+  if (precision != QUDA_DOUBLE_PRECISION && precision != QUDA_SINGLE_PRECISION)
+    errorQuda("Multigrid benchmark is not supported in %s precision", get_prec_str(precision));
+
+  ColorSpinorParam csParam(param);
+  csParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  csParam.x[0] *= 2;
+  csParam.precision = precision;
+  csParam.create = QUDA_ZERO_FIELD_CREATE;
+  cpuColorSpinorField fine(csParam);
+  cpuColorSpinorField fine_out(csParam);
+
+  csParam.nColor = fine.Ncolor() * Nvec;
+  csParam.create = QUDA_NULL_FIELD_CREATE;
+  cpuColorSpinorField V(csParam);
+  gaussian(V.V(), V.Length(), precision, rng);
+  gaussian(fine.V(), fine.Length(), precision, rng);
+
+  ColorSpinorField *coarse = fine.CreateCoarse(geo_bs, 2, Nvec, QUDA_CPU_FIELD_LOCATION);
+  gaussian(coarse->V(), coarse->Length(), precision, rng);
+
+  // the aggregation maps, as built by the Transfer class
+  std::vector<int> fine_to_coarse(fine.Volume());
+  std::vector<int> coarse_to_fine(fine.Volume());
+  int x[QUDA_MAX_DIM];
+  for (int i=0; i<fine.Volume(); i++) {
+    fine.LatticeIndex(x, i);
+    for (int d=0; d<fine.Ndim(); d++) x[d] /= geo_bs[d];
+    coarse->OffsetIndex(fine_to_coarse[i], x);
+  }
+  std::vector<std::pair<int,int> > geo_sort(fine.Volume());
+  for (int i=0; i<fine.Volume(); i++) geo_sort[i] = std::make_pair(fine_to_coarse[i], i);
+  std::sort(geo_sort.begin(), geo_sort.end());
+  for (int i=0; i<fine.Volume(); i++) coarse_to_fine[i] = geo_sort[i].second;
+  int spin_map[4];
+  for (int s=0; s<4; s++) spin_map[s] = s / 2;
+
+  const double flops = 8.0 * fine.Nspin() * fine.Ncolor() * Nvec * fine.Volume();
+
+  Prolongate(fine_out, *coarse, V, Nvec, fine_to_coarse.data(), spin_map);
+  stopwatchStart();
+  for (int i=0; i<niter; i++) Prolongate(fine_out, *coarse, V, Nvec, fine_to_coarse.data(), spin_map);
+  report("prolongate", precision, fine.Volume(), host::nThreads(), stopwatchReadSeconds(), flops,
+	 coarse->Bytes() + V.Bytes() + fine_out.Bytes());
+
+  Restrict(*coarse, fine, V, Nvec, fine_to_coarse.data(), coarse_to_fine.data(), spin_map);
+  stopwatchStart();
+  for (int i=0; i<niter; i++)
+    Restrict(*coarse, fine, V, Nvec, fine_to_coarse.data(), coarse_to_fine.data(), spin_map);
+  report("restrict", precision, fine.Volume(), host::nThreads(), stopwatchReadSeconds(), flops,
+	 fine.Bytes() + V.Bytes() + coarse->Bytes());
+
+  coarseBench(*coarse, rng);
+
+  delete coarse;
+}
+
+/**
+   Print the cost of one component of the multigrid setup or V-cycle
+   on one level of the hierarchy as a JSON object, with the fields of
+   report plus the level and component
+   @param phase "setup" or "vcycle"
+   @param component Component name
+   @param level Level of the hierarchy, zero being the finest
+   @param precision Precision of the level
+   @param volume Number of lattice sites of the level
+   @param count Number of times the component ran
+   @param seconds Total time of the count runs
+   @param flops Total floating-point operations of the count runs
+   @param bytes Total memory traffic of the count runs
+   @param residual Relative residual reached, or negative if not applicable
+ */
+void reportLevel(const char *phase, const char *component, int level, QudaPrecision precision, long volume,
+		 int count, double seconds, double flops, double bytes, double residual=-1.0) {
+  if (comm_rank() != 0) return;
+  printf("{\"kernel\": \"mg_%s\", \"level\": %d, \"component\": \"%s\", \"precision\": \"%s\", \"volume\": %ld, "
+	 "\"threads\": %d, \"niter\": %d, \"seconds\": %e, \"gflops\": %.3f, \"gbytes_per_s\": %.3f",
+	 phase, level, component, get_prec_str(precision), volume, host::nThreads(), count,
+	 count ? seconds / count : 0.0, seconds > 0.0 ? flops / seconds / 1e9 : 0.0,
+	 seconds > 0.0 ? bytes / seconds / 1e9 : 0.0);
+  if (residual >= 0.0) printf(", \"residual\": %e", residual);
+  printf("}\n");
+  fflush(stdout);
+}
+
+/**
+   Replace the gauge field with a weak field, the unit field with
+   Gaussian noise on every link projected back onto U(3), on which
+   multigrid is effective
+ */
+void weakField(void **gauge, QudaGaugeParam &gauge_param, std::mt19937 &rng) {
+  construct_gauge_field(gauge, 0, gauge_param.cpu_prec, &gauge_param);
+
+  GaugeFieldParam gParam(gauge, gauge_param);
+  gParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  cpuGaugeField in(gParam);
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  cpuGaugeField out(gParam);
+
+  const size_t n = in.Volume() * gaugeSiteSize;
+  void *noise = malloc(n * in.Precision());
+  for (int d=0; d<4; d++) {
+    gaussian(noise, n, in.Precision(), rng, 0.1);
+    axpy(1.0, noise, gauge[d], n, in.Precision());
+  }
+  free(noise);
+
+  const double max_error = in.Precision() == QUDA_DOUBLE_PRECISION ? 1e-10 : 1e-6;
+  int fails = unitarizeLinksHost(out, in, 1e-14, max_error, true, false, 1e-6, 1e-6);
+  if (fails) warningQuda("Unitarization failed for %d links", fails);
+  for (int d=0; d<4; d++) memcpy(gauge[d], ((void**)out.Gauge_p())[d], n * in.Precision());
+}
+
+/**
+   Accumulated time, flops and bytes of one component of the
+   multigrid benchmark
+ */
+struct MGComponentCost {
+  Timer timer;
+  double flops;
+  double bytes;
+  MGComponentCost() : flops(0.0), bytes(0.0) { }
+  void start() { timer.Start(__func__, __FILE__, __LINE__); }
+  void stop(double flops_, double bytes_) {
+    timer.Stop(__func__, __FILE__, __LINE__);
+    flops += flops_;
+    bytes += bytes_;
+  }
+};
+
+/**
+   One level of the multigrid benchmark hierarchy: the operator of
+   the level, its work fields and, above the coarsest level, the
+   null-space vectors and transfer operator to the next level
+ */
+struct MGLevel {
+  ColorSpinorField *b;
+  ColorSpinorField *x;
+  ColorSpinorField *r;
+  ColorSpinorField *tmp;
+  std::vector<ColorSpinorField*> B;
+  Transfer *T;
+  cpuGaugeField *Y, *X, *Xinv, *Yhat; // the coarse operator (levels > 0)
+
+  MGComponentCost null_vectors, block_ortho, coarse_op; // setup
+  MGComponentCost smoother, restriction, prolongation, coarse_solve; // V-cycle
+
+  MGLevel() : b(nullptr), x(nullptr), r(nullptr), tmp(nullptr), T(nullptr),
+	      Y(nullptr), X(nullptr), Xinv(nullptr), Yhat(nullptr) { }
+};
+
+template <typename Float>
+void mgCaxpy(const std::complex<double> &a, const ColorSpinorField &x, ColorSpinorField &y) {
+  const std::complex<Float> a_(a.real(), a.imag());
+  const std::complex<Float> *x_ = static_cast<const std::complex<Float>*>(x.V());
+  std::complex<Float> *y_ = static_cast<std::complex<Float>*>(y.V());
+  host::parallel_for(x.Length()/2, [&](int begin, int end) {
+      for (int i=begin; i<end; i++) y_[i] += a_ * x_[i];
+    });
+}
+
+/**
+   Create a zeroed field with the shape of a
+ */
+ColorSpinorField* mgCreate(const ColorSpinorField &a) {
+  ColorSpinorParam param(a);
+  param.create = QUDA_ZERO_FIELD_CREATE;
+  return ColorSpinorField::Create(param);
+}
+
+/**
+   y += a x for host fields
+ */
+void mgCaxpy(const std::complex<double> &a, const ColorSpinorField &x, ColorSpinorField &y) {
+  if (x.Precision() == QUDA_DOUBLE_PRECISION) mgCaxpy<double>(a, x, y);
+  else mgCaxpy<float>(a, x, y);
+}
+
+template <typename Float>
+void mgCDotNorm(double result[3], const ColorSpinorField &x, const ColorSpinorField &y) {
+  const std::complex<Float> *x_ = static_cast<const std::complex<Float>*>(x.V());
+  const std::complex<Float> *y_ = static_cast<const std::complex<Float>*>(y.V());
+  const int n = x.Length()/2;
+  const int nBlock = 8 * host::nThreads(); // fixed blocks keep the sum deterministic
+  std::vector<double> partial(3*nBlock, 0.0);
+  host::parallel_for(nBlock, [&](int begin, int end) {
+      for (int k=begin; k<end; k++) {
+	for (int i=(long)k*n/nBlock; i<(long)(k+1)*n/nBlock; i++) {
+	  const std::complex<double> xi(x_[i].real(), x_[i].imag()), yi(y_[i].real(), y_[i].imag());
+	  const std::complex<double> d = std::conj(xi) * yi;
+	  partial[3*k+0] += d.real();
+	  partial[3*k+1] += d.imag();
+	  partial[3*k+2] += std::norm(xi);
+	}
+      }
+    });
+  for (int i=0; i<3; i++) result[i] = 0.0;
+  for (int k=0; k<nBlock; k++) for (int i=0; i<3; i++) result[i] += partial[3*k+i];
+  comm_allreduce_array(result, 3);
+}
+
+/**
+   Compute (<x,y>, |x|^2) for host fields
+ */
+std::pair<std::complex<double>, double> mgCDotNorm(const ColorSpinorField &x, const ColorSpinorField &y) {
+  double result[3];
+  if (x.Precision() == QUDA_DOUBLE_PRECISION) mgCDotNorm<double>(result, x, y);
+  else mgCDotNorm<float>(result, x, y);
+  return std::make_pair(std::complex<double>(result[0], result[1]), result[2]);
+}
+
+/**
+   Apply the operator of a level of the hierarchy, out = M in, where
+   the fine operator is the Wilson operator M = 1 - kappa D and the
+   coarse operators are those built by the coarsening
+   @return The (flops, bytes) of the application
+ */
+std::pair<double,double> applyLevel(MGLevel &l, int level, const cpuGaugeField &u, double kappa,
+				    ColorSpinorField &out, const ColorSpinorField &in) {
+  if (level == 0) {
+    wilsonDslashHost(out.Even(), u, in.Odd(), QUDA_EVEN_PARITY, 0, &in.Even(), -kappa);
+    wilsonDslashHost(out.Odd(), u, in.Even(), QUDA_ODD_PARITY, 0, &in.Odd(), -kappa);
+    return std::make_pair((1320.0 + 48.0) * in.Volume(),
+			  (8.0 * (gaugeSiteSize + spinorSiteSize) + 2.0 * spinorSiteSize) * in.Volume() * in.Precision());
+  } else {
+    ApplyCoarse(out, in, in, *l.Y, *l.X, kappa);
+    const int n = in.Nspin() * in.Ncolor();
+    return std::make_pair((9 * (8.0*n*n) - 2*n) * in.Volume(),
+			  (2*4 + 1) * in.Bytes() + l.Y->Bytes() + l.X->Bytes() + out.Bytes());
+  }
+}
+
+/**
+   Minimal-residual relaxation: apply n steps to x given its residual
+   r = b - M x, updating both, with the work field Ar
+   @return The (flops, bytes) of the relaxation
+ */
+std::pair<double,double> relaxLevel(MGLevel &l, int level, const cpuGaugeField &u, double kappa,
+				    ColorSpinorField &x, ColorSpinorField &r, ColorSpinorField &Ar, int n) {
+  std::pair<double,double> cost(0.0, 0.0);
+  for (int k=0; k<n; k++) {
+    std::pair<double,double> op = applyLevel(l, level, u, kappa, Ar, r);
+    std::pair<std::complex<double>, double> dot = mgCDotNorm(Ar, r);
+    if (dot.second == 0.0) break;
+    const std::complex<double> alpha = omega * dot.first / dot.second;
+    mgCaxpy(alpha, r, x);
+    mgCaxpy(-alpha, Ar, r);
+    // blas: one dot-norm and two caxpy, 24 flops per complex number and 8 field transfers
+    cost.first += op.first + 24.0 * r.Length() / 2;
+    cost.second += op.second + 8.0 * r.Bytes();
+  }
+  return cost;
+}
+
+/**
+   Apply one V-cycle from the given level: x approximately solves
+   M x = b using nu_pre and nu_post minimal-residual smoothing steps,
+   with a fixed number of minimal-residual steps on the coarsest level
+ */
+void vcycle(std::vector<MGLevel> &levels, int level, const cpuGaugeField &u, double kappa, int coarse_iter) {
+  MGLevel &l = levels[level];
+  memset(l.x->V(), 0, l.x->Bytes());
+  *l.r = *l.b;
+
+  if (level == (int)levels.size() - 1) {
+    l.coarse_solve.start();
+    std::pair<double,double> cost = relaxLevel(l, level, u, kappa, *l.x, *l.r, *l.tmp, coarse_iter);
+    l.coarse_solve.stop(cost.first, cost.second);
+    return;
+  }
+
+  MGLevel &c = levels[level+1];
+
+  l.smoother.start();
+  std::pair<double,double> cost = relaxLevel(l, level, u, kappa, *l.x, *l.r, *l.tmp, nu_pre);
+  l.smoother.stop(cost.first, cost.second);
+
+  l.restriction.start();
+  l.T->R(*c.b, *l.r);
+  const double transfer_flops = 8.0 * l.r->Nspin() * l.r->Ncolor() * c.b->Ncolor() * l.r->Volume();
+  l.restriction.stop(transfer_flops, l.r->Bytes() + l.T->Vectors().Bytes() + c.b->Bytes());
+
+  vcycle(levels, level+1, u, kappa, coarse_iter);
+
+  l.prolongation.start();
+  l.T->P(*l.tmp, *c.x);
+  mgCaxpy(1.0, *l.tmp, *l.x);
+  l.prolongation.stop(transfer_flops + 8.0 * l.x->Length() / 2,
+		      c.x->Bytes() + l.T->Vectors().Bytes() + 4 * l.x->Bytes());
+
+  // post smoothing starts from the true residual of the corrected solution
+  l.smoother.start();
+  cost = applyLevel(l, level, u, kappa, *l.tmp, *l.x);
+  *l.r = *l.b;
+  mgCaxpy(-1.0, *l.tmp, *l.r);
+  std::pair<double,double> post = relaxLevel(l, level, u, kappa, *l.x, *l.r, *l.tmp, nu_post);
+  l.smoother.stop(cost.first + post.first + 8.0 * l.r->Length() / 2, cost.second + post.second + 3 * l.r->Bytes());
+}
+
+/**
+   Build an mg_levels deep hierarchy over the Wilson operator of the
+   given gauge field and time its setup and V-cycle, per level and per
+   component.  The null-space vectors are random vectors relaxed
+   towards the near null space of the level operator, which are then
+   block orthogonalized and used to construct the coarse operator,
+   exactly as the multigrid setup does.  The V-cycle is timed as the
+   stationary iteration x += V(b - M x), and the relative residual it
+   reaches is reported with the fine-level total.
+ */
+void multigridBench(const ColorSpinorParam &param, void **gauge, QudaGaugeParam &gauge_param, std::mt19937 &rng) {
+  const int setup_iter = 20;  // relaxation steps of each null-space vector
+  const int coarse_iter = 10; // relaxation steps of the coarsest-level solve
+  const double kappa = 1.0 / (2.0 * (4.0 + mass));
+  const int nLevel = std::min(std::max(mg_levels, 2), QUDA_MAX_MG_LEVEL);
+
+  // the host multigrid paths are instantiated in single and double precision only
+  const QudaPrecision precision = param.precision;
+  if (precision != QUDA_DOUBLE_PRECISION && precision != QUDA_SINGLE_PRECISION)
+    errorQuda("Multigrid benchmark is not supported in %s precision", get_prec_str(precision));
+
+  GaugeFieldParam gParam(gauge, gauge_param);
+  gParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+  cpuGaugeField in(gParam);
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  gParam.setPrecision(precision);
+  gParam.order = QUDA_QDP_GAUGE_ORDER;
+  cpuGaugeField u(gParam);
+  u.copy(in);
+
+  bool partitioned = false;
+  for (int mu=0; mu<4; mu++) if (comm_dim_partitioned(mu)) partitioned = true;
+  if (partitioned) u.exchangeGhost(QUDA_LINK_BACKWARDS);
+
+  // the fine-level coarsening reads the gauge field through the device-field interface
+  int pad = 0;
+  for (int d=0; d<4; d++) pad = std::max(pad, u.SurfaceCB(d));
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  gParam.order = QUDA_FLOAT2_GAUGE_ORDER;
+  gParam.pad = pad;
+  cudaGaugeField u_d(gParam);
+  u_d.copy(u);
+
+  ColorSpinorParam csParam(param);
+  csParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  csParam.x[0] *= 2;
+  csParam.precision = precision;
+  csParam.create = QUDA_ZERO_FIELD_CREATE;
+
+  TimeProfile profile("multigridBench");
+  std::vector<MGLevel> levels(nLevel);
+  levels[0].b = new cpuColorSpinorField(csParam);
+
+  for (int i=0; i<nLevel; i++) {
+    MGLevel &l = levels[i];
+    l.x = mgCreate(*l.b);
+    l.r = mgCreate(*l.b);
+    l.tmp = mgCreate(*l.b);
+    if (i == nLevel - 1) break;
+
+    const int Nvec = nvec[i] > 0 ? nvec[i] : 24;
+    const int spin_bs = i == 0 ? 2 : 1;
+    int geo_bs[QUDA_MAX_DIM];
+    for (int d=0; d<4; d++) geo_bs[d] = geo_block_size[i][d] > 0 ? geo_block_size[i][d] : 2;
+
+    // null-space vectors: relax M v = 0 from random vectors and normalize
+    l.null_vectors.start();
+    std::pair<double,double> cost(0.0, 0.0);
+    for (int k=0; k<Nvec; k++) {
+      ColorSpinorField *v = mgCreate(*l.b);
+      gaussian(v->V(), v->Length(), precision, rng);
+      std::pair<double,double> op = applyLevel(l, i, u, kappa, *l.tmp, *v);
+      memset(l.r->V(), 0, l.r->Bytes());
+      mgCaxpy(-1.0, *l.tmp, *l.r);
+      std::pair<double,double> relax = relaxLevel(l, i, u, kappa, *v, *l.r, *l.tmp, setup_iter);
+      mgCaxpy(1.0 / sqrt(mgCDotNorm(*v, *v).second) - 1.0, *v, *v); // v /= |v|
+      cost.first += op.first + relax.first;
+      cost.second += op.second + relax.second;
+      l.B.push_back(v);
+    }
+    l.null_vectors.stop(cost.first, cost.second);
+
+    // block orthogonalization, done when the transfer operator is constructed; the
+    // setup kernels count their flops in blas::flops
+    unsigned long long flops0 = blas::flops;
+    l.block_ortho.start();
+    l.T = new Transfer(l.B, Nvec, geo_bs, spin_bs, false, profile);
+    l.block_ortho.stop(blas::flops - flops0, Nvec * l.b->Bytes() + 2 * l.T->Vectors().Bytes());
+
+    // the coarse operator, with the fields allocated as the coarse Dirac operator does
+    MGLevel &c = levels[i+1];
+    c.b = l.b->CreateCoarse(l.T->Geo_bs(), spin_bs, Nvec);
+
+    GaugeFieldParam cParam;
+    for (int d=0; d<4; d++) cParam.x[d] = c.b->X(d);
+    cParam.nColor = c.b->Nspin() * c.b->Ncolor();
+    cParam.reconstruct = QUDA_RECONSTRUCT_NO;
+    cParam.order = QUDA_QDP_GAUGE_ORDER;
+    cParam.link_type = QUDA_COARSE_LINKS;
+    cParam.t_boundary = QUDA_PERIODIC_T;
+    cParam.create = QUDA_ZERO_FIELD_CREATE;
+    cParam.precision = precision;
+    cParam.nDim = 4;
+    cParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+    cParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+    cParam.nFace = 1;
+    cParam.geometry = QUDA_COARSE_GEOMETRY;
+    c.Y = new cpuGaugeField(cParam);
+    c.Yhat = new cpuGaugeField(cParam);
+    cParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+    cParam.nFace = 0;
+    cParam.geometry = QUDA_SCALAR_GEOMETRY;
+    c.X = new cpuGaugeField(cParam);
+    c.Xinv = new cpuGaugeField(cParam);
+
+    flops0 = blas::flops;
+    l.coarse_op.start();
+    if (i == 0) {
+      CoarseOp(*c.Y, *c.X, *c.Xinv, *c.Yhat, *l.T, u_d, nullptr, kappa, 0.0, 0.0, QUDA_WILSON_DIRAC, QUDA_MATPC_INVALID);
+    } else {
+      CoarseCoarseOp(*c.Y, *c.X, *c.Xinv, *c.Yhat, *l.T, *l.Y, *l.X, *l.Xinv, kappa, 0.0, 0.0,
+		     QUDA_COARSE_DIRAC, QUDA_MATPC_INVALID);
+    }
+    const double fine_bytes = i == 0 ? u.Bytes() : l.Y->Bytes() + l.X->Bytes() + l.Xinv->Bytes();
+    l.coarse_op.stop(blas::flops - flops0, fine_bytes + l.T->Vectors().Bytes() + c.Y->Bytes() + c.X->Bytes() + c.Xinv->Bytes() + c.Yhat->Bytes());
+  }
+
+  // iterate x += V(b - M x) from x = 0
+  ColorSpinorField *b = mgCreate(*levels[0].b);
+  ColorSpinorField *x = mgCreate(*levels[0].b);
+  ColorSpinorField *Mx = mgCreate(*levels[0].b);
+  gaussian(b->V(), b->Length(), precision, rng);
+  const double b2 = mgCDotNorm(*b, *b).second;
+
+  MGComponentCost total;
+  *levels[0].b = *b;
+  total.start();
+  for (int it=0; it<niter; it++) {
+    vcycle(levels, 0, u, kappa, coarse_iter);
+    mgCaxpy(1.0, *levels[0].x, *x);
+    applyLevel(levels[0], 0, u, kappa, *Mx, *x);
+    *levels[0].b = *b;
+    mgCaxpy(-1.0, *Mx, *levels[0].b);
+  }
+  total.stop(0.0, 0.0);
+  const double r2 = mgCDotNorm(*levels[0].b, *levels[0].b).second;
+
+  for (int i=0; i<nLevel; i++) {
+    MGLevel &l = levels[i];
+    const long volume = l.b->Volume();
+    if (i < nLevel - 1) {
+      reportLevel("setup", "null_vectors", i, precision, volume, 1, l.null_vectors.timer.time,
+		  l.null_vectors.flops, l.null_vectors.bytes);
+      reportLevel("setup", "block_ortho", i, precision, volume, 1, l.block_ortho.timer.time,
+		  l.block_ortho.flops, l.block_ortho.bytes);
+      reportLevel("setup", "coarse_op", i, precision, volume, 1, l.coarse_op.timer.time,
+		  l.coarse_op.flops, l.coarse_op.bytes);
+      reportLevel("vcycle", "smoother", i, precision, volume, niter, l.smoother.timer.time,
+		  l.smoother.flops, l.smoother.bytes);
+      reportLevel("vcycle", "restrict", i, precision, volume, niter, l.restriction.timer.time,
+		  l.restriction.flops, l.restriction.bytes);
+      reportLevel("vcycle", "prolong", i, precision, volume, niter, l.prolongation.timer.time,
+		  l.prolongation.flops, l.prolongation.bytes);
+    } else {
+      reportLevel("vcycle", "coarse_solve", i, precision, volume, niter, l.coarse_solve.timer.time,
+		  l.coarse_solve.flops, l.coarse_solve.bytes);
+    }
+  }
+
+  double flops = 0.0, bytes = 0.0;
+  for (auto &l : levels) {
+    flops += l.smoother.flops + l.restriction.flops + l.prolongation.flops + l.coarse_solve.flops;
+    bytes += l.smoother.bytes + l.restriction.bytes + l.prolongation.bytes + l.coarse_solve.bytes;
+  }
+  reportLevel("vcycle", "total", 0, precision, levels[0].b->Volume(), niter, total.timer.time, flops, bytes,
+	      sqrt(r2 / b2));
+
+  delete Mx;
+  delete x;
+  delete b;
+  for (auto &l : levels) {
+    for (auto v : l.B) delete v;
+    delete l.T;
+    delete l.Y;
+    delete l.Yhat;
+    delete l.X;
+    delete l.Xinv;
+    delete l.tmp;
+    delete l.r;
+    delete l.x;
+    delete l.b;
+  }
+}
+
+#endif // GPU_MULTIGRID
+
+extern void usage(char**);
+
+int main(int argc, char **argv) {
+
+  for (int i=1; i<argc; i++) {
+    if (process_command_line_option(argc, argv, &i) == 0) continue;
+    printf("ERROR: Invalid option:%s\n", argv[i]);
+    usage(argv);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  setOutputFile(stderr); // stdout only carries the results
+  initRand();
+
+  QudaGaugeParam gauge_param = newQudaGaugeParam();
+  gauge_param.X[0] = xdim;
+  gauge_param.X[1] = ydim;
+  gauge_param.X[2] = zdim;
+  gauge_param.X[3] = tdim;
+  gauge_param.anisotropy = 1.0;
+  gauge_param.type = QUDA_WILSON_LINKS;
+  gauge_param.gauge_order = QUDA_QDP_GAUGE_ORDER;
+  gauge_param.t_boundary = QUDA_PERIODIC_T;
+  gauge_param.cpu_prec = prec;
+  gauge_param.cuda_prec = prec;
+  gauge_param.reconstruct = QUDA_RECONSTRUCT_NO;
+  gauge_param.gauge_fix = QUDA_GAUGE_FIXED_NO;
+  setDims(gauge_param.X);
+  setSpinorSiteSize(24);
+
+  void *gauge[4];
+  for (int d=0; d<4; d++) gauge[d] = malloc(V*gaugeSiteSize*prec);
+  if (strcmp(latfile, "")) { // load in the command line supplied gauge field
+    read_gauge_field(latfile, gauge, prec, gauge_param.X, argc, argv);
+    construct_gauge_field(gauge, 2, prec, &gauge_param);
+  } else { // else generate a random SU(3) field
+    construct_gauge_field(gauge, 1, prec, &gauge_param);
+  }
+
+  ColorSpinorParam csParam;
+  csParam.nColor = 3;
+  csParam.nSpin = 4;
+  csParam.nDim = 4;
+  for (int d=0; d<4; d++) csParam.x[d] = gauge_param.X[d];
+  csParam.x[0] /= 2;
+  csParam.precision = prec;
+  csParam.pad = 0;
+  csParam.siteSubset = QUDA_PARITY_SITE_SUBSET;
+  csParam.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  csParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  csParam.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  csParam.create = QUDA_NULL_FIELD_CREATE;
+
+  std::mt19937 rng(1234 + comm_rank());
+
+  blasBench(prec, rng);
+  reorderBench(csParam);
+  dslashBench(csParam, gauge, gauge_param);
+  unitarizeBench(gauge, gauge_param, rng);
+  ladderBench(gauge, gauge_param);
+  fatLinkBench(gauge, gauge_param);
+  gaugeForceBench(gauge, gauge_param, rng);
+  cloverInvertBench(csParam, rng);
+#ifdef GPU_MULTIGRID
+  transferBench(csParam, rng);
+  // the hierarchy is built over the stored gauge field if given, else over a weak field
+  if (!strcmp(latfile, "")) weakField(gauge, gauge_param, rng);
+  multigridBench(csParam, gauge, gauge_param, rng);
+#endif
+
+  for (int d=0; d<4; d++) free(gauge[d]);
+
+  finalizeComms();
+
+  return 0;
+}
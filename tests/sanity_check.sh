@@ -220,6 +220,76 @@ function complete_invert_check {
    
 
 }
+function complete_mg_check {
+    echo "Performing complete multigrid test:"
+    prog="./multigrid_invert_test"
+    smoothers="mr gcr ca-gcr"
+
+    for smoother in $smoothers; do
+        cmd="$prog --sdim 8 --tdim 16 --dslash-type clover --prec double --prec-sloppy single --mg-levels 2 --mg-block-size 0 4 4 4 4 --mg-nvec 0 16 --mg-smoother $smoother --tol 1e-7"
+        echo -ne  $cmd  "\t"..."\t"
+        echo "----------------------------------------------------------" >>$OUTFILE
+        echo $cmd >> $OUTFILE
+        $cmd >> $OUTFILE 2>&1|| (echo -e "FAIL\n$prog failed, check $OUTFILE for detail"; echo $fail_msg; exit 1) || exit 1
+        echo "OK"
+    done
+
+    # per-level component timings of a three-level hierarchy
+    prog="./multigrid_hierarchy_benchmark_test"
+    cmd="$prog --sdim 16 --tdim 16 --dslash-type wilson --prec double --prec-sloppy single --mg-levels 3 --mg-block-size 0 4 4 4 4 --mg-block-size 1 2 2 2 2 --mg-nvec 0 16 --mg-nvec 1 16 --nsrc 2 --tol 1e-7"
+    echo -ne  $cmd  "\t"..."\t"
+    echo "----------------------------------------------------------" >>$OUTFILE
+    echo $cmd >> $OUTFILE
+    $cmd >> $OUTFILE 2>&1|| (echo -e "FAIL\n$prog failed, check $OUTFILE for detail"; echo $fail_msg; exit 1) || exit 1
+    echo "OK"
+
+}
+
+function complete_deflation_check {
+    echo "Performing complete deflation test:"
+    prog="./deflated_invert_test"
+    seeds="false true"
+
+    for seed in $seeds; do
+        cmd="$prog --sdim 8 --tdim 16 --dslash-type wilson --prec double --prec-sloppy single --inv-type inc-eigcg --solve-type normop-pc --df-nev 8 --df-max-search-dim 64 --df-lanczos-seed $seed --tol 1e-7"
+        echo -ne  $cmd  "\t"..."\t"
+        echo "----------------------------------------------------------" >>$OUTFILE
+        echo $cmd >> $OUTFILE
+        $cmd >> $OUTFILE 2>&1|| (echo -e "FAIL\n$prog failed, check $OUTFILE for detail"; echo $fail_msg; exit 1) || exit 1
+        echo "OK"
+    done
+
+}
+
+function complete_propagator_check {
+    echo "Performing propagator solver test:"
+    prog="./invert_test"
+    dslashes="wilson clover"
+
+    for dslash in $dslashes; do
+        cmd="$prog --sdim 8 --tdim 16 --dslash-type $dslash --prec double --prec-sloppy single --propagator true --nsrc 12 --tol 1e-7"
+        echo -ne  $cmd  "\t"..."\t"
+        echo "----------------------------------------------------------" >>$OUTFILE
+        echo $cmd >> $OUTFILE
+        $cmd >> $OUTFILE 2>&1|| (echo -e "FAIL\n$prog failed, check $OUTFILE for detail"; echo $fail_msg; exit 1) || exit 1
+        echo "OK"
+    done
+
+}
+
+function complete_residency_check {
+    echo "Performing sloppy field residency test:"
+    prog="./sloppy_residency_test"
+
+    cmd="$prog --sdim 8 --tdim 16 --prec double"
+    echo -ne  $cmd  "\t"..."\t"
+    echo "----------------------------------------------------------" >>$OUTFILE
+    echo $cmd >> $OUTFILE
+    $cmd >> $OUTFILE 2>&1|| (echo -e "FAIL\n$prog failed, check $OUTFILE for detail"; echo $fail_msg; exit 1) || exit 1
+    echo "OK"
+
+}
+
 #actions based on arguments
 
 if [ $# == "0" ]; then
@@ -241,6 +311,14 @@ for action in $*; do
 	complete_gauge_force_check ;;
     hf )
 	complete_hisq_force_check ;;
+    mg )
+	complete_mg_check ;;
+    df )
+	complete_deflation_check ;;
+    prop )
+	complete_propagator_check ;;
+    res )
+	complete_residency_check ;;
     all )
 	basic_sanity_check
 	complete_dslash_check
@@ -248,11 +326,15 @@ for action in $*; do
 	complete_fatlink_check
 	complete_gauge_force_check 
 	complete_hisq_force_check
+	complete_mg_check
+	complete_deflation_check
+	complete_propagator_check
+	complete_residency_check
 	;;
     * )
 	echo "ERROR: invalid option ($action)!"
 	echo "Valid options: "
-	echo "              basic/fat/dslash/invert/gf/hisq/all"
+	echo "              basic/fat/dslash/invert/gf/hisq/mg/df/prop/res/all"
 	exit
 	;;
   esac
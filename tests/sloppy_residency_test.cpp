@@ -0,0 +1,258 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <quda_internal.h>
+#include <gauge_field.h>
+#include <clover_field.h>
+
+#include <test_util.h>
+#include <misc.h>
+
+#include <quda.h>
+
+// Test of the residency of the sloppy gauge and clover fields.  The
+// sloppy fields are created lazily and the device memory budget is
+// set so small that every variant a solve does not need is evicted
+// when another one is built, so the test checks that the variants are
+// created on first use, evicted when they are not needed and rebuilt
+// on their next use.  The host memory budget is set likewise, so that
+// the pinned memory pool is flushed on each eviction.
+
+extern int device;
+extern int xdim;
+extern int ydim;
+extern int zdim;
+extern int tdim;
+extern int gridsize_from_cmdline[];
+extern QudaPrecision prec;
+extern QudaReconstructType link_recon;
+extern double mass;
+extern double clover_coeff;
+
+extern void usage(char** );
+
+// the resident fields of the interface
+extern quda::cudaGaugeField *gaugePrecise;
+extern quda::cudaGaugeField *gaugeSloppy;
+extern quda::cudaGaugeField *gaugePrecondition;
+extern quda::cudaCloverField *cloverPrecise;
+extern quda::cudaCloverField *cloverSloppy;
+extern quda::cudaCloverField *cloverPrecondition;
+
+QudaGaugeParam gauge_param;
+QudaInvertParam inv_param;
+
+void *spinorIn, *spinorOut;
+
+void
+display_test_info()
+{
+  printfQuda("running the following test:\n");
+  printfQuda("prec    recon   S_dimension T_dimension\n");
+  printfQuda("%6s   %2s       %3d/%3d/%3d     %3d\n",
+	     get_prec_str(prec), get_recon_str(link_recon), xdim, ydim, zdim, tdim);
+  printfQuda("Grid partition info:     X  Y  Z  T\n");
+  printfQuda("                         %d  %d  %d  %d\n",
+	     dimPartitioned(0),
+	     dimPartitioned(1),
+	     dimPartitioned(2),
+	     dimPartitioned(3));
+  return;
+}
+
+void setParams()
+{
+  gauge_param = newQudaGaugeParam();
+  gauge_param.X[0] = xdim;
+  gauge_param.X[1] = ydim;
+  gauge_param.X[2] = zdim;
+  gauge_param.X[3] = tdim;
+  gauge_param.anisotropy = 1.0;
+  gauge_param.type = QUDA_WILSON_LINKS;
+  gauge_param.gauge_order = QUDA_QDP_GAUGE_ORDER;
+  gauge_param.t_boundary = QUDA_PERIODIC_T;
+  gauge_param.cpu_prec = QUDA_DOUBLE_PRECISION;
+  gauge_param.cuda_prec = prec;
+  gauge_param.reconstruct = link_recon;
+  gauge_param.cuda_prec_sloppy = QUDA_SINGLE_PRECISION;
+  gauge_param.reconstruct_sloppy = link_recon;
+  gauge_param.cuda_prec_precondition = QUDA_SINGLE_PRECISION;
+  gauge_param.reconstruct_precondition = link_recon;
+  gauge_param.gauge_fix = QUDA_GAUGE_FIXED_NO;
+  gauge_param.ga_pad = 0;
+#ifdef MULTI_GPU
+  int pad_size = 0;
+  for (int mu=0; mu<4; mu++) {
+    int face_size = 1;
+    for (int nu=0; nu<4; nu++) if (nu != mu) face_size *= gauge_param.X[nu];
+    if (face_size/2 > pad_size) pad_size = face_size/2;
+  }
+  gauge_param.ga_pad = pad_size;
+#endif
+
+  inv_param = newQudaInvertParam();
+  inv_param.dslash_type = QUDA_CLOVER_WILSON_DSLASH;
+  inv_param.mass = mass;
+  inv_param.kappa = 1.0 / (2.0 * (1 + 3/gauge_param.anisotropy + mass));
+  inv_param.Ls = 1;
+
+  inv_param.inv_type = QUDA_CG_INVERTER;
+  inv_param.solution_type = QUDA_MATPC_SOLUTION;
+  inv_param.solve_type = QUDA_NORMOP_PC_SOLVE;
+  inv_param.matpc_type = QUDA_MATPC_EVEN_EVEN;
+  inv_param.dagger = QUDA_DAG_NO;
+  inv_param.mass_normalization = QUDA_KAPPA_NORMALIZATION;
+  inv_param.solver_normalization = QUDA_DEFAULT_NORMALIZATION;
+
+  inv_param.tol = 1e-7;
+  inv_param.residual_type = QUDA_L2_RELATIVE_RESIDUAL;
+  inv_param.maxiter = 1000;
+  inv_param.reliable_delta = 1e-1;
+
+  inv_param.cpu_prec = QUDA_DOUBLE_PRECISION;
+  inv_param.cuda_prec = prec;
+  inv_param.cuda_prec_sloppy = QUDA_SINGLE_PRECISION;
+  inv_param.cuda_prec_precondition = QUDA_SINGLE_PRECISION;
+  inv_param.preserve_source = QUDA_PRESERVE_SOURCE_YES;
+  inv_param.gamma_basis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  inv_param.dirac_order = QUDA_DIRAC_ORDER;
+  inv_param.input_location = QUDA_CPU_FIELD_LOCATION;
+  inv_param.output_location = QUDA_CPU_FIELD_LOCATION;
+  inv_param.sp_pad = 0;
+  inv_param.cl_pad = 0;
+
+  inv_param.clover_cpu_prec = QUDA_DOUBLE_PRECISION;
+  inv_param.clover_cuda_prec = prec;
+  inv_param.clover_cuda_prec_sloppy = QUDA_SINGLE_PRECISION;
+  inv_param.clover_cuda_prec_precondition = QUDA_SINGLE_PRECISION;
+  inv_param.clover_order = QUDA_PACKED_CLOVER_ORDER;
+  inv_param.clover_coeff = clover_coeff;
+  inv_param.compute_clover_inverse = 1;
+
+  inv_param.verbosity = QUDA_VERBOSE;
+}
+
+/**
+   Solve with the given dslash type and sloppy precision
+ */
+void solve(QudaDslashType dslash_type, QudaPrecision prec_sloppy)
+{
+  QudaInvertParam param = inv_param;
+  param.dslash_type = dslash_type;
+  param.cuda_prec_sloppy = prec_sloppy;
+  param.cuda_prec_precondition = prec_sloppy;
+  param.clover_cuda_prec_sloppy = prec_sloppy;
+  param.clover_cuda_prec_precondition = prec_sloppy;
+  invertQuda(spinorOut, spinorIn, &param);
+  printfQuda("%s solve with %s sloppy precision: %d iterations, true residual %e\n",
+	     get_dslash_str(dslash_type), get_prec_str(prec_sloppy), param.iter, param.true_res);
+}
+
+/**
+   Check the residency of the sloppy variants against the expected one
+   @return Whether the check failed
+ */
+int check(const char *stage, bool gauge, bool clover)
+{
+  bool gauge_resident = gaugeSloppy && gaugeSloppy != gaugePrecise && gaugePrecondition;
+  bool clover_resident = cloverSloppy && cloverSloppy != cloverPrecise && cloverPrecondition;
+  bool pass = gauge_resident == gauge && clover_resident == clover;
+  printfQuda("%-36s gauge %-9s clover %-9s %s\n", stage,
+	     gauge_resident ? "resident" : "evicted", clover_resident ? "resident" : "evicted",
+	     pass ? "passed" : "FAILED");
+  return pass ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+  for (int i = 1; i < argc; i++){
+    if(process_command_line_option(argc, argv, &i) == 0){
+      continue;
+    }
+    printfQuda("ERROR: Invalid option:%s\n", argv[i]);
+    usage(argv);
+  }
+
+  if (prec != QUDA_DOUBLE_PRECISION) {
+    printfQuda("Double precision is required, so that the sloppy fields do not alias the precise ones\n");
+    prec = QUDA_DOUBLE_PRECISION;
+  }
+
+  // must be set before initQuda: lazy creation, and budgets (in GiB) so small that all unused variants are evicted
+  setenv("QUDA_LAZY_SLOPPY", "1", 1);
+  setenv("QUDA_DEVICE_MEMORY_BUDGET", "1e-6", 1);
+  setenv("QUDA_HOST_MEMORY_BUDGET", "1e-6", 1);
+
+  initComms(argc, argv, gridsize_from_cmdline);
+
+  display_test_info();
+
+  setParams();
+  setDims(gauge_param.X);
+  setSpinorSiteSize(24);
+
+  void *gauge[4];
+  for (int dir = 0; dir < 4; dir++) gauge[dir] = malloc(V*gaugeSiteSize*sizeof(double));
+  construct_gauge_field(gauge, 1, gauge_param.cpu_prec, &gauge_param);
+
+  void *clover = malloc(V*cloverSiteSize*sizeof(double));
+  construct_clover_field(clover, 0.01, 1.0, inv_param.clover_cpu_prec);
+
+  spinorIn = malloc(V*spinorSiteSize*sizeof(double));
+  spinorOut = malloc(V*spinorSiteSize*sizeof(double));
+  for (int i=0; i<V*spinorSiteSize; i++) ((double*)spinorIn)[i] = rand() / (double)RAND_MAX;
+
+  initQuda(device);
+
+  int fail = 0;
+
+  loadGaugeQuda(gauge, &gauge_param);
+  loadCloverQuda(clover, nullptr, &inv_param);
+  fail += check("after loading", false, false);
+
+  // the first mixed-precision clover solve creates both
+  solve(QUDA_CLOVER_WILSON_DSLASH, QUDA_SINGLE_PRECISION);
+  fail += check("after a clover solve", true, true);
+
+  // a solve without clover that rebuilds the gauge variants evicts the clover ones
+  solve(QUDA_WILSON_DSLASH, QUDA_HALF_PRECISION);
+  fail += check("after a Wilson solve", true, false);
+  if (gaugeSloppy && gaugeSloppy->Precision() != QUDA_HALF_PRECISION) {
+    printfQuda("Sloppy gauge field has precision %d, expected %d: FAILED\n", gaugeSloppy->Precision(), QUDA_HALF_PRECISION);
+    fail++;
+  }
+
+  // the next clover solve rebuilds them
+  solve(QUDA_CLOVER_WILSON_DSLASH, QUDA_SINGLE_PRECISION);
+  fail += check("after a second clover solve", true, true);
+
+  // loading a new clover field evicts the gauge variants
+  inv_param.clover_coeff *= 1.1;
+  loadCloverQuda(clover, nullptr, &inv_param);
+  fail += check("after reloading the clover field", false, false);
+
+  // and loading a new gauge field evicts the clover variants
+  solve(QUDA_CLOVER_WILSON_DSLASH, QUDA_SINGLE_PRECISION);
+  fail += check("after a third clover solve", true, true);
+  loadGaugeQuda(gauge, &gauge_param);
+  fail += check("after reloading the gauge field", false, false);
+
+  solve(QUDA_CLOVER_WILSON_DSLASH, QUDA_SINGLE_PRECISION);
+  fail += check("after a fourth clover solve", true, true);
+
+  printfQuda("Sloppy residency test %s (%d failures)\n", fail ? "FAILED" : "passed", fail);
+
+  freeGaugeQuda();
+  freeCloverQuda();
+  endQuda();
+
+  for (int dir = 0; dir < 4; dir++) free(gauge[dir]);
+  free(clover);
+  free(spinorIn);
+  free(spinorOut);
+
+  finalizeComms();
+
+  return fail ? 1 : 0;
+}
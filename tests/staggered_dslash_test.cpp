@@ -39,6 +39,7 @@ cpuGaugeField *cpuFat = NULL;
 cpuGaugeField *cpuLong = NULL;
 
 cpuColorSpinorField *spinor, *spinorOut, *spinorRef, *tmpCpu;
+cpuColorSpinorField *spinorHost = NULL; // result of the host Dslash
 cudaColorSpinorField *cudaSpinor, *cudaSpinorOut;
 
 cudaColorSpinorField* tmp;
@@ -73,6 +74,7 @@ int X[4];
 extern int Nsrc; // number of spinors to apply to simultaneously
 
 Dirac* dirac;
+Dirac* hostDirac = NULL; // operator applied to the host fields, which allocates host temporaries
 
 void init()
 {    
@@ -168,6 +170,7 @@ void init()
   spinorOut = new cpuColorSpinorField(csParam);
   spinorRef = new cpuColorSpinorField(csParam);
   tmpCpu = new cpuColorSpinorField(csParam);
+  spinorHost = new cpuColorSpinorField(csParam);
 
   csParam.siteSubset = QUDA_FULL_SITE_SUBSET;
   csParam.x[0] = gaugeParam.X[0];
@@ -278,6 +281,11 @@ void init()
 
     dirac = Dirac::create(diracParam);
 
+    if (dslash_type == QUDA_ASQTAD_DSLASH && test_type < 2 && hostStaggeredDslashSupported(*spinor)) {
+      diracParam.tmp1 = NULL;
+      hostDirac = Dirac::create(diracParam);
+    }
+
   } else {
     errorQuda("Error not suppported");
   }
@@ -294,6 +302,7 @@ void end(void)
 
   if (!transfer){
     delete dirac;
+    if (hostDirac) delete hostDirac;
     delete cudaSpinor;
     delete cudaSpinorOut;
     delete tmp;
@@ -303,6 +312,7 @@ void end(void)
   delete spinorOut;
   delete spinorRef;
   delete tmpCpu;
+  delete spinorHost;
 
   if (cpuFat) delete cpuFat;
   if (cpuLong) delete cpuLong;
@@ -391,6 +401,30 @@ DslashTime dslashCUDA(int niter) {
   return dslash_time;
 }
 
+// time the operator applied to the host fields
+double dslashHost(int niter) {
+
+  timeval tstart, tstop;
+  comm_barrier();
+  gettimeofday(&tstart, NULL);
+
+  for (int i = 0; i < niter; i++) {
+    switch (test_type) {
+      case 0:
+        hostDirac->Dslash(*spinorHost, *spinor, parity);
+        break;
+      case 1:
+        hostDirac->MdagM(*spinorHost, *spinor);
+        break;
+    }
+  }
+
+  gettimeofday(&tstop, NULL);
+  long ds = tstop.tv_sec - tstart.tv_sec;
+  long dus = tstop.tv_usec - tstart.tv_usec;
+  return ds + 0.000001*dus;
+}
+
 void staggeredDslashRef()
 {
 
@@ -433,6 +467,19 @@ TEST(dslash, verify) {
   ASSERT_LE(deviation, tol) << "CPU and CUDA implementations do not agree";
 }
 
+TEST(dslash, host) {
+  if (!hostDirac) {
+    printfQuda("Host Dslash not available for this configuration\n");
+    return;
+  }
+
+  // the host links are converted from the device precision
+  double deviation = pow(10, -(double)(cpuColorSpinorField::Compare(*spinorRef, *spinorHost)));
+  double tol = (inv_param.cuda_prec == QUDA_DOUBLE_PRECISION ? 1e-12 :
+		(inv_param.cuda_prec == QUDA_SINGLE_PRECISION ? 1e-3 : 1e-1));
+  ASSERT_LE(deviation, tol) << "CPU reference and host Dslash do not agree";
+}
+
 static int dslashTest()
 {
   // return code for google test
@@ -467,6 +514,15 @@ static int dslashTest()
 	       1.0e-9*2*cudaSpinor->GhostBytes()/dslash_time.cpu_max, 1.0e-9*2*cudaSpinor->GhostBytes()/dslash_time.cpu_min,
 	       2*cudaSpinor->GhostBytes());
 
+    if (hostDirac) {
+      printfQuda("Executing %d host loops...", niter);
+      hostDirac->Flops();
+      double host_time = dslashHost(niter);
+      unsigned long long host_flops = hostDirac->Flops();
+      printfQuda("%fus per host call\n", 1e6*host_time / niter);
+      printfQuda("Host GFLOPS = %f\n", 1.0e-9*host_flops/host_time);
+    }
+
     double spinor_ref_norm2 = blas::norm2(*spinorRef);
     double spinor_out_norm2 =  blas::norm2(*spinorOut);
 
@@ -20,6 +20,11 @@
 // In a typical application, quda.h is the only QUDA header required.
 #include <quda.h>
 
+// for the host check of the gradient flow
+#include <gauge_field.h>
+#include <gauge_tools.h>
+#include <vector>
+
 extern bool tune;
 extern int device;
 extern int xdim;
@@ -80,7 +85,9 @@ void setGaugeParam(QudaGaugeParam &gauge_param) {
 
 extern void usage(char**);
 
-void SU3test(int argc, char **argv) {
+int SU3test(int argc, char **argv) {
+
+  int fail = 0;
 
   for (int i = 1; i < argc; i++){
     if(process_command_line_option(argc, argv, &i) == 0){
@@ -161,7 +168,7 @@ void SU3test(int argc, char **argv) {
   // stop the timer
   time0 += clock();
   time0 /= CLOCKS_PER_SEC;
-  printfQuda("Total time for STOUT = %g secs\n", time0);
+  printfQuda("Total time for STOUT = %g secs (%g secs per step)\n", time0, time0/nSteps);
   qCharge = qChargeCuda();
   printf("Computed topological charge after is %.16e \n", qCharge);
 
@@ -172,7 +179,7 @@ void SU3test(int argc, char **argv) {
   // stop the timer
   time0 += clock();
   time0 /= CLOCKS_PER_SEC;
-  printfQuda("Total time for APE = %g secs\n", time0);
+  printfQuda("Total time for APE = %g secs (%g secs per step)\n", time0, time0/nSteps);
   qCharge = qChargeCuda();
   printf("Computed topological charge after is %.16e \n", qCharge);
 
@@ -186,10 +193,48 @@ void SU3test(int argc, char **argv) {
   // stop the timer
   time0 += clock();
   time0 /= CLOCKS_PER_SEC;
-  printfQuda("Total time for Over Improved STOUT = %g secs\n", time0);
+  printfQuda("Total time for Over Improved STOUT = %g secs (%g secs per step)\n", time0, time0/nSteps);
   qCharge = qChargeCuda();
   printf("Computed topological charge after is %.16e \n", qCharge);
 
+  // Wilson flow
+  nSteps = 20;
+  double flow_eps = 0.01;
+  std::vector<double> flow_obs(4*(nSteps+1));
+  // start the timer
+  time0 = -((double)clock());
+  performGFlownStep(nSteps, flow_eps, 0.0, QUDA_WFLOW_TYPE_WILSON, flow_obs.data());
+  // stop the timer
+  time0 += clock();
+  time0 /= CLOCKS_PER_SEC;
+  printfQuda("Total time for Wilson flow = %g secs\n", time0);
+
+  // repeat the flow on the host and compare the observables
+  if (!comm_partitioned()) {
+    quda::GaugeFieldParam gParam(gauge, gauge_param);
+    quda::cpuGaugeField cpuRef(gParam);
+    gParam.create = QUDA_NULL_FIELD_CREATE;
+    quda::cpuGaugeField cpuFlow(gParam);
+    cpuFlow.copy(cpuRef);
+    gParam.create = QUDA_ZERO_FIELD_CREATE;
+    quda::cpuGaugeField cpuZ(gParam);
+
+    double obs[4];
+    double max_dev = 0.0;
+    for (unsigned int i=0; i<=nSteps; i++) {
+      if (i < nSteps) quda::gradientFlowStep(cpuFlow, cpuZ, flow_eps, QUDA_WFLOW_TYPE_WILSON, obs);
+      else quda::gradientFlowMeasure(cpuFlow, cpuZ, obs);
+      for (int j=0; j<3; j++) max_dev = MAX(max_dev, fabs(obs[j] - flow_obs[4*i+1+j]));
+    }
+    printfQuda("Host Wilson flow: t = %g plaquette = %e E = %e Q = %e, max deviation from device = %e\n",
+	       flow_obs[4*nSteps], obs[0], obs[1], obs[2], max_dev);
+
+    // the device flow runs in cuda_prec, the host flow in cpu_prec
+    const double flow_tol = (cuda_prec == QUDA_DOUBLE_PRECISION && cpu_prec == QUDA_DOUBLE_PRECISION) ? 1e-9 : 1e-3;
+    if (!(max_dev <= flow_tol)) fail++;
+    printfQuda("Host Wilson flow test %s (tolerance %e)\n", max_dev <= flow_tol ? "PASSED" : "FAILED", flow_tol);
+  }
+
 #else
   printf("Skipping plaquette tests since gauge tools have not been compiled\n");
 #endif
@@ -205,11 +250,13 @@ void SU3test(int argc, char **argv) {
   }
 
   finalizeComms();
+
+  return fail;
 }
 
 int main(int argc, char **argv) {
 
-  SU3test(argc, argv);
+  int fail = SU3test(argc, argv);
 
-  return 0;
+  return fail ? 1 : 0;
 }
@@ -1631,6 +1631,7 @@ char vec_outfile[256] = "";
 QudaInverterType inv_type;
 QudaInverterType precon_type = QUDA_INVALID_INVERTER;
 int multishift = 0;
+int propagator = 0;
 bool verify_results = true;
 double mass = 0.1;
 double mu = 0.1;
@@ -1668,6 +1669,9 @@ int eigcg_max_restarts = 3;
 int max_restart_num = 3;
 double inc_tol = 1e-2;
 double eigenval_tol = 1e-1;
+bool lanczos_seed = false;
+int max_recycle_dim = 0;
+double recycle_mem_limit = 0.0;
 
 QudaExtLibType solver_ext_lib     = QUDA_EIGEN_EXTLIB;
 QudaExtLibType deflation_ext_lib  = QUDA_EIGEN_EXTLIB;
@@ -1726,6 +1730,7 @@ void usage(char** argv )
   printf("    --precon-type <mr/ (unspecified)>         # The type of solver to use (default none (=unspecified)).\n"
 	 "                                                  For multigrid this sets the smoother type.\n");
   printf("    --multishift <true/false>                 # Whether to do a multi-shift solver test or not (default false)\n");     
+  printf("    --propagator <true/false>                 # Whether to compare the propagator solver on --nsrc sources with sequential solves (default false)\n");
   printf("    --mass                                    # Mass of Dirac operator (default 0.1)\n");
   printf("    --mu                                      # Twisted-Mass of Dirac operator (default 0.1)\n");
   printf("    --compute-clover                          # Compute the clover field or use random numbers (default false)\n");
@@ -1746,7 +1751,7 @@ void usage(char** argv )
   printf("    --mg-setup-inv <level inv>                # The inverter to use for the setup of multigrid (default bicgstab)\n");
   printf("    --mg-setup-tol                            # The tolerance to use for the setup of multigrid (default 5e-6)\n");
   printf("    --mg-omega                                # The over/under relaxation factor for the smoother of multigrid (default 0.85)\n");
-  printf("    --mg-smoother                             # The smoother to use for multigrid (default mr)\n");
+  printf("    --mg-smoother <mr/gcr/ca-gcr>             # The smoother to use for multigrid (default mr)\n");
   printf("    --mg-block-size <level x y z t>           # Set the geometric block size for the each multigrid level's transfer operator (default 4 4 4 4)\n");
   printf("    --mg-mu-factor <level factor>             # Set the multiplicative factor for the twisted mass mu parameter on each level (default 1)\n");
   printf("    --mg-generate-nullspace <true/false>      # Generate the null-space vector dynamically (default true)\n");
@@ -1762,6 +1767,9 @@ void usage(char** argv )
   printf("    --df-tol-inc <tol>                        # Set tolerance for the subsequent restarts in the initCG solver  (default 1e-2)\n");
   printf("    --df-max-restart-num <n>                  # Set maximum number of the initCG restarts in the deflation stage (default 3)\n");
   printf("    --df-tol-eigenval <tol>                   # Set maximum eigenvalue residual norm (default 1e-1)\n");
+  printf("    --df-lanczos-seed <true/false>            # Seed the deflation space with thick-restart Lanczos eigenvectors (default false)\n");
+  printf("    --df-recycle-dim <n>                      # Set maximum size of the GMRES-DR subspace recycled between solves (default 0, disabled)\n");
+  printf("    --df-recycle-mem <GiB>                    # Set maximum memory used by the recycled GMRES-DR subspace (default 0, no limit)\n");
 
 
   printf("    --solver-ext-lib-type <eigen/magma>       # Set external library for the solvers  (default Eigen library)\n");
@@ -2088,6 +2096,25 @@ int process_command_line_option(int argc, char** argv, int* idx)
     goto out;
   }
 
+  if( strcmp(argv[i], "--propagator") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+
+    if (strcmp(argv[i+1], "true") == 0){
+      propagator = true;
+    }else if (strcmp(argv[i+1], "false") == 0){
+      propagator = false;
+    }else{
+      fprintf(stderr, "ERROR: invalid propagator boolean\n");
+      exit(1);
+    }
+
+    i++;
+    ret = 0;
+    goto out;
+  }
+
   if( strcmp(argv[i], "--gridsize") == 0){
     if (i+1 >= argc){ 
       usage(argv);
@@ -2736,6 +2763,47 @@ int process_command_line_option(int argc, char** argv, int* idx)
     goto out;
   } 
 
+  if( strcmp(argv[i], "--df-lanczos-seed") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+
+    if (strcmp(argv[i+1], "true") == 0){
+      lanczos_seed = true;
+    }else if (strcmp(argv[i+1], "false") == 0){
+      lanczos_seed = false;
+    }else{
+      fprintf(stderr, "ERROR: invalid lanczos seed type\n");
+      exit(1);
+    }
+
+    i++;
+    ret = 0;
+    goto out;
+  }
+
+  if( strcmp(argv[i], "--df-recycle-dim") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+
+    max_recycle_dim = atoi(argv[i+1]);
+    i++;
+    ret = 0;
+    goto out;
+  }
+
+  if( strcmp(argv[i], "--df-recycle-mem") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+
+    recycle_mem_limit = atof(argv[i+1]);
+    i++;
+    ret = 0;
+    goto out;
+  }
+
   if( strcmp(argv[i], "--df-tol-inc") == 0){
     if (i+1 >= argc){
       usage(argv);